@@ -229,9 +229,18 @@ void BenchmarkOptimize(SharedPtr<Infinity> infinity, const String &db_name, cons
 
 void BenchmarkQuery(SharedPtr<Infinity> infinity, const String &db_name, const String &table_name) {
     std::string fields = "text";
-    std::vector<std::string> query_vec = {"harmful \"social custom\"", "social custom \"harmful chemical\"", "\"annual American awards\"", "harmful chemical", "\"one of\""};
-
-    for (auto match_text : query_vec) {
+    // pairs of match text and match options
+    std::vector<std::pair<std::string, std::string>> query_vec = {{"harmful \"social custom\"", ""},
+                                                                  {"social custom \"harmful chemical\"", ""},
+                                                                  {"\"annual American awards\"", ""},
+                                                                  {"harmful chemical", ""},
+                                                                  {"\"one of\"", ""},
+                                                                  {"harm*", "wildcard=true"},
+                                                                  {"ch?mi*l", "wildcard=true"},
+                                                                  {"chemcal~1", "fuzzy=true"},
+                                                                  {"americn~2", "fuzzy=true;max_expansions=20"}};
+
+    for (auto &[match_text, match_options] : query_vec) {
         BaseProfiler profiler;
         profiler.Begin();
         auto *search_expr = new SearchExpr();
@@ -241,6 +250,7 @@ void BenchmarkQuery(SharedPtr<Infinity> infinity, const String &db_name, const S
             auto *match_expr = new MatchExpr();
             match_expr->fields_ = fields;
             match_expr->matching_text_ = match_text;
+            match_expr->options_text_ = match_options;
             exprs->push_back(match_expr);
             search_expr->SetExprs(exprs);
         }
@@ -92,6 +92,7 @@ public:
 
         app_.add_option("--ef", ef_, "ef")->required(false);
         app_.add_option("--test_n", test_n_, "test n")->required(false);
+        app_.add_option("--batch_size", batch_size_, "queries searched together by one thread")->required(false);
 
         try {
             app_.parse(argc, argv);
@@ -133,6 +134,7 @@ public:
 
     SizeT ef_ = 200;
     SizeT test_n_ = 1;
+    SizeT batch_size_ = 1;
 
 public:
     Path data_path_;
@@ -230,14 +232,40 @@ void Query(const BenchmarkOption &option) {
         for (SizeT i = 0; i < option.thread_n_; ++i) {
             query_threads.emplace_back([&] {
                 SizeT i;
-                while ((i = cur_i.fetch_add(1)) < query_num) {
-                    const float *query = query_data.get() + i * query_dim;
-                    Vector<Pair<float, LabelT>> pairs = hnsw->KnnSearchSorted(query, topk, search_option);
-                    if (pairs.size() < SizeT(topk)) {
-                        UnrecoverableError("result_n != topk");
+                if (option.batch_size_ <= 1) {
+                    while ((i = cur_i.fetch_add(1)) < query_num) {
+                        const float *query = query_data.get() + i * query_dim;
+                        Vector<Pair<float, LabelT>> pairs = hnsw->KnnSearchSorted(query, topk, search_option);
+                        if (pairs.size() < SizeT(topk)) {
+                            UnrecoverableError("result_n != topk");
+                        }
+                        for (i32 j = 0; j < topk; ++j) {
+                            results[i][j] = pairs[j].second;
+                        }
                     }
-                    for (i32 j = 0; j < topk; ++j) {
-                        results[i][j] = pairs[j].second;
+                    return;
+                }
+                Vector<const float *> queries;
+                while ((i = cur_i.fetch_add(option.batch_size_)) < query_num) {
+                    SizeT batch_n = std::min(option.batch_size_, query_num - i);
+                    queries.clear();
+                    for (SizeT q = 0; q < batch_n; ++q) {
+                        queries.push_back(query_data.get() + (i + q) * query_dim);
+                    }
+                    auto batch_results = hnsw->KnnSearchBatch(queries.data(), batch_n, topk, search_option);
+                    for (SizeT q = 0; q < batch_n; ++q) {
+                        auto &[result_n, d_ptr, l_ptr] = batch_results[q];
+                        if (result_n < SizeT(topk)) {
+                            UnrecoverableError("result_n != topk");
+                        }
+                        Vector<Pair<float, LabelT>> pairs;
+                        for (SizeT j = 0; j < result_n; ++j) {
+                            pairs.emplace_back(d_ptr[j], l_ptr[j]);
+                        }
+                        std::sort(pairs.begin(), pairs.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+                        for (i32 j = 0; j < topk; ++j) {
+                            results[i + q][j] = pairs[j].second;
+                        }
                     }
                 }
             });
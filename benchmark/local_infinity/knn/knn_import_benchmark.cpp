@@ -42,14 +42,19 @@ import virtual_store;
 using namespace infinity;
 
 int main(int argc, char *argv[]) {
-    if (argc < 2) {
-        std::cout << "import sift or gist, with optional test_data_path (default to /infinity/test/data in docker) and optional infinity path "
-                     "(default to /var/infinity)"
+    auto print_usage = [] {
+        std::cout << "import sift or gist, with optional test_data_path (default to /infinity/test/data in docker), optional infinity path "
+                     "(default to /var/infinity) and optional index type hnsw or diskann (default to hnsw)"
                   << std::endl;
+    };
+    if (argc < 2) {
+        print_usage();
         return 1;
     }
     bool sift = true;
     if (strcmp(argv[1], "sift") && strcmp(argv[1], "gist")) {
+        std::cout << "Unknown data set: " << argv[1] << std::endl;
+        print_usage();
         return 1;
     }
     sift = strcmp(argv[1], "sift") == 0;
@@ -58,6 +63,15 @@ int main(int argc, char *argv[]) {
     if (argc >= 4) {
         data_path = std::string(argv[3]);
     }
+    bool diskann = false;
+    if (argc >= 5) {
+        if (strcmp(argv[4], "hnsw") && strcmp(argv[4], "diskann")) {
+            std::cout << "Unknown index type: " << argv[4] << std::endl;
+            print_usage();
+            return 1;
+        }
+        diskann = strcmp(argv[4], "diskann") == 0;
+    }
 
     if (VirtualStore::Exists(data_path)) {
         std::cout << "Data path: " << data_path << " is already existed." << std::endl;
@@ -72,7 +86,7 @@ int main(int argc, char *argv[]) {
 
     std::vector<std::string> results;
 
-    // hnsw benchmark
+    // hnsw or diskann benchmark
     do {
         std::vector<ColumnDef *> column_defs;
 
@@ -99,7 +113,7 @@ int main(int argc, char *argv[]) {
         column_defs.emplace_back(col1_def.release());
 
         std::string db_name = "default_db";
-        std::string index_name = "hnsw_index";
+        std::string index_name = diskann ? "diskann_index" : "hnsw_index";
 
         std::shared_ptr<Infinity> infinity = Infinity::LocalConnect();
         CreateDatabaseOptions create_db_options;
@@ -127,10 +141,17 @@ int main(int argc, char *argv[]) {
         std::cout << "Import data cost: " << profiler.ElapsedToString() << std::endl;
 
         auto index_info = new IndexInfo();
-        index_info->index_type_ = IndexType::kHnsw;
+        index_info->index_type_ = diskann ? IndexType::kDiskAnn : IndexType::kHnsw;
         index_info->column_name_ = col1_name;
 
-        {
+        if (diskann) {
+            auto index_param_list = new std::vector<InitParameter *>();
+            index_param_list->emplace_back(new InitParameter("R", std::to_string(64)));
+            index_param_list->emplace_back(new InitParameter("L", std::to_string(100)));
+            index_param_list->emplace_back(new InitParameter("num_pq_chunks", std::to_string(sift ? 32 : 120)));
+            index_param_list->emplace_back(new InitParameter("metric", "l2"));
+            index_info->index_param_list_ = index_param_list;
+        } else {
             auto index_param_list = new std::vector<InitParameter *>();
             index_param_list->emplace_back(new InitParameter("m", std::to_string(16)));
             index_param_list->emplace_back(new InitParameter("ef_construction", std::to_string(200)));
@@ -75,8 +75,8 @@ inline void ParallelFor(size_t start, size_t end, size_t numThreads, Function fn
 
 int main(int argc, char *argv[]) {
     if (argc < 3) {
-        std::cout << "query gist/sift ef=? , with optional test_data_path (default to /infinity/test/data in docker) and optional infinity path "
-                     "(default to /var/infinity)"
+        std::cout << "query gist/sift ef=? , with optional rerank, optional test_data_path (default to /infinity/test/data in docker), "
+                     "optional infinity path (default to /var/infinity) and optional index name (default to hnsw_index)"
                   << std::endl;
         return 1;
     }
@@ -102,11 +102,16 @@ int main(int argc, char *argv[]) {
     if (argc >= 6) {
         path = std::string(argv[5]);
     }
+    // hnsw_index or diskann_index, as created by knn_import_benchmark
+    std::string index_name = "hnsw_index";
+    if (argc >= 7) {
+        index_name = std::string(argv[6]);
+    }
 
     Infinity::LocalInit(path);
 
     std::cout << ">>> Query Benchmark Start <<<" << std::endl;
-    std::cout << "Thread Num: " << thread_num << ", Times: " << total_times << std::endl;
+    std::cout << "Thread Num: " << thread_num << ", Times: " << total_times << ", Index: " << index_name << std::endl;
 
     std::vector<std::string> results;
 
@@ -190,6 +195,7 @@ int main(int argc, char *argv[]) {
             knn_expr->dimension_ = dimension;
             knn_expr->distance_type_ = KnnDistanceType::kL2;
             knn_expr->topn_ = topk;
+            knn_expr->index_name_ = index_name;
             knn_expr->opt_params_ = new std::vector<InitParameter *>();
             {
                 knn_expr->opt_params_->push_back(new InitParameter("ef", std::to_string(ef)));
@@ -235,6 +241,7 @@ int main(int argc, char *argv[]) {
             auto elapsed_ns = profiler.Elapsed();
             auto elapsed_s = elapsed_ns / (1'000'000'000.0);
             results.push_back(fmt::format("Total cost : {} s", elapsed_s));
+            results.push_back(fmt::format("QPS : {:.1f}", query_count / elapsed_s));
         }
         {
             size_t correct_1 = 0, correct_10 = 0, correct_100 = 0;
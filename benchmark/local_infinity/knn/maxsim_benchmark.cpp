@@ -0,0 +1,140 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+import stl;
+import third_party;
+import profiler;
+import maxsim_kernel;
+
+using namespace infinity;
+
+// maxsim rerank of candidate documents against one query tensor, on random data
+// usage: maxsim_benchmark [candidate_num] [query_embedding_num] [doc_embedding_num] [dimension] [round]
+// every element type is scored one document at a time and with ScoreBatch
+
+template <typename T>
+Vector<T> RandomData(SizeT size, std::mt19937 &rng) {
+    Vector<T> data(size);
+    if constexpr (std::is_floating_point_v<T>) {
+        std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+        for (auto &v : data) {
+            v = dist(rng);
+        }
+    } else {
+        std::uniform_int_distribution<i32> dist(std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max());
+        for (auto &v : data) {
+            v = static_cast<T>(dist(rng));
+        }
+    }
+    return data;
+}
+
+template <typename TensorElemT, typename QueryElemT, typename StoreT>
+void Benchmark(const String &name,
+               const Vector<QueryElemT> &query,
+               const Vector<StoreT> &docs,
+               u32 doc_bytes,
+               u32 candidate_num,
+               u32 query_embedding_num,
+               u32 doc_embedding_num,
+               u32 dimension,
+               u32 round) {
+    const auto *query_ptr = reinterpret_cast<const char *>(query.data());
+    const auto *doc_ptr = reinterpret_cast<const char *>(docs.data());
+    Vector<const char *> tensors(candidate_num);
+    Vector<u32> embedding_nums(candidate_num, doc_embedding_num);
+    for (u32 i = 0; i < candidate_num; ++i) {
+        tensors[i] = doc_ptr + static_cast<SizeT>(i) * doc_bytes;
+    }
+    MaxSimKernel<TensorElemT, QueryElemT> kernel(query_ptr, query_embedding_num, dimension);
+    Vector<f32> single_scores(candidate_num);
+    Vector<f32> batch_scores(candidate_num);
+
+    BaseProfiler single_profiler("Single");
+    single_profiler.Begin();
+    for (u32 r = 0; r < round; ++r) {
+        for (u32 i = 0; i < candidate_num; ++i) {
+            single_scores[i] = kernel.Score(tensors[i], doc_embedding_num);
+        }
+    }
+    single_profiler.End();
+
+    BaseProfiler batch_profiler("Batch");
+    batch_profiler.Begin();
+    for (u32 r = 0; r < round; ++r) {
+        kernel.ScoreBatch(tensors.data(), embedding_nums.data(), candidate_num, batch_scores.data());
+    }
+    batch_profiler.End();
+
+    f32 max_diff = 0.0f;
+    for (u32 i = 0; i < candidate_num; ++i) {
+        max_diff = std::max(max_diff, std::abs(single_scores[i] - batch_scores[i]));
+    }
+    const f64 single_ms = static_cast<f64>(single_profiler.Elapsed()) / 1e6 / round;
+    const f64 batch_ms = static_cast<f64>(batch_profiler.Elapsed()) / 1e6 / round;
+    std::cout << fmt::format("{:<10} single: {:>10.3f} ms, batch: {:>10.3f} ms, max score diff: {}", name, single_ms, batch_ms, max_diff)
+              << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    const u32 candidate_num = argc > 1 ? std::stoul(argv[1]) : 1000;
+    const u32 query_embedding_num = argc > 2 ? std::stoul(argv[2]) : 128;
+    const u32 doc_embedding_num = argc > 3 ? std::stoul(argv[3]) : 300;
+    const u32 dimension = argc > 4 ? std::stoul(argv[4]) : 128;
+    const u32 round = argc > 5 ? std::stoul(argv[5]) : 5;
+    if (dimension % 8 != 0) {
+        std::cerr << "dimension must be a multiple of 8" << std::endl;
+        return 1;
+    }
+    std::cout << fmt::format("candidates: {}, query embeddings: {}, doc embeddings: {}, dimension: {}, round: {}",
+                             candidate_num,
+                             query_embedding_num,
+                             doc_embedding_num,
+                             dimension,
+                             round)
+              << std::endl;
+
+    std::mt19937 rng(0);
+    const SizeT query_elem_num = static_cast<SizeT>(query_embedding_num) * dimension;
+    const SizeT doc_elem_num = static_cast<SizeT>(doc_embedding_num) * dimension;
+    const auto query_f32 = RandomData<f32>(query_elem_num, rng);
+    {
+        const auto docs = RandomData<f32>(doc_elem_num * candidate_num, rng);
+        const u32 doc_bytes = doc_elem_num * sizeof(f32);
+        Benchmark<f32, f32>("f32", query_f32, docs, doc_bytes, candidate_num, query_embedding_num, doc_embedding_num, dimension, round);
+    }
+    {
+        const auto query = RandomData<i8>(query_elem_num, rng);
+        const auto docs = RandomData<i8>(doc_elem_num * candidate_num, rng);
+        Benchmark<i8, i8>("i8", query, docs, doc_elem_num, candidate_num, query_embedding_num, doc_embedding_num, dimension, round);
+    }
+    {
+        const auto query = RandomData<u8>(query_elem_num, rng);
+        const auto docs = RandomData<u8>(doc_elem_num * candidate_num, rng);
+        Benchmark<u8, u8>("u8", query, docs, doc_elem_num, candidate_num, query_embedding_num, doc_embedding_num, dimension, round);
+    }
+    {
+        // bit packed documents, 8 dimensions in a byte
+        const auto docs = RandomData<u8>(doc_elem_num / 8 * candidate_num, rng);
+        Benchmark<bool, f32>("bit x f32", query_f32, docs, doc_elem_num / 8, candidate_num, query_embedding_num, doc_embedding_num, dimension, round);
+        const auto query = RandomData<u8>(query_elem_num / 8, rng);
+        Benchmark<bool, bool>("bit x bit", query, docs, doc_elem_num / 8, candidate_num, query_embedding_num, doc_embedding_num, dimension, round);
+    }
+    return 0;
+}
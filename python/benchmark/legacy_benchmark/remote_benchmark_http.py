@@ -0,0 +1,79 @@
+import argparse
+import random
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+import requests
+
+# Measures requests/sec of the HTTP search and insert endpoints with large embeddings.
+# Run it against two builds of the server to compare their request parsing.
+
+TABLE_NAME = "http_benchmark"
+
+
+def table_url(host):
+    return f"{host}/databases/default_db/tables/{TABLE_NAME}"
+
+
+def random_vector(dimension):
+    return [random.random() for _ in range(dimension)]
+
+
+def create_table(host, dimension):
+    headers = {"accept": "application/json", "content-type": "application/json"}
+    requests.delete(table_url(host), headers=headers, json={"drop_option": "ignore_if_not_exists"})
+    r = requests.post(table_url(host), headers=headers, json={
+        "fields": [{"name": "id", "type": "integer"}, {"name": "vec", "type": f"vector,{dimension},float"}],
+        "create_option": "error",
+    })
+    assert r.json()["error_code"] == 0, r.text
+
+
+def run(name, request_count, threads, send):
+    start = time.time()
+    with ThreadPoolExecutor(max_workers=threads) as executor:
+        results = list(executor.map(send, range(request_count)))
+    dur = time.time() - start
+    failed = sum(1 for ok in results if not ok)
+    print(f"{name}: {request_count} requests, {failed} failed, cost time: {dur:.2f} s, {request_count / dur:.1f} requests/s")
+
+
+def benchmark_insert(host, dimension, rows_per_request, request_count, threads):
+    bodies = [[{"id": i * rows_per_request + j, "vec": random_vector(dimension)} for j in range(rows_per_request)] for i in
+              range(min(request_count, 64))]
+    session = requests.Session()
+
+    def send(i):
+        r = session.post(f"{table_url(host)}/docs", json=bodies[i % len(bodies)])
+        return r.json()["error_code"] == 0
+
+    run(f"insert {rows_per_request} rows of {dimension} dims", request_count, threads, send)
+
+
+def benchmark_search(host, dimension, request_count, threads):
+    bodies = [{
+        "output": ["id"],
+        "search": [{"match_method": "dense", "fields": "vec", "query_vector": random_vector(dimension),
+                    "element_type": "float", "metric_type": "l2", "topn": 10}],
+    } for _ in range(64)]
+    session = requests.Session()
+
+    def send(i):
+        r = session.get(f"{table_url(host)}/docs", json=bodies[i % len(bodies)])
+        return r.json()["error_code"] == 0
+
+    run(f"search with {dimension} dims query vector", request_count, threads, send)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="HTTP API Benchmark")
+    parser.add_argument("--host", type=str, default="http://127.0.0.1:23820")
+    parser.add_argument("-d", "--dimension", type=int, default=1024)
+    parser.add_argument("-r", "--rows", type=int, default=100, help="rows per insert request")
+    parser.add_argument("-n", "--requests", type=int, default=2000)
+    parser.add_argument("-t", "--threads", type=int, default=8)
+    args = parser.parse_args()
+
+    create_table(args.host, args.dimension)
+    benchmark_insert(args.host, args.dimension, args.rows, args.requests, args.threads)
+    benchmark_search(args.host, args.dimension, args.requests, args.threads)
@@ -0,0 +1,95 @@
+import os
+import tempfile
+from common import common_values
+from infinity_runner import InfinityRunner, infinity_runner_decorator_factory
+from infinity.common import ConflictType
+from infinity.errors import ErrorCode
+import infinity.index as index
+
+
+class TestDiskAnn:
+    # more rows than the pq centers, so the imported segment is searched on its graph
+    row_n = 1000
+
+    def vector(self, i: int) -> list[float]:
+        return [i * 0.01, (i % 7) * 0.05, (i % 3) * 0.02, (i % 11) * 0.001]
+
+    def expected(self, query: list[float], topk: int, row_filter) -> list[int]:
+        def distance(i: int) -> float:
+            return sum((a - b) ** 2 for a, b in zip(self.vector(i), query))
+
+        rows = [i for i in range(self.row_n) if row_filter(i)]
+        return sorted(rows, key=distance)[:topk]
+
+    def test_diskann_search_after_restart(self, infinity_runner: InfinityRunner):
+        table_name = "test_diskann"
+        config = "test/data/config/restart_test/test_diskann/1.toml"
+        uri = common_values.TEST_LOCAL_HOST
+        infinity_runner.clear()
+
+        import_dir = tempfile.mkdtemp()
+        import_file = os.path.join(import_dir, "diskann.csv")
+        with open(import_file, "w") as f:
+            for i in range(self.row_n):
+                vector = ", ".join(str(v) for v in self.vector(i))
+                f.write(f'{i},"[{vector}]"\n')
+
+        query = [3.0, 0.1, 0.02, 0.005]
+        topk = 5
+
+        def check(table_obj):
+            data_dict, _ = (
+                table_obj.output(["c1"])
+                .match_dense("c2", query, "float", "l2", topk)
+                .to_result()
+            )
+            assert data_dict["c1"] == self.expected(query, topk, lambda i: True)
+
+            # the nearest rows are filtered out, the candidates list grows until topk rows pass
+            data_dict, _ = (
+                table_obj.output(["c1"])
+                .match_dense("c2", query, "float", "l2", topk, {"filter": "c1 >= 600"})
+                .to_result()
+            )
+            assert data_dict["c1"] == self.expected(query, topk, lambda i: i >= 600)
+
+            # few rows pass, the chunk is scanned brute force
+            data_dict, _ = (
+                table_obj.output(["c1"])
+                .match_dense("c2", query, "float", "l2", topk, {"filter": "c1 < 20"})
+                .to_result()
+            )
+            assert data_dict["c1"] == self.expected(query, topk, lambda i: i < 20)
+
+        decorator = infinity_runner_decorator_factory(config, uri, infinity_runner)
+
+        @decorator
+        def part1(infinity_obj):
+            db_obj = infinity_obj.get_database("default_db")
+            db_obj.drop_table(table_name, ConflictType.Ignore)
+            table_obj = db_obj.create_table(
+                table_name,
+                {"c1": {"type": "int"}, "c2": {"type": "vector,4,float"}},
+            )
+            res = table_obj.create_index(
+                "idx1",
+                index.IndexInfo("c2", index.IndexType.DiskAnn, {"metric": "l2"}),
+            )
+            assert res.error_code == ErrorCode.OK
+            table_obj.import_data(import_file, {"file_type": "csv"})
+            check(table_obj)
+
+        part1()
+
+        # the chunk index is loaded from its file after the restart
+        @decorator
+        def part2(infinity_obj):
+            db_obj = infinity_obj.get_database("default_db")
+            table_obj = db_obj.get_table(table_name)
+            check(table_obj)
+            db_obj.drop_table(table_name)
+
+        part2()
+
+        os.remove(import_file)
+        os.rmdir(import_dir)
@@ -165,11 +165,19 @@ export {
     constexpr SizeT DISKANN_MAX_GRAPH_DEGREE = 512; // SSD index max degree
     constexpr SizeT DISKANN_SECTOR_LEN = 4096u; // SSD index sector size
     constexpr SizeT DISKANN_MAX_N_SECTOR_READS = 128; // SSD index max sector reads
+    constexpr u32 DISKANN_BEAM_WIDTH = 4; // nodes read from SSD in one batch when searching
+    constexpr u32 DISKANN_SEARCH_L = 100; // default length of candidates list when searching
+    constexpr f32 DISKANN_FILTER_BRUTE_FORCE_RATIO = 0.1f; // a chunk where fewer of the rows pass the filter is scanned instead of searched
+    constexpr u32 KNN_BOUND_CHECK_DIM = 64; // dimensions between two checks of a partial l2 distance against the knn distance bound
 
     // default hnsw parameter
     constexpr SizeT HNSW_M = 16;
     constexpr SizeT HNSW_EF_CONSTRUCTION = 200;
     constexpr SizeT HNSW_BLOCK_SIZE = 8192;
+    constexpr SizeT HNSW_PQ_SUBSPACE_DIM = 8; // target dimensions encoded by one byte in hnsw pq encoding
+    constexpr SizeT HNSW_PQ_TRAIN_SAMPLE_NUM = 65536; // max vectors used to train the pq codebook
+    constexpr SizeT HNSW_PQ_TRAIN_SAMPLE_BYTES = 64 * 1024 * 1024; // max bytes of the f32 vectors sampled to train the pq codebook
+    constexpr u32 HNSW_PQ_TRAIN_ITER = 10;
 
     constexpr SizeT BMP_BLOCK_SIZE = 16;
 
@@ -180,10 +188,15 @@ export {
     constexpr SizeT DBT_COMPACTION_M = 4;
     constexpr SizeT DBT_COMPACTION_C = 4;
     constexpr SizeT DBT_COMPACTION_S = DEFAULT_BLOCK_CAPACITY;
+    constexpr f64 DBT_REWRITE_DELETE_RATIO = 0.5;
+    constexpr SizeT DBT_REWRITE_MIN_DELETE_ROWS = DEFAULT_BLOCK_CAPACITY;
+    constexpr SizeT DBT_REWRITE_MAX_RUNNING = 1;
+    constexpr SizeT DBT_REWRITE_ROWS_PER_SEC = 1024 * 1024;
 
     // default query option parameter
     constexpr u32 DEFAULT_MATCH_TEXT_OPTION_TOP_N = 10;
     constexpr u32 DEFAULT_MATCH_TENSOR_OPTION_TOP_N = 10;
+    constexpr SizeT MAXSIM_BATCH_EMBEDDING_NUM = 2048; // document embeddings scored together by one gemm of maxsim
     constexpr u32 DEFAULT_FUSION_OPTION_TOP_N = 100;
 
     constexpr SizeT DEFAULT_BUFFER_MANAGER_SIZE = 8 * 1024lu * 1024lu * 1024lu; // 8Gib
@@ -193,10 +206,23 @@ export {
     constexpr SizeT DEFAULT_MEMINDEX_MEMORY_QUOTA = 4 * 1024lu * 1024lu * 1024lu; // 4GB
     constexpr std::string_view DEFAULT_MEMINDEX_MEMORY_QUOTA_STR = "4GB"; // 4GB
 
+    constexpr SizeT DEFAULT_POSTING_BLOCK_CACHE_SIZE = 256 * 1024lu * 1024lu; // 256MB
+    constexpr std::string_view DEFAULT_POSTING_BLOCK_CACHE_SIZE_STR = "256MB"; // 256MB
+
     constexpr SizeT DEFAULT_LOG_FILE_SIZE = 64 * 1024lu * 1024lu; // 64MB
     constexpr std::string_view DEFAULT_LOG_FILE_SIZE_STR = "64MB"; // 64MB
 
     constexpr SizeT INSERT_BATCH_ROW_LIMIT = 8192;
+    // ORDER BY spills sorted runs to the temp dir once its input exceeds this.
+    constexpr SizeT DEFAULT_SORT_MEMORY_BUDGET = 256 * 1024lu * 1024lu; // 256MB
+    constexpr std::string_view DEFAULT_SORT_MEMORY_BUDGET_STR = "256MB"; // 256MB
+    // Memory a run takes while it is merged, one block and its keys. Bounds the merge fan-in together with the budget.
+    constexpr SizeT SORT_MERGE_RUN_BYTES = 1024lu * 1024lu; // 1MB
+    constexpr SizeT SORT_MAX_MERGE_FAN_IN = 256;
+    // Merged blocks output by one execution of the sort.
+    constexpr SizeT SORT_MERGE_OUTPUT_BLOCKS = 4;
+    // ORDER BY ... LIMIT above this is planned as a spilling sort with a limit instead of a top-N heap.
+    constexpr SizeT TOP_HEAP_MAX_LIMIT = 1024lu * 1024lu;
 
     // default persistence parameter
     constexpr std::string_view DEFAULT_PERSISTENCE_DIR = "/var/infinity/persistence"; // Empty means disabled
@@ -208,6 +234,13 @@ export {
     constexpr std::string_view DEFAULT_OBJECT_STORAGE_DISK_CACHE_DIR = "/var/infinity/localdiskcache";
     constexpr std::string_view DEFAULT_OBJECT_STORAGE_DISK_CACHE_LIMIT_STR = "100GB"; // 100GB
     constexpr SizeT DEFAULT_OBJECT_STORAGE_DISK_CACHE_LIMIT = 100 * 1024lu * 1024lu * 1024lu; // 100GB
+    constexpr i64 DEFAULT_OBJECT_STORAGE_MAX_IN_FLIGHT = 16;
+    constexpr i64 MAX_OBJECT_STORAGE_MAX_IN_FLIGHT = 256;
+    // Objects larger than this are uploaded and downloaded in parts of OBJECT_STORAGE_PART_SIZE, which run in parallel.
+    constexpr SizeT OBJECT_STORAGE_MULTIPART_THRESHOLD = 32 * 1024lu * 1024lu; // 32MB
+    constexpr SizeT OBJECT_STORAGE_PART_SIZE = 16 * 1024lu * 1024lu;           // 16MB
+    constexpr SizeT OBJECT_STORAGE_MAX_ATTEMPTS = 4;
+    constexpr SizeT OBJECT_STORAGE_RETRY_BACKOFF_MS = 100; // doubled after each failed attempt
 
 
     // config name
@@ -252,11 +285,14 @@ export {
     constexpr std::string_view OBJECT_STORAGE_DISK_CACHE_DIR_OPTION_NAME = "disk_cache_dir";
     constexpr std::string_view OBJECT_STORAGE_DISK_CACHE_LIMIT_OPTION_NAME = "disk_cache_limit";
     constexpr std::string_view OBJECT_STORAGE_DISK_CACHE_LRU_COUNT_OPTION_NAME = "disk_cache_lru_count";
+    constexpr std::string_view OBJECT_STORAGE_MAX_IN_FLIGHT_OPTION_NAME = "max_in_flight_requests";
 
     constexpr std::string_view BUFFER_MANAGER_SIZE_OPTION_NAME = "buffer_manager_size";
     constexpr std::string_view LRU_NUM_OPTION_NAME = "lru_num";
     constexpr std::string_view TEMP_DIR_OPTION_NAME = "temp_dir";
     constexpr std::string_view MEMINDEX_MEMORY_QUOTA_OPTION_NAME = "memindex_memory_quota";
+    constexpr std::string_view POSTING_BLOCK_CACHE_SIZE_OPTION_NAME = "posting_block_cache_size";
+    constexpr std::string_view SORT_MEMORY_BUDGET_OPTION_NAME = "sort_memory_budget";
 
     constexpr std::string_view WAL_DIR_OPTION_NAME = "wal_dir";
     constexpr std::string_view WAL_COMPACT_THRESHOLD_OPTION_NAME = "wal_compact_threshold";
@@ -294,6 +330,7 @@ export {
     constexpr std::string_view OPEN_FILE_COUNT_VAR_NAME = "open_file_count";  // global
     constexpr std::string_view CPU_USAGE_VAR_NAME = "cpu_usage";  // global
     constexpr std::string_view FOLLOWER_NUMBER = "follower_number";  // global
+    constexpr std::string_view POSTING_BLOCK_CACHE_VAR_NAME = "posting_block_cache";  // global
 
     // IO related
     constexpr SizeT DEFAULT_READ_BUFFER_SIZE = 4096;
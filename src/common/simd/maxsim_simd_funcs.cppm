@@ -213,4 +213,64 @@ export i64 maxsim_i64_bit_ip_avx512(const i64 *v1, const u8 *v2, SizeT dim) {
 }
 #endif
 
+// sum over rows of the max value in the first col_num columns, rows are row_stride floats apart
+// reduces the query x document similarity matrix of maxsim to the score of the document
+export f32 maxsim_f32_row_max_sum_plain(const f32 *scores, SizeT row_num, SizeT col_num, SizeT row_stride) {
+    f32 sum = 0.0f;
+    for (SizeT i = 0; i < row_num; ++i) {
+        const f32 *row = scores + i * row_stride;
+        f32 max_value = std::numeric_limits<f32>::lowest();
+        for (SizeT j = 0; j < col_num; ++j) {
+            max_value = std::max(max_value, row[j]);
+        }
+        sum += max_value;
+    }
+    return sum;
+}
+
+#if defined(__AVX2__)
+export f32 maxsim_f32_row_max_sum_avx2(const f32 *scores, SizeT row_num, SizeT col_num, SizeT row_stride) {
+    const SizeT col_num8 = col_num & ~static_cast<SizeT>(7);
+    f32 sum = 0.0f;
+    for (SizeT i = 0; i < row_num; ++i) {
+        const f32 *row = scores + i * row_stride;
+        f32 max_value = std::numeric_limits<f32>::lowest();
+        SizeT j = 0;
+        if (col_num8 > 0) {
+            __m256 max_8 = _mm256_loadu_ps(row);
+            for (j = 8; j < col_num8; j += 8) {
+                max_8 = _mm256_max_ps(max_8, _mm256_loadu_ps(row + j));
+            }
+            __m128 max_4 = _mm_max_ps(_mm256_castps256_ps128(max_8), _mm256_extractf128_ps(max_8, 1));
+            max_4 = _mm_max_ps(max_4, _mm_movehl_ps(max_4, max_4));
+            max_4 = _mm_max_ss(max_4, _mm_movehdup_ps(max_4));
+            max_value = _mm_cvtss_f32(max_4);
+        }
+        for (; j < col_num; ++j) {
+            max_value = std::max(max_value, row[j]);
+        }
+        sum += max_value;
+    }
+    return sum;
+}
+#endif
+
+#if defined(__AVX512F__)
+export f32 maxsim_f32_row_max_sum_avx512(const f32 *scores, SizeT row_num, SizeT col_num, SizeT row_stride) {
+    const SizeT col_num16 = col_num & ~static_cast<SizeT>(15);
+    const __m512 lowest = _mm512_set1_ps(std::numeric_limits<f32>::lowest());
+    const __mmask16 tail_mask = (1u << (col_num - col_num16)) - 1u;
+    f32 sum = 0.0f;
+    for (SizeT i = 0; i < row_num; ++i) {
+        const f32 *row = scores + i * row_stride;
+        __m512 max_16 = _mm512_mask_loadu_ps(lowest, tail_mask, row + col_num16);
+        for (SizeT j = 0; j < col_num16; j += 16) {
+            max_16 = _mm512_max_ps(max_16, _mm512_loadu_ps(row + j));
+        }
+        sum += _mm512_reduce_max_ps(max_16);
+    }
+    return sum;
+}
+#endif
+
 } // namespace infinity
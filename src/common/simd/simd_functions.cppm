@@ -60,6 +60,7 @@ export struct SIMD_FUNCTIONS {
     MaxSimF32BitIPFuncType MaxSimF32BitIP_func_ptr_ = GetMaxSimF32BitIPFuncPtr();
     MaxSimI32BitIPFuncType MaxSimI32BitIP_func_ptr_ = GetMaxSimI32BitIPFuncPtr();
     MaxSimI64BitIPFuncType MaxSimI64BitIP_func_ptr_ = GetMaxSimI64BitIPFuncPtr();
+    MaxSimRowMaxSumFuncType MaxSimRowMaxSum_func_ptr_ = GetMaxSimRowMaxSumFuncPtr();
 
     // EMVB
     FilterScoresOutputIdsFuncType FilterScoresOutputIds_func_ptr_ = GetFilterScoresOutputIdsFuncPtr();
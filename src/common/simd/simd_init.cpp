@@ -564,6 +564,20 @@ MaxSimI64BitIPFuncType GetMaxSimI64BitIPFuncPtr() {
     return &maxsim_i64_bit_ip_plain;
 }
 
+MaxSimRowMaxSumFuncType GetMaxSimRowMaxSumFuncPtr() {
+#if defined(__AVX512F__)
+    if (IsAVX512Supported()) {
+        return &maxsim_f32_row_max_sum_avx512;
+    }
+#endif
+#if defined(__AVX2__)
+    if (IsAVX2Supported()) {
+        return &maxsim_f32_row_max_sum_avx2;
+    }
+#endif
+    return &maxsim_f32_row_max_sum_plain;
+}
+
 FilterScoresOutputIdsFuncType GetFilterScoresOutputIdsFuncPtr() {
 #if defined(__AVX2__)
     if (IsAVX2Supported()) {
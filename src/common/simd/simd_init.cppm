@@ -35,6 +35,7 @@ export using U8CosDistanceFuncType = f32(*)(const u8 *, const u8 *, SizeT);
 export using MaxSimF32BitIPFuncType = f32(*)(const f32 *, const u8 *, SizeT);
 export using MaxSimI32BitIPFuncType = i32(*)(const i32 *, const u8 *, SizeT);
 export using MaxSimI64BitIPFuncType = i64(*)(const i64 *, const u8 *, SizeT);
+export using MaxSimRowMaxSumFuncType = f32(*)(const f32 *, SizeT, SizeT, SizeT);
 export using FilterScoresOutputIdsFuncType = u32 * (*)(u32 *, f32, const f32 *, u32);
 export using SearchTop1WithDisF32U32FuncType = void(*)(u32, u32, const f32 *, u32, const f32 *, u32 *, f32 *);
 
@@ -73,6 +74,7 @@ export U8CosDistanceFuncType Get_HNSW_U8Cos_ptr();
 export MaxSimF32BitIPFuncType GetMaxSimF32BitIPFuncPtr();
 export MaxSimI32BitIPFuncType GetMaxSimI32BitIPFuncPtr();
 export MaxSimI64BitIPFuncType GetMaxSimI64BitIPFuncPtr();
+export MaxSimRowMaxSumFuncType GetMaxSimRowMaxSumFuncPtr();
 // EMVB
 export FilterScoresOutputIdsFuncType GetFilterScoresOutputIdsFuncPtr();
 // K-means
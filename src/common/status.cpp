@@ -605,4 +605,12 @@ Status Status::NodeNameMismatch(const String &actual_node_name, const String &ex
                   MakeUnique<String>(fmt::format("Expect node name: {}, actual node name: {}", expected_node_name, actual_node_name)));
 }
 
+Status Status::NodeBehindCheckpoint(const String &node_name, u64 node_ts, u64 checkpoint_ts) {
+    return Status(ErrorCode::kNodeBehindCheckpoint,
+                  MakeUnique<String>(fmt::format("Node {} at txn ts {} is behind the leader checkpoint ts {}, the WAL can't catch it up",
+                                                 node_name,
+                                                 node_ts,
+                                                 checkpoint_ts)));
+}
+
 } // namespace infinity
@@ -187,7 +187,8 @@ export enum class ErrorCode : long {
     kInvalidNodeRole = 8007,
     kInvalidNodeStatus = 8008,
     kNodeInfoUpdated = 8009,
-    kNodeNameMismatch = 8010
+    kNodeNameMismatch = 8010,
+    kNodeBehindCheckpoint = 8011
 };
 
 export class Status {
@@ -354,6 +355,7 @@ public:
     static Status InvalidNodeStatus(const String &message);
     static Status NodeInfoUpdated(const String &message);
     static Status NodeNameMismatch(const String &actual_node_name, const String &expected_node_name);
+    static Status NodeBehindCheckpoint(const String &node_name, u64 node_ts, u64 checkpoint_ts);
 
 public:
     Status() = default;
@@ -84,18 +84,35 @@ namespace minio {
         export using minio::s3::CopyObjectResponse;
         export using minio::s3::DownloadObjectArgs;
         export using minio::s3::DownloadObjectResponse;
+        export using minio::s3::GetObjectArgs;
+        export using minio::s3::GetObjectResponse;
         export using minio::s3::UploadObjectArgs;
         export using minio::s3::UploadObjectResponse;
         export using minio::s3::PutObjectArgs;
         export using minio::s3::PutObjectResponse;
         export using minio::s3::BucketExistsArgs;
         export using minio::s3::BucketExistsResponse;
+        export using minio::s3::StatObjectArgs;
+        export using minio::s3::StatObjectResponse;
+        export using minio::s3::CreateMultipartUploadArgs;
+        export using minio::s3::CreateMultipartUploadResponse;
+        export using minio::s3::UploadPartArgs;
+        export using minio::s3::UploadPartResponse;
+        export using minio::s3::CompleteMultipartUploadArgs;
+        export using minio::s3::CompleteMultipartUploadResponse;
+        export using minio::s3::AbortMultipartUploadArgs;
+        export using minio::s3::AbortMultipartUploadResponse;
+        export using minio::s3::Part;
     } // namespace s3
 
     namespace creds {
         export using minio::creds::StaticProvider;
     } // namespace creds
 
+    namespace http {
+        export using minio::http::DataFunctionArgs;
+    } // namespace http
+
 } // namespace minio
 
 namespace fmt {
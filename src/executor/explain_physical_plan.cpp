@@ -90,6 +90,7 @@ import column_def;
 import statement_common;
 import flush_statement;
 import common_query_filter;
+import fast_rough_filter;
 import table_entry;
 import logger;
 import show_statement;
@@ -752,6 +753,13 @@ void ExplainPhysicalPlan::Explain(const PhysicalTableScan *table_scan_node, Shar
     output_columns += table_scan_node->GetOutputNames()->back();
     output_columns += "]";
     result->emplace_back(MakeShared<String>(output_columns));
+
+    // Block skipping, the skipped block count of each call is reported by the profiler
+    if (const auto *evaluator = table_scan_node->GetFastRoughFilterEvaluator();
+        evaluator != nullptr and evaluator->Tag() != FastRoughFilterEvaluatorTag::kAlwaysTrue) {
+        String block_skipping = String(intent_size, ' ') + " - block skipping: minmax filter, zone map";
+        result->emplace_back(MakeShared<String>(block_skipping));
+    }
 }
 
 void ExplainPhysicalPlan::Explain(const PhysicalIndexScan *index_scan_node, SharedPtr<Vector<SharedPtr<String>>> &result, i64 intent_size) {
@@ -835,7 +843,9 @@ void ExplainPhysicalPlan::Explain(const PhysicalKnnScan *knn_scan_node, SharedPt
     // Query embedding
     String query_embedding =
         String(intent_size + 2, ' ') + " - query embedding: " +
-        EmbeddingT::Embedding2String(knn_expr_raw->query_embedding_, knn_expr_raw->embedding_data_type_, knn_expr_raw->dimension_);
+        EmbeddingT::Embedding2String(knn_expr_raw->query_embedding_,
+                                     knn_expr_raw->embedding_data_type_,
+                                     knn_expr_raw->dimension_ * knn_expr_raw->query_embedding_count_);
     result->emplace_back(MakeShared<String>(query_embedding));
 
     // filter expression
@@ -953,6 +963,15 @@ void ExplainPhysicalPlan::Explain(const PhysicalSort *sort_node, SharedPtr<Vecto
         result->emplace_back(MakeShared<String>(sort_expression_str));
     }
 
+    if (sort_node->limit_ != std::numeric_limits<u64>::max()) {
+        String limit_value_str = String(intent_size, ' ') + " - limit: " + std::to_string(sort_node->limit_ - sort_node->offset_);
+        result->emplace_back(MakeShared<String>(limit_value_str));
+        if (sort_node->offset_) {
+            String offset_value_str = String(intent_size, ' ') + " - offset: " + std::to_string(sort_node->offset_);
+            result->emplace_back(MakeShared<String>(offset_value_str));
+        }
+    }
+
     // Output column
     {
         String output_columns_str = String(intent_size, ' ') + " - output columns: [";
@@ -167,7 +167,11 @@ void ExpressionEvaluator::Execute(const SharedPtr<FunctionExpression> &expr,
     DataBlock func_input_data_block;
     func_input_data_block.Init(arguments);
 
-    expr->func_.function_(func_input_data_block, output_column_vector);
+    if (expr->func_.state_function_) {
+        expr->func_.state_function_(func_input_data_block, output_column_vector, state->function_state_);
+    } else {
+        expr->func_.function_(func_input_data_block, output_column_vector);
+    }
 }
 
 void ExpressionEvaluator::Execute(const SharedPtr<ValueExpression> &expr,
@@ -14,6 +14,8 @@
 
 module;
 
+#include <chrono>
+
 module expression_selector;
 
 import stl;
@@ -29,6 +31,9 @@ import internal_types;
 import third_party;
 import data_type;
 import logger;
+import expression_type;
+import function_expression;
+import reference_expression;
 
 import infinity_exception;
 
@@ -70,7 +75,246 @@ void ExpressionSelector::Select(const SharedPtr<BaseExpression> &expr,
         String error_message = "Attempting to select non-boolean expression";
         UnrecoverableError(error_message);
     }
-    Select(expr, state, count, output_true_select);
+    SelectRows(expr, state, count, input_select.get(), output_true_select);
+}
+
+namespace {
+
+// A predicate is evaluated on the selected rows only when at most 1 / kSparseSelectionDivisor of the rows are selected,
+// otherwise copying the selected rows costs more than evaluating all of them.
+constexpr SizeT kSparseSelectionDivisor = 2;
+
+// Halve the statistics after this many input rows, so that the order follows changes in the data
+constexpr f64 kConjunctStatsDecayRows = 1 << 20;
+
+bool IsFunction(const SharedPtr<BaseExpression> &expr, const char *func_name) {
+    return expr->type() == ExpressionType::kFunction && static_cast<const FunctionExpression *>(expr.get())->ScalarFunctionName() == func_name;
+}
+
+void CollectConjuncts(const SharedPtr<BaseExpression> &expr,
+                      SharedPtr<ExpressionState> &state,
+                      Vector<Pair<const SharedPtr<BaseExpression> *, SharedPtr<ExpressionState> *>> &conjuncts) {
+    if (IsFunction(expr, "AND")) {
+        for (SizeT i = 0; i < expr->arguments().size(); ++i) {
+            CollectConjuncts(expr->arguments()[i], state->Children()[i], conjuncts);
+        }
+        return;
+    }
+    conjuncts.emplace_back(&expr, &state);
+}
+
+// Returns false when the expression contains something else than functions, casts, values and column references
+bool CollectReferencedColumns(const SharedPtr<BaseExpression> &expr, Vector<bool> &referenced) {
+    switch (expr->type()) {
+        case ExpressionType::kReference: {
+            SizeT column_index = static_cast<const ReferenceExpression *>(expr.get())->column_index();
+            if (column_index >= referenced.size()) {
+                return false;
+            }
+            referenced[column_index] = true;
+            return true;
+        }
+        case ExpressionType::kValue: {
+            return true;
+        }
+        case ExpressionType::kFunction:
+        case ExpressionType::kCast: {
+            for (const auto &argument : expr->arguments()) {
+                if (!CollectReferencedColumns(argument, referenced)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+inline bool IsTrue(const ColumnVector &bool_column, SizeT idx) {
+    if (bool_column.vector_type() == ColumnVectorType::kConstant) {
+        idx = 0;
+    }
+    return bool_column.nulls_ptr_->IsTrue(idx) && bool_column.buffer_->GetCompactBit(idx);
+}
+
+} // namespace
+
+void ExpressionSelector::SelectRows(const SharedPtr<BaseExpression> &expr,
+                                    SharedPtr<ExpressionState> &state,
+                                    SizeT count,
+                                    const Selection *input_select,
+                                    SharedPtr<Selection> &output_true_select) {
+    if (input_select != nullptr && input_select->Size() == 0) {
+        return;
+    }
+    if (IsFunction(expr, "AND")) {
+        SelectConjunction(expr, state, count, input_select, output_true_select);
+    } else if (IsFunction(expr, "OR")) {
+        SelectDisjunction(expr, state, count, input_select, output_true_select);
+    } else {
+        SelectPredicate(expr, state, count, input_select, output_true_select);
+    }
+}
+
+void ExpressionSelector::SelectConjunction(const SharedPtr<BaseExpression> &expr,
+                                           SharedPtr<ExpressionState> &state,
+                                           SizeT count,
+                                           const Selection *input_select,
+                                           SharedPtr<Selection> &output_true_select) {
+    Vector<Pair<const SharedPtr<BaseExpression> *, SharedPtr<ExpressionState> *>> conjuncts;
+    CollectConjuncts(expr, state, conjuncts);
+    auto &conjunct_stats = state->conjunct_stats_;
+    if (conjunct_stats.size() != conjuncts.size()) {
+        conjunct_stats.assign(conjuncts.size(), ConjunctStats());
+    }
+
+    // Cheap conjuncts which reject many rows go first: ascending cost per row / (1 - pass rate)
+    Vector<SizeT> order(conjuncts.size());
+    std::iota(order.begin(), order.end(), 0);
+    bool has_stats = std::all_of(conjunct_stats.begin(), conjunct_stats.end(), [](const ConjunctStats &stats) { return stats.input_rows_ > 0; });
+    if (has_stats) {
+        Vector<f64> ranks(conjuncts.size());
+        for (SizeT i = 0; i < conjuncts.size(); ++i) {
+            const ConjunctStats &stats = conjunct_stats[i];
+            f64 pass_rate = stats.output_rows_ / stats.input_rows_;
+            ranks[i] = (stats.nanos_ / stats.input_rows_) / (1.0 - pass_rate + 1e-6);
+        }
+        std::stable_sort(order.begin(), order.end(), [&](SizeT left, SizeT right) { return ranks[left] < ranks[right]; });
+    }
+
+    SharedPtr<Selection> selected = nullptr;
+    const Selection *active_select = input_select;
+    for (SizeT conjunct_id : order) {
+        auto &[conjunct_expr, conjunct_state] = conjuncts[conjunct_id];
+        SizeT input_rows = active_select != nullptr ? active_select->Size() : count;
+        auto conjunct_selected = MakeShared<Selection>();
+        conjunct_selected->Initialize(count);
+
+        auto begin_time = std::chrono::steady_clock::now();
+        SelectRows(*conjunct_expr, *conjunct_state, count, active_select, conjunct_selected);
+        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin_time).count();
+
+        ConjunctStats &stats = conjunct_stats[conjunct_id];
+        if (stats.input_rows_ > kConjunctStatsDecayRows) {
+            stats.input_rows_ /= 2;
+            stats.output_rows_ /= 2;
+            stats.nanos_ /= 2;
+        }
+        stats.input_rows_ += input_rows;
+        stats.output_rows_ += conjunct_selected->Size();
+        stats.nanos_ += nanos;
+
+        selected = std::move(conjunct_selected);
+        active_select = selected.get();
+        if (selected->Size() == 0) {
+            break;
+        }
+    }
+    output_true_select = std::move(selected);
+}
+
+void ExpressionSelector::SelectDisjunction(const SharedPtr<BaseExpression> &expr,
+                                           SharedPtr<ExpressionState> &state,
+                                           SizeT count,
+                                           const Selection *input_select,
+                                           SharedPtr<Selection> &output_true_select) {
+    auto left_selected = MakeShared<Selection>();
+    left_selected->Initialize(count);
+    SelectRows(expr->arguments()[0], state->Children()[0], count, input_select, left_selected);
+
+    // The right side only needs the rows the left side rejected
+    auto left_rejected = MakeShared<Selection>();
+    left_rejected->Initialize(count);
+    SizeT input_size = input_select != nullptr ? input_select->Size() : count;
+    for (SizeT i = 0, left_i = 0; i < input_size; ++i) {
+        SizeT row_idx = input_select != nullptr ? input_select->Get(i) : i;
+        if (left_i < left_selected->Size() && left_selected->Get(left_i) == row_idx) {
+            ++left_i;
+        } else {
+            left_rejected->Append(row_idx);
+        }
+    }
+    if (left_rejected->Size() == 0) {
+        output_true_select = std::move(left_selected);
+        return;
+    }
+    auto right_selected = MakeShared<Selection>();
+    right_selected->Initialize(count);
+    SelectRows(expr->arguments()[1], state->Children()[1], count, left_rejected.get(), right_selected);
+
+    // Merge the two disjoint sets of rows in row order
+    auto selected = MakeShared<Selection>();
+    selected->Initialize(count);
+    SizeT left_i = 0, right_i = 0;
+    while (left_i < left_selected->Size() || right_i < right_selected->Size()) {
+        if (right_i == right_selected->Size() || (left_i < left_selected->Size() && left_selected->Get(left_i) < right_selected->Get(right_i))) {
+            selected->Append(left_selected->Get(left_i++));
+        } else {
+            selected->Append(right_selected->Get(right_i++));
+        }
+    }
+    output_true_select = std::move(selected);
+}
+
+void ExpressionSelector::SelectPredicate(const SharedPtr<BaseExpression> &expr,
+                                         SharedPtr<ExpressionState> &state,
+                                         SizeT count,
+                                         const Selection *input_select,
+                                         SharedPtr<Selection> &output_true_select) {
+    if (input_select == nullptr) {
+        Select(expr, state, count, output_true_select);
+        return;
+    }
+
+    SharedPtr<ColumnVector> bool_column = MakeShared<ColumnVector>(MakeShared<DataType>(LogicalType::kBoolean));
+    bool_column->Initialize(ColumnVectorType::kCompactBit);
+    ExpressionEvaluator expr_evaluator;
+
+    const SizeT selected_count = input_select->Size();
+    Vector<bool> referenced(input_data_->column_count(), false);
+    if (selected_count * kSparseSelectionDivisor > count || !CollectReferencedColumns(expr, referenced) ||
+        std::find(referenced.begin(), referenced.end(), true) == referenced.end()) {
+        // Dense: evaluate all rows and keep the selected ones
+        expr_evaluator.Init(input_data_);
+        expr_evaluator.Execute(expr, state, bool_column);
+        for (SizeT i = 0; i < selected_count; ++i) {
+            SizeT row_idx = input_select->Get(i);
+            if (IsTrue(*bool_column, row_idx)) {
+                output_true_select->Append(row_idx);
+            }
+        }
+        return;
+    }
+
+    // Sparse: evaluate a block made of the selected rows of the referenced columns
+    Vector<SharedPtr<ColumnVector>> columns(input_data_->column_count());
+    SharedPtr<ColumnVector> unused_column = nullptr;
+    for (SizeT column_idx = 0; column_idx < columns.size(); ++column_idx) {
+        if (referenced[column_idx]) {
+            const ColumnVector &input_column = *input_data_->column_vectors[column_idx];
+            columns[column_idx] = MakeShared<ColumnVector>(input_column.data_type());
+            columns[column_idx]->Initialize(input_column, *input_select);
+        } else {
+            // never read by the expression, a constant column doesn't count in the row count of the block
+            if (unused_column.get() == nullptr) {
+                unused_column = MakeShared<ColumnVector>(MakeShared<DataType>(LogicalType::kTinyInt));
+                unused_column->Initialize(ColumnVectorType::kConstant, 1);
+            }
+            columns[column_idx] = unused_column;
+        }
+    }
+    DataBlock selected_block;
+    selected_block.Init(columns);
+
+    expr_evaluator.Init(&selected_block);
+    expr_evaluator.Execute(expr, state, bool_column);
+    for (SizeT i = 0; i < selected_count; ++i) {
+        if (IsTrue(*bool_column, i)) {
+            output_true_select->Append(input_select->Get(i));
+        }
+    }
 }
 
 void ExpressionSelector::Select(const SharedPtr<BaseExpression> &expr,
@@ -45,6 +45,32 @@ public:
     static void Select(const SharedPtr<ColumnVector> &bool_column, SizeT count, SharedPtr<Selection> &output_true_select, bool nullable);
 
 private:
+    // Selects the rows of input_select (all rows when it is null) for which expr is true.
+    // AND narrows the rows for each conjunct and OR only evaluates its right side on the rows the left side rejected.
+    void SelectRows(const SharedPtr<BaseExpression> &expr,
+                    SharedPtr<ExpressionState> &state,
+                    SizeT count,
+                    const Selection *input_select,
+                    SharedPtr<Selection> &output_true_select);
+
+    void SelectConjunction(const SharedPtr<BaseExpression> &expr,
+                           SharedPtr<ExpressionState> &state,
+                           SizeT count,
+                           const Selection *input_select,
+                           SharedPtr<Selection> &output_true_select);
+
+    void SelectDisjunction(const SharedPtr<BaseExpression> &expr,
+                           SharedPtr<ExpressionState> &state,
+                           SizeT count,
+                           const Selection *input_select,
+                           SharedPtr<Selection> &output_true_select);
+
+    void SelectPredicate(const SharedPtr<BaseExpression> &expr,
+                         SharedPtr<ExpressionState> &state,
+                         SizeT count,
+                         const Selection *input_select,
+                         SharedPtr<Selection> &output_true_select);
+
     const DataBlock *input_data_{nullptr};
 };
 
@@ -37,6 +37,13 @@ export enum class AggregateFlag : i8 {
     kRunAndFinish = 3,
 };
 
+// Rows in and out of a conjunct of an AND filter and the time spent on it, accumulated over the evaluated blocks
+export struct ConjunctStats {
+    f64 input_rows_{};
+    f64 output_rows_{};
+    f64 nanos_{};
+};
+
 export class ExpressionState {
 public:
     // Static functions
@@ -69,6 +76,12 @@ public:
 
     AggregateFlag agg_flag_{AggregateFlag::kUninitialized};
 
+    // for AND filters, the conjuncts are evaluated in the order of their observed cost and selectivity
+    Vector<ConjunctStats> conjunct_stats_{};
+
+    // for scalar functions with a state_function_, the state they keep across blocks
+    SharedPtr<void> function_state_{};
+
 private:
     Vector<SharedPtr<ExpressionState>> children_;
     String name_;
@@ -257,6 +257,19 @@ bool PhysicalCommand::Execute(QueryContext *query_context, OperatorState *operat
                             config->SetCompactInterval(interval);
                             break;
                         }
+                        case GlobalOptionIndex::kSortMemoryBudget: {
+                            if (set_command->value_type() != SetVarType::kInteger) {
+                                Status status = Status::DataTypeMismatch("Integer", set_command->value_type_str());
+                                RecoverableError(status);
+                            }
+                            i64 budget = set_command->value_int();
+                            if (budget <= 0) {
+                                Status status = Status::InvalidCommand(fmt::format("Attempt to set sort memory budget: {}", budget));
+                                RecoverableError(status);
+                            }
+                            config->SetSortMemoryBudget(budget);
+                            break;
+                        }
                         case GlobalOptionIndex::kOptimizeIndexInterval: {
                             if (set_command->value_type() != SetVarType::kInteger) {
                                 Status status = Status::DataTypeMismatch("Integer", set_command->value_type_str());
@@ -35,6 +35,9 @@ import default_values;
 import status;
 import infinity_exception;
 import logger;
+import column_vector;
+import value_expression;
+import expression_type;
 
 import column_def;
 
@@ -68,14 +71,20 @@ bool PhysicalInsert::Execute(QueryContext *query_context, OperatorState *operato
 
     ExpressionEvaluator evaluator;
     evaluator.Init(nullptr);
-    // Each cell's expression of a column may differ. So we have to evaluate each cell instead of column here.
-    for (SizeT row_idx = 0; row_idx < row_count; ++row_idx) {
-        for (SizeT expr_idx = 0; expr_idx < column_count; ++expr_idx) {
+    // Each cell's expression of a column may differ. Constant cells, which is what clients send, are appended as they are;
+    // only the other cells go through the evaluator.
+    for (SizeT expr_idx = 0; expr_idx < column_count; ++expr_idx) {
+        ColumnVector &column = *output_block->column_vectors[expr_idx];
+        for (SizeT row_idx = 0; row_idx < row_count; ++row_idx) {
             const SharedPtr<BaseExpression> &expr = value_list_[row_idx][expr_idx];
+            if (expr->type() == ExpressionType::kValue) {
+                column.AppendValue(static_cast<ValueExpression *>(expr.get())->GetValue());
+                continue;
+            }
             SharedPtr<ExpressionState> expr_state = ExpressionState::CreateState(expr);
             evaluator.Execute(expr, expr_state, output_block_tmp->column_vectors[expr_idx]);
+            column.AppendWith(*output_block_tmp->column_vectors[expr_idx], 0, 1);
         }
-        output_block->AppendWith(output_block_tmp);
     }
     output_block->Finalize();
 
@@ -320,6 +320,10 @@ bool PhysicalMatch::ExecuteInnerHomebrewed(QueryContext *query_context, Operator
     }
 
     // 3 full text search
+    // the search visits every segment of the table, deleted rows are filtered out per segment
+    for (const auto &[_, segment_snapshot] : base_table_ref_->block_index_->segment_block_index_) {
+        segment_snapshot.segment_entry_->IncreaseScanCount();
+    }
 
     auto finish_query_builder_time = std::chrono::high_resolution_clock::now();
     TimeDurationType query_builder_duration = finish_query_builder_time - finish_parse_query_tree_time;
@@ -57,15 +57,7 @@ bool PhysicalProject::Execute(QueryContext *, OperatorState *operator_state) {
         evaluator.Init(nullptr);
 
         SizeT expression_count = expressions_.size();
-
-        // Prepare the expression states
-        Vector<SharedPtr<ExpressionState>> expr_states;
-        expr_states.reserve(expression_count);
-
-        for (const auto &expr : expressions_) {
-            // expression state
-            expr_states.emplace_back(ExpressionState::CreateState(expr));
-        }
+        auto &expr_states = project_operator_state->expr_states_;
 
         for (SizeT expr_idx = 0; expr_idx < expression_count; ++expr_idx) {
             //        Vector<SharedPtr<ColumnVector>> blocks_column;
@@ -89,15 +81,8 @@ bool PhysicalProject::Execute(QueryContext *, OperatorState *operator_state) {
             evaluator.Init(input_data_block);
 
             SizeT expression_count = expressions_.size();
-
-            // Prepare the expression states
-            Vector<SharedPtr<ExpressionState>> expr_states;
-            expr_states.reserve(expression_count);
-
-            for (const auto &expr : expressions_) {
-                // expression state
-                expr_states.emplace_back(ExpressionState::CreateState(expr));
-            }
+            // the expression states are created with the operator state and kept across blocks
+            auto &expr_states = project_operator_state->expr_states_;
 
             for (SizeT expr_idx = 0; expr_idx < expression_count; ++expr_idx) {
                 //        Vector<SharedPtr<ColumnVector>> blocks_column;
@@ -57,6 +57,7 @@ import status;
 import create_index_info;
 import knn_expr;
 import block_entry;
+import fast_rough_filter;
 import segment_entry;
 import abstract_hnsw;
 import physical_match_tensor_scan;
@@ -64,6 +65,7 @@ import hnsw_alg;
 import ivf_index_data_in_mem;
 import ivf_index_data;
 import ivf_index_search;
+import diskann_index_in_chunk;
 
 namespace infinity {
 
@@ -127,13 +129,46 @@ auto GetKnnExprForCalculation(const KnnExpression &src_knn_expr, const Embedding
     Pair<std::unique_ptr<void, decltype([](void *ptr) { std::free(ptr); })>, EmbeddingDataType> result = {nullptr, EmbeddingDataType::kElemInvalid};
     if (new_query_embedding_type != EmbeddingDataType::kElemInvalid) {
         const auto aligned_ptr =
-            GetAlignedCast(src_knn_expr.query_embedding_.ptr, src_knn_expr.dimension_, src_query_embedding_type, new_query_embedding_type);
+            GetAlignedCast(src_knn_expr.query_embedding_.ptr,
+                           src_knn_expr.dimension_ * src_knn_expr.query_embedding_count_,
+                           src_query_embedding_type,
+                           new_query_embedding_type);
         result.first.reset(aligned_ptr);
         result.second = new_query_embedding_type;
     }
     return result;
 }
 
+// the topk rows nearest to any of the queries, a row found by several queries keeps its best distance
+template <typename QueryDataType, template <typename, typename> typename C, typename DistanceDataType>
+Pair<Vector<DistanceDataType>, Vector<RowID>>
+MergeQueryResults(const MergeKnn<QueryDataType, C, DistanceDataType> *merge_heap, u64 query_n, i64 topk) {
+    using Compare = typename C<DistanceDataType, RowID>::CompareReverse;
+    Vector<Pair<DistanceDataType, RowID>> results;
+    for (u64 query_idx = 0; query_idx < query_n; ++query_idx) {
+        const DistanceDataType *dists = merge_heap->GetDistancesByIdx(query_idx);
+        const RowID *row_ids = merge_heap->GetIDsByIdx(query_idx);
+        for (i64 i = 0; i < merge_heap->result_count(query_idx); ++i) {
+            results.emplace_back(dists[i], row_ids[i]);
+        }
+    }
+    std::sort(results.begin(), results.end(), [](const auto &a, const auto &b) {
+        return a.second < b.second || (a.second == b.second && Compare::Compare(a.first, b.first));
+    });
+    results.erase(std::unique(results.begin(), results.end(), [](const auto &a, const auto &b) { return a.second == b.second; }), results.end());
+    std::sort(results.begin(), results.end(), [](const auto &a, const auto &b) {
+        return Compare::Compare(a.first, b.first) || (a.first == b.first && a.second < b.second);
+    });
+    results.resize(std::min<SizeT>(results.size(), topk));
+
+    Pair<Vector<DistanceDataType>, Vector<RowID>> merged;
+    for (const auto &[dist, row_id] : results) {
+        merged.first.push_back(dist);
+        merged.second.push_back(row_id);
+    }
+    return merged;
+}
+
 void PhysicalKnnScan::Init() {
     KnnExpression *knn_expr = knn_expression_.get();
     const auto *column_expr = static_cast<const ColumnExpression *>(knn_expr->arguments()[0].get());
@@ -381,9 +416,12 @@ void PhysicalKnnScan::PlanWithIndex(QueryContext *query_context) { // TODO: retu
                 }
                 // check index type
                 if (auto index_type = table_index_entry->index_base()->index_type_;
-                    index_type != IndexType::kIVF and index_type != IndexType::kHnsw) {
+                    index_type != IndexType::kIVF and index_type != IndexType::kHnsw and index_type != IndexType::kDiskAnn) {
                     LOG_TRACE(fmt::format("KnnScan: PlanWithIndex(): Skipping non-knn index."));
                     continue;
+                } else if (index_type == IndexType::kDiskAnn and knn_expression_->distance_type_ != KnnDistanceType::kL2) {
+                    LOG_TRACE(fmt::format("KnnScan: PlanWithIndex(): Skipping DiskAnn index for non-l2 distance."));
+                    continue;
                 }
 
                 // Fill the segment with index
@@ -415,7 +453,7 @@ void PhysicalKnnScan::PlanWithIndex(QueryContext *query_context) { // TODO: retu
             }
             // check index type
             if (auto index_type = table_index_entry->index_base()->index_type_;
-                index_type != IndexType::kIVF and index_type != IndexType::kHnsw) {
+                index_type != IndexType::kIVF and index_type != IndexType::kHnsw and index_type != IndexType::kDiskAnn) {
                 LOG_ERROR("Invalid index type");
                 Status error_status = Status::InvalidIndexType("invalid index");
                 RecoverableError(std::move(error_status));
@@ -481,6 +519,7 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
         return;
     }
 
+    knn_scan_operator_state->skipped_block_count_ = 0;
     auto knn_scan_function_data = knn_scan_operator_state->knn_scan_function_data_.get();
     auto knn_scan_shared_data = knn_scan_function_data->knn_scan_shared_data_;
 
@@ -499,6 +538,21 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
     BlockIndex *block_index = knn_scan_shared_data->table_ref_->block_index_.get();
     BufferManager *buffer_mgr = query_context->storage()->buffer_manager();
     SizeT knn_column_id = GetColumnID();
+    const FastRoughFilterEvaluator *fast_rough_filter_evaluator = common_query_filter_->fast_rough_filter_evaluator_.get();
+
+    // the k-th distance of this task is shared with the other tasks of the scan, each of them skips candidates farther than it
+    KnnDistanceBound *distance_bound = &knn_scan_shared_data->distance_bound_;
+    knn_scan_operator_state->pruned_candidate_count_ = 0;
+    auto publish_distance_bound = [&] {
+        for (u64 query_idx = 0; query_idx < knn_scan_shared_data->query_count_; ++query_idx) {
+            DistanceDataType kth_distance{};
+            if (merge_heap->GetKthDistance(query_idx, kth_distance)) {
+                distance_bound->Tighten(query_idx, C<DistanceDataType, RowID>::IsMax ? kth_distance : -kth_distance);
+            }
+        }
+    };
+    // squared l2 only grows with more dimensions, a row can be left once its partial distance passes the bound
+    const bool bound_for_l2 = knn_scan_shared_data->knn_distance_type_ == KnnDistanceType::kL2 && embedding_dim > KNN_BOUND_CHECK_DIM;
 
     UniquePtr<QueryDataType[]> buffer_ptr_for_cast;
     if (u64 block_column_idx =
@@ -514,11 +568,17 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
             const SegmentID segment_id = block_entry->GetSegmentEntry()->segment_id();
             const auto row_count = block_entry->row_count();
             Bitmask bitmask;
-            if (this->CalculateFilterBitmask(segment_id, block_id, row_count, bitmask)) {
+            if (fast_rough_filter_evaluator != nullptr && !fast_rough_filter_evaluator->EvaluateZoneMap(block_entry->zone_map(), row_count)) {
+                // no row of the block can pass the filter
+                ++knn_scan_operator_state->skipped_block_count_;
+            } else if (this->CalculateFilterBitmask(segment_id, block_id, row_count, bitmask)) {
                 // LOG_TRACE(fmt::format("KnnScan: {} brute force {}/{} not skipped after common_query_filter",
                 //                       knn_scan_function_data->task_id_,
                 //                       block_column_idx + 1,
                 //                       brute_task_n));
+                if (block_id == 0) {
+                    block_entry->GetSegmentEntry()->IncreaseScanCount();
+                }
                 block_entry->SetDeleteBitmask(begin_ts, bitmask);
                 ColumnVector column_vector = block_column_entry->GetConstColumnVector(buffer_mgr);
                 BruteForceBlockScan<t, ColumnDataType, QueryDataType, C, DistanceDataType>::Execute(merge_heap,
@@ -530,7 +590,12 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
                                                                                                     segment_id,
                                                                                                     block_id,
                                                                                                     row_count,
-                                                                                                    bitmask);
+                                                                                                    bitmask,
+                                                                                                    bound_for_l2 ? distance_bound : nullptr,
+                                                                                                    knn_scan_operator_state->pruned_candidate_count_);
+                publish_distance_bound();
+            } else {
+                ++knn_scan_operator_state->skipped_block_count_;
             }
             block_column_idx = knn_scan_shared_data->current_block_idx_++;
         } while (block_column_idx < brute_task_n);
@@ -540,11 +605,13 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
         SegmentIndexEntry *segment_index_entry = knn_scan_shared_data->index_entries_->at(index_idx);
 
         auto segment_id = segment_index_entry->segment_id();
+        SegmentEntry *segment_entry = nullptr;
         SegmentOffset segment_row_count = 0;
         const auto &segment_index_hashmap = base_table_ref_->block_index_->segment_block_index_;
         if (auto iter = segment_index_hashmap.find(segment_id); iter == segment_index_hashmap.end()) {
             UnrecoverableError(fmt::format("Cannot find SegmentEntry for segment id: {}", segment_id));
         } else {
+            segment_entry = iter->second.segment_entry_;
             segment_row_count = iter->second.segment_offset_;
         }
 
@@ -569,6 +636,7 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
         }
 
         if (has_some_result) {
+            segment_entry->IncreaseScanCount();
             switch (segment_index_entry->table_index_entry()->index_base()->index_type_) {
                 case IndexType::kIVF: {
                     const SegmentOffset max_segment_offset = block_index->GetSegmentOffset(segment_id);
@@ -611,50 +679,73 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
                                     rerank = true;
                                 }
                             }
+                            if (use_bitmask && bitmask.count() > 0) {
+                                search_option.filter_ratio_ = static_cast<f32>(bitmask.CountTrue()) / bitmask.count();
+                            }
+                            if constexpr (t == LogicalType::kEmbedding) {
+                                if (!rerank) {
+                                    search_option.distance_bounds_ = distance_bound->Data(0);
+                                    search_option.bound_pruned_count_ = &knn_scan_operator_state->pruned_candidate_count_;
+                                }
+                            }
 
-                            i64 result_n = -1;
-                            for (u64 query_idx = 0; query_idx < knn_scan_shared_data->query_count_; ++query_idx) {
-                                const auto *query = static_cast<const QueryDataType *>(knn_scan_shared_data->query_embedding_) +
-                                                    query_idx * knn_scan_shared_data->dimension_;
-
-                                SizeT result_n1 = 0;
-                                UniquePtr<DistanceDataType[]> d_ptr = nullptr;
-                                UniquePtr<SegmentOffset[]> l_ptr = nullptr;
+                            // run `search(filter, with_lock)` with the filter of this segment
+                            auto knn_search = [&](auto &&search) {
                                 if (use_bitmask) {
                                     BitmaskFilter<SegmentOffset> filter(bitmask);
-                                    if (with_lock) {
-                                        std::tie(result_n1, d_ptr, l_ptr) =
-                                            hnsw_index->template KnnSearch<BitmaskFilter<SegmentOffset>, true>(query,
-                                                                                                               knn_scan_shared_data->topk_,
-                                                                                                               filter,
-                                                                                                               search_option);
-                                    } else {
-                                        std::tie(result_n1, d_ptr, l_ptr) =
-                                            hnsw_index->template KnnSearch<BitmaskFilter<SegmentOffset>, false>(query,
-                                                                                                                knn_scan_shared_data->topk_,
-                                                                                                                filter,
-                                                                                                                search_option);
-                                    }
-                                } else {
-                                    SegmentOffset max_segment_offset = block_index->GetSegmentOffset(segment_id);
-                                    if (!with_lock) {
-                                        std::tie(result_n1, d_ptr, l_ptr) =
-                                            hnsw_index->template KnnSearch<false>(query, knn_scan_shared_data->topk_, search_option);
-                                    } else {
-                                        AppendFilter filter(max_segment_offset);
-                                        std::tie(result_n1, d_ptr, l_ptr) =
-                                            hnsw_index->template KnnSearch<AppendFilter, true>(query,
-                                                                                               knn_scan_shared_data->topk_,
-                                                                                               filter,
-                                                                                               search_option);
+                                    return with_lock ? search(filter, std::true_type{}) : search(filter, std::false_type{});
+                                }
+                                if (!with_lock) {
+                                    return search(None, std::false_type{});
+                                }
+                                AppendFilter filter(block_index->GetSegmentOffset(segment_id));
+                                return search(filter, std::true_type{});
+                            };
+                            const u64 query_count = knn_scan_shared_data->query_count_;
+                            auto get_query = [&](u64 query_idx) {
+                                return static_cast<const QueryDataType *>(knn_scan_shared_data->query_embedding_) +
+                                       query_idx * knn_scan_shared_data->dimension_;
+                            };
+
+                            // several queries share the traversal of the upper layers and the search scratch
+                            Vector<Tuple<SizeT, UniquePtr<DistanceDataType[]>, UniquePtr<SegmentOffset[]>>> batch_results;
+                            if constexpr (t == LogicalType::kEmbedding) {
+                                if (query_count > 1) {
+                                    Vector<const QueryDataType *> queries(query_count);
+                                    for (u64 query_idx = 0; query_idx < query_count; ++query_idx) {
+                                        queries[query_idx] = get_query(query_idx);
                                     }
+                                    batch_results = knn_search([&](const auto &filter, auto with_lock_c) {
+                                        using Filter = std::decay_t<decltype(filter)>;
+                                        return hnsw_index->template KnnSearchBatch<Filter, decltype(with_lock_c)::value>(queries.data(),
+                                                                                                                        query_count,
+                                                                                                                        knn_scan_shared_data->topk_,
+                                                                                                                        filter,
+                                                                                                                        search_option);
+                                    });
                                 }
+                            }
+
+                            for (u64 query_idx = 0; query_idx < query_count; ++query_idx) {
+                                const auto *query = get_query(query_idx);
 
-                                if (result_n < 0) {
-                                    result_n = result_n1;
-                                } else if (result_n != (i64)result_n1) {
-                                    String error_message = "KnnScan: result_n mismatch";
-                                    UnrecoverableError(error_message);
+                                // the result count differs between queries, e.g. when the distance bound of one query drops more results
+                                SizeT result_n = 0;
+                                UniquePtr<DistanceDataType[]> d_ptr = nullptr;
+                                UniquePtr<SegmentOffset[]> l_ptr = nullptr;
+                                if (!batch_results.empty()) {
+                                    std::tie(result_n, d_ptr, l_ptr) = std::move(batch_results[query_idx]);
+                                } else {
+                                    if (search_option.distance_bounds_ != nullptr) {
+                                        search_option.distance_bounds_ = distance_bound->Data(query_idx);
+                                    }
+                                    std::tie(result_n, d_ptr, l_ptr) = knn_search([&](const auto &filter, auto with_lock_c) {
+                                        using Filter = std::decay_t<decltype(filter)>;
+                                        return hnsw_index->template KnnSearch<Filter, decltype(with_lock_c)::value>(query,
+                                                                                                                   knn_scan_shared_data->topk_,
+                                                                                                                   filter,
+                                                                                                                   search_option);
+                                    });
                                 }
 
                                 if (rerank) {
@@ -678,12 +769,9 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
                                         if constexpr (t == LogicalType::kEmbedding) {
                                             const auto *data = reinterpret_cast<const ColumnDataType *>(column_vector.data());
                                             data += block_offset * knn_scan_shared_data->dimension_;
-                                            merge_heap->Search(query,
-                                                               data,
-                                                               knn_scan_shared_data->dimension_,
-                                                               dist_func->dist_func_,
-                                                               segment_id,
-                                                               segment_offset);
+                                            const DistanceDataType distance = dist_func->dist_func_(query, data, knn_scan_shared_data->dimension_);
+                                            const RowID row_id(segment_id, segment_offset);
+                                            merge_heap->Search(query_idx, &distance, &row_id, 1);
                                         } else if constexpr (t == LogicalType::kMultiVector) {
                                             MultiVectorSearchOneLine<ColumnDataType, QueryDataType, C, DistanceDataType>(merge_heap,
                                                                                                                          dist_func,
@@ -711,7 +799,7 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
                                         // FIXME:
                                         case KnnDistanceType::kCosine:
                                         case KnnDistanceType::kInnerProduct: {
-                                            for (i64 i = 0; i < result_n; ++i) {
+                                            for (SizeT i = 0; i < result_n; ++i) {
                                                 d_ptr[i] = -d_ptr[i];
                                             }
                                             break;
@@ -719,11 +807,11 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
                                     }
 
                                     auto row_ids = MakeUniqueForOverwrite<RowID[]>(result_n);
-                                    for (i64 i = 0; i < result_n; ++i) {
+                                    for (SizeT i = 0; i < result_n; ++i) {
                                         row_ids[i] = RowID{segment_id, l_ptr[i]};
                                     }
 
-                                    merge_heap->Search(0, d_ptr.get(), row_ids.get(), result_n);
+                                    merge_heap->Search(query_idx, d_ptr.get(), row_ids.get(), result_n);
                                 }
                             }
                         };
@@ -757,10 +845,124 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
                     }
                     break;
                 }
+                case IndexType::kDiskAnn: {
+                    if constexpr (t != LogicalType::kEmbedding || !std::is_same_v<ColumnDataType, f32>) {
+                        RecoverableError(Status::NotSupport("DiskAnn index only supports float embedding column"));
+                    } else {
+                        if (knn_scan_shared_data->knn_distance_type_ != KnnDistanceType::kL2) {
+                            RecoverableError(Status::NotSupport("DiskAnn index only supports l2 distance"));
+                        }
+                        u32 search_l = DISKANN_SEARCH_L;
+                        u32 beam_width = DISKANN_BEAM_WIDTH;
+                        for (const auto &opt_param : knn_scan_shared_data->opt_params_) {
+                            if (opt_param.param_name_ == "ef") {
+                                search_l = std::stoul(opt_param.param_value_);
+                            } else if (opt_param.param_name_ == "beam_width") {
+                                beam_width = std::stoul(opt_param.param_value_);
+                            }
+                        }
+                        const u32 topk = knn_scan_shared_data->topk_;
+                        search_l = std::max(search_l, topk);
+
+                        // rows outside of the graphs: chunks too small for a graph and rows appended after the index is built
+                        auto brute_force_range = [&](SegmentOffset begin_offset, SegmentOffset end_offset) {
+                            BlockID prev_block_id = -1;
+                            ColumnVector column_vector;
+                            for (SegmentOffset segment_offset = begin_offset; segment_offset < end_offset; ++segment_offset) {
+                                if (use_bitmask && !bitmask.IsTrue(segment_offset)) {
+                                    continue;
+                                }
+                                BlockID block_id = segment_offset / DEFAULT_BLOCK_CAPACITY;
+                                BlockOffset block_offset = segment_offset % DEFAULT_BLOCK_CAPACITY;
+                                if (block_id != prev_block_id) {
+                                    prev_block_id = block_id;
+                                    BlockEntry *block_entry = block_index->GetBlockEntry(segment_id, block_id);
+                                    BlockColumnEntry *block_column_entry = block_entry->GetColumnBlockEntry(knn_column_id);
+                                    column_vector = block_column_entry->GetConstColumnVector(buffer_mgr);
+                                }
+                                const auto *data = reinterpret_cast<const ColumnDataType *>(column_vector.data()) + block_offset * embedding_dim;
+                                merge_heap->Search(knn_query_ptr, data, embedding_dim, dist_func->dist_func_, segment_id, segment_offset);
+                            }
+                        };
+
+                        Vector<Pair<SegmentOffset, const DiskAnnIndexInChunk *>> graph_chunks;
+                        Vector<BufferHandle> index_handles;
+                        Vector<Pair<SegmentOffset, SegmentOffset>> brute_ranges;
+                        for (const auto &chunk_index_entry : segment_index_entry->GetDiskAnnIndexSnapshot()) {
+                            if (!chunk_index_entry->CheckVisible(txn)) {
+                                continue;
+                            }
+                            const SegmentOffset chunk_begin = chunk_index_entry->base_rowid_.segment_offset_;
+                            BufferHandle index_handle = chunk_index_entry->GetIndex();
+                            const auto *diskann_chunk = static_cast<const DiskAnnIndexInChunk *>(index_handle.GetData());
+                            if (diskann_chunk->HasGraph() && use_bitmask) {
+                                // the candidates of the graph search are mostly filtered out when few rows pass
+                                const SegmentOffset chunk_end = std::min<SegmentOffset>(chunk_begin + diskann_chunk->row_count(), segment_row_count);
+                                SizeT pass_count = 0;
+                                for (SegmentOffset segment_offset = chunk_begin; segment_offset < chunk_end; ++segment_offset) {
+                                    pass_count += bitmask.IsTrue(segment_offset);
+                                }
+                                if (pass_count < DISKANN_FILTER_BRUTE_FORCE_RATIO * diskann_chunk->row_count()) {
+                                    brute_ranges.emplace_back(chunk_begin, chunk_begin + chunk_index_entry->row_count_);
+                                    continue;
+                                }
+                            }
+                            if (diskann_chunk->HasGraph()) {
+                                graph_chunks.emplace_back(chunk_begin, diskann_chunk);
+                                index_handles.push_back(std::move(index_handle));
+                            } else {
+                                brute_ranges.emplace_back(chunk_begin, chunk_begin + chunk_index_entry->row_count_);
+                            }
+                        }
+                        SegmentOffset covered_end = 0;
+                        for (const auto &[chunk_begin, diskann_chunk] : graph_chunks) {
+                            covered_end = std::max(covered_end, chunk_begin + diskann_chunk->row_count());
+                        }
+                        for (const auto &[begin_offset, end_offset] : brute_ranges) {
+                            covered_end = std::max(covered_end, end_offset);
+                        }
+                        brute_ranges.emplace_back(covered_end, segment_row_count);
+
+                        Vector<DistanceDataType> d_buffer;
+                        Vector<RowID> row_id_buffer;
+                        for (u64 query_idx = 0; query_idx < knn_scan_shared_data->query_count_; ++query_idx) {
+                            const auto *query = knn_query_ptr + query_idx * embedding_dim;
+                            for (const auto &[chunk_begin, diskann_chunk] : graph_chunks) {
+                                // the candidates list grows until topk of them pass the filter or it can hold the whole chunk
+                                for (u32 chunk_search_l = search_l;; chunk_search_l *= 2) {
+                                    d_buffer.clear();
+                                    row_id_buffer.clear();
+                                    const auto candidates = diskann_chunk->Search(query, chunk_search_l, beam_width);
+                                    for (const auto &[dist, chunk_offset] : candidates) {
+                                        const SegmentOffset segment_offset = chunk_begin + chunk_offset;
+                                        if (segment_offset >= segment_row_count || (use_bitmask && !bitmask.IsTrue(segment_offset))) {
+                                            continue;
+                                        }
+                                        d_buffer.push_back(dist);
+                                        row_id_buffer.emplace_back(segment_id, segment_offset);
+                                        if (d_buffer.size() == topk) {
+                                            break;
+                                        }
+                                    }
+                                    const bool exhausted = candidates.size() < chunk_search_l || chunk_search_l >= diskann_chunk->row_count();
+                                    if (d_buffer.size() == topk || exhausted) {
+                                        break;
+                                    }
+                                }
+                                merge_heap->Search(query_idx, d_buffer.data(), row_id_buffer.data(), d_buffer.size());
+                            }
+                        }
+                        for (const auto &[begin_offset, end_offset] : brute_ranges) {
+                            brute_force_range(begin_offset, std::min(end_offset, segment_row_count));
+                        }
+                    }
+                    break;
+                }
                 default: {
                     RecoverableError(Status::NotSupport("Not implemented index type"));
                 }
             }
+            publish_distance_bound();
         }
     }
     if (knn_scan_shared_data->current_index_idx_ >= index_task_n && knn_scan_shared_data->current_block_idx_ >= brute_task_n) {
@@ -768,17 +970,17 @@ void PhysicalKnnScan::ExecuteInternalByColumnDataTypeAndQueryDataType(QueryConte
         // all task Complete
 
         merge_heap->End();
-        i64 result_n = std::min(knn_scan_shared_data->topk_, merge_heap->total_count());
-
-        SizeT query_n = knn_scan_shared_data->query_count_;
-        Vector<char *> result_dists_list;
-        Vector<RowID *> row_ids_list;
-        for (SizeT query_id = 0; query_id < query_n; ++query_id) {
-            result_dists_list.emplace_back(reinterpret_cast<char *>(merge_heap->GetDistancesByIdx(query_id)));
-            row_ids_list.emplace_back(merge_heap->GetIDsByIdx(query_id));
+        if (knn_scan_shared_data->query_count_ == 1) {
+            i64 result_n = std::min(knn_scan_shared_data->topk_, merge_heap->total_count());
+            Vector<char *> result_dists_list{reinterpret_cast<char *>(merge_heap->GetDistancesByIdx(0))};
+            Vector<RowID *> row_ids_list{merge_heap->GetIDsByIdx(0)};
+            this->SetOutput(result_dists_list, row_ids_list, sizeof(DistanceDataType), result_n, query_context, knn_scan_operator_state);
+        } else {
+            auto [result_dists, result_row_ids] = MergeQueryResults(merge_heap, knn_scan_shared_data->query_count_, knn_scan_shared_data->topk_);
+            Vector<char *> result_dists_list{reinterpret_cast<char *>(result_dists.data())};
+            Vector<RowID *> row_ids_list{result_row_ids.data()};
+            this->SetOutput(result_dists_list, row_ids_list, sizeof(DistanceDataType), result_dists.size(), query_context, knn_scan_operator_state);
         }
-
-        this->SetOutput(result_dists_list, row_ids_list, sizeof(DistanceDataType), result_n, query_context, knn_scan_operator_state);
         knn_scan_operator_state->SetComplete();
     }
 }
@@ -794,7 +996,9 @@ struct BruteForceBlockScan<LogicalType::kEmbedding, ColumnDataType, QueryDataTyp
                         const SegmentID segment_id,
                         const BlockID block_id,
                         const BlockOffset row_count,
-                        const Bitmask &bitmask) {
+                        const Bitmask &bitmask,
+                        const KnnDistanceBound *l2_distance_bound,
+                        u64 &pruned_count) {
         auto data = reinterpret_cast<const ColumnDataType *>(column_vector.data());
         const QueryDataType *target_ptr = nullptr;
         if constexpr (std::is_same_v<ColumnDataType, QueryDataType>) {
@@ -809,8 +1013,72 @@ struct BruteForceBlockScan<LogicalType::kEmbedding, ColumnDataType, QueryDataTyp
             }
             target_ptr = buffer_ptr_for_cast.get();
         }
+        if constexpr (std::is_same_v<QueryDataType, f32>) {
+            if (l2_distance_bound != nullptr) {
+                SearchWithL2Bound(merge_heap,
+                                  dist_func,
+                                  knn_query_ptr,
+                                  embedding_dim,
+                                  target_ptr,
+                                  segment_id,
+                                  block_id,
+                                  row_count,
+                                  bitmask,
+                                  *l2_distance_bound,
+                                  pruned_count);
+                return;
+            }
+        }
         merge_heap->Search(knn_query_ptr, target_ptr, embedding_dim, dist_func->dist_func_, row_count, segment_id, block_id, bitmask);
     }
+
+    // the squared l2 distance is summed KNN_BOUND_CHECK_DIM dimensions at a time, and a row is left once it passes the bound.
+    // the partial distance of a left row is still added: it is farther than k rows found by other tasks and never gets into
+    // the final result, while the row count of the task stays the same for every query
+    static void SearchWithL2Bound(MergeKnn<QueryDataType, C, DistanceDataType> *merge_heap,
+                                  KnnDistance1<QueryDataType, DistanceDataType> *dist_func,
+                                  const QueryDataType *knn_query_ptr,
+                                  const u32 embedding_dim,
+                                  const QueryDataType *target_ptr,
+                                  const SegmentID segment_id,
+                                  const BlockID block_id,
+                                  const BlockOffset row_count,
+                                  const Bitmask &bitmask,
+                                  const KnnDistanceBound &distance_bound,
+                                  u64 &pruned_count) {
+        const u64 query_count = distance_bound.QueryCount();
+        bool has_bound = false;
+        for (u64 query_idx = 0; query_idx < query_count; ++query_idx) {
+            has_bound |= distance_bound.Get(query_idx) < std::numeric_limits<f32>::max();
+        }
+        if (!has_bound) {
+            merge_heap->Search(knn_query_ptr, target_ptr, embedding_dim, dist_func->dist_func_, row_count, segment_id, block_id, bitmask);
+            return;
+        }
+        const bool all_true = bitmask.IsAllTrue();
+        const SegmentOffset segment_offset_start = block_id * DEFAULT_BLOCK_CAPACITY;
+        for (u64 query_idx = 0; query_idx < query_count; ++query_idx) {
+            const QueryDataType *query = knn_query_ptr + query_idx * embedding_dim;
+            const f32 bound = distance_bound.Get(query_idx);
+            for (BlockOffset row = 0; row < row_count; ++row) {
+                if (!all_true && !bitmask.IsTrue(row)) {
+                    continue;
+                }
+                const QueryDataType *row_ptr = target_ptr + SizeT(row) * embedding_dim;
+                DistanceDataType distance = 0;
+                for (u32 dim_begin = 0; dim_begin < embedding_dim; dim_begin += KNN_BOUND_CHECK_DIM) {
+                    const u32 dim_n = std::min(KNN_BOUND_CHECK_DIM, embedding_dim - dim_begin);
+                    distance += dist_func->dist_func_(query + dim_begin, row_ptr + dim_begin, dim_n);
+                    if (distance > bound && dim_begin + dim_n < embedding_dim) {
+                        ++pruned_count;
+                        break;
+                    }
+                }
+                const RowID row_id(segment_id, segment_offset_start + row);
+                merge_heap->Search(query_idx, &distance, &row_id, 1);
+            }
+        }
+    }
 };
 
 template <typename ColumnDataType, typename QueryDataType, template <typename, typename> typename C, typename DistanceDataType>
@@ -824,7 +1092,9 @@ struct BruteForceBlockScan<LogicalType::kMultiVector, ColumnDataType, QueryDataT
                         const SegmentID segment_id,
                         const BlockID block_id,
                         const BlockOffset row_count,
-                        const Bitmask &bitmask) {
+                        const Bitmask &bitmask,
+                        const KnnDistanceBound *,
+                        u64 &) {
         for (BlockOffset row_id = 0; row_id < row_count; ++row_id) {
             if (bitmask.IsTrue(row_id)) {
                 SegmentOffset segment_offset = block_id * DEFAULT_BLOCK_CAPACITY + row_id;
@@ -68,7 +68,7 @@ import embedding_info;
 import buffer_manager;
 import buffer_handle;
 import match_tensor_scan_function_data;
-import mlas_matrix_multiply;
+import maxsim_kernel;
 import physical_fusion;
 import filter_value_type_classification;
 import logical_match_tensor_scan;
@@ -285,6 +285,7 @@ void PhysicalMatchTensorScan::ExecuteInner(QueryContext *query_context, MatchTen
 
         if (has_some_result) {
             LOG_TRACE(fmt::format("MatchTensorScan: index {}/{} not skipped after common_query_filter", task_job_index, index_entries_.size()));
+            segment_entry->IncreaseScanCount();
             // TODO: now only have EMVB index
             const Tuple<Vector<SharedPtr<ChunkIndexEntry>>, SharedPtr<EMVBIndexInMem>> emvb_snapshot = index_entry->GetEMVBIndexSnapshot();
             // 1. in mem index
@@ -374,6 +375,9 @@ void PhysicalMatchTensorScan::ExecuteInner(QueryContext *query_context, MatchTen
         BlockOffset row_count = block_index->GetBlockOffset(segment_id, block_id);
         Bitmask bitmask;
         if (this->CalculateFilterBitmask(segment_id, block_id, row_count, bitmask)) {
+            if (block_id == 0) {
+                segment_entry->IncreaseScanCount();
+            }
             block_entry->SetDeleteBitmask(begin_ts, bitmask);
             auto column_vector = block_column_entry->GetConstColumnVector(buffer_mgr);
             // output score will always be float type
@@ -431,305 +435,48 @@ void PhysicalMatchTensorScan::ExecuteInner(QueryContext *query_context, MatchTen
     }
 }
 
-// TensorElemT: bit, QueryElemT: bit (unaligned).
-// TensorElemT: bit, QueryElemT: f32, i32, i64 (aligned).
-// TensorElemT: u8, QueryElemT: u8 (unaligned).
-// TensorElemT: i8, QueryElemT: i8 (unaligned).
-// TensorElemT: f32, f64, f16, bf16, QueryElemT: f32 (aligned).
-template <typename TensorElemT, typename QueryElemT>
-struct MaxSimOp {
-    static float Score(const char *raw_query_tensor_ptr,
-                       const char *raw_target_tensor_ptr,
-                       const u32 query_embedding_num,
-                       const u32 target_embedding_num,
-                       const u32 basic_embedding_dimension) {
-        UnrecoverableError("Unreachable code!");
-        return {};
-    }
-};
-
-// TensorElemT: bit, QueryElemT: bit (unaligned)
-// TODO: hamming distance?
-template <>
-struct MaxSimOp<bool, bool> {
-    static float Score(const char *raw_query_tensor_ptr,
-                       const char *raw_target_tensor_ptr,
-                       const u32 query_embedding_num,
-                       const u32 target_embedding_num,
-                       const u32 basic_embedding_dimension) {
-        const auto unit_embedding_bytes = basic_embedding_dimension / 8;
-        if (unit_embedding_bytes % 4 == 0) {
-            if (reinterpret_cast<uintptr_t>(raw_query_tensor_ptr) % alignof(u32) == 0 &&
-                reinterpret_cast<uintptr_t>(raw_target_tensor_ptr) % alignof(u32) == 0) {
-                const auto u32_cnt = unit_embedding_bytes / 4;
-                const auto query_tensor_u32_ptr = reinterpret_cast<const u32 *>(raw_query_tensor_ptr);
-                const auto target_tensor_u32_ptr = reinterpret_cast<const u32 *>(raw_target_tensor_ptr);
-                u32 maxsim_score = 0;
-                for (u32 query_i = 0; query_i < query_embedding_num; ++query_i) {
-                    const auto query_ptr = query_tensor_u32_ptr + query_i * u32_cnt;
-                    auto min_score_i = std::numeric_limits<u32>::max();
-                    for (u32 target_j = 0; target_j < target_embedding_num; ++target_j) {
-                        const auto target_ptr = target_tensor_u32_ptr + target_j * u32_cnt;
-                        u32 score_ij = 0;
-                        for (u32 k = 0; k < u32_cnt; ++k) {
-                            score_ij += std::popcount(query_ptr[k] ^ target_ptr[k]);
-                        }
-                        min_score_i = std::min(min_score_i, score_ij);
-                    }
-                    maxsim_score += min_score_i;
-                }
-                // hamming distance, higher score means more different
-                return -static_cast<float>(maxsim_score);
-            }
-            // memory allocated by new char[] should be aligned to any basic type
-            LOG_ERROR("MaxSimOp<bool, bool> Score: input tensor is not aligned to int");
-        }
-        const auto query_tensor_ptr = reinterpret_cast<const u8 *>(raw_query_tensor_ptr);
-        const auto target_tensor_ptr = reinterpret_cast<const u8 *>(raw_target_tensor_ptr);
-        u32 maxsim_score = 0;
-        for (u32 query_i = 0; query_i < query_embedding_num; ++query_i) {
-            const auto query_ptr = query_tensor_ptr + query_i * unit_embedding_bytes;
-            auto min_score_i = std::numeric_limits<u32>::max();
-            for (u32 target_j = 0; target_j < target_embedding_num; ++target_j) {
-                const auto target_ptr = target_tensor_ptr + target_j * unit_embedding_bytes;
-                u32 score_ij = 0;
-                for (u32 k = 0; k < unit_embedding_bytes; ++k) {
-                    score_ij += std::popcount(static_cast<u32>(query_ptr[k] ^ target_ptr[k]));
-                }
-                min_score_i = std::min(min_score_i, score_ij);
-            }
-            maxsim_score += min_score_i;
-        }
-        // hamming distance, higher score means more different
-        return -static_cast<float>(maxsim_score);
-    }
-};
-
-// TensorElemT: bit, QueryElemT: f32 (aligned)
-template <>
-struct MaxSimOp<bool, f32> {
-    static float Score(const char *raw_query_tensor_ptr,
-                       const char *raw_target_tensor_ptr,
-                       const u32 query_embedding_num,
-                       const u32 target_embedding_num,
-                       const u32 basic_embedding_dimension) {
-        const auto f32_bit_ip_func_ptr = GetSIMD_FUNCTIONS().MaxSimF32BitIP_func_ptr_;
-        const auto query_tensor_ptr = reinterpret_cast<const f32 *>(raw_query_tensor_ptr);
-        const auto target_tensor_ptr = reinterpret_cast<const u8 *>(raw_target_tensor_ptr);
-        const auto unit_embedding_bytes = basic_embedding_dimension / 8;
-        float maxsim_score = 0.0f;
-        for (u32 query_i = 0; query_i < query_embedding_num; ++query_i) {
-            const auto query_ptr = query_tensor_ptr + query_i * basic_embedding_dimension;
-            auto max_score_i = std::numeric_limits<float>::lowest();
-            for (u32 target_j = 0; target_j < target_embedding_num; ++target_j) {
-                const auto target_ptr = target_tensor_ptr + target_j * unit_embedding_bytes;
-                const auto score_ij = f32_bit_ip_func_ptr(query_ptr, target_ptr, basic_embedding_dimension);
-                max_score_i = std::max(max_score_i, score_ij);
-            }
-            maxsim_score += max_score_i;
-        }
-        return maxsim_score;
-    }
-};
-
-// TensorElemT: bit, QueryElemT: i32 (aligned)
-template <>
-struct MaxSimOp<bool, i32> {
-    static float Score(const char *raw_query_tensor_ptr,
-                       const char *raw_target_tensor_ptr,
-                       const u32 query_embedding_num,
-                       const u32 target_embedding_num,
-                       const u32 basic_embedding_dimension) {
-        const auto i32_bit_ip_func_ptr = GetSIMD_FUNCTIONS().MaxSimI32BitIP_func_ptr_;
-        const auto query_tensor_ptr = reinterpret_cast<const i32 *>(raw_query_tensor_ptr);
-        const auto target_tensor_ptr = reinterpret_cast<const u8 *>(raw_target_tensor_ptr);
-        const auto unit_embedding_bytes = basic_embedding_dimension / 8;
-        i32 maxsim_score = 0;
-        for (u32 query_i = 0; query_i < query_embedding_num; ++query_i) {
-            const auto query_ptr = query_tensor_ptr + query_i * basic_embedding_dimension;
-            auto max_score_i = std::numeric_limits<i32>::lowest();
-            for (u32 target_j = 0; target_j < target_embedding_num; ++target_j) {
-                const auto target_ptr = target_tensor_ptr + target_j * unit_embedding_bytes;
-                const auto score_ij = i32_bit_ip_func_ptr(query_ptr, target_ptr, basic_embedding_dimension);
-                max_score_i = std::max(max_score_i, score_ij);
-            }
-            maxsim_score += max_score_i;
-        }
-        return maxsim_score;
-    }
-};
-
-// TensorElemT: bit, QueryElemT: i64 (aligned)
-template <>
-struct MaxSimOp<bool, i64> {
-    static float Score(const char *raw_query_tensor_ptr,
-                       const char *raw_target_tensor_ptr,
-                       const u32 query_embedding_num,
-                       const u32 target_embedding_num,
-                       const u32 basic_embedding_dimension) {
-        const auto i64_bit_ip_func_ptr = GetSIMD_FUNCTIONS().MaxSimI64BitIP_func_ptr_;
-        const auto query_tensor_ptr = reinterpret_cast<const i64 *>(raw_query_tensor_ptr);
-        const auto target_tensor_ptr = reinterpret_cast<const u8 *>(raw_target_tensor_ptr);
-        const auto unit_embedding_bytes = basic_embedding_dimension / 8;
-        i64 maxsim_score = 0;
-        for (u32 query_i = 0; query_i < query_embedding_num; ++query_i) {
-            const auto query_ptr = query_tensor_ptr + query_i * basic_embedding_dimension;
-            auto max_score_i = std::numeric_limits<i64>::lowest();
-            for (u32 target_j = 0; target_j < target_embedding_num; ++target_j) {
-                const auto target_ptr = target_tensor_ptr + target_j * unit_embedding_bytes;
-                const auto score_ij = i64_bit_ip_func_ptr(query_ptr, target_ptr, basic_embedding_dimension);
-                max_score_i = std::max(max_score_i, score_ij);
-            }
-            maxsim_score += max_score_i;
-        }
-        return maxsim_score;
-    }
-};
+// tensors of the rows to score, a tensor array row adds one entry per tensor
+struct MaxSimTensorBatch {
+    Vector<const char *> tensors_;
+    Vector<u32> embedding_nums_;
+    Vector<u32> row_idx_;
 
-// TensorElemT: u8, QueryElemT: u8 (unaligned)
-template <>
-struct MaxSimOp<u8, u8> {
-    static float Score(const char *raw_query_tensor_ptr,
-                       const char *raw_target_tensor_ptr,
-                       const u32 query_embedding_num,
-                       const u32 target_embedding_num,
-                       const u32 basic_embedding_dimension) {
-        const auto u8ip_func_ptr = GetSIMD_FUNCTIONS().HNSW_U8IP_ptr_;
-        const auto query_tensor_ptr = reinterpret_cast<const u8 *>(raw_query_tensor_ptr);
-        const auto target_tensor_ptr = reinterpret_cast<const u8 *>(raw_target_tensor_ptr);
-        i32 maxsim_score = 0;
-        for (u32 query_i = 0; query_i < query_embedding_num; ++query_i) {
-            const auto query_ptr = query_tensor_ptr + query_i * basic_embedding_dimension;
-            auto max_score_i = std::numeric_limits<i32>::lowest();
-            for (u32 target_j = 0; target_j < target_embedding_num; ++target_j) {
-                const auto target_ptr = target_tensor_ptr + target_j * basic_embedding_dimension;
-                const i32 score_ij = u8ip_func_ptr(query_ptr, target_ptr, basic_embedding_dimension);
-                max_score_i = std::max(max_score_i, score_ij);
-            }
-            maxsim_score += max_score_i;
-        }
-        return maxsim_score;
+    void Add(const char *tensor, const u32 embedding_num, const u32 row_idx) {
+        tensors_.push_back(tensor);
+        embedding_nums_.push_back(embedding_num);
+        row_idx_.push_back(row_idx);
     }
-};
 
-// TensorElemT: i8, QueryElemT: i8 (unaligned)
-template <>
-struct MaxSimOp<i8, i8> {
-    static float Score(const char *raw_query_tensor_ptr,
-                       const char *raw_target_tensor_ptr,
-                       const u32 query_embedding_num,
-                       const u32 target_embedding_num,
-                       const u32 basic_embedding_dimension) {
-        const auto i8ip_func_ptr = GetSIMD_FUNCTIONS().HNSW_I8IP_ptr_;
-        const auto query_tensor_ptr = reinterpret_cast<const i8 *>(raw_query_tensor_ptr);
-        const auto target_tensor_ptr = reinterpret_cast<const i8 *>(raw_target_tensor_ptr);
-        i32 maxsim_score = 0;
-        for (u32 query_i = 0; query_i < query_embedding_num; ++query_i) {
-            const auto query_ptr = query_tensor_ptr + query_i * basic_embedding_dimension;
-            auto max_score_i = std::numeric_limits<i32>::lowest();
-            for (u32 target_j = 0; target_j < target_embedding_num; ++target_j) {
-                const auto target_ptr = target_tensor_ptr + target_j * basic_embedding_dimension;
-                const i32 score_ij = i8ip_func_ptr(query_ptr, target_ptr, basic_embedding_dimension);
-                max_score_i = std::max(max_score_i, score_ij);
-            }
-            maxsim_score += max_score_i;
+    // score of a row is the best score of its tensors
+    template <typename Kernel>
+    void Score(Kernel &kernel, const u32 row_num, Vector<f32> &row_scores) const {
+        Vector<f32> tensor_scores(tensors_.size());
+        kernel.ScoreBatch(tensors_.data(), embedding_nums_.data(), tensors_.size(), tensor_scores.data());
+        row_scores.assign(row_num, std::numeric_limits<f32>::lowest());
+        for (SizeT i = 0; i < tensor_scores.size(); ++i) {
+            row_scores[row_idx_[i]] = std::max(row_scores[row_idx_[i]], tensor_scores[i]);
         }
-        return maxsim_score;
     }
 };
 
-// TensorElemT: f32, QueryElemT: f32 (aligned)
-template <>
-struct MaxSimOp<float, float> {
-    static float Score(const char *query_tensor_ptr,
-                       const char *target_tensor_ptr,
-                       const u32 query_embedding_num,
-                       const u32 target_embedding_num,
-                       const u32 basic_embedding_dimension) {
-        auto output_ptr = MakeUniqueForOverwrite<float[]>(query_embedding_num * target_embedding_num);
-        matrixA_multiply_transpose_matrixB_output_to_C(reinterpret_cast<const float *>(query_tensor_ptr),
-                                                       reinterpret_cast<const float *>(target_tensor_ptr),
-                                                       query_embedding_num,
-                                                       target_embedding_num,
-                                                       basic_embedding_dimension,
-                                                       output_ptr.get());
-        float maxsim_score = 0.0f;
-        for (u32 query_i = 0; query_i < query_embedding_num; ++query_i) {
-            const float *query_ip_ptr = output_ptr.get() + query_i * target_embedding_num;
-            float max_score_i = std::numeric_limits<float>::lowest();
-            for (u32 k = 0; k < target_embedding_num; ++k) {
-                max_score_i = std::max(max_score_i, query_ip_ptr[k]);
-            }
-            maxsim_score += max_score_i;
-        }
-        return maxsim_score;
-    }
-};
-
-// TensorElemT: f64, f16, bf16, QueryElemT: f32 (aligned)
-template <typename TensorElemT>
-    requires(IsAnyOf<TensorElemT, f64, Float16T, BFloat16T>)
-struct MaxSimOp<TensorElemT, float> {
-    static float Score(const char *query_tensor_ptr,
-                       const char *src_target_tensor_ptr,
-                       const u32 query_embedding_num,
-                       const u32 target_embedding_num,
-                       const u32 basic_embedding_dimension) {
-        auto src_target_type_ptr = reinterpret_cast<const TensorElemT *>(src_target_tensor_ptr);
-        auto target_buffer = MakeUniqueForOverwrite<float[]>(basic_embedding_dimension * target_embedding_num);
-        for (u32 i = 0; i < basic_embedding_dimension * target_embedding_num; ++i) {
-            target_buffer[i] = static_cast<float>(src_target_type_ptr[i]);
-        }
-        auto output_ptr = MakeUniqueForOverwrite<float[]>(query_embedding_num * target_embedding_num);
-        matrixA_multiply_transpose_matrixB_output_to_C(reinterpret_cast<const float *>(query_tensor_ptr),
-                                                       target_buffer.get(),
-                                                       query_embedding_num,
-                                                       target_embedding_num,
-                                                       basic_embedding_dimension,
-                                                       output_ptr.get());
-        float maxsim_score = 0.0f;
-        for (u32 query_i = 0; query_i < query_embedding_num; ++query_i) {
-            const float *query_ip_ptr = output_ptr.get() + query_i * target_embedding_num;
-            float max_score_i = std::numeric_limits<float>::lowest();
-            for (u32 k = 0; k < target_embedding_num; ++k) {
-                max_score_i = std::max(max_score_i, query_ip_ptr[k]);
-            }
-            maxsim_score += max_score_i;
-        }
-        return maxsim_score;
-    }
-};
-
-template <typename Op>
-struct CalcutateScoreOfTensorRow {
-    static float Execute(ColumnVector &column_vector,
-                         const u32 block_offset,
-                         const char *query_tensor_ptr,
-                         const u32 query_embedding_num,
-                         const u32 basic_embedding_dimension) {
+struct CollectTensorOfRow {
+    static void Execute(const ColumnVector &column_vector, const u32 block_offset, const u32 row_idx, MaxSimTensorBatch &batch) {
         const auto [raw_data, embedding_num] = column_vector.GetTensorRaw(block_offset);
-        return Op::Score(query_tensor_ptr, raw_data.data(), query_embedding_num, embedding_num, basic_embedding_dimension);
+        batch.Add(raw_data.data(), embedding_num, row_idx);
     }
 };
 
-template <typename Op>
-struct CalcutateScoreOfTensorArrayRow {
-    static float Execute(ColumnVector &column_vector,
-                         const u32 block_offset,
-                         const char *query_tensor_ptr,
-                         const u32 query_embedding_num,
-                         const u32 basic_embedding_dimension) {
-        float maxsim_score = std::numeric_limits<float>::lowest();
+struct CollectTensorArrayOfRow {
+    static void Execute(const ColumnVector &column_vector, const u32 block_offset, const u32 row_idx, MaxSimTensorBatch &batch) {
         Vector<Pair<Span<const char>, SizeT>> tensor_array = column_vector.GetTensorArrayRaw(block_offset);
         for (const auto &[raw_data, embedding_num] : tensor_array) {
-            const float tensor_score = Op::Score(query_tensor_ptr, raw_data.data(), query_embedding_num, embedding_num, basic_embedding_dimension);
-            maxsim_score = std::max(maxsim_score, tensor_score);
+            batch.Add(raw_data.data(), embedding_num, row_idx);
         }
-        return maxsim_score;
     }
 };
 
-template <typename CalcutateScoreOfRowOp>
+// the rows of the block are scored in batches by the kernel
+template <typename CollectTensorsOfRowOp, typename Kernel>
 void ExecuteScanOnColumn(ColumnVector &column_vector,
                          const SegmentID segment_id,
                          const BlockID block_id,
@@ -743,13 +490,20 @@ void ExecuteScanOnColumn(ColumnVector &column_vector,
     const u32 basic_embedding_dimension = match_tensor_expr.tensor_basic_embedding_dimension_;
     const u32 segment_offset_start = block_id * DEFAULT_BLOCK_CAPACITY;
     const u32 end_block_offset = start_block_offset + row_count;
+    MaxSimTensorBatch batch;
+    Vector<u32> block_offsets;
     for (u32 i = start_block_offset; i < end_block_offset; ++i) {
         if (bitmask.IsTrue(i)) {
-            const float maxsim_score =
-                CalcutateScoreOfRowOp::Execute(column_vector, i, query_tensor_ptr, query_embedding_num, basic_embedding_dimension);
-            function_data.result_handler_->AddResult(0, maxsim_score, RowID(segment_id, segment_offset_start + i));
+            CollectTensorsOfRowOp::Execute(column_vector, i, block_offsets.size(), batch);
+            block_offsets.push_back(i);
         }
     }
+    Kernel kernel(query_tensor_ptr, query_embedding_num, basic_embedding_dimension);
+    Vector<f32> row_scores;
+    batch.Score(kernel, block_offsets.size(), row_scores);
+    for (SizeT i = 0; i < block_offsets.size(); ++i) {
+        function_data.result_handler_->AddResult(0, row_scores[i], RowID(segment_id, segment_offset_start + block_offsets[i]));
+    }
 }
 
 struct TensorScanParameterPack {
@@ -773,18 +527,18 @@ struct TensorScanParameterPack {
           bitmask_(bitmask), match_tensor_expr_(match_tensor_expr), function_data_(function_data) {}
 };
 
-template <template <typename> typename CalcutateScoreOfRow, typename ColumnElemT, typename QueryElemT>
+template <typename CollectTensorsOfRowOp, typename ColumnElemT, typename QueryElemT>
 void CalculateScoreOnColumnVectorT(TensorScanParameterPack &parameter_pack) {
     switch (parameter_pack.match_tensor_expr_.search_method_) {
         case MatchTensorSearchMethod::kMaxSim: {
-            return ExecuteScanOnColumn<CalcutateScoreOfRow<MaxSimOp<ColumnElemT, QueryElemT>>>(parameter_pack.column_vector_,
-                                                                                               parameter_pack.segment_id_,
-                                                                                               parameter_pack.block_id_,
-                                                                                               parameter_pack.start_block_offset_,
-                                                                                               parameter_pack.row_count_,
-                                                                                               parameter_pack.bitmask_,
-                                                                                               parameter_pack.match_tensor_expr_,
-                                                                                               parameter_pack.function_data_);
+            return ExecuteScanOnColumn<CollectTensorsOfRowOp, MaxSimKernel<ColumnElemT, QueryElemT>>(parameter_pack.column_vector_,
+                                                                                                    parameter_pack.segment_id_,
+                                                                                                    parameter_pack.block_id_,
+                                                                                                    parameter_pack.start_block_offset_,
+                                                                                                    parameter_pack.row_count_,
+                                                                                                    parameter_pack.bitmask_,
+                                                                                                    parameter_pack.match_tensor_expr_,
+                                                                                                    parameter_pack.function_data_);
         }
         case MatchTensorSearchMethod::kInvalid: {
             const auto error_message = "Invalid search method!";
@@ -799,10 +553,10 @@ struct ExecuteMatchTensorScanTypes {
     static void Execute(TensorScanParameterPack &parameter_pack) {
         switch (parameter_pack.column_vector_.data_type()->type()) {
             case LogicalType::kTensor: {
-                return CalculateScoreOnColumnVectorT<CalcutateScoreOfTensorRow, T...>(parameter_pack);
+                return CalculateScoreOnColumnVectorT<CollectTensorOfRow, T...>(parameter_pack);
             }
             case LogicalType::kTensorArray: {
-                return CalculateScoreOnColumnVectorT<CalcutateScoreOfTensorArrayRow, T...>(parameter_pack);
+                return CalculateScoreOnColumnVectorT<CollectTensorArrayOfRow, T...>(parameter_pack);
             }
             default: {
                 const auto error_message = "Invalid column type! target column is not Tensor or TensorArray type.";
@@ -899,7 +653,8 @@ struct RerankerParameterPack {
           match_tensor_expr_(match_tensor_expr) {}
 };
 
-template <typename CalcutateScoreOfRowOp>
+// all candidates are scored in batches by the kernel, each block is loaded once
+template <typename CollectTensorsOfRowOp, typename Kernel>
 void GetRerankerScore(Vector<MatchTensorRerankDoc> &rerank_docs,
                       BufferManager *buffer_mgr,
                       const ColumnID column_id,
@@ -907,33 +662,49 @@ void GetRerankerScore(Vector<MatchTensorRerankDoc> &rerank_docs,
                       const char *query_tensor_ptr,
                       const u32 query_embedding_num,
                       const u32 basic_embedding_dimension) {
-    for (auto &doc : rerank_docs) {
-        const RowID row_id = doc.row_id_;
+    Vector<u32> doc_order(rerank_docs.size());
+    std::iota(doc_order.begin(), doc_order.end(), 0);
+    std::sort(doc_order.begin(), doc_order.end(), [&](const u32 lhs, const u32 rhs) { return rerank_docs[lhs].row_id_ < rerank_docs[rhs].row_id_; });
+    // the collected tensors point into the loaded blocks
+    Vector<ColumnVector> column_vectors;
+    MaxSimTensorBatch batch;
+    Pair<SegmentID, BlockID> loaded_block(INVALID_SEGMENT_ID, INVALID_BLOCK_ID);
+    for (u32 i = 0; i < doc_order.size(); ++i) {
+        const RowID row_id = rerank_docs[doc_order[i]].row_id_;
         const SegmentID segment_id = row_id.segment_id_;
         const SegmentOffset segment_offset = row_id.segment_offset_;
         const BlockID block_id = segment_offset / DEFAULT_BLOCK_CAPACITY;
         const BlockOffset block_offset = segment_offset % DEFAULT_BLOCK_CAPACITY;
-        BlockColumnEntry *block_column_entry =
-            block_index->segment_block_index_.at(segment_id).block_map_.at(block_id)->GetColumnBlockEntry(column_id);
-        auto column_vec = block_column_entry->GetConstColumnVector(buffer_mgr);
-        doc.score_ = CalcutateScoreOfRowOp::Execute(column_vec, block_offset, query_tensor_ptr, query_embedding_num, basic_embedding_dimension);
+        if (loaded_block != Pair<SegmentID, BlockID>(segment_id, block_id)) {
+            BlockColumnEntry *block_column_entry =
+                block_index->segment_block_index_.at(segment_id).block_map_.at(block_id)->GetColumnBlockEntry(column_id);
+            column_vectors.push_back(block_column_entry->GetConstColumnVector(buffer_mgr));
+            loaded_block = {segment_id, block_id};
+        }
+        CollectTensorsOfRowOp::Execute(column_vectors.back(), block_offset, i, batch);
+    }
+    Kernel kernel(query_tensor_ptr, query_embedding_num, basic_embedding_dimension);
+    Vector<f32> row_scores;
+    batch.Score(kernel, doc_order.size(), row_scores);
+    for (u32 i = 0; i < doc_order.size(); ++i) {
+        rerank_docs[doc_order[i]].score_ = row_scores[i];
     }
 }
 
-template <template <typename> typename CalcutateScoreOfRow, typename ColumnElemT, typename QueryElemT>
+template <typename CollectTensorsOfRowOp, typename ColumnElemT, typename QueryElemT>
 void RerankerScoreT(RerankerParameterPack &parameter_pack) {
     const char *query_tensor_ptr = parameter_pack.match_tensor_expr_.query_embedding_.ptr;
     const u32 query_embedding_num = parameter_pack.match_tensor_expr_.num_of_embedding_in_query_tensor_;
     const u32 basic_embedding_dimension = parameter_pack.match_tensor_expr_.tensor_basic_embedding_dimension_;
     switch (parameter_pack.match_tensor_expr_.search_method_) {
         case MatchTensorSearchMethod::kMaxSim: {
-            return GetRerankerScore<CalcutateScoreOfRow<MaxSimOp<ColumnElemT, QueryElemT>>>(parameter_pack.rerank_docs_,
-                                                                                            parameter_pack.buffer_mgr_,
-                                                                                            parameter_pack.column_id_,
-                                                                                            parameter_pack.block_index_,
-                                                                                            query_tensor_ptr,
-                                                                                            query_embedding_num,
-                                                                                            basic_embedding_dimension);
+            return GetRerankerScore<CollectTensorsOfRowOp, MaxSimKernel<ColumnElemT, QueryElemT>>(parameter_pack.rerank_docs_,
+                                                                                                 parameter_pack.buffer_mgr_,
+                                                                                                 parameter_pack.column_id_,
+                                                                                                 parameter_pack.block_index_,
+                                                                                                 query_tensor_ptr,
+                                                                                                 query_embedding_num,
+                                                                                                 basic_embedding_dimension);
         }
         case MatchTensorSearchMethod::kInvalid: {
             const auto error_message = "Invalid search method!";
@@ -948,10 +719,10 @@ struct ExecuteMatchTensorRerankerTypes {
     static void Execute(RerankerParameterPack &parameter_pack) {
         switch (parameter_pack.column_data_type_->type()) {
             case LogicalType::kTensor: {
-                return RerankerScoreT<CalcutateScoreOfTensorRow, T...>(parameter_pack);
+                return RerankerScoreT<CollectTensorOfRow, T...>(parameter_pack);
             }
             case LogicalType::kTensorArray: {
-                return RerankerScoreT<CalcutateScoreOfTensorArrayRow, T...>(parameter_pack);
+                return RerankerScoreT<CollectTensorArrayOfRow, T...>(parameter_pack);
             }
             default: {
                 const auto error_message = "Invalid column type! target column is not Tensor or TensorArray type.";
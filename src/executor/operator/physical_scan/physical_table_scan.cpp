@@ -40,6 +40,7 @@ import column_vector;
 import logical_type;
 
 import block_entry;
+import segment_entry;
 
 namespace infinity {
 
@@ -101,6 +102,7 @@ void PhysicalTableScan::ExecuteInternal(QueryContext *query_context, TableScanOp
     DataBlock *output_ptr = table_scan_operator_state->data_block_array_.back().get();
     output_ptr->Init(*GetOutputTypes());
 
+    table_scan_operator_state->skipped_block_count_ = 0;
     TableScanFunctionData *table_scan_function_data_ptr = table_scan_operator_state->table_scan_function_data_.get();
     const BlockIndex *block_index = table_scan_function_data_ptr->block_index_;
     Vector<GlobalBlockID> *block_ids = table_scan_function_data_ptr->global_block_ids_.get();
@@ -135,20 +137,26 @@ void PhysicalTableScan::ExecuteInternal(QueryContext *query_context, TableScanOp
 
         BlockEntry *current_block_entry = block_index->GetBlockEntry(segment_id, block_id);
         if (read_offset == 0) {
-            // new block, check FastRoughFilter
+            // new block, check FastRoughFilter, and the zone map if the block is not sealed yet
             const auto &fast_rough_filter = *current_block_entry->GetFastRoughFilter();
-            if (fast_rough_filter_evaluator_ and !fast_rough_filter_evaluator_->Evaluate(begin_ts, fast_rough_filter)) {
+            if (fast_rough_filter_evaluator_ and
+                (!fast_rough_filter_evaluator_->Evaluate(begin_ts, fast_rough_filter) or
+                 !fast_rough_filter_evaluator_->EvaluateZoneMap(current_block_entry->zone_map(), current_block_entry->row_count()))) {
                 // skip this block
                 LOG_TRACE(fmt::format("TableScan: block_ids_idx: {}, block_ids.size(): {}, skipped after apply FastRoughFilter",
                                       block_ids_idx,
                                       block_ids_count));
                 ++block_ids_idx;
+                ++table_scan_operator_state->skipped_block_count_;
                 continue;
             } else {
                 LOG_TRACE(fmt::format("TableScan: block_ids_idx: {}, block_ids.size(): {}, not skipped after apply FastRoughFilter",
                                       block_ids_idx,
                                       block_ids_count));
             }
+            if (block_id == 0) {
+                current_block_entry->GetSegmentEntry()->IncreaseScanCount();
+            }
         }
         auto [row_begin, row_end] = current_block_entry->GetVisibleRange(begin_ts, read_offset);
         if (row_begin == row_end) {
@@ -65,6 +65,8 @@ public:
 
     Vector<SizeT> &ColumnIDs() const;
 
+    const FastRoughFilterEvaluator *GetFastRoughFilterEvaluator() const { return fast_rough_filter_evaluator_.get(); }
+
     bool ParallelExchange() const override { return true; }
 
     bool IsExchange() const override { return true; }
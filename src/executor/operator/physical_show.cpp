@@ -80,6 +80,7 @@ import infinity_context;
 import peer_task;
 import cleanup_scanner;
 import obj_status;
+import posting_block_cache;
 
 namespace infinity {
 
@@ -1258,7 +1259,10 @@ void PhysicalShow::ExecuteShowIndexSegment(QueryContext *query_context, ShowOper
                     chunk_index_entries = std::get<0>(segment_index_entry->GetBMPIndexSnapshot());
                     break;
                 }
-                case IndexType::kDiskAnn:
+                case IndexType::kDiskAnn: {
+                    chunk_index_entries = segment_index_entry->GetDiskAnnIndexSnapshot();
+                    break;
+                }
                 case IndexType::kInvalid: {
                     Status status3 = Status::InvalidIndexName(index_type_name);
                     RecoverableError(status3);
@@ -1337,7 +1341,10 @@ void PhysicalShow::ExecuteShowIndexChunk(QueryContext *query_context, ShowOperat
             chunk_indexes = chunk_index_entries;
             break;
         }
-        case IndexType::kDiskAnn:
+        case IndexType::kDiskAnn: {
+            chunk_indexes = segment_index_entry->GetDiskAnnIndexSnapshot();
+            break;
+        }
         case IndexType::kInvalid: {
             Status status3 = Status::InvalidIndexName(index_type_name);
             RecoverableError(status3);
@@ -4040,6 +4047,25 @@ void PhysicalShow::ExecuteShowGlobalVariable(QueryContext *query_context, ShowOp
             }
             break;
         }
+        case GlobalVariable::kPostingBlockCache: {
+            Vector<SharedPtr<ColumnDef>> output_column_defs = {
+                MakeShared<ColumnDef>(0, varchar_type, "value", std::set<ConstraintType>()),
+            };
+
+            SharedPtr<TableDef> table_def = TableDef::Make(MakeShared<String>("default_db"), MakeShared<String>("variables"), output_column_defs);
+            output_ = MakeShared<DataTable>(table_def, TableType::kResult);
+
+            Vector<SharedPtr<DataType>> output_column_types{
+                varchar_type,
+            };
+
+            output_block_ptr->Init(output_column_types);
+
+            Value value = Value::MakeVarchar(PostingBlockCache::instance().GetStats().ToString());
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
+            break;
+        }
         case GlobalVariable::kCleanupTrace: {
             CleanupInfoTracer *tracer = query_context->storage()->cleanup_info_tracer();
             String error_msg = tracer->GetCleanupInfo();
@@ -4577,6 +4603,27 @@ void PhysicalShow::ExecuteShowGlobalVariables(QueryContext *query_context, ShowO
                 }
                 break;
             }
+            case GlobalVariable::kPostingBlockCache: {
+                {
+                    // option name
+                    Value value = Value::MakeVarchar(var_name);
+                    ValueExpression value_expr(value);
+                    value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
+                }
+                {
+                    // option value
+                    Value value = Value::MakeVarchar(PostingBlockCache::instance().GetStats().ToString());
+                    ValueExpression value_expr(value);
+                    value_expr.AppendToChunk(output_block_ptr->column_vectors[1]);
+                }
+                {
+                    // option description
+                    Value value = Value::MakeVarchar("Hits, misses and usage of the decoded posting block cache");
+                    ValueExpression value_expr(value);
+                    value_expr.AppendToChunk(output_block_ptr->column_vectors[2]);
+                }
+                break;
+            }
             case GlobalVariable::kCleanupTrace: {
                 CleanupInfoTracer *tracer = query_context->storage()->cleanup_info_tracer();
                 String error_msg = tracer->GetCleanupInfo();
@@ -14,6 +14,7 @@
 
 module;
 
+#include <cstring>
 #include <string>
 
 module physical_sort;
@@ -38,6 +39,13 @@ import third_party;
 import status;
 import physical_top;
 import logger;
+import sort_key_encoder;
+import loser_tree;
+import data_type;
+import sorted_run;
+import infinity_context;
+import config;
+import logical_type;
 
 namespace infinity {
 
@@ -50,20 +58,10 @@ struct BlockRawIndex {
 
 class Comparator {
 public:
-    explicit Comparator(const CompareTwoRowAndPreferLeft &prefer_left_function,
-                        const Vector<UniquePtr<DataBlock>> &order_by_blocks,
-                        const Vector<SharedPtr<BaseExpression>> &expressions,
-                        Vector<SharedPtr<ExpressionState>> &expr_states)
-        : prefer_left_function_(prefer_left_function), order_by_blocks_(order_by_blocks), expressions_(expressions), expr_states_(expr_states) {}
-
-    void Init() {
-        if (order_by_blocks_.empty()) {
-            return;
-        }
-        eval_results_ = PhysicalTop::GetEvalColumns(expressions_, expr_states_, order_by_blocks_);
-    }
+    explicit Comparator(const CompareTwoRowAndPreferLeft &prefer_left_function, Vector<Vector<SharedPtr<ColumnVector>>> eval_results)
+        : prefer_left_function_(prefer_left_function), eval_results_(std::move(eval_results)) {}
 
-    bool Compare(BlockRawIndex left_index, BlockRawIndex right_index) {
+    bool Compare(BlockRawIndex left_index, BlockRawIndex right_index) const {
         auto &left = eval_results_[left_index.block_idx_];
         auto &right = eval_results_[right_index.block_idx_];
         return prefer_left_function_.Compare(left, left_index.offset_, right, right_index.offset_);
@@ -71,51 +69,125 @@ public:
 
 private:
     const CompareTwoRowAndPreferLeft &prefer_left_function_;
-    const Vector<UniquePtr<DataBlock>> &order_by_blocks_;
-    const Vector<SharedPtr<BaseExpression>> &expressions_;
-    Vector<SharedPtr<ExpressionState>> &expr_states_;
 
     // Blocks -> Expressions
     Vector<Vector<SharedPtr<ColumnVector>>> eval_results_;
 };
 
-Vector<BlockRawIndex> MergeTwoIndexes(Vector<BlockRawIndex> &&indexes_a, Vector<BlockRawIndex> &&indexes_b, Comparator &comparator) {
-    if (indexes_a.empty() || indexes_b.empty()) {
-        return indexes_a.empty() ? indexes_b : indexes_a;
-    }
-    Vector<BlockRawIndex> merged_indexes;
-    merged_indexes.reserve(indexes_a.size() + indexes_b.size());
+// The block of a sorted run being merged, with its keys and, for incomplete keys, its sort values
+struct MergeInput {
+    UniquePtr<DataBlock> block_{};
+    Vector<u8> keys_{};
+    Vector<SharedPtr<ColumnVector>> eval_columns_{};
+};
 
-    auto ptr_a = indexes_a.begin();
-    auto ptr_b = indexes_b.begin();
+// Head of a sorted run in the k-way merge
+struct RunCursor {
+    const u8 *key_{};
+    u32 run_{};
+    u32 offset_{};
+};
 
-    while (ptr_a != indexes_a.end() && ptr_b != indexes_b.end()) {
-        if (comparator.Compare(*ptr_a, *ptr_b)) {
-            merged_indexes.push_back(*ptr_a);
-            ++ptr_a;
-        } else {
-            merged_indexes.push_back(*ptr_b);
-            ++ptr_b;
+class RunCursorLess {
+public:
+    RunCursorLess(const SortKeyEncoder &encoder, const CompareTwoRowAndPreferLeft &prefer_left_function, const Vector<MergeInput> &inputs)
+        : encoder_(&encoder), prefer_left_function_(&prefer_left_function), inputs_(&inputs) {}
+
+    bool operator()(const RunCursor &left, const RunCursor &right) const {
+        if (int cmp = encoder_->Compare(left.key_, right.key_); cmp != 0) {
+            return cmp < 0;
         }
+        if (!encoder_->complete()) {
+            const auto &left_columns = (*inputs_)[left.run_].eval_columns_;
+            const auto &right_columns = (*inputs_)[right.run_].eval_columns_;
+            if (!prefer_left_function_->Compare(right_columns, right.offset_, left_columns, left.offset_)) {
+                return true;
+            }
+            if (!prefer_left_function_->Compare(left_columns, left.offset_, right_columns, right.offset_)) {
+                return false;
+            }
+        }
+        return left.run_ < right.run_;
     }
-    if (ptr_a != indexes_a.end()) {
-        merged_indexes.insert(merged_indexes.end(), ptr_a, indexes_a.end());
+
+private:
+    const SortKeyEncoder *encoder_{};
+    const CompareTwoRowAndPreferLeft *prefer_left_function_{};
+    const Vector<MergeInput> *inputs_{};
+};
+
+// K-way merge of sorted runs, the spilled runs are read one block at a time
+class RunMerge final : public SortedRunMerge {
+public:
+    RunMerge(Vector<UniquePtr<SortedRun>> runs,
+             const SortKeyEncoder &encoder,
+             const CompareTwoRowAndPreferLeft &prefer_left_function,
+             const Vector<SharedPtr<BaseExpression>> &expressions,
+             Vector<SharedPtr<ExpressionState>> &expr_states)
+        : runs_(std::move(runs)), inputs_(runs_.size()), encoder_(&encoder), expressions_(&expressions), expr_states_(&expr_states),
+          cursor_less_(encoder, prefer_left_function, inputs_), loser_tree_(runs_.size(), cursor_less_) {
+        for (u32 run_id = 0; run_id < runs_.size(); ++run_id) {
+            if (LoadBlock(run_id)) {
+                RunCursor cursor{inputs_[run_id].keys_.data(), run_id, 0};
+                loser_tree_.InsertStart(&cursor, run_id, false);
+            } else {
+                loser_tree_.InsertStart(nullptr, run_id, true);
+            }
+        }
+        loser_tree_.Init();
     }
-    if (ptr_b != indexes_b.end()) {
-        merged_indexes.insert(merged_indexes.end(), ptr_b, indexes_b.end());
+
+    bool Done() { return loser_tree_.TopSource() == LoserTree<RunCursor, RunCursorLess>::invalid_; }
+
+    // The smallest row which is not merged yet
+    RunCursor Top() { return loser_tree_.TopKey(); }
+
+    const DataBlock *Block(const RunCursor &cursor) const { return inputs_[cursor.run_].block_.get(); }
+
+    void Pop() {
+        RunCursor cursor = loser_tree_.TopKey();
+        auto &input = inputs_[cursor.run_];
+        ++merged_row_count_;
+        if (++cursor.offset_ < input.block_->row_count()) {
+            cursor.key_ += encoder_->key_size();
+            loser_tree_.DeleteTopInsert(&cursor, false);
+        } else if (LoadBlock(cursor.run_)) {
+            cursor.key_ = input.keys_.data();
+            cursor.offset_ = 0;
+            loser_tree_.DeleteTopInsert(&cursor, false);
+        } else {
+            loser_tree_.DeleteTopInsert(nullptr, true);
+        }
     }
 
-    return merged_indexes;
-}
+    u64 merged_row_count() const { return merged_row_count_; }
 
-Vector<BlockRawIndex> MergeIndexes(Vector<Vector<BlockRawIndex>> &indexes_group, SizeT l, SizeT r, Comparator &comparator) {
-    if (l > r or r >= indexes_group.size())
-        return Vector<BlockRawIndex>();
-    if (l == r)
-        return indexes_group[l];
-    SizeT mid = (l + r) >> 1;
-    return MergeTwoIndexes(MergeIndexes(indexes_group, l, mid, comparator), MergeIndexes(indexes_group, mid + 1, r, comparator), comparator);
-}
+private:
+    bool LoadBlock(u32 run_id) {
+        auto &input = inputs_[run_id];
+        if (!runs_[run_id]->NextBlock(input.block_, input.keys_)) {
+            input.block_.reset();
+            return false;
+        }
+        if (!encoder_->complete()) {
+            // values are only needed to order rows with equal keys
+            Vector<UniquePtr<DataBlock>> block_array;
+            block_array.push_back(std::move(input.block_));
+            input.eval_columns_ = std::move(PhysicalTop::GetEvalColumns(*expressions_, *expr_states_, block_array)[0]);
+            input.block_ = std::move(block_array[0]);
+        }
+        return true;
+    }
+
+    Vector<UniquePtr<SortedRun>> runs_{};
+    Vector<MergeInput> inputs_{};
+    const SortKeyEncoder *encoder_{};
+    const Vector<SharedPtr<BaseExpression>> *expressions_{};
+    Vector<SharedPtr<ExpressionState>> *expr_states_{};
+    RunCursorLess cursor_less_;
+    LoserTree<RunCursor, RunCursorLess> loser_tree_;
+    u64 merged_row_count_{};
+};
 
 void CopyWithIndexes(const Vector<UniquePtr<DataBlock>> &input_blocks,
                      Vector<UniquePtr<DataBlock>> &output_blocks,
@@ -158,65 +230,216 @@ void PhysicalSort::Init() {
     }
     Vector<std::function<std::strong_ordering(const SharedPtr<ColumnVector> &, u32, const SharedPtr<ColumnVector> &, u32)>> sort_functions;
     sort_functions.reserve(sort_expr_count);
+    Vector<DataType> sort_key_types;
+    sort_key_types.reserve(sort_expr_count);
     for (u32 i = 0; i < sort_expr_count; ++i) {
         sort_functions.emplace_back(PhysicalTop::GenerateSortFunction(order_by_types_[i], expressions_[i]));
+        sort_key_types.push_back(expressions_[i]->Type());
     }
     prefer_left_function_ = CompareTwoRowAndPreferLeft(std::move(sort_functions));
+    sort_key_encoder_.Init(sort_key_types, order_by_types_);
+
+    // The column serialization of spill files doesn't support these types
+    spillable_ = true;
+    for (const auto &output_type : *GetOutputTypes()) {
+        if (output_type->type() == LogicalType::kHugeInt || output_type->type() == LogicalType::kMixed) {
+            spillable_ = false;
+        }
+    }
 }
 
 bool PhysicalSort::Execute(QueryContext *, OperatorState *operator_state) {
     auto *prev_op_state = operator_state->prev_op_state_;
     auto *sort_operator_state = static_cast<SortOperatorState *>(operator_state);
+    if (sort_operator_state->merge_.get() != nullptr) {
+        // The input is done, output the next merged blocks
+        return OutputMergedBlocks(sort_operator_state);
+    }
 
-    // Generate block indexes
-    Vector<BlockRawIndex> block_indexes;
-    auto pre_op_state = operator_state->prev_op_state_;
+    for (auto &input_block : prev_op_state->data_block_array_) {
+        if (input_block->row_count() == 0) {
+            continue;
+        }
+        if (spillable_) {
+            sort_operator_state->buffered_bytes_ += input_block->GetSizeInBytes();
+        }
+        sort_operator_state->buffered_blocks_.push_back(std::move(input_block));
+    }
+    prev_op_state->data_block_array_.clear();
+
+    if (!prev_op_state->Complete()) {
+        // Half of the budget for the buffered input and half for the runs kept in memory
+        const i64 memory_budget = InfinityContext::instance().config()->SortMemoryBudget();
+        if (spillable_ && sort_operator_state->buffered_bytes_ >= static_cast<SizeT>(memory_budget / 2)) {
+            GenerateRun(sort_operator_state);
+            auto &sorted_runs = sort_operator_state->sorted_runs_;
+            SizeT run_memory_usage = 0;
+            for (const auto &run : sorted_runs) {
+                run_memory_usage += run->memory_usage();
+            }
+            if (run_memory_usage >= static_cast<SizeT>(memory_budget / 2)) {
+                const String temp_dir = InfinityContext::instance().config()->TempDir();
+                for (auto &run : sorted_runs) {
+                    run->Spill(temp_dir);
+                }
+            }
+        }
+        return false;
+    }
+
+    GenerateRun(sort_operator_state);
+    auto &sorted_runs = sort_operator_state->sorted_runs_;
+    if (sorted_runs.size() == 1 && !sorted_runs[0]->spilled()) {
+        u32 row_count = sorted_runs[0]->row_count();
+        sort_operator_state->data_block_array_ = sorted_runs[0]->TakeBlocks();
+        PhysicalTop::HandleOutputOffset(row_count, offset_, sort_operator_state->data_block_array_);
+    } else if (!sorted_runs.empty()) {
+        MergeRuns(sort_operator_state);
+        return OutputMergedBlocks(sort_operator_state);
+    }
+    sorted_runs.clear();
+    sort_operator_state->SetComplete();
+    return true;
+}
 
-    block_indexes.reserve(pre_op_state->data_block_array_.size() * DEFAULT_BLOCK_CAPACITY);
-    // filling block_indexes
-    for (u32 block_id = 0; block_id < pre_op_state->data_block_array_.size(); block_id++) {
-        for (u32 offset = 0; offset < pre_op_state->data_block_array_[block_id]->row_count(); offset++) {
+void PhysicalSort::GenerateRun(SortOperatorState *sort_operator_state) const {
+    auto &input_blocks = sort_operator_state->buffered_blocks_;
+    const SizeT key_size = sort_key_encoder_.key_size();
+    Vector<BlockRawIndex> block_indexes;
+    for (u32 block_id = 0; block_id < input_blocks.size(); block_id++) {
+        for (u32 offset = 0; offset < input_blocks[block_id]->row_count(); offset++) {
             block_indexes.emplace_back(block_id, offset);
         }
     }
-    auto &expr_states = (static_cast<SortOperatorState *>(operator_state))->expr_states_;
-    auto block_comparator = Comparator(prefer_left_function_, pre_op_state->data_block_array_, expressions_, expr_states);
+    if (block_indexes.empty()) {
+        return;
+    }
 
-    block_comparator.Init();
-    // sort block_indexes
-    std::sort(block_indexes.begin(), block_indexes.end(), [&block_comparator](BlockRawIndex x, BlockRawIndex y) -> bool {
-        // Be careful! std::sort needs a strict ordering comparator. ("<" instead of "<=")
-        return !block_comparator.Compare(y, x);
+    // Encode the sort keys of the input and sort it
+    const u32 row_count = block_indexes.size();
+    Vector<u8> keys(row_count * key_size);
+    auto eval_columns = PhysicalTop::GetEvalColumns(expressions_, sort_operator_state->expr_states_, input_blocks);
+    for (SizeT block_id = 0, key_offset = 0; block_id < input_blocks.size(); ++block_id) {
+        const SizeT block_row_count = input_blocks[block_id]->row_count();
+        sort_key_encoder_.Encode(eval_columns[block_id], block_row_count, keys.data() + key_offset);
+        key_offset += block_row_count * key_size;
+    }
+    auto block_comparator = Comparator(prefer_left_function_, std::move(eval_columns));
+    Vector<u32> sorted_rows = SortEncodedRows(sort_key_encoder_, keys.data(), row_count, [&](u32 left, u32 right) {
+        // Be careful! the sort needs a strict ordering comparator. ("<" instead of "<=")
+        return !block_comparator.Compare(block_indexes[right], block_indexes[left]);
     });
 
-    CopyWithIndexes(pre_op_state->data_block_array_, sort_operator_state->unmerge_sorted_blocks_, block_indexes);
-    prev_op_state->data_block_array_.clear();
-
-    if (!prev_op_state->Complete()) {
-        return false;
+    // Rows after the limit can't be in the result
+    const u32 run_row_count = std::min<u64>(row_count, limit_);
+    Vector<u8> run_keys(run_row_count * key_size);
+    Vector<BlockRawIndex> sorted_indexes;
+    sorted_indexes.reserve(run_row_count);
+    for (u32 i = 0; i < run_row_count; ++i) {
+        sorted_indexes.push_back(block_indexes[sorted_rows[i]]);
+        std::memcpy(run_keys.data() + i * key_size, keys.data() + sorted_rows[i] * key_size, key_size);
     }
-    auto &unmerge_sorted_blocks = sort_operator_state->unmerge_sorted_blocks_;
-    auto merge_comparator = Comparator(prefer_left_function_, unmerge_sorted_blocks, expressions_, expr_states);
-    Vector<Vector<BlockRawIndex>> indexes_group;
+    Vector<UniquePtr<DataBlock>> run_blocks;
+    CopyWithIndexes(input_blocks, run_blocks, sorted_indexes);
+    input_blocks.clear();
+    sort_operator_state->buffered_bytes_ = 0;
+    sort_operator_state->sorted_runs_.push_back(MakeUnique<SortedRun>(std::move(run_blocks), std::move(run_keys), key_size));
+}
 
-    merge_comparator.Init();
-    indexes_group.reserve(unmerge_sorted_blocks.size());
+void PhysicalSort::MergeRuns(SortOperatorState *sort_operator_state) const {
+    auto &sorted_runs = sort_operator_state->sorted_runs_;
+    auto &expr_states = sort_operator_state->expr_states_;
+    const SizeT key_size = sort_key_encoder_.key_size();
+    // Every merged run keeps a block in memory
+    const i64 memory_budget = InfinityContext::instance().config()->SortMemoryBudget();
+    const SizeT fan_in = std::clamp<SizeT>(memory_budget / SORT_MERGE_RUN_BYTES, 2, SORT_MAX_MERGE_FAN_IN);
+
+    while (sorted_runs.size() > fan_in) {
+        // Merge groups of consecutive runs into new spilled runs, so rows with equal keys keep the input order
+        const String temp_dir = InfinityContext::instance().config()->TempDir();
+        Vector<UniquePtr<SortedRun>> merged_runs;
+        for (SizeT begin = 0; begin < sorted_runs.size(); begin += fan_in) {
+            const SizeT end = std::min(begin + fan_in, sorted_runs.size());
+            if (end - begin == 1) {
+                merged_runs.push_back(std::move(sorted_runs[begin]));
+                continue;
+            }
+            Vector<UniquePtr<SortedRun>> group;
+            for (SizeT run_id = begin; run_id < end; ++run_id) {
+                group.push_back(std::move(sorted_runs[run_id]));
+            }
+            RunMerge merge(std::move(group), sort_key_encoder_, prefer_left_function_, expressions_, expr_states);
+            auto merged_run = MakeUnique<SortedRun>(temp_dir, key_size);
+            UniquePtr<DataBlock> block;
+            Vector<u8> keys;
+            u32 block_row_count = 0;
+            auto append_block = [&] {
+                block->Finalize();
+                merged_run->Append(*block, keys.data());
+                block.reset();
+                keys.clear();
+                block_row_count = 0;
+            };
+            // Rows after the limit can't be in the result
+            while (!merge.Done() && merge.merged_row_count() < limit_) {
+                RunCursor cursor = merge.Top();
+                const DataBlock *input_block = merge.Block(cursor);
+                if (block.get() == nullptr) {
+                    block = DataBlock::MakeUniquePtr();
+                    block->Init(input_block->types(), DEFAULT_BLOCK_CAPACITY);
+                }
+                block->AppendWith(input_block, cursor.offset_, 1);
+                keys.insert(keys.end(), cursor.key_, cursor.key_ + key_size);
+                merge.Pop();
+                if (++block_row_count == DEFAULT_BLOCK_CAPACITY) {
+                    append_block();
+                }
+            }
+            if (block.get() != nullptr) {
+                append_block();
+            }
+            merged_run->FinishAppend();
+            merged_runs.push_back(std::move(merged_run));
+        }
+        sorted_runs = std::move(merged_runs);
+    }
 
-    for (u32 block_id = 0; block_id < unmerge_sorted_blocks.size(); ++block_id) {
-        Vector<BlockRawIndex> indexes;
-        indexes.reserve(unmerge_sorted_blocks[block_id]->row_count());
+    sort_operator_state->merge_ = MakeUnique<RunMerge>(std::move(sorted_runs), sort_key_encoder_, prefer_left_function_, expressions_, expr_states);
+    sorted_runs.clear();
+}
 
-        for (u32 offset = 0; offset < unmerge_sorted_blocks[block_id]->row_count(); ++offset) {
-            indexes.emplace_back(block_id, offset);
+bool PhysicalSort::OutputMergedBlocks(SortOperatorState *sort_operator_state) const {
+    auto *merge = static_cast<RunMerge *>(sort_operator_state->merge_.get());
+    auto &output_blocks = sort_operator_state->data_block_array_;
+    UniquePtr<DataBlock> output_block;
+    u32 output_row_count = 0;
+    while (!merge->Done() && merge->merged_row_count() < limit_ && output_blocks.size() < SORT_MERGE_OUTPUT_BLOCKS) {
+        RunCursor cursor = merge->Top();
+        if (merge->merged_row_count() >= offset_) {
+            const DataBlock *input_block = merge->Block(cursor);
+            if (output_block.get() == nullptr) {
+                output_block = DataBlock::MakeUniquePtr();
+                output_block->Init(input_block->types(), DEFAULT_BLOCK_CAPACITY);
+            }
+            output_block->AppendWith(input_block, cursor.offset_, 1);
+            if (++output_row_count == DEFAULT_BLOCK_CAPACITY) {
+                output_block->Finalize();
+                output_blocks.push_back(std::move(output_block));
+                output_row_count = 0;
+            }
         }
-        indexes_group.push_back(std::move(indexes));
+        merge->Pop();
+    }
+    if (output_block.get() != nullptr) {
+        output_block->Finalize();
+        output_blocks.push_back(std::move(output_block));
     }
-    auto merge_indexes = MergeIndexes(indexes_group, 0, indexes_group.size() - 1, merge_comparator);
-    indexes_group.clear();
 
-    CopyWithIndexes(sort_operator_state->unmerge_sorted_blocks_, sort_operator_state->data_block_array_, merge_indexes);
-    sort_operator_state->unmerge_sorted_blocks_.clear();
-    sort_operator_state->SetComplete();
+    if (merge->Done() || merge->merged_row_count() >= limit_) {
+        sort_operator_state->merge_.reset();
+        sort_operator_state->SetComplete();
+    }
+    // Until the sort is complete, the sink collects the output blocks and the task executes the sort again
     return true;
 }
 
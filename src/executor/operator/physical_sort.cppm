@@ -32,6 +32,7 @@ import physical_top;
 import internal_types;
 import select_statement;
 import data_type;
+import sort_key_encoder;
 
 namespace infinity {
 
@@ -41,9 +42,11 @@ public:
                           UniquePtr<PhysicalOperator> left,
                           Vector<SharedPtr<BaseExpression>> expressions,
                           Vector<OrderType> order_by_types,
+                          u64 limit,
+                          u32 offset,
                           SharedPtr<Vector<LoadMeta>> load_metas)
         : PhysicalOperator(PhysicalOperatorType::kSort, std::move(left), nullptr, id, load_metas), expressions_(std::move(expressions)),
-          order_by_types_(std::move(order_by_types)) {}
+          order_by_types_(std::move(order_by_types)), limit_(limit), offset_(offset) {}
 
     ~PhysicalSort() override = default;
 
@@ -62,10 +65,23 @@ public:
 
     Vector<SharedPtr<BaseExpression>> expressions_;
     Vector<OrderType> order_by_types_{};
+    u64 limit_{}; // u64 max when there is no LIMIT
+    u32 offset_{};
 
 private:
+    // Sorts the buffered input blocks into a new sorted run
+    void GenerateRun(SortOperatorState *sort_operator_state) const;
+
+    // Merges the sorted runs of the state in passes until at most the fan-in is left, then starts the final merge
+    void MergeRuns(SortOperatorState *sort_operator_state) const;
+
+    // Outputs the next blocks of the final merge, the sort is complete after the last ones
+    bool OutputMergedBlocks(SortOperatorState *sort_operator_state) const;
+
     u64 input_table_index_{};
     CompareTwoRowAndPreferLeft prefer_left_function_; // compare function
+    SortKeyEncoder sort_key_encoder_;                 // normalized sort keys
+    bool spillable_{};                                // whether the input can be written to a spill file
 };
 
 } // namespace infinity
@@ -37,13 +37,15 @@ import third_party;
 import status;
 import logical_type;
 import internal_types;
+import sort_key_encoder;
+import data_type;
 
 namespace infinity {
 
 class TopSolver {
 public:
-    explicit TopSolver(u32 limit, const CompareTwoRowAndPreferLeft &prefer_left_function)
-        : limit_(limit), prefer_left_function_(prefer_left_function) {
+    explicit TopSolver(u32 limit, const CompareTwoRowAndPreferLeft &prefer_left_function, const SortKeyEncoder &sort_key_encoder)
+        : limit_(limit), prefer_left_function_(prefer_left_function), sort_key_encoder_(sort_key_encoder) {
         Init();
     }
     u32 WriteTopResultsToOutput(const Vector<Vector<SharedPtr<ColumnVector>>> &eval_columns,
@@ -59,6 +61,9 @@ private:
     u32 size_{};
     u32 limit_{};
     const CompareTwoRowAndPreferLeft &prefer_left_function_; // sort functions
+    const SortKeyEncoder &sort_key_encoder_;
+    Vector<u8> sort_keys_;            // normalized sort keys of all input rows
+    Vector<SizeT> block_key_offsets_; // offset of the first key of each input block in sort_keys_
     UniquePtr<Pair<u32, u32>[]> candidate_local_row_ids_;
     Pair<u32, u32> *row_ids_ptr_ = nullptr; // with offset, start from 1, for heap sort
     const Vector<Vector<SharedPtr<ColumnVector>>> *input_data_ = nullptr;
@@ -69,7 +74,20 @@ private:
     void ResetInput(const Vector<Vector<SharedPtr<ColumnVector>>> &eval_columns) {
         size_ = 0;
         input_data_ = &eval_columns;
+        const SizeT key_size = sort_key_encoder_.key_size();
+        block_key_offsets_.clear();
+        SizeT key_offset = 0;
+        for (const auto &block_columns : eval_columns) {
+            block_key_offsets_.push_back(key_offset);
+            key_offset += block_columns[0]->Size() * key_size;
+        }
+        sort_keys_.resize(key_offset);
+        for (SizeT block_id = 0; block_id < eval_columns.size(); ++block_id) {
+            const auto &block_columns = eval_columns[block_id];
+            sort_key_encoder_.Encode(block_columns, block_columns[0]->Size(), sort_keys_.data() + block_key_offsets_[block_id]);
+        }
     }
+    const u8 *SortKey(Pair<u32, u32> id) const { return sort_keys_.data() + block_key_offsets_[id.first] + id.second * sort_key_encoder_.key_size(); }
     void HeapifyDown(u32 index, auto compare) {
         if (index == 0 || (index << 1) > size_) {
             return;
@@ -121,6 +139,9 @@ private:
         // compare_id_for_heap: for heap sort
         // example: x = heap_top, y = candidate, return true if y should be put into heap
         auto compare_id_for_heap = [&](Pair<u32, u32> x, Pair<u32, u32> y) -> bool {
+            if (int cmp = sort_key_encoder_.Compare(SortKey(x), SortKey(y)); cmp != 0 || sort_key_encoder_.complete()) {
+                return cmp > 0;
+            }
             return !prefer_left_function_.Compare((*input_data_)[x.first], x.second, (*input_data_)[y.first], y.second);
         };
         const u32 input_block_cnt = input_data_->size();
@@ -184,11 +205,30 @@ InvalidPhysicalTopCompareType(const DataType &type_) {
     };
 }
 
+// NULL is the smallest value, as in the normalized sort keys. Returns None when neither side is NULL.
+template <OrderType compare_order>
+inline Optional<std::strong_ordering>
+CompareNulls(const SharedPtr<ColumnVector> &left_col, u32 left_id, const SharedPtr<ColumnVector> &right_col, u32 right_id) {
+    const bool left_valid = left_col->nulls_ptr_->IsTrue(left_id);
+    const bool right_valid = right_col->nulls_ptr_->IsTrue(right_id);
+    if (left_valid && right_valid) {
+        return None;
+    }
+    if constexpr (compare_order == OrderType::kAsc) {
+        return left_valid <=> right_valid;
+    } else {
+        return right_valid <=> left_valid;
+    }
+}
+
 // general template for POD types without three-way comparison but with operator< and operator==
 template <OrderType compare_order, BinaryGenerateBoolean T>
 struct PhysicalTopCompareSingleValue {
     static std::strong_ordering
     Compare(const SharedPtr<ColumnVector> &left_col, u32 left_id, const SharedPtr<ColumnVector> &right_col, u32 right_id) {
+        if (auto null_order = CompareNulls<compare_order>(left_col, left_id, right_col, right_id); null_order) {
+            return *null_order;
+        }
         auto compare_prefer_left = [](const T &x, const T &y) -> bool {
             if constexpr (compare_order == OrderType::kAsc) {
                 return x < y;
@@ -219,6 +259,9 @@ template <OrderType compare_order, BinaryGenerateBoolean T>
 struct PhysicalTopCompareSingleValue<compare_order, T> {
     static std::strong_ordering
     Compare(const SharedPtr<ColumnVector> &left_col, u32 left_id, const SharedPtr<ColumnVector> &right_col, u32 right_id) {
+        if (auto null_order = CompareNulls<compare_order>(left_col, left_id, right_col, right_id); null_order) {
+            return *null_order;
+        }
         auto left = (reinterpret_cast<T *>(left_col->data()))[left_id];
         auto right = (reinterpret_cast<T *>(right_col->data()))[right_id];
         if constexpr (compare_order == OrderType::kAsc) {
@@ -235,6 +278,9 @@ template <OrderType compare_order, BinaryGenerateBoolean T>
 struct PhysicalTopCompareSingleValue<compare_order, T> {
     static std::strong_ordering
     Compare(const SharedPtr<ColumnVector> &left_col, u32 left_id, const SharedPtr<ColumnVector> &right_col, u32 right_id) {
+        if (auto null_order = CompareNulls<compare_order>(left_col, left_id, right_col, right_id); null_order) {
+            return *null_order;
+        }
         ColumnValueReader<T> left(left_col);
         ColumnValueReader<T> right(right_col);
         if constexpr (compare_order == OrderType::kAsc) {
@@ -328,6 +374,12 @@ void PhysicalTop::Init() {
         sort_functions.emplace_back(GenerateSortFunction(order_by_types_[i], sort_expressions_[i]));
     }
     prefer_left_function_ = CompareTwoRowAndPreferLeft(std::move(sort_functions));
+    Vector<DataType> sort_key_types;
+    sort_key_types.reserve(sort_expr_count_);
+    for (const auto &sort_expression : sort_expressions_) {
+        sort_key_types.push_back(sort_expression->Type());
+    }
+    sort_key_encoder_.Init(sort_key_types, order_by_types_);
 }
 
 // Behavior now: always sort the output results
@@ -353,7 +405,7 @@ bool PhysicalTop::Execute(QueryContext *, OperatorState *operator_state) {
         UnrecoverableError(error_message);
     }
     auto eval_columns = GetEvalColumns(sort_expressions_, (static_cast<TopOperatorState *>(operator_state))->expr_states_, input_data_block_array);
-    TopSolver solve_top(limit_, prefer_left_function_);
+    TopSolver solve_top(limit_, prefer_left_function_, sort_key_encoder_);
     auto output_row_cnt = solve_top.WriteTopResultsToOutput(eval_columns, input_data_block_array, output_data_block_array);
     input_data_block_array.clear();
     HandleOutputOffset(output_row_cnt, offset_, output_data_block_array);
@@ -35,6 +35,7 @@ import physical_limit;
 import internal_types;
 import select_statement;
 import data_type;
+import sort_key_encoder;
 
 namespace infinity {
 
@@ -122,6 +123,7 @@ private:
     Vector<OrderType> order_by_types_;                   // ASC or DESC
     Vector<SharedPtr<BaseExpression>> sort_expressions_; // expressions to sort
     CompareTwoRowAndPreferLeft prefer_left_function_;    // compare function
+    SortKeyEncoder sort_key_encoder_;                    // normalized keys for the heap
     // TODO: save a common threshold value for all tasks
 };
 
@@ -37,6 +37,7 @@ import internal_types;
 import column_def;
 import data_type;
 import segment_entry;
+import sorted_run;
 
 namespace infinity {
 
@@ -60,6 +61,11 @@ export struct OperatorState {
 
     bool complete_{false};
 
+    // blocks ruled out by FastRoughFilter or zone map in the last call, reported by the profiler
+    u64 skipped_block_count_{0};
+    // knn candidates not evaluated in the last call because they are farther than the shared top k distance bound
+    u64 pruned_candidate_count_{0};
+
     inline void SetComplete() { complete_ = true; }
 
     inline bool Complete() const { return complete_; }
@@ -158,6 +164,8 @@ export struct MergeKnnOperatorState : public OperatorState {
 // Filter
 export struct FilterOperatorState : public OperatorState {
     inline explicit FilterOperatorState() : OperatorState(PhysicalOperatorType::kFilter) {}
+
+    SharedPtr<ExpressionState> condition_state_{}; // kept across blocks for the runtime statistics of the condition
 };
 
 // IndexScan
@@ -235,13 +243,17 @@ export struct TopOperatorState : public OperatorState {
 // Projection
 export struct ProjectionOperatorState : public OperatorState {
     inline explicit ProjectionOperatorState() : OperatorState(PhysicalOperatorType::kProjection) {}
+    Vector<SharedPtr<ExpressionState>> expr_states_; // expression states, kept across blocks like the condition state of filter
 };
 
 // Sort
 export struct SortOperatorState : public OperatorState {
     inline explicit SortOperatorState() : OperatorState(PhysicalOperatorType::kSort) {}
     Vector<SharedPtr<ExpressionState>> expr_states_; // expression states
-    Vector<UniquePtr<DataBlock>> unmerge_sorted_blocks_{};
+    Vector<UniquePtr<DataBlock>> buffered_blocks_{}; // input blocks which are not sorted yet
+    SizeT buffered_bytes_{};
+    Vector<UniquePtr<SortedRun>> sorted_runs_{};
+    UniquePtr<SortedRunMerge> merge_{}; // merge which still has output
 };
 
 // Merge Sort
@@ -66,6 +66,7 @@ import physical_project;
 import physical_show;
 import physical_sink;
 import physical_sort;
+import default_values;
 import physical_source;
 import physical_table_scan;
 import physical_index_scan;
@@ -723,6 +724,8 @@ UniquePtr<PhysicalOperator> PhysicalPlanner::BuildSort(const SharedPtr<LogicalNo
                                     std::move(input_physical_operator),
                                     logical_sort->expressions_,
                                     logical_sort->order_by_types_,
+                                    std::numeric_limits<u64>::max(),
+                                    u32{},
                                     logical_operator->load_metas());
 }
 
@@ -795,6 +798,16 @@ UniquePtr<PhysicalOperator> PhysicalPlanner::BuildTop(const SharedPtr<LogicalNod
         Status status = Status::SyntaxError("Limit is too large");
         RecoverableError(status);
     }
+    if (merge_limit > static_cast<i64>(TOP_HEAP_MAX_LIMIT)) {
+        // the heap of a large limit doesn't fit in memory, sort the input with a limit instead
+        return MakeUnique<PhysicalSort>(logical_operator_top->node_id(),
+                                        std::move(input_physical_operator),
+                                        logical_operator_top->sort_expressions_,
+                                        logical_operator_top->order_by_types_,
+                                        merge_limit,
+                                        merge_offset,
+                                        logical_operator_top->load_metas());
+    }
     if (input_physical_operator->TaskletCount() <= 1) {
         // only Top
         return MakeUnique<PhysicalTop>(logical_operator_top->node_id(),
@@ -0,0 +1,244 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <cstring>
+
+module sort_key_encoder;
+
+import stl;
+import column_vector;
+import internal_types;
+import data_type;
+import logical_type;
+import select_statement;
+import infinity_exception;
+
+namespace infinity {
+
+namespace {
+
+SizeT KeyWidth(LogicalType type) {
+    switch (type) {
+        case LogicalType::kBoolean:
+        case LogicalType::kTinyInt:
+            return 1;
+        case LogicalType::kSmallInt:
+            return 2;
+        case LogicalType::kInteger:
+        case LogicalType::kFloat16:
+        case LogicalType::kBFloat16:
+        case LogicalType::kFloat:
+        case LogicalType::kDate:
+        case LogicalType::kTime:
+            return 4;
+        case LogicalType::kBigInt:
+        case LogicalType::kDouble:
+        case LogicalType::kDateTime:
+        case LogicalType::kTimestamp:
+        case LogicalType::kRowID:
+            return 8;
+        case LogicalType::kHugeInt:
+            return 16;
+        case LogicalType::kVarchar:
+            return SortKeyEncoder::kVarcharPrefixSize;
+        default:
+            return 0;
+    }
+}
+
+template <typename T>
+inline void StoreBigEndian(T value, u8 *dst) {
+    for (SizeT i = 0; i < sizeof(T); ++i) {
+        dst[i] = static_cast<u8>(value >> (8 * (sizeof(T) - 1 - i)));
+    }
+}
+
+template <typename T>
+inline void StoreSigned(T value, u8 *dst) {
+    using U = std::make_unsigned_t<T>;
+    StoreBigEndian<U>(static_cast<U>(value) ^ (U(1) << (8 * sizeof(T) - 1)), dst);
+}
+
+inline void StoreFloat(float value, u8 *dst) {
+    if (value == 0) {
+        // -0.0 and 0.0 are equal
+        value = 0;
+    }
+    u32 bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    StoreBigEndian<u32>((bits & 0x80000000u) ? ~bits : (bits | 0x80000000u), dst);
+}
+
+inline void StoreDouble(double value, u8 *dst) {
+    if (value == 0) {
+        value = 0;
+    }
+    u64 bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    StoreBigEndian<u64>((bits & 0x8000000000000000ul) ? ~bits : (bits | 0x8000000000000000ul), dst);
+}
+
+template <typename T, typename Store>
+inline void EncodeValues(const SharedPtr<ColumnVector> &column, SizeT row_count, u8 *keys, SizeT key_size, Store store) {
+    const auto *data = reinterpret_cast<const T *>(column->data());
+    for (SizeT row = 0; row < row_count; ++row, keys += key_size) {
+        store(data[row], keys);
+    }
+}
+
+} // namespace
+
+void SortKeyEncoder::Init(const Vector<DataType> &types, const Vector<OrderType> &order_types) {
+    key_columns_.clear();
+    key_size_ = 0;
+    complete_ = true;
+    for (SizeT i = 0; i < types.size(); ++i) {
+        LogicalType type = types[i].type();
+        SizeT width = KeyWidth(type);
+        if (width == 0) {
+            // not encodable, the rest of the columns are compared by value
+            complete_ = false;
+            break;
+        }
+        key_columns_.push_back({type, order_types[i], key_size_, width});
+        key_size_ += 1 + width;
+        if (type == LogicalType::kVarchar) {
+            complete_ = false;
+            break;
+        }
+    }
+}
+
+void SortKeyEncoder::Encode(const Vector<SharedPtr<ColumnVector>> &columns, SizeT row_count, u8 *keys) const {
+    for (SizeT i = 0; i < key_columns_.size(); ++i) {
+        EncodeColumn(key_columns_[i], columns[i], row_count, keys);
+    }
+}
+
+void SortKeyEncoder::EncodeColumn(const KeyColumn &key_column, const SharedPtr<ColumnVector> &column, SizeT row_count, u8 *keys) const {
+    u8 *begin = keys + key_column.offset_;
+    u8 *values = begin + 1;
+    const bool all_valid = column->nulls_ptr_->IsAllTrue();
+    switch (key_column.type_) {
+        case LogicalType::kBoolean: {
+            ColumnValueReader<BooleanT> reader(column);
+            for (SizeT row = 0; row < row_count; ++row) {
+                values[row * key_size_] = reader.SetIndex(row).GetValue();
+            }
+            break;
+        }
+        case LogicalType::kTinyInt: {
+            EncodeValues<TinyIntT>(column, row_count, values, key_size_, StoreSigned<TinyIntT>);
+            break;
+        }
+        case LogicalType::kSmallInt: {
+            EncodeValues<SmallIntT>(column, row_count, values, key_size_, StoreSigned<SmallIntT>);
+            break;
+        }
+        case LogicalType::kInteger: {
+            EncodeValues<IntegerT>(column, row_count, values, key_size_, StoreSigned<IntegerT>);
+            break;
+        }
+        case LogicalType::kBigInt: {
+            EncodeValues<BigIntT>(column, row_count, values, key_size_, StoreSigned<BigIntT>);
+            break;
+        }
+        case LogicalType::kHugeInt: {
+            EncodeValues<HugeIntT>(column, row_count, values, key_size_, [](const HugeIntT &value, u8 *dst) {
+                StoreSigned<i64>(value.upper, dst);
+                StoreSigned<i64>(value.lower, dst + sizeof(i64));
+            });
+            break;
+        }
+        case LogicalType::kFloat16: {
+            EncodeValues<Float16T>(column, row_count, values, key_size_, [](const Float16T &value, u8 *dst) { StoreFloat(value.f(), dst); });
+            break;
+        }
+        case LogicalType::kBFloat16: {
+            EncodeValues<BFloat16T>(column, row_count, values, key_size_, [](const BFloat16T &value, u8 *dst) { StoreFloat(value.f(), dst); });
+            break;
+        }
+        case LogicalType::kFloat: {
+            EncodeValues<FloatT>(column, row_count, values, key_size_, StoreFloat);
+            break;
+        }
+        case LogicalType::kDouble: {
+            EncodeValues<DoubleT>(column, row_count, values, key_size_, StoreDouble);
+            break;
+        }
+        case LogicalType::kDate: {
+            EncodeValues<DateT>(column, row_count, values, key_size_, [](const DateT &value, u8 *dst) { StoreSigned<i32>(value.GetValue(), dst); });
+            break;
+        }
+        case LogicalType::kTime: {
+            EncodeValues<TimeT>(column, row_count, values, key_size_, [](const TimeT &value, u8 *dst) { StoreSigned<i32>(value.GetValue(), dst); });
+            break;
+        }
+        case LogicalType::kDateTime: {
+            EncodeValues<DateTimeT>(column, row_count, values, key_size_, [](const DateTimeT &value, u8 *dst) {
+                StoreSigned<i32>(value.date.GetValue(), dst);
+                StoreSigned<i32>(value.time.GetValue(), dst + sizeof(i32));
+            });
+            break;
+        }
+        case LogicalType::kTimestamp: {
+            EncodeValues<TimestampT>(column, row_count, values, key_size_, [](const TimestampT &value, u8 *dst) {
+                StoreSigned<i32>(value.date.GetValue(), dst);
+                StoreSigned<i32>(value.time.GetValue(), dst + sizeof(i32));
+            });
+            break;
+        }
+        case LogicalType::kRowID: {
+            EncodeValues<RowID>(column, row_count, values, key_size_, [](const RowID &value, u8 *dst) {
+                StoreBigEndian<u64>(value.ToUint64(), dst);
+            });
+            break;
+        }
+        case LogicalType::kVarchar: {
+            for (SizeT row = 0; row < row_count; ++row) {
+                if (!all_valid && !column->nulls_ptr_->IsTrue(row)) {
+                    continue;
+                }
+                Span<const char> value = column->GetVarchar(row);
+                u8 *dst = values + row * key_size_;
+                SizeT len = std::min(value.size(), kVarcharPrefixSize);
+                std::memcpy(dst, value.data(), len);
+                std::memset(dst + len, 0, kVarcharPrefixSize - len);
+            }
+            break;
+        }
+        default: {
+            String error_message = "Unexpected sort key type";
+            UnrecoverableError(error_message);
+        }
+    }
+
+    for (SizeT row = 0; row < row_count; ++row) {
+        u8 *dst = begin + row * key_size_;
+        if (all_valid || column->nulls_ptr_->IsTrue(row)) {
+            dst[0] = 1;
+        } else {
+            std::memset(dst, 0, 1 + key_column.width_);
+        }
+        if (key_column.order_type_ == OrderType::kDesc) {
+            for (SizeT i = 0; i <= key_column.width_; ++i) {
+                dst[i] = ~dst[i];
+            }
+        }
+    }
+}
+
+} // namespace infinity
@@ -0,0 +1,127 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <cstring>
+
+export module sort_key_encoder;
+
+import stl;
+import column_vector;
+import internal_types;
+import data_type;
+import logical_type;
+import select_statement;
+import radix_sort;
+
+namespace infinity {
+
+// Encodes the ORDER BY keys of a row into a fixed width byte string, so that memcmp on two encoded rows gives their order.
+// Every key column is a validity byte followed by the big endian value with its sign bit flipped, DESC columns are inverted.
+// NULL is the smallest value: first in ASC and last in DESC.
+// VARCHAR only keeps a prefix, so the key ends after the first VARCHAR column and equal keys have to be compared by value.
+export class SortKeyEncoder {
+public:
+    static constexpr SizeT kVarcharPrefixSize = 16;
+
+    void Init(const Vector<DataType> &types, const Vector<OrderType> &order_types);
+
+    // Writes the keys of the first row_count rows to keys, key_size_ bytes per row.
+    void Encode(const Vector<SharedPtr<ColumnVector>> &columns, SizeT row_count, u8 *keys) const;
+
+    [[nodiscard]] inline SizeT key_size() const { return key_size_; }
+
+    // Whether equal keys mean equal rows.
+    [[nodiscard]] inline bool complete() const { return complete_; }
+
+    [[nodiscard]] inline int Compare(const u8 *left, const u8 *right) const { return std::memcmp(left, right, key_size_); }
+
+    // The first 8 bytes of a key as an integer with the same order, for radix sorting.
+    [[nodiscard]] inline u64 Prefix(const u8 *key) const {
+        u64 prefix = 0;
+        std::memcpy(&prefix, key, std::min(key_size_, sizeof(u64)));
+        return __builtin_bswap64(prefix);
+    }
+
+    [[nodiscard]] inline int CompareAfterPrefix(const u8 *left, const u8 *right) const {
+        if (key_size_ <= sizeof(u64)) {
+            return 0;
+        }
+        return std::memcmp(left + sizeof(u64), right + sizeof(u64), key_size_ - sizeof(u64));
+    }
+
+private:
+    struct KeyColumn {
+        LogicalType type_{LogicalType::kInvalid};
+        OrderType order_type_{OrderType::kAsc};
+        SizeT offset_{};
+        SizeT width_{};
+    };
+
+    void EncodeColumn(const KeyColumn &key_column, const SharedPtr<ColumnVector> &column, SizeT row_count, u8 *keys) const;
+
+    Vector<KeyColumn> key_columns_{};
+    SizeT key_size_{};
+    bool complete_{true};
+};
+
+struct SortKeyEntry {
+    u64 prefix_;
+    u32 row_;
+};
+
+struct SortKeyEntryRadix {
+    u64 operator()(const SortKeyEntry &entry) const { return entry.prefix_; }
+};
+
+// Returns the rows [0, row_count) in sorted order, keys being the encoded rows.
+// tie_less(left_row, right_row) orders rows with equal keys when the encoding is not complete. Equal rows keep their input order.
+export template <typename TieLess>
+Vector<u32> SortEncodedRows(const SortKeyEncoder &encoder, const u8 *keys, u32 row_count, TieLess &&tie_less) {
+    const SizeT key_size = encoder.key_size();
+    Vector<SortKeyEntry> entries(row_count);
+    for (u32 row = 0; row < row_count; ++row) {
+        entries[row] = {encoder.Prefix(keys + row * key_size), row};
+    }
+    auto entry_less = [&](const SortKeyEntry &left, const SortKeyEntry &right) -> bool {
+        if (left.prefix_ != right.prefix_) {
+            return left.prefix_ < right.prefix_;
+        }
+        if (int cmp = encoder.CompareAfterPrefix(keys + left.row_ * key_size, keys + right.row_ * key_size); cmp != 0) {
+            return cmp < 0;
+        }
+        if (!encoder.complete()) {
+            if (tie_less(left.row_, right.row_)) {
+                return true;
+            }
+            if (tie_less(right.row_, left.row_)) {
+                return false;
+            }
+        }
+        return left.row_ < right.row_;
+    };
+    ShiftBasedRadixSorter<SortKeyEntry, SortKeyEntryRadix, decltype(entry_less), 56, true>::RadixSort(SortKeyEntryRadix(),
+                                                                                                      entry_less,
+                                                                                                      entries.data(),
+                                                                                                      entries.size(),
+                                                                                                      16);
+    Vector<u32> rows(row_count);
+    for (u32 i = 0; i < row_count; ++i) {
+        rows[i] = entries[i].row_;
+    }
+    return rows;
+}
+
+} // namespace infinity
@@ -0,0 +1,171 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <cstring>
+
+module sorted_run;
+
+import stl;
+import data_block;
+import local_file_handle;
+import virtual_store;
+import status;
+import infinity_exception;
+import third_party;
+import logger;
+import serialize;
+
+namespace infinity {
+
+namespace {
+
+atomic_u64 next_spill_file_id{0};
+
+void ReadExact(LocalFileHandle &file, void *buffer, SizeT nbytes) {
+    auto [read_n, status] = file.Read(buffer, nbytes);
+    if (!status.ok()) {
+        RecoverableError(status);
+    }
+    if (read_n != nbytes) {
+        String error_message = fmt::format("Sort spill file {} is truncated", file.Path());
+        UnrecoverableError(error_message);
+    }
+}
+
+} // namespace
+
+SortedRun::SortedRun(Vector<UniquePtr<DataBlock>> blocks, Vector<u8> keys, SizeT key_size)
+    : blocks_(std::move(blocks)), keys_(std::move(keys)), key_size_(key_size) {
+    memory_usage_ = keys_.size();
+    for (const auto &block : blocks_) {
+        row_count_ += block->row_count();
+        memory_usage_ += block->GetSizeInBytes();
+    }
+}
+
+SortedRun::SortedRun(const String &temp_dir, SizeT key_size) : key_size_(key_size) { CreateSpillFile(temp_dir); }
+
+SortedRun::~SortedRun() {
+    if (spilled()) {
+        spill_file_.reset();
+        Status status = VirtualStore::DeleteFile(spill_path_);
+        if (!status.ok()) {
+            LOG_WARN(fmt::format("Failed to remove sort spill file {}: {}", spill_path_, status.message()));
+        }
+    }
+}
+
+// File layout, for each block: row count (u32), serialized size (i32), serialized block, keys of its rows
+void SortedRun::Spill(const String &temp_dir) {
+    if (spilled()) {
+        return;
+    }
+    CreateSpillFile(temp_dir);
+    SizeT key_offset = 0;
+    for (const auto &block : blocks_) {
+        WriteBlock(*block, keys_.data() + key_offset);
+        key_offset += block->row_count() * key_size_;
+    }
+    spill_file_->Seek(0);
+    LOG_DEBUG(fmt::format("Spilled {} sorted rows, {} bytes to {}", row_count_, memory_usage_, spill_path_));
+
+    blocks_.clear();
+    keys_.clear();
+    keys_.shrink_to_fit();
+    write_buffer_ = Vector<char>();
+    memory_usage_ = 0;
+}
+
+void SortedRun::Append(const DataBlock &block, const u8 *keys) {
+    WriteBlock(block, keys);
+    row_count_ += block.row_count();
+}
+
+void SortedRun::FinishAppend() {
+    spill_file_->Seek(0);
+    write_buffer_ = Vector<char>();
+    LOG_DEBUG(fmt::format("Merged {} sorted rows to {}", row_count_, spill_path_));
+}
+
+void SortedRun::CreateSpillFile(const String &temp_dir) {
+    if (!VirtualStore::Exists(temp_dir)) {
+        VirtualStore::MakeDirectory(temp_dir);
+    }
+    String spill_path = VirtualStore::ConcatenatePath(temp_dir, fmt::format("sort_run_{}", next_spill_file_id.fetch_add(1)));
+    auto [spill_file, status] = VirtualStore::Open(spill_path, FileAccessMode::kWrite);
+    if (!status.ok()) {
+        RecoverableError(status);
+    }
+    spill_path_ = std::move(spill_path);
+    spill_file_ = std::move(spill_file);
+}
+
+void SortedRun::WriteBlock(const DataBlock &block, const u8 *keys) {
+    const u32 block_row_count = block.row_count();
+    const i32 block_size = block.GetSizeInBytes();
+    const SizeT keys_size = block_row_count * key_size_;
+    write_buffer_.resize(sizeof(u32) + sizeof(i32) + block_size + keys_size);
+    char *ptr = write_buffer_.data();
+    WriteBufAdv<u32>(ptr, block_row_count);
+    WriteBufAdv<i32>(ptr, block_size);
+    block.WriteAdv(ptr);
+    std::memcpy(ptr, keys, keys_size);
+    Status status = spill_file_->Append(write_buffer_.data(), write_buffer_.size());
+    if (!status.ok()) {
+        RecoverableError(status);
+    }
+}
+
+bool SortedRun::NextBlock(UniquePtr<DataBlock> &block, Vector<u8> &keys) {
+    if (next_row_ == row_count_) {
+        return false;
+    }
+    if (!spilled()) {
+        block = std::move(blocks_[next_block_++]);
+        const SizeT key_offset = next_row_ * key_size_;
+        keys.assign(keys_.begin() + key_offset, keys_.begin() + key_offset + block->row_count() * key_size_);
+        next_row_ += block->row_count();
+        return true;
+    }
+
+    u32 block_row_count = 0;
+    i32 block_size = 0;
+    ReadExact(*spill_file_, &block_row_count, sizeof(block_row_count));
+    ReadExact(*spill_file_, &block_size, sizeof(block_size));
+    Vector<char> buffer(block_size);
+    ReadExact(*spill_file_, buffer.data(), block_size);
+    const char *ptr = buffer.data();
+    SharedPtr<DataBlock> read_block = DataBlock::ReadAdv(ptr, block_size);
+    block = DataBlock::MakeUniquePtr();
+    block->Init(read_block->column_vectors);
+    block->Finalize();
+    keys.resize(block_row_count * key_size_);
+    ReadExact(*spill_file_, keys.data(), keys.size());
+    next_row_ += block_row_count;
+    return true;
+}
+
+Vector<UniquePtr<DataBlock>> SortedRun::TakeBlocks() {
+    if (spilled()) {
+        String error_message = "Can't take the blocks of a spilled sort run";
+        UnrecoverableError(error_message);
+    }
+    next_row_ = row_count_;
+    memory_usage_ = 0;
+    return std::move(blocks_);
+}
+
+} // namespace infinity
@@ -0,0 +1,83 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module sorted_run;
+
+import stl;
+import data_block;
+import local_file_handle;
+
+namespace infinity {
+
+// Rows in sorted order with their normalized sort keys, in blocks that are all full except the last one.
+// A run can be spilled to a temporary file, it is then read back one block at a time.
+export class SortedRun {
+public:
+    SortedRun(Vector<UniquePtr<DataBlock>> blocks, Vector<u8> keys, SizeT key_size);
+
+    // An empty run which is written to a new file in temp_dir with Append, e.g. the output of a merge pass.
+    SortedRun(const String &temp_dir, SizeT key_size);
+
+    ~SortedRun();
+
+    [[nodiscard]] inline u32 row_count() const { return row_count_; }
+
+    [[nodiscard]] inline bool spilled() const { return !spill_path_.empty(); }
+
+    // Bytes held in memory by the blocks and the keys
+    [[nodiscard]] inline SizeT memory_usage() const { return memory_usage_; }
+
+    // Writes the run to a new file in temp_dir and frees its memory.
+    void Spill(const String &temp_dir);
+
+    // Writes a block and the keys of its rows to the file of a run made by the constructor above.
+    void Append(const DataBlock &block, const u8 *keys);
+
+    // Ends the writes, the run can be read after this.
+    void FinishAppend();
+
+    // Moves out the next block and its keys. Returns false after the last block.
+    bool NextBlock(UniquePtr<DataBlock> &block, Vector<u8> &keys);
+
+    // Moves out all the blocks of a run which is not spilled.
+    Vector<UniquePtr<DataBlock>> TakeBlocks();
+
+private:
+    void CreateSpillFile(const String &temp_dir);
+
+    void WriteBlock(const DataBlock &block, const u8 *keys);
+
+    Vector<UniquePtr<DataBlock>> blocks_{};
+    Vector<u8> keys_{};
+    SizeT key_size_{};
+    u32 row_count_{};
+    SizeT memory_usage_{};
+
+    SizeT next_block_{};
+    SizeT next_row_{};
+
+    String spill_path_{};
+    UniquePtr<LocalFileHandle> spill_file_{};
+    Vector<char> write_buffer_{};
+};
+
+// A merge of sorted runs which is in progress, the sort operator outputs it over several executions.
+export class SortedRunMerge {
+public:
+    virtual ~SortedRunMerge() = default;
+};
+
+} // namespace infinity
@@ -51,6 +51,7 @@ String KnnExpression::KnnDistanceType2Str(KnnDistanceType type) {
 
 KnnExpression::KnnExpression(EmbeddingDataType embedding_data_type,
                              i64 dimension,
+                             i64 query_embedding_count,
                              KnnDistanceType knn_distance_type,
                              EmbeddingT query_embedding,
                              Vector<SharedPtr<BaseExpression>> arguments,
@@ -59,8 +60,8 @@ KnnExpression::KnnExpression(EmbeddingDataType embedding_data_type,
                              SharedPtr<BaseExpression> optional_filter,
                              String using_index,
                              bool ignore_index)
-    : BaseExpression(ExpressionType::kKnn, std::move(arguments)), dimension_(dimension), embedding_data_type_(embedding_data_type),
-      distance_type_(knn_distance_type), query_embedding_(std::move(query_embedding)),
+    : BaseExpression(ExpressionType::kKnn, std::move(arguments)), dimension_(dimension), query_embedding_count_(query_embedding_count),
+      embedding_data_type_(embedding_data_type), distance_type_(knn_distance_type), query_embedding_(std::move(query_embedding)),
       topn_(topn), // Should call move constructor, otherwise there will be memory leak.
       using_index_(std::move(using_index)), ignore_index_(ignore_index), optional_filter_(std::move(optional_filter)) {
     if (opt_params) {
@@ -77,7 +78,7 @@ String KnnExpression::ToString() const {
 
     String expr_str = fmt::format("MATCH VECTOR ({}, {}, {}, {}, {}{})",
                                   arguments_.at(0)->Name(),
-                                  EmbeddingT::Embedding2String(query_embedding_, embedding_data_type_, dimension_),
+                                  EmbeddingT::Embedding2String(query_embedding_, embedding_data_type_, dimension_ * query_embedding_count_),
                                   EmbeddingT::EmbeddingDataType2String(embedding_data_type_),
                                   KnnDistanceType2Str(distance_type_),
                                   topn_,
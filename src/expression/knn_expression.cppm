@@ -33,6 +33,7 @@ public:
 public:
     KnnExpression(EmbeddingDataType embedding_data_type,
                   i64 dimension,
+                  i64 query_embedding_count,
                   KnnDistanceType knn_distance_type,
                   EmbeddingT query_embedding,
                   Vector<SharedPtr<BaseExpression>> arguments,
@@ -62,6 +63,8 @@ public:
 
 public:
     const i64 dimension_{0};
+    // query embeddings of dimension_ stored one after another in query_embedding_
+    const i64 query_embedding_count_{1};
     const EmbeddingDataType embedding_data_type_{EmbeddingDataType::kElemInvalid};
     const KnnDistanceType distance_type_{KnnDistanceType::kInvalid};
     const EmbeddingT query_embedding_;
@@ -107,6 +107,7 @@ void BuiltinFunctions::RegisterScalarFunction() {
     // like function
     RegisterLikeFunction(catalog_ptr_);
     RegisterNotLikeFunction(catalog_ptr_);
+    RegisterRegexpMatchFunction(catalog_ptr_);
 
     // extract function
     RegisterExtractFunction(catalog_ptr_);
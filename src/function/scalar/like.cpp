@@ -14,6 +14,9 @@
 
 module;
 
+#include <cstring>
+#include <re2/re2.h>
+
 module like;
 
 import stl;
@@ -24,6 +27,10 @@ import scalar_function;
 import scalar_function_set;
 
 import third_party;
+import column_vector;
+import data_block;
+import binary_operator;
+import roaring_bitmap;
 import internal_types;
 import data_type;
 import logger;
@@ -31,120 +38,334 @@ import status;
 
 namespace infinity {
 
-bool LikeOperator(const ptr_t left_ptr, SizeT left_len, const ptr_t right_ptr, SizeT right_len) {
-    SizeT left_idx{0}, right_idx{0};
-
-    while (right_idx < right_len) {
-        char left_char = left_ptr[left_idx];
-        char right_char = right_ptr[right_idx];
-        if (right_char == '_' or (left_char == right_char)) {
-            ++left_idx;
-            ++right_idx;
-        } else if (right_char == '%') {
-            ++right_idx;
-
-            // If there are more than one %
-            while (right_idx < right_len && right_ptr[right_idx] == '%') {
-                ++right_idx;
-            }
+namespace {
 
-            // % is the last character
-            if (right_idx == right_len) {
-                return true;
-            }
+constexpr char kLikeEscape = '\\';
+
+inline SizeT Utf8CharLength(char lead) {
+    const u8 c = static_cast<u8>(lead);
+    if (c < 0x80) {
+        return 1;
+    }
+    if ((c >> 5) == 0x6) {
+        return 2;
+    }
+    if ((c >> 4) == 0xE) {
+        return 3;
+    }
+    if ((c >> 3) == 0x1E) {
+        return 4;
+    }
+    // invalid lead byte, treated as a single byte character
+    return 1;
+}
+
+inline void ToLowerAscii(std::string_view str, String &out) {
+    out.resize(str.size());
+    for (SizeT i = 0; i < str.size(); ++i) {
+        char c = str[i];
+        out[i] = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+}
+
+} // namespace
+
+LikeMatcher::LikeMatcher(std::string_view pattern, bool case_insensitive) : case_insensitive_(case_insensitive) {
+    String lowered;
+    if (case_insensitive_) {
+        ToLowerAscii(pattern, lowered);
+        pattern = lowered;
+    }
 
-            // Check any left part is matched with rest of right part.
-            while (left_idx < left_len) {
-                if (LikeOperator(&left_ptr[left_idx], left_len - left_idx, &right_ptr[right_idx], right_len - right_idx)) {
-                    return true;
-                }
-                ++left_idx;
+    // Split the pattern on '%' into segments
+    Segment segment;
+    bool last_is_percent = false;
+    for (SizeT i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        if (c == '%') {
+            if (i == 0) {
+                leading_percent_ = true;
+            } else if (!last_is_percent) {
+                segments_.push_back(std::move(segment));
+                segment = Segment();
             }
+            last_is_percent = true;
+            continue;
+        }
+        last_is_percent = false;
+        bool any_char = false;
+        if (c == kLikeEscape && i + 1 < pattern.size()) {
+            c = pattern[++i];
+        } else if (c == '_') {
+            any_char = true;
+            segment.has_any_char_ = true;
+        }
+        segment.text_.push_back(c);
+        segment.any_char_.push_back(any_char);
+    }
+    trailing_percent_ = last_is_percent;
+    if (!last_is_percent) {
+        segments_.push_back(std::move(segment));
+    }
 
-            // Not matched
-            return false;
+    kind_ = Kind::kGeneric;
+    if (segments_.size() == 1 && !segments_[0].has_any_char_) {
+        if (!leading_percent_ && !trailing_percent_) {
+            kind_ = Kind::kExact;
+        } else if (!leading_percent_) {
+            kind_ = Kind::kPrefix;
+        } else if (!trailing_percent_) {
+            kind_ = Kind::kSuffix;
         } else {
-            return false;
+            kind_ = Kind::kContains;
         }
     }
+}
 
-    while (right_idx < right_len && right_ptr[right_idx] == '%') {
-        ++right_idx;
+bool LikeMatcher::Match(std::string_view str) const {
+    if (case_insensitive_) {
+        ToLowerAscii(str, lower_buffer_);
+        str = lower_buffer_;
     }
-
-    return left_idx == left_len && right_idx == right_len;
+    switch (kind_) {
+        case Kind::kExact: {
+            return str == segments_[0].text_;
+        }
+        case Kind::kPrefix: {
+            const String &prefix = segments_[0].text_;
+            return str.size() >= prefix.size() && std::memcmp(str.data(), prefix.data(), prefix.size()) == 0;
+        }
+        case Kind::kSuffix: {
+            const String &suffix = segments_[0].text_;
+            return str.size() >= suffix.size() && std::memcmp(str.data() + str.size() - suffix.size(), suffix.data(), suffix.size()) == 0;
+        }
+        case Kind::kContains: {
+            const String &needle = segments_[0].text_;
+            return needle.empty() || ::memmem(str.data(), str.size(), needle.data(), needle.size()) != nullptr;
+        }
+        case Kind::kGeneric: {
+            return MatchGeneric(str);
+        }
+    }
+    return false;
 }
 
-struct LikeFunction {
-    template <typename TA, typename TB, typename TC>
-    static inline void Run(TA, TB, TC &) {
-        Status status = Status::NotSupport("Not support: Like function");
-        RecoverableError(status);
+// Returns the end of the segment matched at pos, or npos
+SizeT LikeMatcher::MatchAt(const Segment &segment, std::string_view str, SizeT pos) {
+    for (SizeT i = 0; i < segment.text_.size(); ++i) {
+        if (pos >= str.size()) {
+            return String::npos;
+        }
+        if (segment.any_char_[i]) {
+            pos += Utf8CharLength(str[pos]);
+        } else if (str[pos] == segment.text_[i]) {
+            ++pos;
+        } else {
+            return String::npos;
+        }
     }
-};
+    return pos <= str.size() ? pos : String::npos;
+}
 
-template <>
-inline void LikeFunction::Run(VarcharT &, VarcharT &, bool &) {
-    String error_message = "Not implement";
-    UnrecoverableError(error_message);
+// Leftmost match of the segment starting at or after from, as [begin, end)
+Pair<SizeT, SizeT> LikeMatcher::Find(const Segment &segment, std::string_view str, SizeT from) {
+    if (!segment.has_any_char_) {
+        const SizeT len = segment.text_.size();
+        if (len == 0) {
+            return {from, from};
+        }
+        if (from + len > str.size()) {
+            return {String::npos, String::npos};
+        }
+        const void *found = ::memmem(str.data() + from, str.size() - from, segment.text_.data(), len);
+        if (found == nullptr) {
+            return {String::npos, String::npos};
+        }
+        SizeT begin = static_cast<const char *>(found) - str.data();
+        return {begin, begin + len};
+    }
+    for (SizeT begin = from; begin < str.size(); begin += Utf8CharLength(str[begin])) {
+        if (SizeT end = MatchAt(segment, str, begin); end != String::npos) {
+            return {begin, end};
+        }
+    }
+    return {String::npos, String::npos};
+}
 
-//    ptr_t left_ptr = left.GetDataPtr();
-//    SizeT left_len = left.GetDataLen();
-//    ptr_t right_ptr = right.GetDataPtr();
-//    SizeT right_len = right.GetDataLen();
+bool LikeMatcher::MatchGeneric(std::string_view str) const {
+    SizeT first = 0;
+    SizeT last = segments_.size();
+    SizeT pos = 0;
+    if (!leading_percent_) {
+        // the first segment is anchored at the start
+        pos = MatchAt(segments_[0], str, 0);
+        if (pos == String::npos) {
+            return false;
+        }
+        if (segments_.size() == 1 && !trailing_percent_) {
+            return pos == str.size();
+        }
+        first = 1;
+    }
+    if (!trailing_percent_ && last > first) {
+        --last;
+    }
+    // the segments between two '%' take their leftmost match
+    for (SizeT i = first; i < last; ++i) {
+        auto [begin, end] = Find(segments_[i], str, pos);
+        if (begin == String::npos) {
+            return false;
+        }
+        pos = end;
+    }
+    if (trailing_percent_ || last == segments_.size()) {
+        return true;
+    }
+    // the last segment is anchored at the end
+    const Segment &segment = segments_[last];
+    if (!segment.has_any_char_) {
+        return str.size() >= pos + segment.text_.size() &&
+               std::memcmp(str.data() + str.size() - segment.text_.size(), segment.text_.data(), segment.text_.size()) == 0;
+    }
+    for (SizeT begin = pos; begin < str.size(); begin += Utf8CharLength(str[begin])) {
+        if (MatchAt(segment, str, begin) == str.size()) {
+            return true;
+        }
+    }
+    return false;
+}
 
-//    result = LikeOperator(left_ptr, left_len, right_ptr, right_len);
+String LikeLiteralPrefix(std::string_view pattern, bool &exact) {
+    String prefix;
+    for (SizeT i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        if (c == '%' || c == '_') {
+            exact = false;
+            return prefix;
+        }
+        if (c == kLikeEscape && i + 1 < pattern.size()) {
+            c = pattern[++i];
+        }
+        prefix.push_back(c);
+    }
+    exact = true;
+    return prefix;
 }
 
-struct NotLikeFunction {
-    template <typename TA, typename TB, typename TC>
-    static inline void Run(TA, TB, TC &) {
-        String error_message = "Not implement";
-        UnrecoverableError(error_message);
+namespace {
 
+struct ILikeMatcher : public LikeMatcher {
+    explicit ILikeMatcher(std::string_view pattern) : LikeMatcher(pattern, true) {}
+};
+
+struct CaseSensitiveLikeMatcher : public LikeMatcher {
+    explicit CaseSensitiveLikeMatcher(std::string_view pattern) : LikeMatcher(pattern, false) {}
+};
+
+class RegexpMatcher {
+public:
+    explicit RegexpMatcher(std::string_view pattern) : regex_(re2::StringPiece(pattern.data(), pattern.size()), RE2::Quiet) {
+        if (!regex_.ok()) {
+            Status status = Status::SyntaxError(fmt::format("Invalid regular expression {}: {}", pattern, regex_.error()));
+            RecoverableError(status);
+        }
     }
+
+    bool Match(std::string_view str) const { return RE2::PartialMatch(re2::StringPiece(str.data(), str.size()), regex_); }
+
+private:
+    RE2 regex_;
 };
 
-template <>
-inline void NotLikeFunction::Run(VarcharT &, VarcharT &, bool &) {
-    String error_message = "Not implement";
-    UnrecoverableError(error_message);
+// state_ptr is the matcher compiled from a constant pattern, otherwise the pattern of each row is compiled
+template <typename Matcher, bool negate>
+struct PatternMatchOperator {
+    template <typename TA, typename TB, typename TC>
+    static inline void Execute(TA &left, TB &right, TC &result, Bitmask *, SizeT, void *state_ptr) {
+        Span<const char> str = left.GetValue();
+        std::string_view str_view(str.data(), str.size());
+        bool matched = false;
+        if (state_ptr != nullptr) {
+            matched = static_cast<const Matcher *>(state_ptr)->Match(str_view);
+        } else {
+            Span<const char> pattern = right.GetValue();
+            matched = Matcher(std::string_view(pattern.data(), pattern.size())).Match(str_view);
+        }
+        result.SetValue(matched != negate);
+    }
+};
 
+// The matcher compiled from the constant pattern of the last block, kept in the expression state
+template <typename Matcher>
+struct CompiledPattern {
+    explicit CompiledPattern(String pattern) : pattern_(std::move(pattern)), matcher_(pattern_) {}
 
-//    ptr_t left_ptr = left.GetDataPtr();
-//    SizeT left_len = left.GetDataLen();
-//    ptr_t right_ptr = right.GetDataPtr();
-//    SizeT right_len = right.GetDataLen();
+    String pattern_;
+    Matcher matcher_;
+};
 
-//    result = !LikeOperator(left_ptr, left_len, right_ptr, right_len);
+template <typename Matcher, bool negate>
+void PatternMatchFunctionWithState(const DataBlock &input, SharedPtr<ColumnVector> &output, SharedPtr<void> &state) {
+    if (input.column_count() != 2) {
+        String error_message = "Pattern match function: input column count isn't two.";
+        UnrecoverableError(error_message);
+    }
+    const SharedPtr<ColumnVector> &pattern_column = input.column_vectors[1];
+    // Compile a constant pattern once, the following blocks reuse it while the pattern stays the same
+    const Matcher *matcher = nullptr;
+    if (pattern_column->vector_type() == ColumnVectorType::kConstant && pattern_column->nulls_ptr_->IsAllTrue()) {
+        Span<const char> span = pattern_column->GetVarchar(0);
+        std::string_view pattern(span.data(), span.size());
+        auto *compiled = static_cast<CompiledPattern<Matcher> *>(state.get());
+        if (compiled == nullptr || compiled->pattern_ != pattern) {
+            auto new_compiled = MakeShared<CompiledPattern<Matcher>>(String(pattern));
+            compiled = new_compiled.get();
+            state = std::move(new_compiled);
+        }
+        matcher = &compiled->matcher_;
+    }
+    BinaryOperator::Execute<VarcharT, VarcharT, BooleanT, PatternMatchOperator<Matcher, negate>>(input.column_vectors[0],
+                                                                                                 pattern_column,
+                                                                                                 output,
+                                                                                                 input.row_count(),
+                                                                                                 const_cast<Matcher *>(matcher),
+                                                                                                 true);
 }
 
-void RegisterLikeFunction(const UniquePtr<Catalog> &catalog_ptr) {
-    String func_name = "like";
+template <typename Matcher, bool negate>
+void PatternMatchFunction(const DataBlock &input, SharedPtr<ColumnVector> &output) {
+    SharedPtr<void> state;
+    PatternMatchFunctionWithState<Matcher, negate>(input, output, state);
+}
 
+template <typename Matcher, bool negate>
+void AddPatternMatchFunction(const UniquePtr<Catalog> &catalog_ptr, const String &func_name) {
     SharedPtr<ScalarFunctionSet> function_set_ptr = MakeShared<ScalarFunctionSet>(func_name);
 
-    ScalarFunction varchar_like_function(func_name,
-                                         {DataType(LogicalType::kVarchar), DataType(LogicalType::kVarchar)},
-                                         DataType(LogicalType::kBoolean),
-                                         &ScalarFunction::BinaryFunction<VarcharT, VarcharT, BooleanT, LikeFunction>);
-    function_set_ptr->AddFunction(varchar_like_function);
+    ScalarFunction varchar_function(func_name,
+                                    {DataType(LogicalType::kVarchar), DataType(LogicalType::kVarchar)},
+                                    DataType(LogicalType::kBoolean),
+                                    &PatternMatchFunction<Matcher, negate>,
+                                    &PatternMatchFunctionWithState<Matcher, negate>);
+    function_set_ptr->AddFunction(varchar_function);
 
     Catalog::AddFunctionSet(catalog_ptr.get(), function_set_ptr);
 }
 
-void RegisterNotLikeFunction(const UniquePtr<Catalog> &catalog_ptr) {
-    String func_name = "not_like";
+} // namespace
 
-    SharedPtr<ScalarFunctionSet> function_set_ptr = MakeShared<ScalarFunctionSet>(func_name);
+void RegisterLikeFunction(const UniquePtr<Catalog> &catalog_ptr) {
+    AddPatternMatchFunction<CaseSensitiveLikeMatcher, false>(catalog_ptr, "like");
+    AddPatternMatchFunction<ILikeMatcher, false>(catalog_ptr, "ilike");
+}
 
-    ScalarFunction varchar_not_like_function(func_name,
-                                             {DataType(LogicalType::kVarchar), DataType(LogicalType::kVarchar)},
-                                             DataType(LogicalType::kBoolean),
-                                             &ScalarFunction::BinaryFunction<VarcharT, VarcharT, BooleanT, NotLikeFunction>);
-    function_set_ptr->AddFunction(varchar_not_like_function);
+void RegisterNotLikeFunction(const UniquePtr<Catalog> &catalog_ptr) {
+    AddPatternMatchFunction<CaseSensitiveLikeMatcher, true>(catalog_ptr, "not_like");
+    AddPatternMatchFunction<ILikeMatcher, true>(catalog_ptr, "not_ilike");
+}
 
-    Catalog::AddFunctionSet(catalog_ptr.get(), function_set_ptr);
+void RegisterRegexpMatchFunction(const UniquePtr<Catalog> &catalog_ptr) {
+    AddPatternMatchFunction<RegexpMatcher, false>(catalog_ptr, "regexp_match");
 }
 
-} // namespace infinity
\ No newline at end of file
+} // namespace infinity
@@ -14,16 +14,54 @@
 
 module;
 
-import stl;
-
 export module like;
 
+import stl;
+
 namespace infinity {
 
 class Catalog;
 
+// A compiled LIKE pattern: '%' matches any sequence, '_' matches one UTF-8 character and '\' escapes the next character.
+// Patterns made of one literal with '%' on either side are matched with memcmp / memmem.
+export class LikeMatcher {
+public:
+    LikeMatcher(std::string_view pattern, bool case_insensitive);
+
+    // Not thread safe when case insensitive, the lowered input is kept in a buffer of the matcher.
+    bool Match(std::string_view str) const;
+
+private:
+    enum class Kind : u8 { kExact, kPrefix, kSuffix, kContains, kGeneric };
+
+    // Literal between two '%', '_' positions are marked in any_char_
+    struct Segment {
+        String text_{};
+        Vector<bool> any_char_{};
+        bool has_any_char_{false};
+    };
+
+    static SizeT MatchAt(const Segment &segment, std::string_view str, SizeT pos);
+
+    static Pair<SizeT, SizeT> Find(const Segment &segment, std::string_view str, SizeT from);
+
+    bool MatchGeneric(std::string_view str) const;
+
+    Kind kind_{Kind::kGeneric};
+    Vector<Segment> segments_{};
+    bool leading_percent_{false};
+    bool trailing_percent_{false};
+    bool case_insensitive_{false};
+    mutable String lower_buffer_{};
+};
+
+// The literal characters before the first wildcard of a LIKE pattern, exact is set when the pattern has no wildcard.
+export String LikeLiteralPrefix(std::string_view pattern, bool &exact);
+
 export void RegisterLikeFunction(const UniquePtr<Catalog> &catalog_ptr);
 
 export void RegisterNotLikeFunction(const UniquePtr<Catalog> &catalog_ptr);
 
+export void RegisterRegexpMatchFunction(const UniquePtr<Catalog> &catalog_ptr);
+
 } // namespace infinity
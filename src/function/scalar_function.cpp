@@ -34,6 +34,14 @@ ScalarFunction::ScalarFunction(String name, Vector<DataType> argument_types, Dat
     : Function(std::move(name), FunctionType::kScalar), parameter_types_(std::move(argument_types)), return_type_(std::move(return_type)),
       function_(std::move(function)) {}
 
+ScalarFunction::ScalarFunction(String name,
+                               Vector<DataType> argument_types,
+                               DataType return_type,
+                               ScalarFunctionType function,
+                               ScalarFunctionWithStateType state_function)
+    : Function(std::move(name), FunctionType::kScalar), parameter_types_(std::move(argument_types)), return_type_(std::move(return_type)),
+      function_(std::move(function)), state_function_(std::move(state_function)) {}
+
 void ScalarFunction::CastArgumentTypes(Vector<BaseExpression> &input_arguments) {
     // Check and add a cast function to cast the input arguments expression type to target type
     auto arguments_count = input_arguments.size();
@@ -184,10 +184,20 @@ struct TernaryTryOpToVarlenWrapper {
 
 using ScalarFunctionType = std::function<void(const DataBlock &, SharedPtr<ColumnVector> &)>;
 
+// The last argument is kept by the expression state across the blocks it evaluates, e.g. a pattern compiled once
+using ScalarFunctionWithStateType = std::function<void(const DataBlock &, SharedPtr<ColumnVector> &, SharedPtr<void> &)>;
+
 export class ScalarFunction final : public Function {
 public:
     explicit ScalarFunction(String name, Vector<DataType> argument_types, DataType return_type, ScalarFunctionType function);
 
+    // function_ still evaluates a single block without state, the evaluator calls state_function_ when it's set
+    explicit ScalarFunction(String name,
+                            Vector<DataType> argument_types,
+                            DataType return_type,
+                            ScalarFunctionType function,
+                            ScalarFunctionWithStateType state_function);
+
     void CastArgumentTypes(Vector<BaseExpression> &input_arguments);
 
     [[nodiscard]] const DataType &return_type() const { return return_type_; }
@@ -199,6 +209,7 @@ public:
     DataType return_type_;
 
     ScalarFunctionType function_{};
+    ScalarFunctionWithStateType state_function_{};
 
 public:
     // Unary function
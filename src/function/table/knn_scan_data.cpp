@@ -36,6 +36,18 @@ import simd_functions;
 
 namespace infinity {
 
+KnnDistanceBound::KnnDistanceBound(SizeT query_count) : query_count_(query_count), bounds_(MakeUnique<Atomic<f32>[]>(query_count)) {
+    for (SizeT i = 0; i < query_count; ++i) {
+        bounds_[i].store(std::numeric_limits<f32>::max(), std::memory_order_relaxed);
+    }
+}
+
+void KnnDistanceBound::Tighten(SizeT query_id, f32 distance) {
+    f32 old_bound = bounds_[query_id].load(std::memory_order_relaxed);
+    while (distance < old_bound && !bounds_[query_id].compare_exchange_weak(old_bound, distance, std::memory_order_relaxed)) {
+    }
+}
+
 template <>
 KnnDistance1<f32, f32>::KnnDistance1(KnnDistanceType dist_type) {
     switch (dist_type) {
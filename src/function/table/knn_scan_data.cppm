@@ -36,6 +36,26 @@ import internal_types;
 
 namespace infinity {
 
+// k-th best distance of each query found so far by any task of the scan, in the form "smaller is better" (ip and cosine are negated)
+// it only tightens, a candidate farther than the bound cannot enter the final top k
+export class KnnDistanceBound {
+public:
+    explicit KnnDistanceBound(SizeT query_count);
+
+    f32 Get(SizeT query_id) const { return bounds_[query_id].load(std::memory_order_relaxed); }
+
+    // bounds of the queries from query_id on
+    const Atomic<f32> *Data(SizeT query_id) const { return bounds_.get() + query_id; }
+
+    void Tighten(SizeT query_id, f32 distance);
+
+    SizeT QueryCount() const { return query_count_; }
+
+private:
+    SizeT query_count_{};
+    UniquePtr<Atomic<f32>[]> bounds_{};
+};
+
 export class KnnScanSharedData {
 public:
     KnnScanSharedData(SharedPtr<BaseTableRef> table_ref,
@@ -50,7 +70,8 @@ public:
                       KnnDistanceType knn_distance_type)
         : table_ref_(table_ref), block_column_entries_(std::move(block_column_entries)), index_entries_(std::move(index_entries)),
           opt_params_(std::move(opt_params)), topk_(topk), dimension_(dimension), query_count_(query_embedding_count),
-          query_embedding_(query_embedding), query_elem_type_(elem_type), knn_distance_type_(knn_distance_type) {}
+          query_embedding_(query_embedding), query_elem_type_(elem_type), knn_distance_type_(knn_distance_type),
+          distance_bound_(query_embedding_count) {}
 
 public:
     const SharedPtr<BaseTableRef> table_ref_{};
@@ -68,6 +89,8 @@ public:
 
     atomic_u64 current_block_idx_{0};
     atomic_u64 current_index_idx_{0};
+
+    KnnDistanceBound distance_bound_;
 };
 
 //-------------------------------------------------------------------
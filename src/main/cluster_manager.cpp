@@ -25,6 +25,7 @@ import infinity_exception;
 import peer_server_thrift_types;
 import wal_manager;
 import wal_entry;
+import peer_log_batch;
 
 namespace infinity {
 
@@ -318,19 +319,93 @@ Tuple<SharedPtr<PeerClient>, Status> ClusterManager::ConnectToServerNoLock(const
     return {client, client_status};
 }
 
-Status ClusterManager::SendLogs(const String &node_name, const SharedPtr<PeerClient> &peer_client, const Vector<SharedPtr<String>> &logs, bool synchronize) {
-    SharedPtr<SyncLogTask> sync_log_task = MakeShared<SyncLogTask>(node_name, logs);
-    peer_client->Send(sync_log_task);
-
-    if(synchronize) {
+Status ClusterManager::SendLogs(const SharedPtr<NodeInfo> &node_info,
+                                const SharedPtr<PeerClient> &peer_client,
+                                const Vector<SharedPtr<String>> &logs,
+                                bool synchronize) {
+    const String &node_name = node_info->node_name_;
+    // The window is kept per node across calls, so batches left queued by an asynchronous call still count against it and
+    // their errors are returned by the next call.
+    Deque<SharedPtr<SyncLogTask>> &inflight_tasks = inflight_log_tasks_[node_name];
+    Status status = Status::OK();
+    auto complete_oldest = [&] {
+        SharedPtr<SyncLogTask> sync_log_task = std::move(inflight_tasks.front());
+        inflight_tasks.pop_front();
         sync_log_task->Wait();
+        if (status.ok() && sync_log_task->error_code_ != 0) {
+            LOG_ERROR(fmt::format("Fail to send log follower: {}, error message: {}", node_name, sync_log_task->error_message_));
+            status.code_ = static_cast<ErrorCode>(sync_log_task->error_code_);
+            status.msg_ = MakeUnique<String>(sync_log_task->error_message_);
+        }
+    };
+    // The logs after a failed batch would leave a gap on the node, wait for the rest of the window and report the failure.
+    auto fail = [&] {
+        while (!inflight_tasks.empty()) {
+            complete_oldest();
+        }
+        return std::move(status);
+    };
+    while (!inflight_tasks.empty() && inflight_tasks.front()->IsComplete()) {
+        complete_oldest();
+    }
+    if (!status.ok()) {
+        return fail();
     }
 
-    Status status = Status::OK();
-    if (sync_log_task->error_code_ != 0) {
-        LOG_ERROR(fmt::format("Fail to send log follower: {}, error message: {}", node_name, sync_log_task->error_message_));
-        status.code_ = static_cast<ErrorCode>(sync_log_task->error_code_);
-        status.msg_ = MakeUnique<String>(sync_log_task->error_message_);
+    if (node_info->log_batch_version_ < PeerLogBatch::kVersion) {
+        // The node can't decode batch frames, send the plain entries in one request.
+        LOG_TRACE(fmt::format("Send {} plain logs to {}", logs.size(), node_name));
+        if (inflight_tasks.size() >= kMaxInflightLogBatches) {
+            complete_oldest();
+            if (!status.ok()) {
+                return fail();
+            }
+        }
+        auto sync_log_task = MakeShared<SyncLogTask>(node_name, logs);
+        peer_client->Send(sync_log_task);
+        inflight_tasks.push_back(std::move(sync_log_task));
+        if (synchronize) {
+            while (!inflight_tasks.empty()) {
+                complete_oldest();
+            }
+        }
+        return status;
+    }
+
+    // Ship the logs as compressed batches and keep at most kMaxInflightLogBatches of them queued on the peer client.
+    // Each batch is packed right before it's queued, so packing it overlaps with sending the previous ones.
+    SizeT raw_bytes = 0;
+    SizeT frame_bytes = 0;
+    SizeT frame_count = 0;
+    for (SizeT next_idx = 0; next_idx < logs.size();) {
+        const SizeT begin_idx = next_idx;
+        SharedPtr<String> frame = PeerLogBatch::PackNext(logs, next_idx);
+        for (SizeT i = begin_idx; i < next_idx; ++i) {
+            raw_bytes += logs[i]->size();
+        }
+        frame_bytes += frame->size();
+        ++frame_count;
+        if (inflight_tasks.size() >= kMaxInflightLogBatches) {
+            complete_oldest();
+            if (!status.ok()) {
+                return fail();
+            }
+        }
+        auto sync_log_task = MakeShared<SyncLogTask>(node_name, Vector<SharedPtr<String>>{std::move(frame)});
+        peer_client->Send(sync_log_task);
+        inflight_tasks.push_back(std::move(sync_log_task));
+    }
+    LOG_TRACE(fmt::format("Send {} logs to {} in {} batches, {} bytes, {} bytes before compression",
+                          logs.size(),
+                          node_name,
+                          frame_count,
+                          frame_bytes,
+                          raw_bytes));
+
+    if (synchronize) {
+        while (!inflight_tasks.empty()) {
+            complete_oldest();
+        }
     }
     return status;
 }
@@ -361,7 +436,16 @@ Status ClusterManager::AddNodeInfo(const SharedPtr<NodeInfo> &node_info) {
 
     reader_client_map_.emplace(node_info->node_name_, client_to_follower);
 
-    SyncLogsOnRegistration(node_info, client_to_follower);
+    Status sync_status = SyncLogsOnRegistration(node_info, client_to_follower);
+    if (!sync_status.ok()) {
+        // The node isn't in sync with the leader, refuse the registration instead of keeping a stale member.
+        LOG_ERROR(fmt::format("Fail to sync logs to node {} on registration: {}", node_info->node_name_, sync_status.message()));
+        other_node_map_.erase(node_info->node_name_);
+        client_to_follower->UnInit();
+        reader_client_map_.erase(node_info->node_name_);
+        inflight_log_tasks_.erase(node_info->node_name_);
+        return sync_status;
+    }
 
     return Status::OK();
 }
@@ -384,6 +468,7 @@ Status ClusterManager::RemoveNode(const String &node_name) {
         client_iter->second->UnInit();
         reader_client_map_.erase(node_name);
     }
+    inflight_log_tasks_.erase(node_name);
 
     return Status::OK();
 }
@@ -474,11 +559,19 @@ Status ClusterManager::SyncLogsOnRegistration(const SharedPtr<NodeInfo> &non_lea
     // Check leader WAL and get the diff log
     LOG_TRACE("Leader will get the log diff");
     WalManager *wal_manager = txn_manager_->wal_manager();
+    TxnTimeStamp checkpoint_ts = wal_manager->GetCheckpointedTS();
+    if (non_leader_node->txn_timestamp_ < checkpoint_ts) {
+        // The WAL before the checkpoint is already recycled and the peer protocol has no file transfer to ship the checkpoint,
+        // so the node can't be caught up. It has to be restored from a copy of the leader data before it registers again.
+        Status status = Status::NodeBehindCheckpoint(non_leader_node->node_name_, non_leader_node->txn_timestamp_, checkpoint_ts);
+        LOG_ERROR(status.message());
+        return status;
+    }
     Vector<SharedPtr<String>> wal_strings = wal_manager->GetDiffWalEntryString(non_leader_node->txn_timestamp_);
 
     // Leader will send the WALs
     LOG_TRACE(fmt::format("Leader will send the diff logs count: {} to {} synchronously", wal_strings.size(), non_leader_node->node_name_));
-    return SendLogs(non_leader_node->node_name_, peer_client, wal_strings, true);
+    return SendLogs(non_leader_node, peer_client, wal_strings, true);
 }
 
 Status ClusterManager::SyncLogsToFollower() {
@@ -543,10 +636,24 @@ Status ClusterManager::UpdateNodeInfoNoLock(const Vector<SharedPtr<NodeInfo>> &i
 }
 
 Status ClusterManager::ApplySyncedLogNolock(const Vector<String>& synced_logs) {
-    for(auto& log_str: synced_logs) {
+    Vector<String> unpacked_logs;
+    for (const auto &log_str : synced_logs) {
+        if (PeerLogBatch::IsFrame(log_str)) {
+            Status status = PeerLogBatch::Unpack(log_str, unpacked_logs);
+            if (!status.ok()) {
+                return status;
+            }
+        } else {
+            unpacked_logs.emplace_back(log_str);
+        }
+    }
+    for(auto& log_str: unpacked_logs) {
         const i32 entry_size = log_str.size();
         const char *ptr = log_str.data();
         SharedPtr<WalEntry> entry = WalEntry::ReadAdv(ptr, entry_size);
+        if (entry.get() == nullptr) {
+            return Status::DataCorrupted("Synced WAL entry");
+        }
         LOG_DEBUG(fmt::format("WAL Entry: {}", entry->ToString()));
     }
     return Status::OK();
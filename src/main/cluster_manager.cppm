@@ -47,7 +47,8 @@ private:
     Status RegisterToLeaderNoLock();
     Status UnregisterFromLeaderNoLock();
     Tuple<SharedPtr<PeerClient>, Status> ConnectToServerNoLock(const String &server_ip, i64 server_port);
-    Status SendLogs(const String &node_name, const SharedPtr<PeerClient>& peer_client, const Vector<SharedPtr<String>>& logs, bool synchronize);
+    // Sends batch frames if the node registered with a PeerLogBatch version, plain entries otherwise.
+    Status SendLogs(const SharedPtr<NodeInfo> &node_info, const SharedPtr<PeerClient>& peer_client, const Vector<SharedPtr<String>>& logs, bool synchronize);
 
 public:
     // Used by leader to add non-leader node in register phase
@@ -88,6 +89,9 @@ public:
     SharedPtr<NodeInfo> ThisNode() const;
 
 private:
+    // Max number of log batches queued to one peer client before SendLogs waits for the oldest one.
+    static constexpr SizeT kMaxInflightLogBatches = 4;
+
     TxnManager *txn_manager_{};
     mutable std::mutex mutex_;
 
@@ -100,6 +104,9 @@ private:
     // Leader clients to followers and learners
     Map<String, SharedPtr<PeerClient>> reader_client_map_{}; // Used by leader;
 
+    // Log batches sent to each follower and learner and not acknowledged yet
+    Map<String, Deque<SharedPtr<SyncLogTask>>> inflight_log_tasks_{}; // Used by leader;
+
     SharedPtr<PeerClient> client_to_leader_{}; // Used by follower and learner to connect leader server;
 
     Map<String, SharedPtr<PeerClient>> clients_to_follower_{}; // Used by leader to connect follower / learner server;
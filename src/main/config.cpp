@@ -416,6 +416,26 @@ Status Config::Init(const SharedPtr<String> &config_path, DefaultConfig *default
             UnrecoverableError(status.message());
         }
 
+        // Posting block cache size
+        i64 posting_block_cache_size = DEFAULT_POSTING_BLOCK_CACHE_SIZE;
+        UniquePtr<IntegerOption> posting_block_cache_size_option =
+            MakeUnique<IntegerOption>(POSTING_BLOCK_CACHE_SIZE_OPTION_NAME, posting_block_cache_size, std::numeric_limits<i64>::max(), 0);
+        status = global_options_.AddOption(std::move(posting_block_cache_size_option));
+        if(!status.ok()) {
+            fmt::print("Fatal: {}", status.message());
+            UnrecoverableError(status.message());
+        }
+
+        // Sort memory budget
+        i64 sort_memory_budget = DEFAULT_SORT_MEMORY_BUDGET;
+        UniquePtr<IntegerOption> sort_memory_budget_option =
+            MakeUnique<IntegerOption>(SORT_MEMORY_BUDGET_OPTION_NAME, sort_memory_budget, std::numeric_limits<i64>::max(), 1);
+        status = global_options_.AddOption(std::move(sort_memory_budget_option));
+        if(!status.ok()) {
+            fmt::print("Fatal: {}", status.message());
+            UnrecoverableError(status.message());
+        }
+
         // Temp Dir
         String temp_dir = "/var/infinity/tmp";
         if(default_config != nullptr) {
@@ -1450,6 +1470,40 @@ Status Config::Init(const SharedPtr<String> &config_path, DefaultConfig *default
                                         }
                                         break;
                                     }
+                                    case GlobalOptionIndex::kObjectStorageMaxInFlight: {
+                                        i64 max_in_flight = DEFAULT_OBJECT_STORAGE_MAX_IN_FLIGHT;
+                                        if (elem.second.is_integer()) {
+                                            max_in_flight = elem.second.value_or(max_in_flight);
+                                        } else {
+                                            return Status::InvalidConfig("'max_in_flight_requests' field isn't integer.");
+                                        }
+                                        UniquePtr<IntegerOption> max_in_flight_option =
+                                            MakeUnique<IntegerOption>(OBJECT_STORAGE_MAX_IN_FLIGHT_OPTION_NAME, max_in_flight, MAX_OBJECT_STORAGE_MAX_IN_FLIGHT, 1);
+                                        if (!max_in_flight_option->Validate()) {
+                                            return Status::InvalidConfig(fmt::format("Invalid max in flight requests: {}", max_in_flight));
+                                        }
+                                        global_options_.AddOption(std::move(max_in_flight_option));
+                                        break;
+                                    }
+                                    case GlobalOptionIndex::kObjectStorageDiskCacheLimit: {
+                                        i64 disk_cache_limit = DEFAULT_OBJECT_STORAGE_DISK_CACHE_LIMIT;
+                                        if (elem.second.is_string()) {
+                                            String disk_cache_limit_str = elem.second.value_or(DEFAULT_OBJECT_STORAGE_DISK_CACHE_LIMIT_STR.data());
+                                            auto res = ParseByteSize(disk_cache_limit_str, disk_cache_limit);
+                                            if (!res.ok()) {
+                                                return res;
+                                            }
+                                        } else {
+                                            return Status::InvalidConfig("'disk_cache_limit' field isn't string, such as \"100GB\"");
+                                        }
+                                        UniquePtr<IntegerOption> disk_cache_limit_option =
+                                            MakeUnique<IntegerOption>(OBJECT_STORAGE_DISK_CACHE_LIMIT_OPTION_NAME, disk_cache_limit, std::numeric_limits<i64>::max(), 1);
+                                        if (!disk_cache_limit_option->Validate()) {
+                                            return Status::InvalidConfig(fmt::format("Invalid disk cache limit: {}", disk_cache_limit));
+                                        }
+                                        global_options_.AddOption(std::move(disk_cache_limit_option));
+                                        break;
+                                    }
                                     default: {
                                         return Status::InvalidConfig(fmt::format("Unrecognized config parameter: {} in 'storage.object_storage' field", var_name));
                                     }
@@ -1475,6 +1529,24 @@ Status Config::Init(const SharedPtr<String> &config_path, DefaultConfig *default
                             if (global_options_.GetOptionByIndex(GlobalOptionIndex::kObjectStorageHttps) == nullptr) {
                                 return Status::InvalidConfig("No 'enable_https' field in [storage.object_storage]");
                             }
+                            if (global_options_.GetOptionByIndex(GlobalOptionIndex::kObjectStorageMaxInFlight) == nullptr) {
+                                i64 max_in_flight = DEFAULT_OBJECT_STORAGE_MAX_IN_FLIGHT;
+                                UniquePtr<IntegerOption> max_in_flight_option =
+                                    MakeUnique<IntegerOption>(OBJECT_STORAGE_MAX_IN_FLIGHT_OPTION_NAME, max_in_flight, MAX_OBJECT_STORAGE_MAX_IN_FLIGHT, 1);
+                                Status status = global_options_.AddOption(std::move(max_in_flight_option));
+                                if (!status.ok()) {
+                                    UnrecoverableError(status.message());
+                                }
+                            }
+                            if (global_options_.GetOptionByIndex(GlobalOptionIndex::kObjectStorageDiskCacheLimit) == nullptr) {
+                                i64 disk_cache_limit = DEFAULT_OBJECT_STORAGE_DISK_CACHE_LIMIT;
+                                UniquePtr<IntegerOption> disk_cache_limit_option =
+                                    MakeUnique<IntegerOption>(OBJECT_STORAGE_DISK_CACHE_LIMIT_OPTION_NAME, disk_cache_limit, std::numeric_limits<i64>::max(), 1);
+                                Status status = global_options_.AddOption(std::move(disk_cache_limit_option));
+                                if (!status.ok()) {
+                                    UnrecoverableError(status.message());
+                                }
+                            }
                             break;
                         }
                         default: {
@@ -1641,6 +1713,46 @@ Status Config::Init(const SharedPtr<String> &config_path, DefaultConfig *default
                             global_options_.AddOption(std::move(mem_index_memory_quota_option));
                             break;
                         }
+                        case GlobalOptionIndex::kPostingBlockCacheSize: {
+                            i64 posting_block_cache_size = DEFAULT_POSTING_BLOCK_CACHE_SIZE;
+                            if (elem.second.is_string()) {
+                                String posting_block_cache_size_str = elem.second.value_or(DEFAULT_POSTING_BLOCK_CACHE_SIZE_STR.data());
+                                auto res = ParseByteSize(posting_block_cache_size_str, posting_block_cache_size);
+                                if (!res.ok()) {
+                                    return res;
+                                }
+                            } else {
+                                return Status::InvalidConfig("'posting_block_cache_size' field isn't string, such as \"256MB\"");
+                            }
+                            UniquePtr<IntegerOption> posting_block_cache_size_option = MakeUnique<IntegerOption>(POSTING_BLOCK_CACHE_SIZE_OPTION_NAME,
+                                                                                                                 posting_block_cache_size,
+                                                                                                                 std::numeric_limits<i64>::max(),
+                                                                                                                 0);
+                            if (!posting_block_cache_size_option->Validate()) {
+                                return Status::InvalidConfig(fmt::format("Invalid posting block cache size: {}", posting_block_cache_size));
+                            }
+                            global_options_.AddOption(std::move(posting_block_cache_size_option));
+                            break;
+                        }
+                        case GlobalOptionIndex::kSortMemoryBudget: {
+                            i64 sort_memory_budget = DEFAULT_SORT_MEMORY_BUDGET;
+                            if (elem.second.is_string()) {
+                                String sort_memory_budget_str = elem.second.value_or(DEFAULT_SORT_MEMORY_BUDGET_STR.data());
+                                auto res = ParseByteSize(sort_memory_budget_str, sort_memory_budget);
+                                if (!res.ok()) {
+                                    return res;
+                                }
+                            } else {
+                                return Status::InvalidConfig("'sort_memory_budget' field isn't string, such as \"256MB\"");
+                            }
+                            UniquePtr<IntegerOption> sort_memory_budget_option =
+                                MakeUnique<IntegerOption>(SORT_MEMORY_BUDGET_OPTION_NAME, sort_memory_budget, std::numeric_limits<i64>::max(), 1);
+                            if (!sort_memory_budget_option->Validate()) {
+                                return Status::InvalidConfig(fmt::format("Invalid sort memory budget: {}", sort_memory_budget));
+                            }
+                            global_options_.AddOption(std::move(sort_memory_budget_option));
+                            break;
+                        }
                         default: {
                             return Status::InvalidConfig(fmt::format("Unrecognized config parameter: {} in 'buffer' field", var_name));
                         }
@@ -1686,6 +1798,26 @@ Status Config::Init(const SharedPtr<String> &config_path, DefaultConfig *default
                         UnrecoverableError(status.message());
                     }
                 }
+                if (global_options_.GetOptionByIndex(GlobalOptionIndex::kPostingBlockCacheSize) == nullptr) {
+                    // Posting Block Cache Size
+                    i64 posting_block_cache_size = DEFAULT_POSTING_BLOCK_CACHE_SIZE;
+                    UniquePtr<IntegerOption> posting_block_cache_size_option =
+                        MakeUnique<IntegerOption>(POSTING_BLOCK_CACHE_SIZE_OPTION_NAME, posting_block_cache_size, std::numeric_limits<i64>::max(), 0);
+                    Status status = global_options_.AddOption(std::move(posting_block_cache_size_option));
+                    if(!status.ok()) {
+                        UnrecoverableError(status.message());
+                    }
+                }
+                if (global_options_.GetOptionByIndex(GlobalOptionIndex::kSortMemoryBudget) == nullptr) {
+                    // Sort Memory Budget
+                    i64 sort_memory_budget = DEFAULT_SORT_MEMORY_BUDGET;
+                    UniquePtr<IntegerOption> sort_memory_budget_option =
+                        MakeUnique<IntegerOption>(SORT_MEMORY_BUDGET_OPTION_NAME, sort_memory_budget, std::numeric_limits<i64>::max(), 1);
+                    Status status = global_options_.AddOption(std::move(sort_memory_budget_option));
+                    if(!status.ok()) {
+                        UnrecoverableError(status.message());
+                    }
+                }
 
             } else {
                 return Status::InvalidConfig("No 'buffer' section in configure file.");
@@ -2230,6 +2362,16 @@ bool Config::ObjectStorageHttps() {
     return global_options_.GetBoolValue(GlobalOptionIndex::kObjectStorageHttps);
 }
 
+i64 Config::ObjectStorageMaxInFlight() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return global_options_.GetIntegerValue(GlobalOptionIndex::kObjectStorageMaxInFlight);
+}
+
+i64 Config::ObjectStorageDiskCacheLimit() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return global_options_.GetIntegerValue(GlobalOptionIndex::kObjectStorageDiskCacheLimit);
+}
+
 // Persistence
 String Config::PersistenceDir() {
     std::lock_guard<std::mutex> guard(mutex_);
@@ -2257,6 +2399,27 @@ String Config::TempDir() {
     return global_options_.GetStringValue(GlobalOptionIndex::kTempDir);
 }
 
+i64 Config::PostingBlockCacheSize() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return global_options_.GetIntegerValue(GlobalOptionIndex::kPostingBlockCacheSize);
+}
+
+i64 Config::SortMemoryBudget() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return global_options_.GetIntegerValue(GlobalOptionIndex::kSortMemoryBudget);
+}
+
+void Config::SetSortMemoryBudget(i64 budget) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    BaseOption *base_option = global_options_.GetOptionByIndex(GlobalOptionIndex::kSortMemoryBudget);
+    if (base_option->data_type_ != BaseOptionDataType::kInteger) {
+        String error_message = "Attempt to set non-integer value to sort memory budget";
+        UnrecoverableError(error_message);
+    }
+    IntegerOption *sort_memory_budget_option = static_cast<IntegerOption *>(base_option);
+    sort_memory_budget_option->value_ = budget;
+}
+
 i64 Config::MemIndexMemoryQuota() {
     std::lock_guard<std::mutex> guard(mutex_);
     return global_options_.GetIntegerValue(GlobalOptionIndex::kMemIndexMemoryQuota);
@@ -2389,6 +2552,8 @@ void Config::PrintAll() {
             fmt::print(" - object_storage_access_key: {}\n", ObjectStorageAccessKey());
             fmt::print(" - object_storage_secret_key: {}\n", ObjectStorageSecretKey());
             fmt::print(" - object_storage_enable_https: {}\n", ObjectStorageHttps());
+            fmt::print(" - object_storage_max_in_flight_requests: {}\n", ObjectStorageMaxInFlight());
+            fmt::print(" - object_storage_disk_cache_limit: {}\n", Utility::FormatByteSize(ObjectStorageDiskCacheLimit()));
             break;
         }
         default: {
@@ -2400,6 +2565,8 @@ void Config::PrintAll() {
     fmt::print(" - buffer_manager_size: {}\n", Utility::FormatByteSize(BufferManagerSize()));
     fmt::print(" - temp_dir: {}\n", TempDir());
     fmt::print(" - memindex_memory_quota: {}\n", Utility::FormatByteSize(MemIndexMemoryQuota()));
+    fmt::print(" - posting_block_cache_size: {}\n", Utility::FormatByteSize(PostingBlockCacheSize()));
+    fmt::print(" - sort_memory_budget: {}\n", Utility::FormatByteSize(SortMemoryBudget()));
 
     // WAL
     fmt::print(" - wal_dir: {}\n", WALDir());
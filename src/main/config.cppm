@@ -100,6 +100,8 @@ public:
     String ObjectStorageAccessKey();
     String ObjectStorageSecretKey();
     bool ObjectStorageHttps();
+    i64 ObjectStorageMaxInFlight();
+    i64 ObjectStorageDiskCacheLimit();
 
     // Persistence
     String PersistenceDir();
@@ -111,6 +113,9 @@ public:
     String TempDir();
 
     i64 MemIndexMemoryQuota();
+    i64 PostingBlockCacheSize();
+    i64 SortMemoryBudget();
+    void SetSortMemoryBudget(i64 budget);
 
     // WAL
     String WALDir();
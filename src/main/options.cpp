@@ -66,11 +66,15 @@ GlobalOptions::GlobalOptions() {
     name2index_[String(OBJECT_STORAGE_ACCESS_KEY_OPTION_NAME)] = GlobalOptionIndex::kObjectStorageAccessKey;
     name2index_[String(OBJECT_STORAGE_SECRET_KEY_OPTION_NAME)] = GlobalOptionIndex::kObjectStorageSecretKey;
     name2index_[String(OBJECT_STORAGE_ENABLE_HTTPS_OPTION_NAME)] = GlobalOptionIndex::kObjectStorageHttps;
+    name2index_[String(OBJECT_STORAGE_MAX_IN_FLIGHT_OPTION_NAME)] = GlobalOptionIndex::kObjectStorageMaxInFlight;
+    name2index_[String(OBJECT_STORAGE_DISK_CACHE_LIMIT_OPTION_NAME)] = GlobalOptionIndex::kObjectStorageDiskCacheLimit;
 
     name2index_[String(BUFFER_MANAGER_SIZE_OPTION_NAME)] = GlobalOptionIndex::kBufferManagerSize;
     name2index_[String(LRU_NUM_OPTION_NAME)] = GlobalOptionIndex::kLRUNum;
     name2index_[String(TEMP_DIR_OPTION_NAME)] = GlobalOptionIndex::kTempDir;
     name2index_[String(MEMINDEX_MEMORY_QUOTA_OPTION_NAME)] = GlobalOptionIndex::kMemIndexMemoryQuota;
+    name2index_[String(POSTING_BLOCK_CACHE_SIZE_OPTION_NAME)] = GlobalOptionIndex::kPostingBlockCacheSize;
+    name2index_[String(SORT_MEMORY_BUDGET_OPTION_NAME)] = GlobalOptionIndex::kSortMemoryBudget;
 
     name2index_[String(WAL_DIR_OPTION_NAME)] = GlobalOptionIndex::kWALDir;
     name2index_[String(WAL_COMPACT_THRESHOLD_OPTION_NAME)] = GlobalOptionIndex::kWALCompactThreshold;
@@ -158,8 +158,12 @@ export enum class GlobalOptionIndex : i8 {
     kObjectStorageAccessKey = 42,
     kObjectStorageSecretKey = 43,
     kObjectStorageHttps = 44,
+    kObjectStorageMaxInFlight = 45,
+    kPostingBlockCacheSize = 46,
+    kSortMemoryBudget = 47,
+    kObjectStorageDiskCacheLimit = 48,
 
-    kInvalid = 45,
+    kInvalid = 49,
 };
 
 export struct GlobalOptions {
@@ -169,7 +169,15 @@ void TaskProfiler::StopOperator(const OperatorState *operator_state) {
         output_rows += output_data_block->Finalized() ? output_data_block->row_count() : 0;
     }
 
-    OperatorInformation info(active_operator_->GetName(), profiler_.GetBegin(), profiler_.GetEnd(), profiler_.Elapsed(), input_rows, output_data_size, output_rows);
+    OperatorInformation info(active_operator_->GetName(),
+                             profiler_.GetBegin(),
+                             profiler_.GetEnd(),
+                             profiler_.Elapsed(),
+                             input_rows,
+                             output_data_size,
+                             output_rows,
+                             operator_state->skipped_block_count_,
+                             operator_state->pruned_candidate_count_);
 
     timings_.push_back(std::move(info));
     active_operator_ = nullptr;
@@ -279,6 +287,8 @@ void QueryProfiler::ExecuteRender(std::stringstream &ss) const {
                        << ", InputRows: " << op.input_rows_
                        << ", OutputRows: " << op.output_rows_
                        << ", OutputDataSize: " << op.output_data_size_
+                       << ", SkippedBlocks: " << op.skipped_blocks_
+                       << ", PrunedCandidates: " << op.pruned_candidates_
                        << std::endl;
                 }
                 times ++;
@@ -347,6 +357,8 @@ nlohmann::json QueryProfiler::Serialize(const QueryProfiler *profiler) {
                     json_info["input_rows"] = op.input_rows_;
                     json_info["output_rows"] = op.output_rows_;
                     json_info["output_data_size"] = op.output_data_size_;
+                    json_info["skipped_blocks"] = op.skipped_blocks_;
+                    json_info["pruned_candidates"] = op.pruned_candidates_;
                     json_operators["infos"].push_back(json_info);
                 }
                 times ++;
@@ -93,17 +93,28 @@ struct OperatorInformation {
 
     OperatorInformation(const OperatorInformation& other)
         : name_(other.name_), start_(other.start_), end_(other.end_), elapsed_(other.elapsed_), input_rows_(other.input_rows_),
-          output_data_size_(other.output_data_size_), output_rows_(other.output_rows_) {
+          output_data_size_(other.output_data_size_), output_rows_(other.output_rows_), skipped_blocks_(other.skipped_blocks_),
+          pruned_candidates_(other.pruned_candidates_) {
 
     }
 
     OperatorInformation(OperatorInformation&& other)
         : name_(std::move(other.name_)), start_(other.start_), end_(other.end_), elapsed_(other.elapsed_), input_rows_(other.input_rows_),
-          output_data_size_(other.output_data_size_), output_rows_(other.output_rows_) {
+          output_data_size_(other.output_data_size_), output_rows_(other.output_rows_), skipped_blocks_(other.skipped_blocks_),
+          pruned_candidates_(other.pruned_candidates_) {
     }
 
-    OperatorInformation(String name, i64 start, i64 end, i64 elapsed, u16 input_rows, i32 output_data_size, u16 output_rows)
-        : name_(std::move(name)), start_(start), end_(end), elapsed_(elapsed), input_rows_(input_rows), output_data_size_(output_data_size), output_rows_(output_rows) {
+    OperatorInformation(String name,
+                        i64 start,
+                        i64 end,
+                        i64 elapsed,
+                        u16 input_rows,
+                        i32 output_data_size,
+                        u16 output_rows,
+                        u64 skipped_blocks,
+                        u64 pruned_candidates)
+        : name_(std::move(name)), start_(start), end_(end), elapsed_(elapsed), input_rows_(input_rows), output_data_size_(output_data_size),
+          output_rows_(output_rows), skipped_blocks_(skipped_blocks), pruned_candidates_(pruned_candidates) {
     }
 
     OperatorInformation& operator=(OperatorInformation&& other) {
@@ -115,6 +126,8 @@ struct OperatorInformation {
             input_rows_ = other.input_rows_;
             output_rows_ = other.output_rows_;
             output_data_size_ = other.output_data_size_;
+            skipped_blocks_ = other.skipped_blocks_;
+            pruned_candidates_ = other.pruned_candidates_;
         }
         return *this;
     }
@@ -127,6 +140,10 @@ struct OperatorInformation {
     u16 input_rows_ {};
     i32 output_data_size_ {};
     u16 output_rows_ {};
+    // blocks of the scan ruled out by FastRoughFilter or zone map
+    u64 skipped_blocks_ {};
+    // knn candidates left by the shared top k distance bound
+    u64 pruned_candidates_ {};
 };
 
 export struct TaskBinding {
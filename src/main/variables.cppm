@@ -46,6 +46,7 @@ export enum class GlobalVariable {
     kJeProf,                    // global
     kCleanupTrace,              // global
     kFollowerNum,               // global
+    kPostingBlockCache,         // global
     kInvalid,
 };
 
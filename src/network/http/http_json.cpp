@@ -0,0 +1,521 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+#include "simdjson/simdjson.h"
+#include <cstring>
+
+module http_json;
+
+import stl;
+import internal_types;
+import parsed_expr;
+import constant_expr;
+import third_party;
+
+namespace infinity {
+
+namespace {
+
+// The document of an on-demand parser is only valid until the next iterate(), and none of the functions below nest:
+// each request body is parsed once, nested values are walked in the same document.
+thread_local simdjson::ondemand::parser json_parser;
+
+// Text of a value, whatever its type, as it appears in the input.
+simdjson::error_code GetRawJson(simdjson::ondemand::value &value, std::string_view &raw_json) {
+    simdjson::ondemand::json_type json_type;
+    if (auto error = value.type().get(json_type); error) {
+        return error;
+    }
+    switch (json_type) {
+        case simdjson::ondemand::json_type::array: {
+            simdjson::ondemand::array array;
+            if (auto error = value.get_array().get(array); error) {
+                return error;
+            }
+            return array.raw_json().get(raw_json);
+        }
+        case simdjson::ondemand::json_type::object: {
+            simdjson::ondemand::object object;
+            if (auto error = value.get_object().get(object); error) {
+                return error;
+            }
+            return object.raw_json().get(raw_json);
+        }
+        default: {
+            raw_json = value.raw_json_token();
+            return simdjson::SUCCESS;
+        }
+    }
+}
+
+template <typename T>
+bool DecodeNumber(simdjson::ondemand::value &value, bool integer_only, T &out) {
+    auto assign = [&](auto v) {
+        if constexpr (std::is_arithmetic_v<T>) {
+            out = static_cast<T>(v);
+        } else {
+            out = static_cast<f32>(v);
+        }
+    };
+    simdjson::ondemand::number_type number_type;
+    if (value.get_number_type().get(number_type)) {
+        return false;
+    }
+    switch (number_type) {
+        case simdjson::ondemand::number_type::signed_integer: {
+            i64 v = 0;
+            if (value.get_int64().get(v)) {
+                return false;
+            }
+            assign(v);
+            return true;
+        }
+        case simdjson::ondemand::number_type::unsigned_integer: {
+            u64 v = 0;
+            if (value.get_uint64().get(v)) {
+                return false;
+            }
+            assign(v);
+            return true;
+        }
+        case simdjson::ondemand::number_type::floating_point_number: {
+            f64 v = 0;
+            if (integer_only || value.get_double().get(v)) {
+                return false;
+            }
+            assign(v);
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+template <typename T>
+Tuple<i64, void *> ConvertVector(const JsonMember &member, bool integer_only, String &error_message) {
+    if (!member.is_array_) {
+        error_message = "Can't recognize embedding/vector.";
+        return {0, nullptr};
+    }
+    if (!member.all_numbers_ || (integer_only && !member.all_integers_)) {
+        error_message = integer_only ? "Embedding element type should be integer" : "Embedding element type should be float";
+        return {0, nullptr};
+    }
+    SizeT dimension = member.numbers_.size();
+    if (dimension == 0) {
+        error_message = "Empty embedding data";
+        return {0, nullptr};
+    }
+    auto embedding = MakeUnique<T[]>(dimension);
+    for (SizeT idx = 0; idx < dimension; ++idx) {
+        if constexpr (std::is_arithmetic_v<T>) {
+            embedding[idx] = static_cast<T>(member.numbers_[idx]);
+        } else {
+            embedding[idx] = static_cast<f32>(member.numbers_[idx]);
+        }
+    }
+    return {dimension, embedding.release()};
+}
+
+const char *SkipSpaces(const char *p) {
+    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') {
+        ++p;
+    }
+    return p;
+}
+
+// Sets `end` past the bracket that closes a container whose last value ends at `last`.
+simdjson::error_code CloseContainer(const char *last, char bracket, const char *&end) {
+    last = SkipSpaces(last);
+    if (*last != bracket) {
+        return simdjson::TAPE_ERROR;
+    }
+    end = last + 1;
+    return simdjson::SUCCESS;
+}
+
+// Lists the members of an object in one forward pass of the on-demand document, descending into the arrays so that
+// nested search objects and query vectors need no parsing of their own. Values are located in the padded copy and
+// mapped back to the caller's input.
+class MemberLister {
+public:
+    MemberLister(std::string_view input, const simdjson::padded_string &padded) : input_(input), padded_(padded) {}
+
+    // `begin` points to the opening brace of `object`; `end` is set past its closing one.
+    simdjson::error_code
+    ListObject(simdjson::ondemand::object &object, const char *begin, Vector<JsonMember> &members, const char *&end) {
+        const char *last = begin + 1;
+        for (auto field : object) {
+            std::string_view key;
+            simdjson::ondemand::value value;
+            if (auto error = field.unescaped_key().get(key); error) {
+                return error;
+            }
+            if (auto error = field.value().get(value); error) {
+                return error;
+            }
+            JsonMember &member = members.emplace_back();
+            member.key_ = String(key);
+            if (auto error = ListValue(value, member, last); error) {
+                return error;
+            }
+        }
+        return CloseContainer(last, '}', end);
+    }
+
+private:
+    simdjson::error_code ListValue(simdjson::ondemand::value &value, JsonMember &member, const char *&end) {
+        simdjson::ondemand::json_type json_type;
+        if (auto error = value.type().get(json_type); error) {
+            return error;
+        }
+        if (json_type != simdjson::ondemand::json_type::array) {
+            std::string_view raw_json;
+            if (auto error = GetRawJson(value, raw_json); error) {
+                return error;
+            }
+            end = raw_json.data() + raw_json.size();
+            member.raw_value_ = ToInputView(raw_json.data(), end);
+            return simdjson::SUCCESS;
+        }
+
+        const char *begin = value.raw_json_token().data();
+        simdjson::ondemand::array array;
+        if (auto error = value.get_array().get(array); error) {
+            return error;
+        }
+        member.is_array_ = member.all_numbers_ = member.all_integers_ = member.all_objects_ = true;
+        const char *last = begin + 1;
+        for (auto element : array) {
+            simdjson::ondemand::value element_value;
+            simdjson::ondemand::json_type element_type;
+            if (auto error = element.get(element_value); error) {
+                return error;
+            }
+            if (auto error = element_value.type().get(element_type); error) {
+                return error;
+            }
+            member.all_numbers_ = member.all_numbers_ && element_type == simdjson::ondemand::json_type::number;
+            member.all_objects_ = member.all_objects_ && element_type == simdjson::ondemand::json_type::object;
+            if (member.all_numbers_) {
+                std::string_view token = element_value.raw_json_token();
+                last = token.data() + token.size();
+                if (auto error = DecodeElement(element_value, member); error) {
+                    return error;
+                }
+            } else if (member.all_objects_) {
+                const char *object_begin = element_value.raw_json_token().data();
+                simdjson::ondemand::object object;
+                if (auto error = element_value.get_object().get(object); error) {
+                    return error;
+                }
+                if (auto error = ListObject(object, object_begin, member.objects_.emplace_back(), last); error) {
+                    return error;
+                }
+            } else {
+                std::string_view raw_json;
+                if (auto error = GetRawJson(element_value, raw_json); error) {
+                    return error;
+                }
+                last = raw_json.data() + raw_json.size();
+            }
+        }
+        if (!member.all_numbers_) {
+            member.all_integers_ = false;
+            member.numbers_.clear();
+        }
+        if (!member.all_objects_) {
+            member.objects_.clear();
+        }
+        if (auto error = CloseContainer(last, ']', end); error) {
+            return error;
+        }
+        member.raw_value_ = ToInputView(begin, end);
+        return simdjson::SUCCESS;
+    }
+
+    static simdjson::error_code DecodeElement(simdjson::ondemand::value &value, JsonMember &member) {
+        simdjson::ondemand::number_type number_type;
+        if (auto error = value.get_number_type().get(number_type); error) {
+            return error;
+        }
+        switch (number_type) {
+            case simdjson::ondemand::number_type::signed_integer: {
+                i64 v = 0;
+                if (auto error = value.get_int64().get(v); error) {
+                    return error;
+                }
+                member.numbers_.push_back(static_cast<f64>(v));
+                break;
+            }
+            case simdjson::ondemand::number_type::unsigned_integer: {
+                u64 v = 0;
+                if (auto error = value.get_uint64().get(v); error) {
+                    return error;
+                }
+                member.numbers_.push_back(static_cast<f64>(v));
+                break;
+            }
+            case simdjson::ondemand::number_type::floating_point_number: {
+                f64 v = 0;
+                if (auto error = value.get_double().get(v); error) {
+                    return error;
+                }
+                member.all_integers_ = false;
+                member.numbers_.push_back(v);
+                break;
+            }
+            default: {
+                // out of range integers aren't taken as embedding elements
+                member.all_numbers_ = member.all_integers_ = false;
+                break;
+            }
+        }
+        return simdjson::SUCCESS;
+    }
+
+    std::string_view ToInputView(const char *begin, const char *end) const {
+        return input_.substr(begin - padded_.data(), end - begin);
+    }
+
+    std::string_view input_;
+    const simdjson::padded_string &padded_;
+};
+
+ConstantExpr *ParseNumberArray(simdjson::ondemand::array &array) {
+    SizeT dimension = 0;
+    if (array.count_elements().get(dimension) || dimension == 0) {
+        return nullptr;
+    }
+    UniquePtr<ConstantExpr> const_expr;
+    for (auto element : array) {
+        simdjson::ondemand::value value;
+        simdjson::ondemand::number_type number_type;
+        if (element.get(value) || value.get_number_type().get(number_type)) {
+            return nullptr;
+        }
+        if (const_expr.get() == nullptr) {
+            // like the DOM path, the first element decides the array type
+            bool is_float = number_type == simdjson::ondemand::number_type::floating_point_number;
+            const_expr = MakeUnique<ConstantExpr>(is_float ? LiteralType::kDoubleArray : LiteralType::kIntegerArray);
+            if (is_float) {
+                const_expr->double_array_.reserve(dimension);
+            } else {
+                const_expr->long_array_.reserve(dimension);
+            }
+        }
+        if (const_expr->literal_type_ == LiteralType::kDoubleArray) {
+            f64 v = 0;
+            if (number_type != simdjson::ondemand::number_type::floating_point_number || value.get_double().get(v)) {
+                return nullptr;
+            }
+            const_expr->double_array_.push_back(v);
+        } else {
+            i64 v = 0;
+            if (!DecodeNumber(value, true, v)) {
+                return nullptr;
+            }
+            const_expr->long_array_.push_back(v);
+        }
+    }
+    return const_expr.release();
+}
+
+ConstantExpr *ParseInsertValue(simdjson::ondemand::value &value) {
+    simdjson::ondemand::json_type json_type;
+    if (value.type().get(json_type)) {
+        return nullptr;
+    }
+    switch (json_type) {
+        case simdjson::ondemand::json_type::boolean: {
+            bool v = false;
+            if (value.get_bool().get(v)) {
+                return nullptr;
+            }
+            auto const_expr = new ConstantExpr(LiteralType::kBoolean);
+            const_expr->bool_value_ = v;
+            return const_expr;
+        }
+        case simdjson::ondemand::json_type::number: {
+            simdjson::ondemand::number_type number_type;
+            if (value.get_number_type().get(number_type)) {
+                return nullptr;
+            }
+            if (number_type == simdjson::ondemand::number_type::floating_point_number) {
+                f64 v = 0;
+                if (value.get_double().get(v)) {
+                    return nullptr;
+                }
+                auto const_expr = new ConstantExpr(LiteralType::kDouble);
+                const_expr->double_value_ = v;
+                return const_expr;
+            }
+            i64 v = 0;
+            if (!DecodeNumber(value, true, v)) {
+                return nullptr;
+            }
+            auto const_expr = new ConstantExpr(LiteralType::kInteger);
+            const_expr->integer_value_ = v;
+            return const_expr;
+        }
+        case simdjson::ondemand::json_type::string: {
+            std::string_view v;
+            if (value.get_string().get(v)) {
+                return nullptr;
+            }
+            auto const_expr = new ConstantExpr(LiteralType::kString);
+            const_expr->str_value_ = strdup(String(v).c_str());
+            return const_expr;
+        }
+        case simdjson::ondemand::json_type::array: {
+            simdjson::ondemand::array array;
+            if (value.get_array().get(array)) {
+                return nullptr;
+            }
+            return ParseNumberArray(array);
+        }
+        default: {
+            // sparse vectors, tensors and nulls are left to the DOM path
+            return nullptr;
+        }
+    }
+}
+
+bool ParseInsertRowsImpl(std::string_view json, Vector<String> &columns, Vector<Vector<ParsedExpr *> *> &rows) {
+    simdjson::padded_string padded(json.data(), json.size());
+    simdjson::ondemand::document doc;
+    simdjson::ondemand::array row_array;
+    if (json_parser.iterate(padded).get(doc) || doc.get_array().get(row_array)) {
+        return false;
+    }
+    HashMap<String, SizeT> column_name_id_map;
+    for (auto row_element : row_array) {
+        simdjson::ondemand::object row_object;
+        if (row_element.get_object().get(row_object)) {
+            return false;
+        }
+        const bool first_row = rows.empty();
+        rows.push_back(new Vector<ParsedExpr *>(columns.size(), nullptr));
+        Vector<ParsedExpr *> &values_row = *rows.back();
+        SizeT value_count = 0;
+        for (auto field : row_object) {
+            std::string_view key_view;
+            simdjson::ondemand::value value;
+            if (field.unescaped_key().get(key_view) || field.value().get(value)) {
+                return false;
+            }
+            String key(key_view);
+            SizeT column_id = 0;
+            if (first_row) {
+                if (!column_name_id_map.emplace(key, columns.size()).second) {
+                    return false;
+                }
+                column_id = columns.size();
+                columns.push_back(std::move(key));
+                values_row.push_back(nullptr);
+            } else {
+                auto iter = column_name_id_map.find(key);
+                if (iter == column_name_id_map.end() || values_row[iter->second] != nullptr) {
+                    return false;
+                }
+                column_id = iter->second;
+            }
+            values_row[column_id] = ParseInsertValue(value);
+            if (values_row[column_id] == nullptr) {
+                return false;
+            }
+            ++value_count;
+        }
+        if (value_count != columns.size() || value_count == 0) {
+            return false;
+        }
+    }
+    // trailing content isn't json
+    return !rows.empty() && doc.at_end();
+}
+
+} // namespace
+
+bool HTTPJson::ListMembers(std::string_view json, Vector<JsonMember> &members, String &error_message) {
+    simdjson::padded_string padded(json.data(), json.size());
+    simdjson::ondemand::document doc;
+    simdjson::ondemand::object object;
+    if (auto error = json_parser.iterate(padded).get(doc); error) {
+        error_message = simdjson::error_message(error);
+        return false;
+    }
+    if (auto error = doc.get_object().get(object); error) {
+        error_message = simdjson::error_message(error);
+        return false;
+    }
+    MemberLister lister(json, padded);
+    const char *end = nullptr;
+    if (auto error = lister.ListObject(object, SkipSpaces(padded.data()), members, end); error) {
+        error_message = simdjson::error_message(error);
+        return false;
+    }
+    if (!doc.at_end()) {
+        error_message = "Trailing content after the JSON object";
+        return false;
+    }
+    return true;
+}
+
+Tuple<i64, void *> HTTPJson::DecodeVector(const JsonMember &member, EmbeddingDataType elem_type, String &error_message) {
+    switch (elem_type) {
+        case EmbeddingDataType::kElemInt32: {
+            return ConvertVector<i32>(member, true, error_message);
+        }
+        case EmbeddingDataType::kElemInt8: {
+            return ConvertVector<i8>(member, true, error_message);
+        }
+        case EmbeddingDataType::kElemUInt8: {
+            return ConvertVector<u8>(member, true, error_message);
+        }
+        case EmbeddingDataType::kElemFloat: {
+            return ConvertVector<f32>(member, false, error_message);
+        }
+        case EmbeddingDataType::kElemFloat16: {
+            return ConvertVector<Float16T>(member, false, error_message);
+        }
+        case EmbeddingDataType::kElemBFloat16: {
+            return ConvertVector<BFloat16T>(member, false, error_message);
+        }
+        default: {
+            error_message = "Only support float as the embedding data type";
+            return {0, nullptr};
+        }
+    }
+}
+
+bool HTTPJson::ParseInsertRows(std::string_view json, Vector<String> &columns, Vector<Vector<ParsedExpr *> *> &rows) {
+    if (ParseInsertRowsImpl(json, columns, rows)) {
+        return true;
+    }
+    for (auto *values_row : rows) {
+        for (auto *value_ptr : *values_row) {
+            delete value_ptr;
+        }
+        delete values_row;
+    }
+    rows.clear();
+    columns.clear();
+    return false;
+}
+
+} // namespace infinity
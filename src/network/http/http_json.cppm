@@ -0,0 +1,56 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+export module http_json;
+
+import stl;
+import internal_types;
+import parsed_expr;
+
+namespace infinity {
+
+export struct JsonMember {
+    String key_;
+    std::string_view raw_value_; // points into the parsed input
+
+    // Arrays are walked while listing, so that their content needs no parsing of its own.
+    bool is_array_{false};
+    bool all_numbers_{false};           // every element is a number, decoded into numbers_
+    bool all_integers_{false};          // ... and an integer
+    Vector<f64> numbers_;
+    bool all_objects_{false};           // every element is an object, whose members are listed into objects_
+    Vector<Vector<JsonMember>> objects_;
+};
+
+// On-demand (simdjson) parsing for the request bodies of the HTTP hot paths. Nothing here builds a DOM:
+// callers walk the raw members and only hand the small ones to nlohmann.
+export class HTTPJson {
+public:
+    // Lists the members of a JSON object in order, with their unparsed values, in a single pass over `json`.
+    // Returns false if `json` isn't exactly one object.
+    static bool ListMembers(std::string_view json, Vector<JsonMember> &members, String &error_message);
+
+    // Converts the numbers of a listed array member into a new[] allocated buffer of `elem_type`. Returns {0, nullptr} on error.
+    static Tuple<i64, void *> DecodeVector(const JsonMember &member, EmbeddingDataType elem_type, String &error_message);
+
+    // Parses an insert body made of rows with scalar, string and flat numeric array values into constant expressions.
+    // Returns false, leaving `columns` and `rows` empty, on anything else (sparse or tensor values, mismatching rows,
+    // malformed JSON ...) so that the caller can take the DOM path, which reports the exact error.
+    static bool ParseInsertRows(std::string_view json, Vector<String> &columns, Vector<Vector<ParsedExpr *> *> &rows);
+};
+
+} // namespace infinity
@@ -43,6 +43,7 @@ import physical_import;
 import explain_statement;
 import internal_types;
 import select_statement;
+import http_json;
 
 namespace infinity {
 
@@ -54,10 +55,13 @@ void HTTPSearch::Process(Infinity *infinity_ptr,
                          nlohmann::json &response) {
     http_status = HTTPStatus::CODE_500;
     try {
-        nlohmann::json input_json = nlohmann::json::parse(input_json_str);
-        if (!input_json.is_object()) {
+        // The body is parsed once: the search objects and their query vectors come listed along with the members.
+        Vector<JsonMember> members;
+        String error_message;
+        if (!HTTPJson::ListMembers(input_json_str, members, error_message)) {
             response["error_code"] = ErrorCode::kInvalidJsonFormat;
-            response["error_message"] = "HTTP Body isn't json object";
+            response["error_message"] = fmt::format("HTTP Body isn't json object: {}", error_message);
+            return;
         }
         UniquePtr<ParsedExpr> filter{};
         UniquePtr<ParsedExpr> limit{};
@@ -85,16 +89,30 @@ void HTTPSearch::Process(Infinity *infinity_ptr,
             }
         });
 
-        for (const auto &elem : input_json.items()) {
-            String key = elem.key();
+        for (const auto &member : members) {
+            String key = member.key_;
             ToLower(key);
+            if (IsEqual(key, "search")) {
+                if (search_expr) {
+                    response["error_code"] = ErrorCode::kInvalidExpression;
+                    response["error_message"] = "More than one search field.";
+                    return;
+                }
+                search_expr = ParseSearchExpr(member, http_status, response);
+                if (!search_expr) {
+                    return;
+                }
+                continue;
+            }
+
+            nlohmann::json elem_value = nlohmann::json::parse(member.raw_value_);
             if (IsEqual(key, "output")) {
                 if (output_columns != nullptr) {
                     response["error_code"] = ErrorCode::kInvalidExpression;
                     response["error_message"] = "More than one output field.";
                     return;
                 }
-                auto &output_list = elem.value();
+                auto &output_list = elem_value;
                 if (!output_list.is_array()) {
                     response["error_code"] = ErrorCode::kInvalidExpression;
                     response["error_message"] = "Output field should be array";
@@ -112,7 +130,7 @@ void HTTPSearch::Process(Infinity *infinity_ptr,
                     return;
                 }
 
-                auto &list = elem.value();
+                auto &list = elem_value;
                 if (!list.is_array()) {
                     response["error_code"] = ErrorCode::kInvalidExpression;
                     response["error_message"] = "Sort field should be array";
@@ -130,7 +148,7 @@ void HTTPSearch::Process(Infinity *infinity_ptr,
                     response["error_message"] = "More than one filter field.";
                     return;
                 }
-                filter = ParseFilter(elem.value(), http_status, response);
+                filter = ParseFilter(elem_value, http_status, response);
                 if (!filter) {
                     return;
                 }
@@ -141,7 +159,7 @@ void HTTPSearch::Process(Infinity *infinity_ptr,
                     response["error_message"] = "More than one limit field.";
                     return;
                 }
-                limit = ParseFilter(elem.value(), http_status, response);
+                limit = ParseFilter(elem_value, http_status, response);
                 if (!limit) {
                     return;
                 }
@@ -152,20 +170,10 @@ void HTTPSearch::Process(Infinity *infinity_ptr,
                     response["error_message"] = "More than one offset field.";
                     return;
                 }
-                offset = ParseFilter(elem.value(), http_status, response);
+                offset = ParseFilter(elem_value, http_status, response);
                 if (!offset) {
                     return;
                 }
-            } else if (IsEqual(key, "search")) {
-                if (search_expr) {
-                    response["error_code"] = ErrorCode::kInvalidExpression;
-                    response["error_message"] = "More than one search field.";
-                    return;
-                }
-                search_expr = ParseSearchExpr(elem.value(), http_status, response);
-                if (!search_expr) {
-                    return;
-                }
             } else {
                 response["error_code"] = ErrorCode::kInvalidExpression;
                 response["error_message"] = "Unknown expression: " + key;
@@ -531,57 +539,74 @@ UniquePtr<SearchExpr> HTTPSearch::ParseSearchExpr(const nlohmann::json &json_obj
     });
     child_expr->reserve(json_object.size());
     for (const auto &sub_search_it : json_object.items()) {
-        const auto &search_obj = sub_search_it.value();
-        if (!search_obj.is_object()) {
-            response["error_code"] = ErrorCode::kInvalidExpression;
-            response["error_message"] = "Search field should be list of objects";
+        auto sub_expr = ParseSearchItem(sub_search_it.value(), nullptr, http_status, response);
+        if (!sub_expr) {
             return {};
         }
-        if (search_obj.contains("fusion_method") && search_obj.contains("match_method")) {
-            response["error_code"] = ErrorCode::kInvalidExpression;
-            response["error_message"] = "Every single search expression should not contain both fusion_method and match_method fields";
-            return {};
-        }
-        if (search_obj.contains("fusion_method")) {
-            auto fusion_expr = ParseFusion(search_obj, http_status, response);
-            if (!fusion_expr) {
-                return {};
+        child_expr->push_back(sub_expr.release());
+    }
+    auto search_expr = MakeUnique<SearchExpr>();
+    try {
+        search_expr->SetExprs(child_expr);
+        child_expr = nullptr;
+    } catch (std::exception &e) {
+        response["error_code"] = ErrorCode::kInvalidExpression;
+        response["error_message"] = fmt::format("Invalid Search expression, error info: {}", e.what());
+        return nullptr;
+    }
+    return search_expr;
+}
+
+UniquePtr<SearchExpr> HTTPSearch::ParseSearchExpr(const JsonMember &search_member, HTTPStatus &http_status, nlohmann::json &response) {
+    if (!search_member.is_array_) {
+        response["error_code"] = ErrorCode::kInvalidExpression;
+        response["error_message"] = "Search field should be list";
+        return {};
+    }
+    if (!search_member.all_objects_) {
+        response["error_code"] = ErrorCode::kInvalidExpression;
+        response["error_message"] = "Search field should be list of objects";
+        return {};
+    }
+    auto child_expr = new std::vector<ParsedExpr *>();
+    DeferFn defer_fn([&] {
+        if (child_expr) {
+            for (const auto expr : *child_expr) {
+                delete expr;
             }
-            child_expr->push_back(fusion_expr.release());
-        } else {
-            // match type
-            String match_method = search_obj.at("match_method");
-            ToLower(match_method);
-            if (match_method == "dense") {
-                auto match_dense_expr = ParseMatchDense(search_obj, http_status, response);
-                if (!match_dense_expr) {
-                    return {};
-                }
-                child_expr->push_back(match_dense_expr.release());
-            } else if (match_method == "sparse") {
-                auto match_sparse_expr = ParseMatchSparse(search_obj, http_status, response);
-                if (!match_sparse_expr) {
-                    return {};
-                }
-                child_expr->push_back(match_sparse_expr.release());
-            } else if (match_method == "text") {
-                auto match_text_expr = ParseMatchText(search_obj, http_status, response);
-                if (!match_text_expr) {
-                    return {};
-                }
-                child_expr->push_back(match_text_expr.release());
-            } else if (match_method == "tensor") {
-                auto match_tensor_expr = ParseMatchTensor(search_obj, http_status, response);
-                if (!match_tensor_expr) {
-                    return {};
-                }
-                child_expr->push_back(match_tensor_expr.release());
+            delete child_expr;
+            child_expr = nullptr;
+        }
+    });
+    child_expr->reserve(search_member.objects_.size());
+    for (const auto &members : search_member.objects_) {
+        // Everything but the query vector is small, a DOM of it is cheap.
+        nlohmann::json search_obj = nlohmann::json::object();
+        const JsonMember *query_vector = nullptr;
+        for (const auto &member : members) {
+            String key = member.key_;
+            ToLower(key);
+            if (IsEqual(key, "query_vector")) {
+                query_vector = &member;
             } else {
-                response["error_code"] = ErrorCode::kInvalidExpression;
-                response["error_message"] = fmt::format("Unknown match method: {}", match_method);
-                return {};
+                search_obj[member.key_] = nlohmann::json::parse(member.raw_value_);
             }
         }
+        bool is_dense = false;
+        if (auto iter = search_obj.find("match_method"); iter != search_obj.end() && iter->is_string()) {
+            String match_method = *iter;
+            ToLower(match_method);
+            is_dense = IsEqual(match_method, "dense");
+        }
+        if (!is_dense && query_vector != nullptr) {
+            search_obj["query_vector"] = nlohmann::json::parse(query_vector->raw_value_);
+            query_vector = nullptr;
+        }
+        auto sub_expr = ParseSearchItem(search_obj, query_vector, http_status, response);
+        if (!sub_expr) {
+            return {};
+        }
+        child_expr->push_back(sub_expr.release());
     }
     auto search_expr = MakeUnique<SearchExpr>();
     try {
@@ -595,6 +620,38 @@ UniquePtr<SearchExpr> HTTPSearch::ParseSearchExpr(const nlohmann::json &json_obj
     return search_expr;
 }
 
+UniquePtr<ParsedExpr>
+HTTPSearch::ParseSearchItem(const nlohmann::json &search_obj, const JsonMember *query_vector, HTTPStatus &http_status, nlohmann::json &response) {
+    if (!search_obj.is_object()) {
+        response["error_code"] = ErrorCode::kInvalidExpression;
+        response["error_message"] = "Search field should be list of objects";
+        return nullptr;
+    }
+    if (search_obj.contains("fusion_method") && search_obj.contains("match_method")) {
+        response["error_code"] = ErrorCode::kInvalidExpression;
+        response["error_message"] = "Every single search expression should not contain both fusion_method and match_method fields";
+        return nullptr;
+    }
+    if (search_obj.contains("fusion_method")) {
+        return ParseFusion(search_obj, http_status, response);
+    }
+    // match type
+    String match_method = search_obj.at("match_method");
+    ToLower(match_method);
+    if (match_method == "dense") {
+        return ParseMatchDense(search_obj, http_status, response, query_vector);
+    } else if (match_method == "sparse") {
+        return ParseMatchSparse(search_obj, http_status, response);
+    } else if (match_method == "text") {
+        return ParseMatchText(search_obj, http_status, response);
+    } else if (match_method == "tensor") {
+        return ParseMatchTensor(search_obj, http_status, response);
+    }
+    response["error_code"] = ErrorCode::kInvalidExpression;
+    response["error_message"] = fmt::format("Unknown match method: {}", match_method);
+    return nullptr;
+}
+
 UniquePtr<FusionExpr> HTTPSearch::ParseFusion(const nlohmann::json &json_object, HTTPStatus &http_status, nlohmann::json &response) {
     if (!json_object.is_object()) {
         response["error_code"] = ErrorCode::kInvalidExpression;
@@ -676,7 +733,10 @@ UniquePtr<FusionExpr> HTTPSearch::ParseFusion(const nlohmann::json &json_object,
     return fusion_expr;
 }
 
-UniquePtr<KnnExpr> HTTPSearch::ParseMatchDense(const nlohmann::json &json_object, HTTPStatus &http_status, nlohmann::json &response) {
+UniquePtr<KnnExpr> HTTPSearch::ParseMatchDense(const nlohmann::json &json_object,
+                                                HTTPStatus &http_status,
+                                                nlohmann::json &response,
+                                                const JsonMember *query_vector) {
     if (!json_object.is_object()) {
         response["error_code"] = ErrorCode::kInvalidExpression;
         response["error_message"] = "MatchDense field should be object";
@@ -689,6 +749,9 @@ UniquePtr<KnnExpr> HTTPSearch::ParseMatchDense(const nlohmann::json &json_object
     // may have: "params"
     constexpr std::array possible_keys{"match_method", "fields", "query_vector", "element_type", "metric_type", "topn", "params"};
     std::set<String> possible_keys_set(possible_keys.begin(), possible_keys.end());
+    if (query_vector != nullptr) {
+        possible_keys_set.erase("query_vector");
+    }
     for (auto &field_json_obj : json_object.items()) {
         String key = field_json_obj.key();
         ToLower(key);
@@ -791,7 +854,18 @@ UniquePtr<KnnExpr> HTTPSearch::ParseMatchDense(const nlohmann::json &json_object
         return nullptr;
     }
     knn_expr->topn_ = topn;
-    const auto [dimension, embedding_ptr] = ParseVector(query_vector_json, knn_expr->embedding_data_type_, http_status, response);
+    i64 dimension = 0;
+    void *embedding_ptr = nullptr;
+    if (query_vector == nullptr) {
+        std::tie(dimension, embedding_ptr) = ParseVector(query_vector_json, knn_expr->embedding_data_type_, http_status, response);
+    } else {
+        String error_message;
+        std::tie(dimension, embedding_ptr) = HTTPJson::DecodeVector(*query_vector, knn_expr->embedding_data_type_, error_message);
+        if (embedding_ptr == nullptr) {
+            response["error_code"] = ErrorCode::kInvalidEmbeddingDataType;
+            response["error_message"] = error_message;
+        }
+    }
     if (embedding_ptr == nullptr) {
         return nullptr;
     }
@@ -30,6 +30,7 @@ import internal_types;
 import constant_expr;
 import search_expr;
 import select_statement;
+import http_json;
 
 namespace infinity {
 
@@ -52,8 +53,15 @@ public:
     static Vector<OrderByExpr *> *ParseSort(const nlohmann::json &json_object, HTTPStatus &http_status, nlohmann::json &response);
     static UniquePtr<ParsedExpr> ParseFilter(const nlohmann::json &json_object, HTTPStatus &http_status, nlohmann::json &response);
     static UniquePtr<SearchExpr> ParseSearchExpr(const nlohmann::json &json_object, HTTPStatus &http_status, nlohmann::json &response);
+    static UniquePtr<SearchExpr> ParseSearchExpr(const JsonMember &search_member, HTTPStatus &http_status, nlohmann::json &response);
+    // `query_vector`, if set, is the listed query vector of a search object from which it was taken out.
+    static UniquePtr<ParsedExpr>
+    ParseSearchItem(const nlohmann::json &search_obj, const JsonMember *query_vector, HTTPStatus &http_status, nlohmann::json &response);
     static UniquePtr<FusionExpr> ParseFusion(const nlohmann::json &json_object, HTTPStatus &http_status, nlohmann::json &response);
-    static UniquePtr<KnnExpr> ParseMatchDense(const nlohmann::json &json_object, HTTPStatus &http_status, nlohmann::json &response);
+    static UniquePtr<KnnExpr> ParseMatchDense(const nlohmann::json &json_object,
+                                              HTTPStatus &http_status,
+                                              nlohmann::json &response,
+                                              const JsonMember *query_vector = nullptr);
     static UniquePtr<MatchExpr> ParseMatchText(const nlohmann::json &json_object, HTTPStatus &http_status, nlohmann::json &response);
     static UniquePtr<MatchTensorExpr> ParseMatchTensor(const nlohmann::json &json_object, HTTPStatus &http_status, nlohmann::json &response);
     static UniquePtr<MatchSparseExpr> ParseMatchSparse(const nlohmann::json &json_object, HTTPStatus &http_status, nlohmann::json &response);
@@ -48,6 +48,7 @@ import statement_common;
 import extra_ddl_info;
 import update_statement;
 import http_search;
+import http_json;
 import knn_expr;
 import function_expr;
 import column_expr;
@@ -848,6 +849,28 @@ public:
         HTTPStatus http_status = HTTPStatus::CODE_500;
 
         String data_body = request->readBodyToString();
+
+        // Rows of scalars and flat vectors are decoded without a DOM, anything else takes the path below.
+        {
+            auto *columns = new Vector<String>();
+            auto *column_values = new Vector<Vector<ParsedExpr *> *>();
+            if (HTTPJson::ParseInsertRows(data_body, *columns, *column_values)) {
+                auto database_name = request->getPathVariable("database_name");
+                auto table_name = request->getPathVariable("table_name");
+                auto result = infinity->Insert(database_name, table_name, columns, column_values);
+                if (result.IsOk()) {
+                    json_response["error_code"] = 0;
+                    http_status = HTTPStatus::CODE_200;
+                } else {
+                    json_response["error_code"] = result.ErrorCode();
+                    json_response["error_message"] = result.ErrorMsg();
+                }
+                return ResponseFactory::createResponse(http_status, json_response.dump());
+            }
+            delete columns;
+            delete column_values;
+        }
+
         try {
             nlohmann::json http_body_json = nlohmann::json::parse(data_body);
 
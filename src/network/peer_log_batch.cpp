@@ -0,0 +1,148 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+#include "snappy/snappy.h"
+#include <cstring>
+
+module peer_log_batch;
+
+import stl;
+import status;
+import third_party;
+
+namespace infinity {
+
+Vector<SharedPtr<String>> PeerLogBatch::Pack(const Vector<SharedPtr<String>> &logs, SizeT batch_bytes, bool compress) {
+    Vector<SharedPtr<String>> frames;
+    for (SizeT next_idx = 0; next_idx < logs.size();) {
+        frames.emplace_back(PackNext(logs, next_idx, batch_bytes, compress));
+    }
+    return frames;
+}
+
+SharedPtr<String> PeerLogBatch::PackNext(const Vector<SharedPtr<String>> &logs, SizeT &next_idx, SizeT batch_bytes, bool compress) {
+    String payload;
+    u32 entry_count = 0;
+    for (; next_idx < logs.size(); ++next_idx) {
+        const auto &log_str = logs[next_idx];
+        if (entry_count > 0 && payload.size() + sizeof(u32) + log_str->size() > batch_bytes) {
+            break;
+        }
+        u32 entry_size = log_str->size();
+        payload.append(reinterpret_cast<const char *>(&entry_size), sizeof(entry_size));
+        payload.append(*log_str);
+        ++entry_count;
+    }
+    return MakeFrame(payload, entry_count, compress);
+}
+
+SharedPtr<String> PeerLogBatch::MakeFrame(const String &payload, u32 entry_count, bool compress) {
+    String compressed;
+    u8 codec = kCodecNone;
+    if (compress && payload.size() >= kMinCompressBytes) {
+        snappy::Compress(payload.data(), payload.size(), &compressed);
+        if (compressed.size() < payload.size()) {
+            codec = kCodecSnappy;
+        }
+    }
+    const String &body = codec == kCodecSnappy ? compressed : payload;
+
+    auto frame = MakeShared<String>();
+    frame->resize(kFrameHeaderSize + body.size());
+    char *ptr = frame->data();
+    const i32 magic = kFrameMagic;
+    const u32 raw_size = payload.size();
+    std::memcpy(ptr, &magic, sizeof(magic));
+    ptr += sizeof(magic);
+    std::memcpy(ptr, &codec, sizeof(codec));
+    ptr += sizeof(codec);
+    std::memcpy(ptr, &entry_count, sizeof(entry_count));
+    ptr += sizeof(entry_count);
+    std::memcpy(ptr, &raw_size, sizeof(raw_size));
+    ptr += sizeof(raw_size);
+    std::memcpy(ptr, body.data(), body.size());
+    return frame;
+}
+
+bool PeerLogBatch::IsFrame(const String &log_str) {
+    if (log_str.size() < kFrameHeaderSize) {
+        return false;
+    }
+    i32 magic = 0;
+    std::memcpy(&magic, log_str.data(), sizeof(magic));
+    return magic == kFrameMagic;
+}
+
+Status PeerLogBatch::Unpack(const String &frame, Vector<String> &logs) {
+    if (!IsFrame(frame)) {
+        return Status::DataCorrupted("WAL batch frame: bad header");
+    }
+    const char *ptr = frame.data() + sizeof(i32);
+    u8 codec = 0;
+    u32 entry_count = 0;
+    u32 raw_size = 0;
+    std::memcpy(&codec, ptr, sizeof(codec));
+    ptr += sizeof(codec);
+    std::memcpy(&entry_count, ptr, sizeof(entry_count));
+    ptr += sizeof(entry_count);
+    std::memcpy(&raw_size, ptr, sizeof(raw_size));
+    ptr += sizeof(raw_size);
+    const SizeT body_size = frame.size() - kFrameHeaderSize;
+
+    String uncompressed;
+    const char *payload = ptr;
+    switch (codec) {
+        case kCodecNone: {
+            if (body_size != raw_size) {
+                return Status::DataCorrupted(fmt::format("WAL batch frame: payload size {} mismatches {}", body_size, raw_size));
+            }
+            break;
+        }
+        case kCodecSnappy: {
+            if (!snappy::Uncompress(ptr, body_size, &uncompressed) || uncompressed.size() != raw_size) {
+                return Status::DataCorrupted("WAL batch frame: can't decompress payload");
+            }
+            payload = uncompressed.data();
+            break;
+        }
+        default: {
+            return Status::DataCorrupted(fmt::format("WAL batch frame: unknown codec {}", codec));
+        }
+    }
+
+    const char *const payload_end = payload + raw_size;
+    logs.reserve(logs.size() + entry_count);
+    for (u32 i = 0; i < entry_count; ++i) {
+        u32 entry_size = 0;
+        if (payload_end - payload < static_cast<i64>(sizeof(entry_size))) {
+            return Status::DataCorrupted("WAL batch frame: truncated payload");
+        }
+        std::memcpy(&entry_size, payload, sizeof(entry_size));
+        payload += sizeof(entry_size);
+        if (payload_end - payload < static_cast<i64>(entry_size)) {
+            return Status::DataCorrupted("WAL batch frame: truncated entry");
+        }
+        logs.emplace_back(payload, entry_size);
+        payload += entry_size;
+    }
+    if (payload != payload_end) {
+        return Status::DataCorrupted("WAL batch frame: trailing bytes");
+    }
+    return Status::OK();
+}
+
+} // namespace infinity
@@ -0,0 +1,61 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+export module peer_log_batch;
+
+import stl;
+import status;
+
+namespace infinity {
+
+// Packs serialized WAL entries into size bounded, optionally snappy compressed frames for log shipping.
+//
+// Frames travel in SyncLogRequest::log_entries next to plain entries. A plain entry starts with its
+// positive i32 size, while a frame starts with kFrameMagic, which is negative. Frame layout:
+//   i32 magic | u8 codec | u32 entry count | u32 raw payload size | payload
+// and the raw payload is `u32 entry size | entry` repeated entry count times.
+export class PeerLogBatch {
+public:
+    // Sent by a node on registration. Nodes that don't send it only decode plain entries.
+    static constexpr i64 kVersion = 1;
+
+    static constexpr i32 kFrameMagic = static_cast<i32>(0xB1A7C0DEu);
+    static constexpr u8 kCodecNone = 0;
+    static constexpr u8 kCodecSnappy = 1;
+    static constexpr SizeT kFrameHeaderSize = sizeof(i32) + sizeof(u8) + sizeof(u32) + sizeof(u32);
+
+    static constexpr SizeT kDefaultBatchBytes = 4UL * 1024 * 1024;
+    // Payloads smaller than this are not worth compressing.
+    static constexpr SizeT kMinCompressBytes = 1024;
+
+    // Splits `logs` into frames of at most `batch_bytes` raw payload each, entries larger than that get a frame of their own.
+    static Vector<SharedPtr<String>> Pack(const Vector<SharedPtr<String>> &logs, SizeT batch_bytes = kDefaultBatchBytes, bool compress = true);
+
+    // Packs the next frame from `logs[next_idx]` on and advances `next_idx` past the packed entries.
+    static SharedPtr<String>
+    PackNext(const Vector<SharedPtr<String>> &logs, SizeT &next_idx, SizeT batch_bytes = kDefaultBatchBytes, bool compress = true);
+
+    static bool IsFrame(const String &log_str);
+
+    // Appends the entries of `frame` to `logs`.
+    static Status Unpack(const String &frame, Vector<String> &logs);
+
+private:
+    static SharedPtr<String> MakeFrame(const String &payload, u32 entry_count, bool compress);
+};
+
+} // namespace infinity
@@ -317,6 +317,10 @@ void RegisterRequest::__set_node_port(const int64_t val) {
 void RegisterRequest::__set_txn_timestamp(const int64_t val) {
   this->txn_timestamp = val;
 }
+
+void RegisterRequest::__set_log_batch_version(const int64_t val) {
+  this->log_batch_version = val;
+}
 std::ostream& operator<<(std::ostream& out, const RegisterRequest& obj)
 {
   obj.printTo(out);
@@ -387,6 +391,14 @@ uint32_t RegisterRequest::read(::apache::thrift::protocol::TProtocol* iprot) {
           xfer += iprot->skip(ftype);
         }
         break;
+      case 6:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->log_batch_version);
+          this->__isset.log_batch_version = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
       default:
         xfer += iprot->skip(ftype);
         break;
@@ -424,6 +436,10 @@ uint32_t RegisterRequest::write(::apache::thrift::protocol::TProtocol* oprot) co
   xfer += oprot->writeI64(this->txn_timestamp);
   xfer += oprot->writeFieldEnd();
 
+  xfer += oprot->writeFieldBegin("log_batch_version", ::apache::thrift::protocol::T_I64, 6);
+  xfer += oprot->writeI64(this->log_batch_version);
+  xfer += oprot->writeFieldEnd();
+
   xfer += oprot->writeFieldStop();
   xfer += oprot->writeStructEnd();
   return xfer;
@@ -436,6 +452,7 @@ void swap(RegisterRequest &a, RegisterRequest &b) {
   swap(a.node_ip, b.node_ip);
   swap(a.node_port, b.node_port);
   swap(a.txn_timestamp, b.txn_timestamp);
+  swap(a.log_batch_version, b.log_batch_version);
   swap(a.__isset, b.__isset);
 }
 
@@ -445,6 +462,7 @@ RegisterRequest::RegisterRequest(const RegisterRequest& other5) {
   node_ip = other5.node_ip;
   node_port = other5.node_port;
   txn_timestamp = other5.txn_timestamp;
+  log_batch_version = other5.log_batch_version;
   __isset = other5.__isset;
 }
 RegisterRequest& RegisterRequest::operator=(const RegisterRequest& other6) {
@@ -453,6 +471,7 @@ RegisterRequest& RegisterRequest::operator=(const RegisterRequest& other6) {
   node_ip = other6.node_ip;
   node_port = other6.node_port;
   txn_timestamp = other6.txn_timestamp;
+  log_batch_version = other6.log_batch_version;
   __isset = other6.__isset;
   return *this;
 }
@@ -464,6 +483,7 @@ void RegisterRequest::printTo(std::ostream& out) const {
   out << ", " << "node_ip=" << to_string(node_ip);
   out << ", " << "node_port=" << to_string(node_port);
   out << ", " << "txn_timestamp=" << to_string(txn_timestamp);
+  out << ", " << "log_batch_version=" << to_string(log_batch_version);
   out << ")";
 }
 
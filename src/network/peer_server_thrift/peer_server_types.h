@@ -170,12 +170,13 @@ void swap(NodeInfo &a, NodeInfo &b);
 std::ostream& operator<<(std::ostream& out, const NodeInfo& obj);
 
 typedef struct _RegisterRequest__isset {
-  _RegisterRequest__isset() : node_name(false), node_type(false), node_ip(false), node_port(false), txn_timestamp(false) {}
+  _RegisterRequest__isset() : node_name(false), node_type(false), node_ip(false), node_port(false), txn_timestamp(false), log_batch_version(true) {}
   bool node_name :1;
   bool node_type :1;
   bool node_ip :1;
   bool node_port :1;
   bool txn_timestamp :1;
+  bool log_batch_version :1;
 } _RegisterRequest__isset;
 
 class RegisterRequest : public virtual ::apache::thrift::TBase {
@@ -188,7 +189,8 @@ class RegisterRequest : public virtual ::apache::thrift::TBase {
                     node_type(static_cast<NodeType::type>(0)),
                     node_ip(),
                     node_port(0),
-                    txn_timestamp(0) {
+                    txn_timestamp(0),
+                    log_batch_version(0LL) {
   }
 
   virtual ~RegisterRequest() noexcept;
@@ -201,6 +203,7 @@ class RegisterRequest : public virtual ::apache::thrift::TBase {
   std::string node_ip;
   int64_t node_port;
   int64_t txn_timestamp;
+  int64_t log_batch_version;
 
   _RegisterRequest__isset __isset;
 
@@ -214,6 +217,8 @@ class RegisterRequest : public virtual ::apache::thrift::TBase {
 
   void __set_txn_timestamp(const int64_t val);
 
+  void __set_log_batch_version(const int64_t val);
+
   bool operator == (const RegisterRequest & rhs) const
   {
     if (!(node_name == rhs.node_name))
@@ -226,6 +231,8 @@ class RegisterRequest : public virtual ::apache::thrift::TBase {
       return false;
     if (!(txn_timestamp == rhs.txn_timestamp))
       return false;
+    if (!(log_batch_version == rhs.log_batch_version))
+      return false;
     return true;
   }
   bool operator != (const RegisterRequest &rhs) const {
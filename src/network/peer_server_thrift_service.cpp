@@ -55,6 +55,7 @@ void PeerServerThriftService::Register(infinity_peer_server::RegisterResponse &r
         non_leader_node_info->port_ = request.node_port;
         non_leader_node_info->node_status_ = NodeStatus::kAlive;
         non_leader_node_info->txn_timestamp_ = request.txn_timestamp;
+        non_leader_node_info->log_batch_version_ = request.log_batch_version;
 
         auto now = std::chrono::system_clock::now();
         auto time_since_epoch = now.time_since_epoch();
@@ -53,6 +53,7 @@ export struct NodeInfo {
     String ip_address_{};
     i64 port_{};
     i64 txn_timestamp_{};
+    i64 log_batch_version_{}; // PeerLogBatch version the node decodes, 0 for plain log entries only
     u64 last_update_ts_{};
     i64 leader_term_{};
     i64 heartbeat_interval_{}; // provide by leader and used by follower and learner;
@@ -70,11 +71,16 @@ public:
         if (async_) {
             return;
         }
-        complete_ = false;
         std::unique_lock<std::mutex> locker(mutex_);
         cv_.wait(locker, [this] { return complete_; });
     }
 
+    // A queued task may complete before it's waited for.
+    bool IsComplete() const {
+        std::unique_lock<std::mutex> locker(mutex_);
+        return complete_;
+    }
+
     void Complete() {
         if (async_) {
             return;
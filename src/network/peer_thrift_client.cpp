@@ -24,6 +24,7 @@ import status;
 import thrift;
 import infinity_exception;
 import peer_task;
+import peer_log_batch;
 
 namespace infinity {
 
@@ -174,6 +175,7 @@ void PeerClient::Register(RegisterPeerTask *peer_task) {
     request.node_ip = peer_task->node_ip_;
     request.node_port = peer_task->node_port_;
     request.txn_timestamp = peer_task->txn_ts_;
+    request.log_batch_version = PeerLogBatch::kVersion;
 
     RegisterResponse response;
 
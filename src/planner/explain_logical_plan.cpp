@@ -928,7 +928,9 @@ Status ExplainLogicalPlan::Explain(const LogicalKnnScan *knn_scan_node, SharedPt
     // Query embedding
     String query_embedding = String(intent_size + 2, ' ');
     query_embedding += " - query embedding: ";
-    query_embedding += EmbeddingT::Embedding2String(knn_expr_raw->query_embedding_, knn_expr_raw->embedding_data_type_, knn_expr_raw->dimension_);
+    query_embedding += EmbeddingT::Embedding2String(knn_expr_raw->query_embedding_,
+                                                    knn_expr_raw->embedding_data_type_,
+                                                    knn_expr_raw->dimension_ * knn_expr_raw->query_embedding_count_);
     result->emplace_back(MakeShared<String>(query_embedding));
 
     // filter expression
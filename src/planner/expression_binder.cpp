@@ -734,12 +734,22 @@ SharedPtr<BaseExpression> ExpressionBinder::BuildKnnExpr(const KnnExpr &parsed_k
     }
     auto expr_ptr = BuildColExpr((ColumnExpr &)*parsed_knn_expr.column_expr_, bind_context_ptr, depth, false);
     TypeInfo *type_info = expr_ptr->Type().type_info().get();
+    i64 query_dimension = parsed_knn_expr.dimension_;
+    i64 query_embedding_count = 1;
     if (type_info == nullptr or type_info->type() != TypeInfoType::kEmbedding) {
         Status status = Status::SyntaxError("Expect the column search is an embedding column");
         RecoverableError(status);
     } else {
         EmbeddingInfo *embedding_info = (EmbeddingInfo *)type_info;
-        if ((i64)embedding_info->Dimension() != parsed_knn_expr.dimension_) {
+        const i64 column_dimension = embedding_info->Dimension();
+        // several queries of an embedding column are given one after another in the query vector,
+        // the result is the topn rows nearest to any of them
+        if (expr_ptr->Type().type() == LogicalType::kEmbedding && column_dimension > 0 && parsed_knn_expr.dimension_ > column_dimension &&
+            parsed_knn_expr.dimension_ % column_dimension == 0) {
+            query_dimension = column_dimension;
+            query_embedding_count = parsed_knn_expr.dimension_ / column_dimension;
+        }
+        if (column_dimension != query_dimension) {
             Status status = Status::SyntaxError(fmt::format("Query embedding with dimension: {} which doesn't not matched with {}",
                                                             parsed_knn_expr.dimension_,
                                                             embedding_info->Dimension()));
@@ -768,7 +778,8 @@ SharedPtr<BaseExpression> ExpressionBinder::BuildKnnExpr(const KnnExpr &parsed_k
     auto optional_filter = BuildSearchSubExprOptionalFilter(this, parsed_knn_expr.filter_expr_.get(), bind_context_ptr, depth);
 
     SharedPtr<KnnExpression> bound_knn_expr = MakeShared<KnnExpression>(parsed_knn_expr.embedding_data_type_,
-                                                                        parsed_knn_expr.dimension_,
+                                                                        query_dimension,
+                                                                        query_embedding_count,
                                                                         parsed_knn_expr.distance_type_,
                                                                         std::move(query_embedding),
                                                                         std::move(arguments),
@@ -28,6 +28,8 @@ import function_expression;
 import filter_expression_push_down_helper;
 import infinity_exception;
 import third_party;
+import like;
+import block_zone_map;
 
 namespace infinity {
 
@@ -36,6 +38,7 @@ public:
     FastRoughFilterEvaluatorTrue() : FastRoughFilterEvaluator(FastRoughFilterEvaluatorTag::kAlwaysTrue) {}
     ~FastRoughFilterEvaluatorTrue() override = default;
     bool EvaluateInner(TxnTimeStamp, const FastRoughFilter &) const override { return true; }
+    bool EvaluateZoneMapInner(const BlockZoneMap &) const override { return true; }
 };
 
 class FastRoughFilterEvaluatorFalse final : public FastRoughFilterEvaluator {
@@ -43,6 +46,7 @@ public:
     FastRoughFilterEvaluatorFalse() : FastRoughFilterEvaluator(FastRoughFilterEvaluatorTag::kAlwaysFalse) {}
     ~FastRoughFilterEvaluatorFalse() override = default;
     bool EvaluateInner(TxnTimeStamp, const FastRoughFilter &) const override { return false; }
+    bool EvaluateZoneMapInner(const BlockZoneMap &) const override { return false; }
 };
 
 class FastRoughFilterEvaluatorCombineAnd final : public FastRoughFilterEvaluator {
@@ -56,6 +60,9 @@ public:
     bool EvaluateInner(TxnTimeStamp query_ts, const FastRoughFilter &filter) const override {
         return left_->EvaluateInner(query_ts, filter) and right_->EvaluateInner(query_ts, filter);
     }
+    bool EvaluateZoneMapInner(const BlockZoneMap &zone_map) const override {
+        return left_->EvaluateZoneMapInner(zone_map) and right_->EvaluateZoneMapInner(zone_map);
+    }
 };
 
 class FastRoughFilterEvaluatorCombineOr final : public FastRoughFilterEvaluator {
@@ -69,6 +76,9 @@ public:
     bool EvaluateInner(TxnTimeStamp query_ts, const FastRoughFilter &filter) const override {
         return left_->EvaluateInner(query_ts, filter) or right_->EvaluateInner(query_ts, filter);
     }
+    bool EvaluateZoneMapInner(const BlockZoneMap &zone_map) const override {
+        return left_->EvaluateZoneMapInner(zone_map) or right_->EvaluateZoneMapInner(zone_map);
+    }
 };
 
 // fast "equal" filter
@@ -83,6 +93,8 @@ public:
     bool EvaluateInner(TxnTimeStamp query_ts, const FastRoughFilter &filter) const override {
         return filter.MayContain(query_ts, column_id_, value_);
     }
+    // the zone map has no bloom filter
+    bool EvaluateZoneMapInner(const BlockZoneMap &) const override { return true; }
 };
 
 // fast "range" filter
@@ -99,6 +111,9 @@ public:
     bool EvaluateInner(TxnTimeStamp query_ts, const FastRoughFilter &filter) const override {
         return filter.MayInRange(column_id_, value_, compare_type_);
     }
+    bool EvaluateZoneMapInner(const BlockZoneMap &zone_map) const override {
+        return zone_map.MayInRange(column_id_, value_, compare_type_);
+    }
 };
 
 struct ExpressionFastRoughFilterInfo {
@@ -115,6 +130,9 @@ struct ExpressionFastRoughFilterInfo {
         kColumnValueCompareExpr,
         kValueColumnCompareExpr,
 
+        // "x like pattern"
+        kColumnLikeExpr,
+
         // logical expr ("not" is treated as unknown)
         kAndExpr,
         kOrExpr,
@@ -181,6 +199,11 @@ struct ExpressionFastRoughFilterInfo {
                         } else if (tree.children[0].info == Enum::kValueExpr and tree.children[1].info == Enum::kColumnExprOrAfterCast) {
                             tree.info = Enum::kValueColumnCompareExpr;
                         }
+                    } else if (f_name == "like") {
+                        if (expression->arguments()[0]->type() == ExpressionType::kColumn and
+                            tree.children[0].info == Enum::kColumnExprOrAfterCast and tree.children[1].info == Enum::kValueExpr) {
+                            tree.info = Enum::kColumnLikeExpr;
+                        }
                     }
                 }
                 break;
@@ -339,6 +362,38 @@ class FastRoughFilterExpressionPushDownMethod {
                 UnrecoverableError("Wrong function name!");
                 return {};
             }
+            case Enum::kColumnLikeExpr: {
+                // "x like 'abc%'" can only match "abc" <= x <= "abc\xFF\xFF...", "x like 'abc'" is "x = 'abc'"
+                auto *function_expression = static_cast<FunctionExpression *>(tree_node.src_ptr->get());
+                auto &col_expr = function_expression->arguments()[0];
+                auto pattern = FilterExpressionPushDownHelper::CalcValueResult(function_expression->arguments()[1]);
+                if (pattern.type().type() != LogicalType::kVarchar) {
+                    return ReturnAlwaysTrue();
+                }
+                bool exact = false;
+                String prefix = LikeLiteralPrefix(pattern.GetVarchar(), exact);
+                if (prefix.empty()) {
+                    return ReturnAlwaysTrue();
+                }
+                auto [column_id, lower_value, lower_compare_type] =
+                    FilterExpressionPushDownHelper::UnwindCast(col_expr, Value::MakeVarchar(prefix), FilterCompareType::kGreaterEqual);
+                UniquePtr<FastRoughFilterEvaluator> result =
+                    MakeUnique<FastRoughFilterEvaluatorMinMaxFilter>(column_id, std::move(lower_value), lower_compare_type);
+                if (exact) {
+                    auto minmax_filter_le =
+                        MakeUnique<FastRoughFilterEvaluatorMinMaxFilter>(column_id, Value::MakeVarchar(prefix), FilterCompareType::kLessEqual);
+                    auto bloom_filter = MakeUnique<FastRoughFilterEvaluatorProbabilisticDataFilter>(column_id, Value::MakeVarchar(prefix));
+                    result = MakeUnique<FastRoughFilterEvaluatorCombineAnd>(std::move(result), std::move(minmax_filter_le));
+                    return MakeUnique<FastRoughFilterEvaluatorCombineAnd>(std::move(bloom_filter), std::move(result));
+                }
+                // the min-max filter compares bytes as unsigned, so no value which starts with the prefix is above prefix + 0xFF...
+                // the filter compares at most 16 bytes, a longer upper bound is truncated there
+                auto [_, upper_value, upper_compare_type] = FilterExpressionPushDownHelper::UnwindCast(
+                    col_expr, Value::MakeVarchar(prefix + String(16, static_cast<char>(0xFF))), FilterCompareType::kLessEqual);
+                auto minmax_filter_le = MakeUnique<FastRoughFilterEvaluatorMinMaxFilter>(column_id, std::move(upper_value), upper_compare_type);
+                result = MakeUnique<FastRoughFilterEvaluatorCombineAnd>(std::move(result), std::move(minmax_filter_le));
+                return result;
+            }
             case Enum::kAndExpr: {
                 std::vector<UniquePtr<FastRoughFilterEvaluator>> children;
                 for (const auto &child : tree_node.children) {
@@ -401,6 +456,7 @@ public:
         // known expression 1: "[cast] x equal value_expr" for ProbabilisticDataFilter, also need to build a val <= x <= val filter for MinMaxFilter
         // known expression 2: "[cast] x compare (>, <, >=, <=) value_expr" for MinMaxFilter
         // known expression 3 : "and" or "or" expression
+        // known expression 4: "x like pattern" with a literal prefix for MinMaxFilter
         ExpressionFastRoughFilterInfo tree_info;
         const auto tree = tree_info.BuildTree(expression);
         return GetFastRoughFilterFromtreeNode(tree);
@@ -512,7 +512,39 @@ private:
                         minimum_should_match_option = ParseMinimumShouldMatchOption(iter->second);
                     }
 
-                    SearchDriver search_driver(column2analyzer, default_field, query_operator_option);
+                    // option: wildcard
+                    bool wildcard = false;
+                    if (iter = search_ops.options_.find("wildcard"); iter != search_ops.options_.end()) {
+                        ToLower(iter->second);
+                        if (iter->second == "true") {
+                            wildcard = true;
+                        } else if (iter->second != "false") {
+                            RecoverableError(Status::SyntaxError(R"(wildcard option must be "true" or "false".)"));
+                        }
+                    }
+
+                    // option: fuzzy
+                    bool fuzzy = false;
+                    if (iter = search_ops.options_.find("fuzzy"); iter != search_ops.options_.end()) {
+                        ToLower(iter->second);
+                        if (iter->second == "true") {
+                            fuzzy = true;
+                        } else if (iter->second != "false") {
+                            RecoverableError(Status::SyntaxError(R"(fuzzy option must be "true" or "false".)"));
+                        }
+                    }
+
+                    // option: max_expansions
+                    u32 max_expansions = MultiTermQueryNode::kDefaultMaxExpansions;
+                    if (iter = search_ops.options_.find("max_expansions"); iter != search_ops.options_.end()) {
+                        i32 max_expansions_option = std::strtol(iter->second.c_str(), nullptr, 0);
+                        if (max_expansions_option <= 0) {
+                            RecoverableError(Status::SyntaxError("max_expansions must be a positive integer"));
+                        }
+                        max_expansions = max_expansions_option;
+                    }
+
+                    SearchDriver search_driver(column2analyzer, default_field, query_operator_option, wildcard, max_expansions, fuzzy);
                     query_tree = search_driver.ParseSingleWithFields(filter_fulltext_expr->fields_, filter_fulltext_expr->matching_text_);
                     if (!query_tree) {
                         RecoverableError(Status::ParseMatchExprFailed(filter_fulltext_expr->fields_, filter_fulltext_expr->matching_text_));
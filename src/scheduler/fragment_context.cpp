@@ -41,6 +41,8 @@ import physical_create_index_do;
 import physical_sort;
 import physical_top;
 import physical_merge_top;
+import physical_filter;
+import physical_project;
 import physical_match_tensor_scan;
 import physical_match_sparse_scan;
 import physical_compact;
@@ -267,6 +269,23 @@ UniquePtr<OperatorState> MakeSortState(PhysicalOperator *physical_op) {
     return operator_state;
 }
 
+UniquePtr<OperatorState> MakeFilterState(PhysicalOperator *physical_op) {
+    auto operator_state = MakeUnique<FilterOperatorState>();
+    operator_state->condition_state_ = ExpressionState::CreateState((static_cast<PhysicalFilter *>(physical_op))->condition());
+    return operator_state;
+}
+
+UniquePtr<OperatorState> MakeProjectionState(PhysicalOperator *physical_op) {
+    auto operator_state = MakeUnique<ProjectionOperatorState>();
+    auto &expr_states = operator_state->expr_states_;
+    auto &expressions = (static_cast<PhysicalProject *>(physical_op))->expressions_;
+    expr_states.reserve(expressions.size());
+    for (auto &expr : expressions) {
+        expr_states.emplace_back(ExpressionState::CreateState(expr));
+    }
+    return operator_state;
+}
+
 UniquePtr<OperatorState> MakeTopState(PhysicalOperator *physical_op) {
     auto operator_state = MakeUnique<TopOperatorState>();
     auto &expr_states = operator_state->expr_states_;
@@ -328,7 +347,7 @@ MakeTaskState(SizeT operator_id, const Vector<PhysicalOperator *> &physical_ops,
             return MakeTaskStateTemplate<MergeParallelAggregateOperatorState>(physical_ops[operator_id]);
         }
         case PhysicalOperatorType::kFilter: {
-            return MakeTaskStateTemplate<FilterOperatorState>(physical_ops[operator_id]);
+            return MakeFilterState(physical_ops[operator_id]);
         }
         case PhysicalOperatorType::kIndexScan: {
             if (operator_id != physical_ops.size() - 1) {
@@ -380,7 +399,7 @@ MakeTaskState(SizeT operator_id, const Vector<PhysicalOperator *> &physical_ops,
             return MakeMergeMatchSparseState(physical_ops[operator_id]);
         }
         case PhysicalOperatorType::kProjection: {
-            return MakeTaskStateTemplate<ProjectionOperatorState>(physical_ops[operator_id]);
+            return MakeProjectionState(physical_ops[operator_id]);
         }
         case PhysicalOperatorType::kSort: {
             return MakeSortState(physical_ops[operator_id]);
@@ -689,7 +708,7 @@ SizeT InitKnnScanFragmentContext(PhysicalKnnScan *knn_scan_operator, FragmentCon
                                               std::move(knn_expr->opt_params_),
                                               knn_expr->topn_,
                                               knn_expr->dimension_,
-                                              1,
+                                              knn_expr->query_embedding_count_,
                                               knn_scan_operator->real_knn_query_embedding_ptr_,
                                               knn_scan_operator->real_knn_query_elem_type_,
                                               knn_expr->distance_type_);
@@ -704,7 +723,7 @@ SizeT InitKnnScanFragmentContext(PhysicalKnnScan *knn_scan_operator, FragmentCon
                                               std::move(knn_expr->opt_params_),
                                               knn_expr->topn_,
                                               knn_expr->dimension_,
-                                              1,
+                                              knn_expr->query_embedding_count_,
                                               knn_scan_operator->real_knn_query_embedding_ptr_,
                                               knn_scan_operator->real_knn_query_elem_type_,
                                               knn_expr->distance_type_);
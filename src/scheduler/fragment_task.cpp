@@ -65,7 +65,10 @@ void FragmentTask::OnExecute() {
     }
 
     bool execute_success{false};
-    source_op->Execute(query_context, source_state_.get());
+    const i64 first_op_idx = FirstOperatorToExecute();
+    if (first_op_idx == operator_count_ - 1) {
+        source_op->Execute(query_context, source_state_.get());
+    }
     Status operator_status{};
     if (source_state_->status_.ok()) {
         // No source error
@@ -76,7 +79,7 @@ void FragmentTask::OnExecute() {
         HashMap<SizeT, SharedPtr<BaseTableRef>> table_refs;
         profiler.Begin();
         try {
-            for (i64 op_idx = operator_count_ - 1; op_idx >= 0; --op_idx) {
+            for (i64 op_idx = first_op_idx; op_idx >= 0; --op_idx) {
                 profiler.StartOperator(operator_refs[op_idx]);
                 DeferFn defer_fn([&]() { profiler.StopOperator(operator_states_[op_idx].get()); });
 
@@ -141,6 +144,10 @@ bool FragmentTask::QuitFromWorkerLoop() {
         // fragment's source is not from queue
         return false;
     }
+    if (FirstOperatorToExecute() != operator_count_ - 1) {
+        // the source is done but an operator still has output
+        return false;
+    }
     auto *queue_state = static_cast<QueueSourceState *>(source_state_.get());
 
     std::unique_lock lock(mutex_);
@@ -153,6 +160,14 @@ bool FragmentTask::QuitFromWorkerLoop() {
     return false;
 }
 
+i64 FragmentTask::FirstOperatorToExecute() const {
+    i64 op_idx = operator_count_ - 1;
+    while (op_idx > 0 && operator_states_[op_idx]->Complete()) {
+        --op_idx;
+    }
+    return op_idx;
+}
+
 TaskBinding FragmentTask::TaskBinding() const {
     struct TaskBinding binding {};
 
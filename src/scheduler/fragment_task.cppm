@@ -93,6 +93,10 @@ public:
     UniquePtr<SinkState> sink_state_{};
 
 private:
+    // Operators before an operator which still has output after its input is complete, e.g. a sort which outputs its merged
+    // runs over several executions, completed in an earlier execution and aren't executed again.
+    i64 FirstOperatorToExecute() const;
+
     std::mutex mutex_;
 
     FragmentTaskStatus status_{FragmentTaskStatus::kPending};
@@ -15,6 +15,7 @@
 module;
 
 #include <set>
+#include <sys/mman.h>
 
 module hnsw_file_worker;
 
@@ -36,6 +37,7 @@ import abstract_hnsw;
 import virtual_store;
 import persistence_manager;
 import local_file_handle;
+import status;
 
 namespace infinity {
 
@@ -99,6 +101,10 @@ void HnswFileWorker::FreeInMemory() {
         *p);
     delete p;
     data_ = nullptr;
+    if (!mmap_path_.empty()) {
+        VirtualStore::MunmapFile(mmap_path_);
+        mmap_path_.clear();
+    }
 }
 
 bool HnswFileWorker::WriteToFileImpl(bool to_spill, bool &prepare_success, const FileWorkerSaveCtx &ctx) {
@@ -134,10 +140,33 @@ void HnswFileWorker::ReadFromFileImpl(SizeT file_size) {
                 UnrecoverableError("Invalid index type.");
             } else {
                 using IndexT = std::decay_t<decltype(*index)>;
-                index = IndexT::Load(*file_handle_).release();
+                if constexpr (IndexT::kLoadFromPtr) {
+                    const char *ptr = MmapIndexFile();
+                    index = IndexT::LoadFromPtr(ptr).release();
+                } else {
+                    index = IndexT::Load(*file_handle_).release();
+                }
             }
         },
         *hnsw_index);
 }
 
+// The index file is searched in place, so the page cache rather than the heap holds the cold parts of the graph.
+const char *HnswFileWorker::MmapIndexFile() {
+    String path = file_handle_->Path();
+    u8 *data_ptr = nullptr;
+    SizeT data_len = 0;
+    if (VirtualStore::MmapFile(path, data_ptr, data_len) != 0) {
+        Status status = Status::MmapFileError(path);
+        RecoverableError(status);
+    }
+    mmap_path_ = std::move(path);
+    SizeT offset = persistence_manager_ != nullptr ? obj_addr_.part_offset_ : 0;
+    SizeT size = persistence_manager_ != nullptr ? obj_addr_.part_size_ : data_len;
+    // The search visits level 0 vertices in no particular order, readahead would only evict useful pages.
+    // Only this object's part is advised, the mapping is shared with the other objects packed in the file.
+    AdviseMapped(data_ptr + offset, size, MADV_RANDOM);
+    return reinterpret_cast<const char *>(data_ptr) + offset;
+}
+
 } // namespace infinity
\ No newline at end of file
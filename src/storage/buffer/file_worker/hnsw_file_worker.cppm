@@ -57,7 +57,11 @@ protected:
     void ReadFromFileImpl(SizeT file_size) override;
 
 private:
+    const char *MmapIndexFile();
+
     SizeT index_size_{};
+    // Set while the loaded index points into the mapped file.
+    String mmap_path_{};
 };
 
 } // namespace infinity
\ No newline at end of file
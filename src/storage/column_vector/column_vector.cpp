@@ -171,8 +171,14 @@ void ColumnVector::Initialize(const ColumnVector &other, const Selection &input_
         if (tail_index_ == 0)
             return;
         CopyRow(other, 0, 0);
+        nulls_ptr_->Set(0, other.nulls_ptr_->IsTrue(0));
     } else {
         tail_index_ = input_select.Size();
+        if (!other.nulls_ptr_->IsAllTrue()) {
+            for (SizeT idx = 0; idx < tail_index_; ++idx) {
+                nulls_ptr_->Set(idx, other.nulls_ptr_->IsTrue(input_select[idx]));
+            }
+        }
 
         // Copy data from other column vector to here according to the select
         switch (data_type_->type()) {
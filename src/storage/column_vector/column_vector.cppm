@@ -1301,6 +1301,7 @@ public:
         return *this;
     }
     auto &operator[](u32 index) { return SetIndex(index); }
+    inline Span<const char> GetValue() const { return col_->GetVarchar(idx_); }
     // Does not check type.
     friend std::strong_ordering ThreeWayCompareReaderValue(const IteratorType &left, const IteratorType &right) {
         Span<const char> left_v = left.col_->GetVarchar(left.idx_);
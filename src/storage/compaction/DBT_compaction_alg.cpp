@@ -14,6 +14,7 @@
 
 module;
 
+#include <chrono>
 #include <utility>
 #include <vector>
 
@@ -86,6 +87,15 @@ Vector<SegmentEntry *> SegmentLayer::PickCompacting(TransactionID txn_id, SizeT
     return ret;
 }
 
+void SegmentLayer::PickRewrite(TransactionID txn_id, SegmentEntry *rewrite_segment) {
+    RemoveSegment(rewrite_segment);
+    auto [iter, insert_ok] = compacting_segments_map_.emplace(txn_id, Vector<SegmentEntry *>{rewrite_segment});
+    if (!insert_ok) {
+        String error_message = fmt::format("TransactionID conflict: {}", txn_id);
+        UnrecoverableError(error_message);
+    }
+}
+
 void SegmentLayer::CommitCompact(TransactionID txn_id) {
     SizeT remove_n = compacting_segments_map_.erase(txn_id);
     if (remove_n != 1) {
@@ -136,7 +146,57 @@ Vector<SegmentEntry *> DBTCompactionAlg::CheckCompaction(TransactionID txn_id) {
             return compact_segments;
         }
     }
-    return {};
+    return CheckRewrite(txn_id);
+}
+
+// called when lock held
+Vector<SegmentEntry *> DBTCompactionAlg::CheckRewrite(TransactionID txn_id) {
+    if (rewrite_config_.delete_ratio_ >= 1.0 || rewrite_txns_.size() >= rewrite_config_.max_running_rewrite_) {
+        return {};
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now < next_rewrite_time_) {
+        return {};
+    }
+    int best_layer = -1;
+    SegmentEntry *rewrite_segment = nullptr;
+    f64 best_score = 0;
+    for (int layer = 0; layer < (int)segment_layers_.size(); ++layer) {
+        for (const auto &[segment_id, segment_entry] : segment_layers_[layer].segments()) {
+            SizeT row_cnt = segment_entry->row_count();
+            SizeT actual_row_cnt = segment_entry->actual_row_count();
+            if (row_cnt - actual_row_cnt < rewrite_config_.min_delete_rows_) {
+                continue;
+            }
+            f64 score = RewriteScore(row_cnt, actual_row_cnt, segment_entry->scan_count());
+            if (score >= rewrite_config_.delete_ratio_ && score > best_score) {
+                best_layer = layer;
+                rewrite_segment = segment_entry;
+                best_score = score;
+            }
+        }
+    }
+    if (rewrite_segment == nullptr) {
+        return {};
+    }
+    segment_layers_[best_layer].PickRewrite(txn_id, rewrite_segment);
+    LOG_INFO(fmt::format("Rewrite segment {}, row count: {}, actual row count: {}, scan count: {}, score: {}",
+                         rewrite_segment->segment_id(),
+                         rewrite_segment->row_count(),
+                         rewrite_segment->actual_row_count(),
+                         rewrite_segment->scan_count(),
+                         best_score));
+    if (rewrite_config_.rewrite_rows_per_sec_ > 0) {
+        // the rewrite scans all rows of the segment, so throttle by total row count
+        auto cost = std::chrono::microseconds(rewrite_segment->row_count() * 1000'000 / rewrite_config_.rewrite_rows_per_sec_);
+        next_rewrite_time_ = now + cost;
+    }
+    if (++running_task_n_ == 1) {
+        status_ = CompactionStatus::kRunning;
+    }
+    txn_2_layer_.emplace(txn_id, best_layer);
+    rewrite_txns_.insert(txn_id);
+    return {rewrite_segment};
 }
 
 void DBTCompactionAlg::AddSegment(SegmentEntry *new_segment) {
@@ -176,6 +236,7 @@ void DBTCompactionAlg::CommitCompact(TransactionID commit_txn_id) {
     if (auto iter = txn_2_layer_.find(commit_txn_id); iter != txn_2_layer_.end()) {
         segment_layers_[iter->second].CommitCompact(commit_txn_id);
         txn_2_layer_.erase(iter);
+        rewrite_txns_.erase(commit_txn_id);
     } else {
         String error_message = fmt::format("TransactionID not found in layer: {}", commit_txn_id);
         UnrecoverableError(error_message);
@@ -197,6 +258,7 @@ void DBTCompactionAlg::RollbackCompact(TransactionID rollback_txn_id) {
     if (auto iter = txn_2_layer_.find(rollback_txn_id); iter != txn_2_layer_.end()) {
         segment_layers_[iter->second].RollbackCompact(rollback_txn_id);
         txn_2_layer_.erase(iter);
+        rewrite_txns_.erase(rollback_txn_id);
     } else {
         String error_message = fmt::format("TransactionID not found in layer: {}", rollback_txn_id);
         UnrecoverableError(error_message);
@@ -14,6 +14,7 @@
 
 module;
 
+#include <chrono>
 #include <cmath>
 #include <utility>
 
@@ -51,6 +52,15 @@ private:
     // layer i has capacity: c^i * s, (i >= 0)
 };
 
+// Rewrite a single segment when enough of its rows are deleted, even if its layer is not full.
+// Deleted rows are still scanned and still carry index entries until the segment is compacted.
+export struct DBTRewriteConfig {
+    f64 delete_ratio_{1.0};         // delete ratio (weighted by scan count) to trigger rewrite, >= 1.0 disables rewrite
+    SizeT min_delete_rows_{0};      // ignore segments with fewer deleted rows
+    SizeT max_running_rewrite_{1};  // max concurrent rewrite task of one table
+    SizeT rewrite_rows_per_sec_{0}; // rate limit on rewritten rows, 0 means no limit
+};
+
 class SegmentLayer {
 public:
     SegmentLayer() {}
@@ -61,12 +71,17 @@ public:
 
     Vector<SegmentEntry *> PickCompacting(TransactionID txn_id, SizeT M, SizeT layer);
 
+    // move one segment to compacting state to rewrite it alone
+    void PickRewrite(TransactionID txn_id, SegmentEntry *rewrite_segment);
+
     void CommitCompact(TransactionID txn_id);
 
     void RollbackCompact(TransactionID txn_id);
 
     SizeT LayerSize() const { return segments_.size(); }
 
+    const HashMap<SegmentID, SegmentEntry *> &segments() const { return segments_; }
+
     SegmentEntry *FindSegment(SegmentID segment_id);
 
 private:
@@ -74,10 +89,25 @@ private:
     HashMap<TransactionID, Vector<SegmentEntry *>> compacting_segments_map_;
 };
 
+export f64 RewriteScore(SizeT row_cnt, SizeT actual_row_cnt, u64 scan_cnt) {
+    if (row_cnt == 0 || actual_row_cnt >= row_cnt) {
+        return 0;
+    }
+    f64 delete_ratio = static_cast<f64>(row_cnt - actual_row_cnt) / row_cnt;
+    // frequently scanned segment pays for its deleted rows on every scan, so rewrite it earlier
+    return delete_ratio * (1 + std::log2(1 + static_cast<f64>(scan_cnt)) / 10);
+}
+
 export class DBTCompactionAlg final : public CompactionAlg {
 public:
-    DBTCompactionAlg(int m, int c, int s, SizeT max_segment_capacity, TableEntry *table_entry = nullptr)
-        : CompactionAlg(), config_(m, c, s), max_segment_capacity_(max_segment_capacity), table_entry_(table_entry), running_task_n_(0) {}
+    DBTCompactionAlg(int m,
+                     int c,
+                     int s,
+                     SizeT max_segment_capacity,
+                     TableEntry *table_entry = nullptr,
+                     const DBTRewriteConfig &rewrite_config = DBTRewriteConfig())
+        : CompactionAlg(), config_(m, c, s), max_segment_capacity_(max_segment_capacity), table_entry_(table_entry),
+          rewrite_config_(rewrite_config), running_task_n_(0) {}
 
     virtual Vector<SegmentEntry *> CheckCompaction(TransactionID txn_id) override;
 
@@ -99,10 +129,13 @@ private:
 
     Pair<SegmentEntry *, int> FindSegmentAndLayer(SegmentID segment_id);
 
+    Vector<SegmentEntry *> CheckRewrite(TransactionID txn_id);
+
 private:
     const DBTConfig config_;
     const SizeT max_segment_capacity_;
     TableEntry *table_entry_;
+    const DBTRewriteConfig rewrite_config_;
 
     std::mutex mtx_;
     Vector<SegmentLayer> segment_layers_;
@@ -112,6 +145,9 @@ private:
     int running_task_n_;
 
     HashMap<TransactionID, i32> txn_2_layer_;
+
+    HashSet<TransactionID> rewrite_txns_;
+    std::chrono::steady_clock::time_point next_rewrite_time_{};
 };
 
 } // namespace infinity
@@ -85,6 +85,12 @@ IndexDiskAnn::Make(SharedPtr<String> index_name, const String &file_name, Vector
         RecoverableError(status);
     }
 
+    if (metric_type != MetricType::kMetricL2) {
+        // the graph is built and searched with l2 distance only
+        Status status = Status::NotSupport(fmt::format("DiskAnn index with metric {}", MetricTypeToString(metric_type)));
+        RecoverableError(status);
+    }
+
     if (encode_type == DiskAnnEncodeType::kInvalid) {
         Status status = Status::InvalidIndexParam("Encode type");
         RecoverableError(status);
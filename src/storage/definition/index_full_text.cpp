@@ -44,6 +44,7 @@ SharedPtr<IndexBase> IndexFullText::Make(SharedPtr<String> index_name,
                                          const Vector<InitParameter *> &index_param_list) {
     String analyzer_name{};
     u64 flag = OPTION_FLAG_ALL;
+    bool quantized_norm = false;
     SizeT param_count = index_param_list.size();
     for (SizeT param_idx = 0; param_idx < param_count; ++param_idx) {
         InitParameter *parameter = index_param_list[param_idx];
@@ -53,8 +54,20 @@ SharedPtr<IndexBase> IndexFullText::Make(SharedPtr<String> index_name,
             analyzer_name = parameter->param_value_;
         } else if (para_name == "flag") {
             flag = std::strtoul(parameter->param_value_.c_str(), nullptr, 10);
+        } else if (para_name == "norm") {
+            String norm = parameter->param_value_;
+            ToLowerString(norm);
+            if (norm == "quantized") {
+                quantized_norm = true;
+            } else if (norm != "exact") {
+                Status status = Status::InvalidIndexParam("norm");
+                RecoverableError(status);
+            }
         }
     }
+    if (quantized_norm) {
+        flag |= of_quantized_norm;
+    }
     if (analyzer_name.empty()) {
         analyzer_name = "standard";
     }
@@ -100,6 +113,9 @@ String IndexFullText::ToString() const {
 String IndexFullText::BuildOtherParamsString() const {
     std::stringstream ss;
     ss << "analyzer = " << analyzer_;
+    if (flag_ & of_quantized_norm) {
+        ss << ", norm = quantized";
+    }
     return ss.str();
 }
 
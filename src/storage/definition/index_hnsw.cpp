@@ -42,6 +42,8 @@ HnswEncodeType StringToHnswEncodeType(const String &str) {
         return HnswEncodeType::kPlain;
     } else if (str == "lvq") {
         return HnswEncodeType::kLVQ;
+    } else if (str == "pq") {
+        return HnswEncodeType::kPQ;
     } else {
         return HnswEncodeType::kInvalid;
     }
@@ -53,6 +55,8 @@ String HnswEncodeTypeToString(HnswEncodeType encode_type) {
             return "plain";
         case HnswEncodeType::kLVQ:
             return "lvq";
+        case HnswEncodeType::kPQ:
+            return "pq";
         default:
             return "invalid";
     }
@@ -179,6 +183,14 @@ void IndexHnsw::ValidateColumnDataType(const SharedPtr<BaseTableRef> &base_table
                                 data_type_ptr->ToString())));
             }
         }
+        if (param->param_name_ == "encode" && StringToHnswEncodeType(param->param_value_) == HnswEncodeType::kPQ) {
+            if (embedding_data_type != EmbeddingDataType::kElemFloat) {
+                RecoverableError(Status::InvalidIndexDefinition(
+                    fmt::format("Attempt to create HNSW index with PQ encoding on column: {}, data type: {}. now only support float element type.",
+                                column_name,
+                                data_type_ptr->ToString())));
+            }
+        }
     }
     // TODO: now only support float, int8, uint8?
     switch (embedding_data_type) {
@@ -0,0 +1,239 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+module block_zone_map;
+
+import stl;
+import value;
+import column_vector;
+import internal_types;
+import logical_type;
+import data_type;
+import filter_expression_push_down_helper;
+
+namespace infinity {
+
+namespace {
+
+bool IsZoneMapType(LogicalType type) {
+    switch (type) {
+        case LogicalType::kTinyInt:
+        case LogicalType::kSmallInt:
+        case LogicalType::kInteger:
+        case LogicalType::kBigInt:
+        case LogicalType::kDate:
+        case LogicalType::kTime:
+        case LogicalType::kFloat:
+        case LogicalType::kDouble: {
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+bool IsFloatType(LogicalType type) { return type == LogicalType::kFloat || type == LogicalType::kDouble; }
+
+template <typename T, typename ZoneT>
+void MergeRows(const ColumnVector &column_vector,
+               SizeT offset,
+               SizeT count,
+               Atomic<ZoneT> &zone_min,
+               Atomic<ZoneT> &zone_max,
+               atomic_bool &has_value,
+               atomic_u64 &null_count) {
+    const auto *data = reinterpret_cast<const T *>(column_vector.data());
+    const bool is_constant = column_vector.vector_type() == ColumnVectorType::kConstant;
+    const bool all_valid = column_vector.nulls_ptr_->IsAllTrue();
+    ZoneT min_value = std::numeric_limits<ZoneT>::max();
+    ZoneT max_value = std::numeric_limits<ZoneT>::lowest();
+    u64 nulls = 0;
+    for (SizeT i = offset; i < offset + count; ++i) {
+        const SizeT idx = is_constant ? 0 : i;
+        if (!all_valid && !column_vector.nulls_ptr_->IsTrue(idx)) {
+            ++nulls;
+            continue;
+        }
+        const auto value = static_cast<ZoneT>(data[idx]);
+        if constexpr (std::is_floating_point_v<ZoneT>) {
+            if (std::isnan(value)) {
+                // NaN is not ordered, the column can no longer be ruled out by range
+                min_value = std::numeric_limits<ZoneT>::lowest();
+                max_value = std::numeric_limits<ZoneT>::max();
+                continue;
+            }
+        }
+        min_value = std::min(min_value, value);
+        max_value = std::max(max_value, value);
+    }
+    if (nulls > 0) {
+        null_count.store(null_count.load(std::memory_order_relaxed) + nulls, std::memory_order_relaxed);
+    }
+    if (nulls == count) {
+        return;
+    }
+    // single writer, readers only ever see a range that is at least as wide as the covered rows
+    if (!has_value.load(std::memory_order_relaxed)) {
+        zone_min.store(min_value, std::memory_order_relaxed);
+        zone_max.store(max_value, std::memory_order_relaxed);
+        has_value.store(true, std::memory_order_release);
+        return;
+    }
+    if (min_value < zone_min.load(std::memory_order_relaxed)) {
+        zone_min.store(min_value, std::memory_order_relaxed);
+    }
+    if (max_value > zone_max.load(std::memory_order_relaxed)) {
+        zone_max.store(max_value, std::memory_order_relaxed);
+    }
+}
+
+i64 GetIntValue(const Value &value) {
+    switch (value.type().type()) {
+        case LogicalType::kTinyInt: {
+            return value.GetValue<TinyIntT>();
+        }
+        case LogicalType::kSmallInt: {
+            return value.GetValue<SmallIntT>();
+        }
+        case LogicalType::kInteger: {
+            return value.GetValue<IntegerT>();
+        }
+        case LogicalType::kBigInt: {
+            return value.GetValue<BigIntT>();
+        }
+        case LogicalType::kDate: {
+            return value.GetValue<DateT>().GetValue();
+        }
+        case LogicalType::kTime: {
+            return value.GetValue<TimeT>().GetValue();
+        }
+        default: {
+            return 0;
+        }
+    }
+}
+
+template <typename ZoneT>
+bool MayInRangeT(ZoneT query_value, ZoneT min_value, ZoneT max_value, FilterCompareType compare_type) {
+    switch (compare_type) {
+        case FilterCompareType::kLessEqual: {
+            return query_value >= min_value;
+        }
+        case FilterCompareType::kGreaterEqual: {
+            return query_value <= max_value;
+        }
+        default: {
+            return true;
+        }
+    }
+}
+
+} // namespace
+
+void BlockZoneMap::Init(const Vector<SharedPtr<DataType>> &column_types) {
+    column_count_ = column_types.size();
+    columns_ = MakeUnique<ColumnZone[]>(column_count_);
+    for (SizeT column_id = 0; column_id < column_count_; ++column_id) {
+        if (column_types[column_id].get() != nullptr && IsZoneMapType(column_types[column_id]->type())) {
+            columns_[column_id].type_ = column_types[column_id]->type();
+        }
+    }
+    complete_.store(true, std::memory_order_release);
+}
+
+void BlockZoneMap::Update(ColumnID column_id, const ColumnVector &column_vector, SizeT offset, SizeT count) {
+    if (!complete_.load(std::memory_order_relaxed) || column_id >= column_count_ || count == 0) {
+        return;
+    }
+    ColumnZone &zone = columns_[column_id];
+    switch (zone.type_) {
+        case LogicalType::kTinyInt: {
+            MergeRows<TinyIntT>(column_vector, offset, count, zone.min_int_, zone.max_int_, zone.has_value_, zone.null_count_);
+            break;
+        }
+        case LogicalType::kSmallInt: {
+            MergeRows<SmallIntT>(column_vector, offset, count, zone.min_int_, zone.max_int_, zone.has_value_, zone.null_count_);
+            break;
+        }
+        case LogicalType::kInteger:
+        case LogicalType::kDate:
+        case LogicalType::kTime: {
+            MergeRows<IntegerT>(column_vector, offset, count, zone.min_int_, zone.max_int_, zone.has_value_, zone.null_count_);
+            break;
+        }
+        case LogicalType::kBigInt: {
+            MergeRows<BigIntT>(column_vector, offset, count, zone.min_int_, zone.max_int_, zone.has_value_, zone.null_count_);
+            break;
+        }
+        case LogicalType::kFloat: {
+            MergeRows<FloatT>(column_vector, offset, count, zone.min_float_, zone.max_float_, zone.has_value_, zone.null_count_);
+            break;
+        }
+        case LogicalType::kDouble: {
+            MergeRows<DoubleT>(column_vector, offset, count, zone.min_float_, zone.max_float_, zone.has_value_, zone.null_count_);
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+
+void BlockZoneMap::FinishAppend(SizeT block_row_count, SizeT append_count) {
+    if (!complete_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (row_count_.load(std::memory_order_relaxed) != block_row_count) {
+        // some rows were added without going through the zone map
+        complete_.store(false, std::memory_order_release);
+        return;
+    }
+    row_count_.store(block_row_count + append_count, std::memory_order_release);
+}
+
+bool BlockZoneMap::Covers(SizeT row_count) const {
+    return complete_.load(std::memory_order_acquire) && row_count_.load(std::memory_order_acquire) >= row_count;
+}
+
+bool BlockZoneMap::MayInRange(ColumnID column_id, const Value &value, FilterCompareType compare_type) const {
+    const ColumnZone *zone = GetColumn(column_id);
+    if (zone == nullptr || value.type().type() != zone->type_) {
+        return true;
+    }
+    if (!zone->has_value_.load(std::memory_order_acquire)) {
+        // all covered rows are null, no comparison can be true
+        return false;
+    }
+    if (IsFloatType(zone->type_)) {
+        const f64 query_value = zone->type_ == LogicalType::kFloat ? value.GetValue<FloatT>() : value.GetValue<DoubleT>();
+        return MayInRangeT<f64>(query_value,
+                                zone->min_float_.load(std::memory_order_relaxed),
+                                zone->max_float_.load(std::memory_order_relaxed),
+                                compare_type);
+    }
+    return MayInRangeT<i64>(GetIntValue(value),
+                            zone->min_int_.load(std::memory_order_relaxed),
+                            zone->max_int_.load(std::memory_order_relaxed),
+                            compare_type);
+}
+
+u64 BlockZoneMap::NullCount(ColumnID column_id) const {
+    const ColumnZone *zone = GetColumn(column_id);
+    return zone == nullptr ? 0 : zone->null_count_.load(std::memory_order_relaxed);
+}
+
+} // namespace infinity
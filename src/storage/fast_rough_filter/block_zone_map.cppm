@@ -0,0 +1,75 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module block_zone_map;
+
+import stl;
+import value;
+import column_vector;
+import internal_types;
+import logical_type;
+import data_type;
+import filter_expression_push_down_helper;
+
+namespace infinity {
+
+// min / max and null count of the rows appended to a block, kept up to date on append
+// unlike the sealed minmax filter, it is available for the blocks of the unsealed segment
+// one appender updates it under the block lock, scans read it without lock
+// only the rows appended through BlockEntry are tracked, a block loaded with rows never rules anything out
+export class BlockZoneMap {
+public:
+    BlockZoneMap() = default;
+
+    // called on a new empty block, column_types are indexed by ColumnID
+    void Init(const Vector<SharedPtr<DataType>> &column_types);
+
+    // rows [offset, offset + count) of column_vector are appended to the column
+    void Update(ColumnID column_id, const ColumnVector &column_vector, SizeT offset, SizeT count);
+
+    // publish the rows appended since the last call, block_row_count is the row count before the append
+    void FinishAppend(SizeT block_row_count, SizeT append_count);
+
+    // whether the first row_count rows of the block are all covered by the zone map
+    bool Covers(SizeT row_count) const;
+
+    // false if no covered row of the column satisfies "column compare_type value", compare_type is kLessEqual or kGreaterEqual
+    bool MayInRange(ColumnID column_id, const Value &value, FilterCompareType compare_type) const;
+
+    u64 NullCount(ColumnID column_id) const;
+
+private:
+    struct ColumnZone {
+        LogicalType type_{LogicalType::kInvalid};
+        atomic_bool has_value_{false};
+        Atomic<i64> min_int_{};
+        Atomic<i64> max_int_{};
+        Atomic<f64> min_float_{};
+        Atomic<f64> max_float_{};
+        atomic_u64 null_count_{0};
+    };
+
+    const ColumnZone *GetColumn(ColumnID column_id) const {
+        return column_id < column_count_ && columns_[column_id].type_ != LogicalType::kInvalid ? &columns_[column_id] : nullptr;
+    }
+
+    UniquePtr<ColumnZone[]> columns_{};
+    SizeT column_count_{0};
+    atomic_u32 row_count_{0};
+    atomic_bool complete_{false};
+};
+
+} // namespace infinity
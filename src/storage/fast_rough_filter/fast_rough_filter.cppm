@@ -20,6 +20,7 @@ import value;
 import default_values;
 import probabilistic_data_filter;
 import min_max_data_filter;
+import block_zone_map;
 import logger;
 import third_party;
 import infinity_exception;
@@ -139,6 +140,17 @@ public:
     }
 
     virtual bool EvaluateInner(TxnTimeStamp query_ts, const FastRoughFilter &filter) const = 0;
+
+    // for the blocks without sealed minmax filter, row_count is the number of rows to be read from the block
+    inline bool EvaluateZoneMap(const BlockZoneMap &zone_map, SizeT row_count) const {
+        if (!zone_map.Covers(row_count)) {
+            LOG_TRACE("FastRoughFilterEvaluator: zone map does not cover the block, cannot apply, return true.");
+            return true;
+        }
+        return EvaluateZoneMapInner(zone_map);
+    }
+
+    virtual bool EvaluateZoneMapInner(const BlockZoneMap &zone_map) const = 0;
 };
 
 } // namespace infinity
@@ -42,6 +42,7 @@ import third_party;
 import term_doc_iterator;
 import default_values;
 import logger;
+import fst;
 
 namespace infinity {
 void ColumnIndexReader::Open(optionflag_t flag, String &&index_dir, Map<SegmentID, SharedPtr<SegmentIndexEntry>> &&index_by_segment, Txn *txn) {
@@ -91,6 +92,37 @@ UniquePtr<PostingIterator> ColumnIndexReader::Lookup(const String &term, bool fe
     return iter;
 }
 
+Vector<String> ColumnIndexReader::ExpandTerms(Automaton &automaton, SizeT max_expansions) {
+    Vector<Pair<String, u32>> segment_terms;
+    for (const auto &segment_reader : segment_readers_) {
+        segment_reader->ExpandTerms(automaton, segment_terms);
+    }
+    // sum the doc frequency of a term over the segments
+    std::sort(segment_terms.begin(), segment_terms.end());
+    Vector<Pair<String, u64>> candidates;
+    for (auto &[term, df] : segment_terms) {
+        if (!candidates.empty() && candidates.back().first == term) {
+            candidates.back().second += df;
+        } else {
+            candidates.emplace_back(std::move(term), df);
+        }
+    }
+    // the most frequent terms are kept, the lexicographical order breaks ties
+    if (candidates.size() > max_expansions) {
+        auto by_df = [](const Pair<String, u64> &a, const Pair<String, u64> &b) {
+            return a.second > b.second || (a.second == b.second && a.first < b.first);
+        };
+        std::partial_sort(candidates.begin(), candidates.begin() + max_expansions, candidates.end(), by_df);
+        candidates.resize(max_expansions);
+    }
+    Vector<String> terms;
+    terms.reserve(candidates.size());
+    for (auto &[term, df] : candidates) {
+        terms.push_back(std::move(term));
+    }
+    return terms;
+}
+
 Pair<u64, float> ColumnIndexReader::GetTotalDfAndAvgColumnLength() {
     if (total_df_ == 0) {
         u64 column_len_sum = 0;
@@ -26,6 +26,7 @@ import memory_indexer;
 import internal_types;
 import segment_index_entry;
 import chunk_index_entry;
+import fst;
 
 namespace infinity {
 struct TableEntry;
@@ -38,6 +39,9 @@ public:
 
     UniquePtr<PostingIterator> Lookup(const String &term, bool fetch_position = true);
 
+    // Terms of all segments matched by the automaton. Only the `max_expansions` terms of the highest doc frequency are kept.
+    Vector<String> ExpandTerms(Automaton &automaton, SizeT max_expansions);
+
     Pair<u64, float> GetTotalDfAndAvgColumnLength();
 
     optionflag_t GetOptionFlag() const { return flag_; }
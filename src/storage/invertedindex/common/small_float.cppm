@@ -0,0 +1,81 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <bit>
+
+export module small_float;
+import stl;
+
+namespace infinity {
+
+// One byte encoding of document lengths, after Lucene's SmallFloat.intToByte4:
+// values below kNumFreeValues are exact, larger ones keep 4 significant bits.
+// Unlike Lucene, encoding rounds up, so a decoded length is never shorter than the original one
+// and tf / decoded_length stays within [0, 1].
+export class SmallFloat {
+public:
+    static constexpr u32 kNumFreeValues = 255 - 231; // 231 == LongToInt4(INT32_MAX)
+
+    static u8 IntToByte4(u32 i) {
+        if (i < kNumFreeValues) {
+            return u8(i);
+        }
+        if (i - kNumFreeValues > u32(std::numeric_limits<i32>::max())) {
+            return 255;
+        }
+        u32 code = kNumFreeValues + LongToInt4(i - kNumFreeValues);
+        if (code < 255 && Byte4ToInt(u8(code)) < i) {
+            ++code;
+        }
+        return u8(code);
+    }
+
+    static u32 Byte4ToInt(u8 b) { return kDecodeTable[b]; }
+
+    // The length BM25 sees for `i` once norms are quantized.
+    static u32 Quantize(u32 i) { return Byte4ToInt(IntToByte4(i)); }
+
+private:
+    static constexpr u32 LongToInt4(u32 i) {
+        u32 num_bits = 32 - std::countl_zero(i);
+        if (num_bits < 4) {
+            return i;
+        }
+        u32 shift = num_bits - 4;
+        return ((i >> shift) & 0x07) | ((shift + 1) << 3);
+    }
+
+    static constexpr u32 Int4ToLong(u32 i) {
+        u32 bits = i & 0x07;
+        u32 shift = (i >> 3) - 1;
+        if (shift == u32(-1)) {
+            return bits;
+        }
+        return (bits | 0x08) << shift;
+    }
+
+    static constexpr Array<u32, 256> BuildDecodeTable() {
+        Array<u32, 256> table{};
+        for (u32 b = 0; b < 256; ++b) {
+            table[b] = b < kNumFreeValues ? b : kNumFreeValues + Int4ToLong(b - kNumFreeValues);
+        }
+        return table;
+    }
+
+    static constexpr Array<u32, 256> kDecodeTable = BuildDecodeTable();
+};
+
+} // namespace infinity
@@ -0,0 +1,158 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <cstring>
+
+export module term_table;
+import stl;
+import third_party;
+
+namespace infinity {
+
+// Term -> value table shared by concurrent inverting threads.
+// Terms are hashed into independent shards so that writers of different terms rarely contend,
+// and the term bytes are copied into a per-shard arena instead of one heap string per term.
+export template <typename ValueType>
+class TermTable {
+public:
+    static constexpr SizeT kShardBits = 6;
+    static constexpr SizeT kShardNum = 1UL << kShardBits;
+    static constexpr SizeT kArenaBlockSize = 64 * 1024;
+
+    TermTable() = default;
+
+    ~TermTable() = default;
+
+    bool Get(std::string_view term, ValueType &value) {
+        Shard &shard = GetShard(term);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+        auto it = shard.map_.find(term);
+        if (it == shard.map_.end()) {
+            return false;
+        }
+        value = it->second;
+        return true;
+    }
+
+    // Get or add a value to the table. `make_value` is invoked only when the term is absent.
+    // Returns true if found.
+    // Returns false if not found, and add the term with the made value into the table.
+    template <typename MakeValue>
+    bool GetOrAdd(std::string_view term, ValueType &value, MakeValue &&make_value) {
+        Shard &shard = GetShard(term);
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+            auto it = shard.map_.find(term);
+            if (it != shard.map_.end()) {
+                value = it->second;
+                return true;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+        auto it = shard.map_.find(term);
+        if (it != shard.map_.end()) {
+            value = it->second;
+            return true;
+        }
+        value = make_value();
+        shard.map_.emplace(shard.CopyTerm(term), value);
+        return false;
+    }
+
+    void Clear() {
+        for (Shard &shard : shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+            shard.map_.clear();
+            shard.arena_.clear();
+            shard.block_used_ = 0;
+        }
+    }
+
+    SizeT Size() {
+        SizeT size = 0;
+        for (Shard &shard : shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+            size += shard.map_.size();
+        }
+        return size;
+    }
+
+    // Visits every term and its value, in no particular order.
+    template <typename Visitor>
+    void ForEachTerm(Visitor &&visitor) {
+        for (Shard &shard : shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+            for (const auto &[term, value] : shard.map_) {
+                visitor(term, value);
+            }
+        }
+    }
+
+    // Items in byte-wise ascending order of term.
+    // WARN: Caller shall ensure there's no concurrent write access
+    Vector<Pair<std::string_view, ValueType>> UnsafeSortedItems() const {
+        Vector<Pair<std::string_view, ValueType>> items;
+        for (const Shard &shard : shards_) {
+            items.insert(items.end(), shard.map_.begin(), shard.map_.end());
+        }
+        std::sort(items.begin(), items.end(), [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+        return items;
+    }
+
+private:
+    struct Shard {
+        std::shared_mutex mutex_;
+        FlatHashMap<std::string_view, ValueType> map_;
+        Vector<UniquePtr<char[]>> arena_;
+        SizeT block_used_{0};
+
+        std::string_view CopyTerm(std::string_view term) {
+            if (term.empty()) {
+                return {};
+            }
+            char *dst = nullptr;
+            if (term.size() > kArenaBlockSize / 4) {
+                // long terms get a block of their own, keep the current block for short ones
+                auto block = MakeUnique<char[]>(term.size());
+                dst = block.get();
+                if (arena_.empty()) {
+                    arena_.push_back(std::move(block));
+                    block_used_ = kArenaBlockSize;
+                } else {
+                    arena_.insert(arena_.end() - 1, std::move(block));
+                }
+            } else {
+                if (arena_.empty() || block_used_ + term.size() > kArenaBlockSize) {
+                    arena_.push_back(MakeUnique<char[]>(kArenaBlockSize));
+                    block_used_ = 0;
+                }
+                dst = arena_.back().get() + block_used_;
+                block_used_ += term.size();
+            }
+            std::memcpy(dst, term.data(), term.size());
+            return {dst, term.size()};
+        }
+    };
+
+    Shard &GetShard(std::string_view term) {
+        u64 hash = HashDefaultHash<std::string_view>{}(term);
+        return shards_[hash >> (64 - kShardBits)];
+    }
+
+    Array<Shard, kShardNum> shards_;
+};
+
+} // namespace infinity
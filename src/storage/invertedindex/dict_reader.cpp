@@ -82,4 +82,17 @@ bool DictionaryReader::Next(String &term, TermMeta &term_meta) {
     return true;
 }
 
+void DictionaryReader::ExpandTerms(Automaton &automaton, Vector<Pair<String, u32>> &terms) {
+    FstAutomatonStream s(*fst_, automaton);
+    Vector<u8> key;
+    u64 val;
+    TermMeta term_meta;
+    while (s.Next(key, val)) {
+        u8 *data_cursor = data_ptr_ + val;
+        SizeT left_size = data_len_ - val;
+        meta_loader_.Load(data_cursor, left_size, term_meta);
+        terms.emplace_back(String((char *)key.data(), key.size()), term_meta.GetDocFreq());
+    }
+}
+
 } // namespace infinity
\ No newline at end of file
@@ -43,5 +43,8 @@ public:
     void InitIterator(const String &prefix);
 
     bool Next(String &term, TermMeta &term_meta);
+
+    // Appends terms matched by the automaton with their doc frequency, in lexicographical order.
+    void ExpandTerms(Automaton &automaton, Vector<Pair<String, u32>> &terms);
 };
 } // namespace infinity
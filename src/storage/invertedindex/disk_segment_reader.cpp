@@ -38,6 +38,8 @@ import persistence_manager;
 import infinity_context;
 import persist_result_handler;
 import virtual_store;
+import fst;
+import posting_block_cache;
 
 namespace infinity {
 
@@ -71,6 +73,7 @@ DiskIndexSegmentReader::DiskIndexSegmentReader(const String &index_dir, const St
         Status status = Status::MmapFileError(posting_file);
         RecoverableError(status);
     }
+    posting_file_id_ = PostingFileId::Make(posting_file);
 
     dict_file_ = path_str;
     dict_file_.append(DICT_SUFFIX);
@@ -116,7 +119,14 @@ bool DiskIndexSegmentReader::GetSegmentPosting(const String &term, SegmentPostin
     ByteSlice *slice = ByteSlice::NewSlice(data_ptr_ + term_meta.doc_start_, file_length);
     SharedPtr<ByteSliceList> byte_slice_list = MakeShared<ByteSliceList>(slice);
     seg_posting.Init(std::move(byte_slice_list), base_row_id_, term_meta.doc_freq_, term_meta);
+    seg_posting.SetCacheKey(posting_file_id_, term_meta.doc_start_);
     return true;
 }
 
+void DiskIndexSegmentReader::ExpandTerms(Automaton &automaton, Vector<Pair<String, u32>> &terms) const {
+    if (dict_reader_.get()) {
+        dict_reader_->ExpandTerms(automaton, terms);
+    }
+}
+
 } // namespace infinity
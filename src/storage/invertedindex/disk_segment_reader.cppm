@@ -25,6 +25,8 @@ import file_reader;
 import posting_list_format;
 import internal_types;
 import term_meta;
+import fst;
+import posting_block_cache;
 
 namespace infinity {
 export class DiskIndexSegmentReader : public IndexSegmentReader {
@@ -35,6 +37,8 @@ public:
 
     bool GetSegmentPosting(const String &term, SegmentPosting &seg_posting, bool fetch_position = true) const override;
 
+    void ExpandTerms(Automaton &automaton, Vector<Pair<String, u32>> &terms) const override;
+
 private:
     RowID base_row_id_{INVALID_ROWID};
     SharedPtr<DictionaryReader> dict_reader_;
@@ -43,6 +47,7 @@ private:
     String dict_file_{};
     u8 *data_ptr_{};
     SizeT data_len_{};
+    SharedPtr<const PostingFileId> posting_file_id_;
 };
 
 } // namespace infinity
\ No newline at end of file
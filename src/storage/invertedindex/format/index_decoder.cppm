@@ -37,6 +37,9 @@ public:
 
     u32 InnerGetSeekedDocCount() const { return skiped_item_count_ << MAX_DOC_PER_RECORD_BIT_NUM; }
 
+    // index of the current doc list record
+    u32 GetSkippedItemCount() const { return skiped_item_count_; }
+
 protected:
     u32 offset_ = 0;
     u32 record_len_ = 0;
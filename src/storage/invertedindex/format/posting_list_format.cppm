@@ -13,7 +13,8 @@ namespace infinity {
 export class PostingFormatOption {
 public:
     inline PostingFormatOption(optionflag_t flag = OPTION_FLAG_ALL)
-        : has_term_payload_(flag & of_term_payload), doc_list_format_option_(flag), pos_list_format_option_(flag) {}
+        : has_term_payload_(flag & of_term_payload), has_quantized_norm_(flag & of_quantized_norm), doc_list_format_option_(flag),
+          pos_list_format_option_(flag) {}
 
     bool HasTfList() const { return doc_list_format_option_.HasTfList(); }
 
@@ -25,6 +26,8 @@ public:
 
     bool HasTermPayload() const { return has_term_payload_; }
 
+    bool HasQuantizedNorm() const { return has_quantized_norm_; }
+
     bool IsShortListVbyteCompress() const { return doc_list_format_option_.IsShortListVbyteCompress(); }
 
     void SetShortListVbyteCompress(bool flag) { doc_list_format_option_.SetShortListVbyteCompress(flag); }
@@ -39,6 +42,7 @@ public:
 
 private:
     bool has_term_payload_;
+    bool has_quantized_norm_;
     DocListFormatOption doc_list_format_option_;
     PositionListFormatOption pos_list_format_option_;
 };
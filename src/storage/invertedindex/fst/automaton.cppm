@@ -0,0 +1,256 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+export module fst:automaton;
+import stl;
+
+namespace infinity {
+
+/// A deterministic automaton over bytes which can be intersected with an fst.
+///
+/// Unlike the `Automaton` trait of the original crate, a state that can never
+/// reach a match is reported as `kDeadState` by `Accept` itself, so a stream
+/// prunes the subtree as soon as it sees one.
+export class Automaton {
+public:
+    using State = u32;
+    static constexpr State kDeadState = std::numeric_limits<State>::max();
+
+    virtual ~Automaton() = default;
+
+    /// Returns the start state.
+    virtual State Start() = 0;
+
+    /// Returns the state after reading `byte`, or `kDeadState`.
+    virtual State Accept(State state, u8 byte) = 0;
+
+    /// Returns true if and only if `state` is a match state.
+    virtual bool IsMatch(State state) = 0;
+
+    /// Runs the automaton over a whole key.
+    bool Matches(const u8 *key_ptr, SizeT key_len) {
+        State state = Start();
+        for (SizeT i = 0; i < key_len && state != kDeadState; i++) {
+            state = Accept(state, key_ptr[i]);
+        }
+        return state != kDeadState && IsMatch(state);
+    }
+};
+
+/// Matches keys starting with the given prefix.
+export class PrefixAutomaton final : public Automaton {
+public:
+    explicit PrefixAutomaton(const String &prefix) : prefix_(prefix) {}
+
+    State Start() override { return 0; }
+
+    State Accept(State state, u8 byte) override {
+        if (state == prefix_.size()) {
+            return state;
+        }
+        return u8(prefix_[state]) == byte ? state + 1 : kDeadState;
+    }
+
+    bool IsMatch(State state) override { return state == prefix_.size(); }
+
+private:
+    String prefix_;
+};
+
+/// Length of an utf-8 sequence given its leading byte.
+/// Invalid leading bytes are read as a sequence of their own.
+inline SizeT Utf8SequenceLength(u8 lead) {
+    if (lead < 0xC0) {
+        return 1;
+    } else if (lead < 0xE0) {
+        return 2;
+    } else if (lead < 0xF0) {
+        return 3;
+    } else if (lead < 0xF8) {
+        return 4;
+    }
+    return 1;
+}
+
+inline u32 DecodeUtf8Sequence(const u8 *ptr, SizeT len) {
+    static constexpr u8 lead_masks[] = {0, 0xFF, 0x1F, 0x0F, 0x07};
+    u32 code_point = ptr[0] & lead_masks[len];
+    for (SizeT i = 1; i < len; i++) {
+        code_point = (code_point << 6) | (ptr[i] & 0x3F);
+    }
+    return code_point;
+}
+
+export Vector<u32> DecodeUtf8(const String &str) {
+    Vector<u32> code_points;
+    const u8 *ptr = reinterpret_cast<const u8 *>(str.data());
+    for (SizeT i = 0; i < str.size();) {
+        SizeT len = std::min(Utf8SequenceLength(ptr[i]), str.size() - i);
+        code_points.push_back(DecodeUtf8Sequence(ptr + i, len));
+        i += len;
+    }
+    return code_points;
+}
+
+/// Base of automata defined over unicode code points.
+///
+/// Subclasses describe the automaton by code point level states (a vector of
+/// integers). Those are determinized lazily: every distinct state, paired with
+/// the bytes of a partially read utf-8 sequence, is interned on first visit
+/// and transitions are memoized.
+class Utf8Automaton : public Automaton {
+public:
+    State Start() override {
+        if (states_.empty()) {
+            Intern(StartCharState(), {});
+        }
+        return 0;
+    }
+
+    State Accept(State state, u8 byte) override {
+        u64 key = (u64(state) << 8) | byte;
+        if (auto iter = transitions_.find(key); iter != transitions_.end()) {
+            return iter->second;
+        }
+        State next = Step(state, byte);
+        transitions_.emplace(key, next);
+        return next;
+    }
+
+    bool IsMatch(State state) override {
+        const auto &[char_state, pending] = states_[state];
+        return pending.empty() && IsMatchCharState(char_state);
+    }
+
+protected:
+    virtual Vector<u32> StartCharState() const = 0;
+
+    /// Returns false if no key continuing with `code_point` can match.
+    virtual bool StepCharState(const Vector<u32> &char_state, u32 code_point, Vector<u32> &next) const = 0;
+
+    virtual bool IsMatchCharState(const Vector<u32> &char_state) const = 0;
+
+private:
+    State Step(State state, u8 byte) {
+        auto [char_state, pending] = states_[state];
+        pending.push_back(byte);
+        SizeT len = Utf8SequenceLength(u8(pending[0]));
+        if (pending.size() < len) {
+            return Intern(std::move(char_state), std::move(pending));
+        }
+        u32 code_point = DecodeUtf8Sequence(reinterpret_cast<const u8 *>(pending.data()), len);
+        Vector<u32> next;
+        if (!StepCharState(char_state, code_point, next)) {
+            return kDeadState;
+        }
+        return Intern(std::move(next), {});
+    }
+
+    State Intern(Vector<u32> char_state, String pending) {
+        auto key = MakePair(std::move(char_state), std::move(pending));
+        auto [iter, inserted] = state_ids_.emplace(key, states_.size());
+        if (inserted) {
+            states_.push_back(std::move(key));
+        }
+        return iter->second;
+    }
+
+    Vector<Pair<Vector<u32>, String>> states_;
+    Map<Pair<Vector<u32>, String>, State> state_ids_;
+    HashMap<u64, State> transitions_;
+};
+
+/// Matches keys against a glob pattern, where `*` matches any sequence of
+/// characters and `?` matches exactly one character.
+export class WildcardAutomaton final : public Utf8Automaton {
+public:
+    explicit WildcardAutomaton(const String &pattern) : pattern_(DecodeUtf8(pattern)) {}
+
+protected:
+    // The code point level state is the sorted set of pattern positions reached.
+    Vector<u32> StartCharState() const override {
+        Vector<u32> positions;
+        AddPosition(positions, 0);
+        return positions;
+    }
+
+    bool StepCharState(const Vector<u32> &char_state, u32 code_point, Vector<u32> &next) const override {
+        for (u32 pos : char_state) {
+            if (pos == pattern_.size()) {
+                continue;
+            }
+            u32 ch = pattern_[pos];
+            if (ch == '*') {
+                AddPosition(next, pos);
+            } else if (ch == '?' || ch == code_point) {
+                AddPosition(next, pos + 1);
+            }
+        }
+        std::sort(next.begin(), next.end());
+        next.erase(std::unique(next.begin(), next.end()), next.end());
+        return !next.empty();
+    }
+
+    bool IsMatchCharState(const Vector<u32> &char_state) const override { return !char_state.empty() && char_state.back() == pattern_.size(); }
+
+private:
+    // adds `pos` together with the positions reachable by skipping `*`
+    void AddPosition(Vector<u32> &positions, u32 pos) const {
+        positions.push_back(pos);
+        while (pos < pattern_.size() && pattern_[pos] == '*') {
+            positions.push_back(++pos);
+        }
+    }
+
+    Vector<u32> pattern_;
+};
+
+/// Matches keys within the given Levenshtein distance of a term, counted in
+/// characters.
+export class LevenshteinAutomaton final : public Utf8Automaton {
+public:
+    LevenshteinAutomaton(const String &term, u32 max_distance) : term_(DecodeUtf8(term)), max_distance_(max_distance) {}
+
+protected:
+    // The code point level state is the last row of the edit distance matrix,
+    // with values capped at max_distance + 1 to keep the state space finite.
+    Vector<u32> StartCharState() const override {
+        Vector<u32> row(term_.size() + 1);
+        for (SizeT i = 0; i < row.size(); i++) {
+            row[i] = std::min<u32>(i, max_distance_ + 1);
+        }
+        return row;
+    }
+
+    bool StepCharState(const Vector<u32> &row, u32 code_point, Vector<u32> &next) const override {
+        next.resize(row.size());
+        next[0] = std::min(row[0] + 1, max_distance_ + 1);
+        u32 min_distance = next[0];
+        for (SizeT i = 1; i < row.size(); i++) {
+            u32 cost = term_[i - 1] == code_point ? 0 : 1;
+            next[i] = std::min({row[i - 1] + cost, row[i] + 1, next[i - 1] + 1, max_distance_ + 1});
+            min_distance = std::min(min_distance, next[i]);
+        }
+        return min_distance <= max_distance_;
+    }
+
+    bool IsMatchCharState(const Vector<u32> &row) const override { return row.back() <= max_distance_; }
+
+private:
+    Vector<u32> term_;
+    u32 max_distance_;
+};
+
+} // namespace infinity
@@ -19,6 +19,7 @@ import crc;
 import :error;
 import :bytes;
 import :node;
+import :automaton;
 
 /// An acyclic deterministic finite state transducer.
 ///
@@ -47,6 +48,7 @@ private:
     SizeT data_len_;
 
     friend class FstStream;
+    friend class FstAutomatonStream;
 
 public:
     /// Creates a transducer from its representation as a raw byte sequence.
@@ -366,4 +368,72 @@ private:
     }
 };
 
-} // namespace infinity
\ No newline at end of file
+/// A lexicographically ordered stream of the key-value pairs whose keys are
+/// matched by an automaton. Subtrees of the fst are skipped as soon as the
+/// automaton reaches its dead state.
+export class FstAutomatonStream {
+private:
+    struct AutomatonStreamState {
+        Node node_;
+        SizeT trans_;
+        Output out_;
+        Automaton::State aut_state_;
+        AutomatonStreamState(const Node &node, SizeT trans, Output out, Automaton::State aut_state)
+            : node_(node), trans_(trans), out_(out), aut_state_(aut_state) {}
+    };
+
+    Fst &fst_;
+    Automaton &aut_;
+    Vector<u8> inp_;
+    Vector<AutomatonStreamState> stack_;
+    bool check_empty_key_{true};
+
+public:
+    FstAutomatonStream(Fst &fst, Automaton &aut) : fst_(fst), aut_(aut) {
+        stack_.emplace_back(fst_.Root(), 0, Output(), aut_.Start());
+    }
+
+    /// @brief Get next key-value pair matched by the automaton per lexicographical order
+    /// @param key Stores the key of the pair when found
+    /// @param val Stores the value of the pair when found
+    /// @return true if found next pair, false if not
+    bool Next(Vector<u8> &key, u64 &val) {
+        if (check_empty_key_) {
+            check_empty_key_ = false;
+            AutomatonStreamState &root = stack_.back();
+            if (root.node_.IsFinal() && aut_.IsMatch(root.aut_state_)) {
+                key.clear();
+                val = root.node_.FinalOutput().Value();
+                return true;
+            }
+        }
+        while (!stack_.empty()) {
+            AutomatonStreamState &state = stack_.back();
+            if (state.trans_ >= state.node_.Len()) {
+                if (stack_.size() > 1) {
+                    inp_.pop_back();
+                }
+                stack_.pop_back();
+                continue;
+            }
+            Transition trans = state.node_.TransAt(state.trans_);
+            state.trans_++;
+            Automaton::State next_aut_state = aut_.Accept(state.aut_state_, trans.inp_);
+            if (next_aut_state == Automaton::kDeadState) {
+                continue;
+            }
+            Output out = state.out_.Cat(trans.out_);
+            Node next_node = fst_.NodeAt(trans.addr_);
+            inp_.push_back(trans.inp_);
+            stack_.emplace_back(next_node, 0, out, next_aut_state);
+            if (next_node.IsFinal() && aut_.IsMatch(next_aut_state)) {
+                key = inp_;
+                val = out.Cat(next_node.FinalOutput()).Value();
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace infinity
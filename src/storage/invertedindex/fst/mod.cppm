@@ -16,6 +16,7 @@ module;
 export module fst;
 export import :build;
 export import :fst;
+export import :automaton;
 export import :bytes;
 export import :error;
 export import :writer;
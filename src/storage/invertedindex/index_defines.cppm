@@ -15,11 +15,12 @@ export {
 
     enum OptionFlag {
         of_none = 0,
-        of_term_payload = 1,   // 1 << 0
-        of_doc_payload = 2,    // 1 << 1
-        of_position_list = 4,  // 1 << 2
-        of_term_frequency = 8, // 1 << 3
-        of_block_max = 16,     // 1 << 4
+        of_term_payload = 1,    // 1 << 0
+        of_doc_payload = 2,     // 1 << 1
+        of_position_list = 4,   // 1 << 2
+        of_term_frequency = 8,  // 1 << 3
+        of_block_max = 16,      // 1 << 4
+        of_quantized_norm = 32, // 1 << 5, lossy one byte document lengths for scoring
     };
 
     typedef u16 docpayload_t;
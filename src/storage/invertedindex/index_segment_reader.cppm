@@ -18,6 +18,7 @@ import stl;
 
 import segment_posting;
 import index_defines;
+import fst;
 export module index_segment_reader;
 
 namespace infinity {
@@ -28,6 +29,9 @@ public:
 
     // fetch_position is only valid in DiskIndexSegmentReader
     virtual bool GetSegmentPosting(const String &term, SegmentPosting &seg_posting, bool fetch_position = true) const = 0;
+
+    // Appends the terms of this segment matched by the automaton with their doc frequency in this segment
+    virtual void ExpandTerms(Automaton &automaton, Vector<Pair<String, u32>> &terms) const = 0;
 };
 
 } // namespace infinity
\ No newline at end of file
@@ -24,6 +24,7 @@ import index_defines;
 import posting_writer;
 import memory_indexer;
 import third_party;
+import fst;
 
 namespace infinity {
 InMemIndexSegmentReader::InMemIndexSegmentReader(MemoryIndexer *memory_indexer)
@@ -39,4 +40,12 @@ bool InMemIndexSegmentReader::GetSegmentPosting(const String &term, SegmentPosti
     return false;
 }
 
+void InMemIndexSegmentReader::ExpandTerms(Automaton &automaton, Vector<Pair<String, u32>> &terms) const {
+    posting_table_->store_.ForEachTerm([&](std::string_view term, const auto &posting) {
+        if (automaton.Matches((const u8 *)term.data(), term.size())) {
+            terms.emplace_back(String(term), posting->GetDF());
+        }
+    });
+}
+
 } // namespace infinity
\ No newline at end of file
@@ -24,6 +24,7 @@ import index_defines;
 import posting_writer;
 import memory_indexer;
 import internal_types;
+import fst;
 
 namespace infinity {
 export class InMemIndexSegmentReader : public IndexSegmentReader {
@@ -33,6 +34,8 @@ public:
 
     bool GetSegmentPosting(const String &term, SegmentPosting &seg_posting, bool fetch_position = true) const override;
 
+    void ExpandTerms(Automaton &automaton, Vector<Pair<String, u32>> &terms) const override;
+
 private:
     SharedPtr<MemoryIndexer::PostingTable> posting_table_;
     RowID base_row_id_{INVALID_ROWID};
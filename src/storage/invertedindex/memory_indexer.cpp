@@ -82,7 +82,6 @@ MemoryIndexer::MemoryIndexer(const String &index_dir, const String &base_name, R
       commiting_thread_pool_(infinity::InfinityContext::instance().GetFulltextCommitingThreadPool()), ring_inverted_(15UL), ring_sorted_(13UL) {
     assert(std::filesystem::path(index_dir).is_absolute());
     posting_table_ = MakeShared<PostingTable>();
-    prepared_posting_ = MakeShared<PostingWriter>(posting_format_, column_lengths_);
     spill_full_path_ = Path(index_dir) / (base_name + ".tmp.merge");
     spill_full_path_ = Path(InfinityContext::instance().config()->TempDir()) / StringTransform(spill_full_path_, "/", "_");
 }
@@ -293,14 +292,12 @@ void MemoryIndexer::Dump(bool offline, bool spill) {
     }
     if (posting_table_.get() != nullptr) {
         MemoryIndexer::PostingTableStore &posting_store = posting_table_->store_;
-        for (auto it = posting_store.UnsafeBegin(); it != posting_store.UnsafeEnd(); ++it) {
-            const MemoryIndexer::PostingPtr posting_writer = it->second;
+        for (const auto &[term, posting_writer] : posting_store.UnsafeSortedItems()) {
             TermMeta term_meta(posting_writer->GetDF(), posting_writer->GetTotalTF());
             posting_writer->Dump(posting_file_writer, term_meta, spill);
             SizeT term_meta_offset = dict_file_writer->TotalWrittenBytes();
             term_meta_dumpler.Dump(dict_file_writer, term_meta);
-            const String &term = it->first;
-            fst_builder.Insert((u8 *)term.c_str(), term.length(), term_meta_offset);
+            fst_builder.Insert((u8 *)term.data(), term.length(), term_meta_offset);
         }
         posting_file_writer->Sync();
         dict_file_writer->Sync();
@@ -370,10 +367,7 @@ SharedPtr<PostingWriter> MemoryIndexer::GetOrAddPosting(const String &term) {
     assert(posting_table_.get() != nullptr);
     MemoryIndexer::PostingTableStore &posting_store = posting_table_->store_;
     PostingPtr posting;
-    bool found = posting_store.GetOrAdd(term, posting, prepared_posting_);
-    if (!found) {
-        prepared_posting_ = MakeShared<PostingWriter>(posting_format_, column_lengths_);
-    }
+    posting_store.GetOrAdd(term, posting, [this] { return MakeShared<PostingWriter>(posting_format_, column_lengths_); });
     return posting;
 }
 
@@ -1,6 +1,7 @@
 module;
 
 #include <cassert>
+#include <cstring>
 
 module multi_posting_decoder;
 
@@ -22,6 +23,7 @@ import inmem_position_list_decoder;
 import skiplist_reader;
 import internal_types;
 import third_party;
+import posting_block_cache;
 
 namespace infinity {
 
@@ -32,6 +34,9 @@ MultiPostingDecoder::~MultiPostingDecoder() {
     if (in_doc_pos_iterator_) {
         delete in_doc_pos_iterator_;
     }
+    if (cache_hits_ + cache_misses_ > 0) {
+        PostingBlockCache::instance().RecordAccess(cache_hits_, cache_misses_);
+    }
 }
 
 void MultiPostingDecoder::Init(SharedPtr<Vector<SegmentPosting>> &seg_postings) {
@@ -62,6 +67,11 @@ Pair<u32, u16> MultiPostingDecoder::GetBlockMaxInfo() const { return index_decod
 
 bool MultiPostingDecoder::DecodeCurrentDocIDBuffer(docid_t *doc_buffer) {
     if (need_decode_doc_id_) {
+        if (const DecodedPostingBlock *block = GetCachedBlock(); block != nullptr) {
+            std::memcpy(doc_buffer, block->doc_ids_, sizeof(block->doc_ids_));
+            need_decode_doc_id_ = false;
+            return true;
+        }
         index_decoder_->DecodeCurrentDocIDBuffer(doc_buffer);
         need_decode_doc_id_ = false;
         return true;
@@ -72,6 +82,11 @@ bool MultiPostingDecoder::DecodeCurrentDocIDBuffer(docid_t *doc_buffer) {
 bool MultiPostingDecoder::DecodeCurrentTFBuffer(tf_t *tf_buffer) {
     assert(!need_decode_doc_id_);
     if (need_decode_tf_) {
+        if (cached_block_ != nullptr) {
+            std::memcpy(tf_buffer, cached_block_->tfs_, sizeof(cached_block_->tfs_));
+            need_decode_tf_ = false;
+            return true;
+        }
         index_decoder_->DecodeCurrentTFBuffer(tf_buffer);
         need_decode_tf_ = false;
         return true;
@@ -82,6 +97,11 @@ bool MultiPostingDecoder::DecodeCurrentTFBuffer(tf_t *tf_buffer) {
 void MultiPostingDecoder::DecodeCurrentDocPayloadBuffer(docpayload_t *doc_payload_buffer) {
     assert(!need_decode_doc_id_);
     if (need_decode_doc_payload_) {
+        if (cached_block_ != nullptr) {
+            std::memcpy(doc_payload_buffer, cached_block_->doc_payloads_, sizeof(cached_block_->doc_payloads_));
+            need_decode_doc_payload_ = false;
+            return;
+        }
         index_decoder_->DecodeCurrentDocPayloadBuffer(doc_payload_buffer);
         need_decode_doc_payload_ = false;
     }
@@ -103,6 +123,7 @@ bool MultiPostingDecoder::SkipInOneSegment(RowID start_row_id,
         return false;
     }
     need_decode_doc_id_ = true;
+    cached_block_ = nullptr;
     need_decode_tf_ = format_option_.HasTfList();
     need_decode_doc_payload_ = format_option_.HasDocPayload();
 
@@ -134,6 +155,8 @@ bool MultiPostingDecoder::MoveToSegment(RowID start_row_id) {
 
 bool MultiPostingDecoder::MemSegMoveToSegment(const SharedPtr<PostingWriter> &posting_writer) {
     InMemPostingDecoder *posting_decoder = posting_writer->CreateInMemPostingDecoder();
+    cached_term_.reset();
+    cached_block_ = nullptr;
     if (index_decoder_) {
         delete index_decoder_;
         index_decoder_ = nullptr;
@@ -176,6 +199,13 @@ bool MultiPostingDecoder::DiskSegMoveToSegment(SegmentPosting &cur_segment_posti
 
     index_decoder_->InitSkipList(doc_skiplist_start, doc_skiplist_end, posting_list, term_meta.GetDocFreq());
 
+    cached_term_.reset();
+    cached_block_ = nullptr;
+    if (const auto &posting_file_id = cur_segment_posting.GetPostingFileId(); posting_file_id) {
+        u32 block_count = (term_meta.GetDocFreq() + MAX_DOC_PER_RECORD - 1) / MAX_DOC_PER_RECORD;
+        cached_term_ = PostingBlockCache::instance().GetTerm(posting_file_id, cur_segment_posting.GetTermKey(), block_count);
+    }
+
     if (format_option_.HasPositionList()) {
         u32 pos_list_begin = doc_list_reader.Tell() + doc_skiplist_size + doc_list_size;
         in_doc_state_keeper_.MoveToSegment(posting_list, term_meta.GetTotalTermFreq(), pos_list_begin, format_option_);
@@ -190,6 +220,41 @@ bool MultiPostingDecoder::DiskSegMoveToSegment(SegmentPosting &cur_segment_posti
     return true;
 }
 
+const DecodedPostingBlock *MultiPostingDecoder::GetCachedBlock() {
+    if (!cached_term_) {
+        return nullptr;
+    }
+    u32 block_idx = index_decoder_->GetSkippedItemCount();
+    if (block_idx >= cached_term_->BlockCount()) [[unlikely]] {
+        return nullptr;
+    }
+    cached_block_ = cached_term_->GetBlock(block_idx);
+    if (cached_block_ != nullptr) {
+        ++cache_hits_;
+        return cached_block_;
+    }
+    ++cache_misses_;
+    if (cached_term_->Full()) {
+        return nullptr;
+    }
+    // doc ids, tfs and payloads are stored back to back, so decode them all while the reader is positioned
+    auto block = MakeUnique<DecodedPostingBlock>();
+    index_decoder_->DecodeCurrentDocIDBuffer(block->doc_ids_);
+    if (format_option_.HasTfList()) {
+        index_decoder_->DecodeCurrentTFBuffer(block->tfs_);
+    }
+    if (format_option_.HasDocPayload()) {
+        index_decoder_->DecodeCurrentDocPayloadBuffer(block->doc_payloads_);
+    }
+    cached_block_ = cached_term_->PutBlock(block_idx, block);
+    if (cached_block_ == nullptr) {
+        // another reader filled the term meanwhile, the block is only used here
+        uncached_block_ = std::move(block);
+        cached_block_ = uncached_block_.get();
+    }
+    return cached_block_;
+}
+
 IndexDecoder* MultiPostingDecoder::CreateDocIndexDecoder(u32 doc_list_begin_pos) {
     return new SkipIndexDecoder<SkipListReaderByteSlice>(&doc_reader_, doc_list_begin_pos, format_option_.GetDocListFormatOption());
 }
@@ -14,6 +14,7 @@ import index_defines;
 import posting_list_format;
 import internal_types;
 import posting_writer;
+import posting_block_cache;
 
 namespace infinity {
 export class MultiPostingDecoder {
@@ -78,6 +79,10 @@ private:
 
     IndexDecoder *CreateDocIndexDecoder(u32 doc_list_begin_pos);
 
+    // Returns the cached decoded record the index decoder is positioned at, decoding and publishing it on miss.
+    // Returns nullptr if the current segment is not cached.
+    const DecodedPostingBlock *GetCachedBlock();
+
 private:
     PostingFormatOption format_option_;
     bool need_decode_doc_id_ = false;
@@ -92,6 +97,12 @@ private:
     ByteSliceReader doc_list_reader_;
     InDocPositionIterator *in_doc_pos_iterator_ = nullptr;
     InDocStateKeeper in_doc_state_keeper_;
+
+    SharedPtr<CachedPostingTerm> cached_term_;
+    const DecodedPostingBlock *cached_block_ = nullptr;
+    UniquePtr<DecodedPostingBlock> uncached_block_;
+    u64 cache_hits_ = 0;
+    u64 cache_misses_ = 0;
 private:
     ByteSliceReader doc_reader_;
     ByteSliceReader pos_reader_;
@@ -0,0 +1,172 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <sys/stat.h>
+
+module posting_block_cache;
+
+import stl;
+import index_defines;
+import third_party;
+import utility;
+
+namespace infinity {
+
+SharedPtr<const PostingFileId> PostingFileId::Make(const String &path) {
+    struct stat st {};
+    if (::stat(path.c_str(), &st) != 0) {
+        return nullptr;
+    }
+    auto file_id = MakeShared<PostingFileId>();
+    file_id->path_ = path;
+    file_id->device_ = st.st_dev;
+    file_id->inode_ = st.st_ino;
+    file_id->mtime_ns_ = static_cast<i64>(st.st_mtim.tv_sec) * 1'000'000'000 + st.st_mtim.tv_nsec;
+    file_id->size_ = st.st_size;
+    file_id->hash_ = std::hash<String>{}(path) ^ Mix(file_id->inode_ ^ Mix(file_id->size_ ^ Mix(file_id->mtime_ns_)));
+    return file_id;
+}
+
+CachedPostingTerm::CachedPostingTerm(u32 block_count, SizeT max_charge, Atomic<SizeT> *usage)
+    : block_count_(block_count), max_charge_(max_charge), blocks_(MakeUnique<Atomic<DecodedPostingBlock *>[]>(block_count)), usage_(usage) {
+    for (u32 i = 0; i < block_count_; ++i) {
+        blocks_[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+CachedPostingTerm::~CachedPostingTerm() {
+    for (u32 i = 0; i < block_count_; ++i) {
+        delete blocks_[i].load(std::memory_order_relaxed);
+    }
+    usage_->fetch_sub(charge_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+const DecodedPostingBlock *CachedPostingTerm::PutBlock(u32 block_idx, UniquePtr<DecodedPostingBlock> &block) {
+    if (const DecodedPostingBlock *cached = GetBlock(block_idx); cached != nullptr) {
+        return cached;
+    }
+    // reserve the charge first, so that concurrent publishers can't take the term past its cap
+    SizeT charge = charge_.load(std::memory_order_relaxed);
+    do {
+        if (charge + sizeof(DecodedPostingBlock) > max_charge_) {
+            return nullptr;
+        }
+    } while (!charge_.compare_exchange_weak(charge, charge + sizeof(DecodedPostingBlock), std::memory_order_relaxed));
+
+    DecodedPostingBlock *expected = nullptr;
+    if (blocks_[block_idx].compare_exchange_strong(expected, block.get(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+        usage_->fetch_add(sizeof(DecodedPostingBlock), std::memory_order_relaxed);
+        return block.release();
+    }
+    charge_.fetch_sub(sizeof(DecodedPostingBlock), std::memory_order_relaxed);
+    return expected;
+}
+
+PostingBlockCache::PostingBlockCache(SizeT capacity) : sketch_(MakeUnique<Atomic<u8>[]>(kSketchSize)), capacity_(capacity) {
+    for (SizeT i = 0; i < kSketchSize; ++i) {
+        sketch_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+PostingBlockCache::~PostingBlockCache() { Clear(); }
+
+u8 PostingBlockCache::IncrementFrequency(u64 hash) {
+    // Halve all counters once the window is over so that formerly hot terms fade out.
+    if (sketch_increments_.fetch_add(1, std::memory_order_relaxed) + 1 == kSketchSize * 8) {
+        sketch_increments_.store(0, std::memory_order_relaxed);
+        for (SizeT i = 0; i < kSketchSize; ++i) {
+            sketch_[i].store(sketch_[i].load(std::memory_order_relaxed) >> 1, std::memory_order_relaxed);
+        }
+    }
+    Atomic<u8> &counter = sketch_[hash & (kSketchSize - 1)];
+    u8 count = counter.load(std::memory_order_relaxed);
+    if (count < std::numeric_limits<u8>::max()) {
+        count = counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    return count;
+}
+
+SharedPtr<CachedPostingTerm> PostingBlockCache::GetTerm(const SharedPtr<const PostingFileId> &file_id, u64 term_key, u32 block_count) {
+    Key key{file_id, term_key};
+    SizeT hash = KeyHash{}(key);
+    Shard &shard = shards_[hash % kShardNum];
+    SizeT shard_capacity = capacity_.load(std::memory_order_relaxed) / kShardNum;
+    if (shard_capacity < sizeof(DecodedPostingBlock) || block_count == 0) {
+        return nullptr;
+    }
+    {
+        std::lock_guard<mutex> lock(shard.mutex_);
+        if (auto iter = shard.map_.find(key); iter != shard.map_.end()) {
+            shard.lru_.splice(shard.lru_.begin(), shard.lru_, iter->second);
+            return iter->second->second;
+        }
+    }
+    if (IncrementFrequency(hash >> 32) < kAdmitThreshold) {
+        rejected_terms_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    std::lock_guard<mutex> lock(shard.mutex_);
+    if (auto iter = shard.map_.find(key); iter != shard.map_.end()) {
+        shard.lru_.splice(shard.lru_.begin(), shard.lru_, iter->second);
+        return iter->second->second;
+    }
+    while (shard.usage_.load(std::memory_order_relaxed) > shard_capacity && !shard.lru_.empty()) {
+        shard.map_.erase(shard.lru_.back().first);
+        shard.lru_.pop_back();
+        evicted_terms_.fetch_add(1, std::memory_order_relaxed);
+    }
+    auto term = MakeShared<CachedPostingTerm>(block_count, shard_capacity, &shard.usage_);
+    shard.lru_.emplace_front(key, term);
+    shard.map_.emplace(key, shard.lru_.begin());
+    admitted_terms_.fetch_add(1, std::memory_order_relaxed);
+    return term;
+}
+
+void PostingBlockCache::Clear() {
+    for (Shard &shard : shards_) {
+        std::lock_guard<mutex> lock(shard.mutex_);
+        shard.map_.clear();
+        shard.lru_.clear();
+    }
+}
+
+PostingBlockCacheStats PostingBlockCache::GetStats() const {
+    PostingBlockCacheStats stats;
+    stats.hits_ = hits_.load(std::memory_order_relaxed);
+    stats.misses_ = misses_.load(std::memory_order_relaxed);
+    stats.admitted_terms_ = admitted_terms_.load(std::memory_order_relaxed);
+    stats.rejected_terms_ = rejected_terms_.load(std::memory_order_relaxed);
+    stats.evicted_terms_ = evicted_terms_.load(std::memory_order_relaxed);
+    for (const Shard &shard : shards_) {
+        stats.usage_ += shard.usage_.load(std::memory_order_relaxed);
+    }
+    stats.capacity_ = capacity_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+String PostingBlockCacheStats::ToString() const {
+    return fmt::format("hits: {}, misses: {}, admitted terms: {}, rejected terms: {}, evicted terms: {}, usage: {}/{}",
+                       hits_,
+                       misses_,
+                       admitted_terms_,
+                       rejected_terms_,
+                       evicted_terms_,
+                       Utility::FormatByteSize(usage_),
+                       Utility::FormatByteSize(capacity_));
+}
+
+} // namespace infinity
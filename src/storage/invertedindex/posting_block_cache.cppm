@@ -0,0 +1,167 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module posting_block_cache;
+import stl;
+import singleton;
+import index_defines;
+import default_values;
+
+namespace infinity {
+
+u64 Mix(u64 x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// Identity of a mapped posting file. A path reused by a new chunk or a file rewritten in place gets another identity,
+// so the blocks cached for the old content are never served for it.
+export struct PostingFileId {
+    String path_;
+    u64 device_{};
+    u64 inode_{};
+    i64 mtime_ns_{};
+    u64 size_{};
+    SizeT hash_{};
+
+    // Returns nullptr if the file can't be stat'ed, its blocks are not cached then.
+    static SharedPtr<const PostingFileId> Make(const String &path);
+
+    bool operator==(const PostingFileId &other) const {
+        return hash_ == other.hash_ && device_ == other.device_ && inode_ == other.inode_ && mtime_ns_ == other.mtime_ns_ &&
+               size_ == other.size_ && path_ == other.path_;
+    }
+};
+
+// One doc list record of an on-disk posting, fully decoded.
+export struct DecodedPostingBlock {
+    docid_t doc_ids_[MAX_DOC_PER_RECORD];
+    tf_t tfs_[MAX_DOC_PER_RECORD];
+    docpayload_t doc_payloads_[MAX_DOC_PER_RECORD];
+};
+
+// Decoded blocks of one term in one chunk.
+// Blocks are published once and never modified afterwards, so readers only need an atomic load.
+// A term holds at most `max_charge` bytes of blocks (the share of one cache shard): a long posting streamed
+// through the cache keeps its first blocks and the rest is decoded as without the cache.
+export class CachedPostingTerm {
+public:
+    CachedPostingTerm(u32 block_count, SizeT max_charge, Atomic<SizeT> *usage);
+
+    ~CachedPostingTerm();
+
+    u32 BlockCount() const { return block_count_; }
+
+    const DecodedPostingBlock *GetBlock(u32 block_idx) const { return blocks_[block_idx].load(std::memory_order_acquire); }
+
+    // Returns the block which ends up cached, which is not `block` if another reader published first.
+    // Returns nullptr and leaves `block` to the caller if the term is full.
+    const DecodedPostingBlock *PutBlock(u32 block_idx, UniquePtr<DecodedPostingBlock> &block);
+
+    bool Full() const { return charge_.load(std::memory_order_relaxed) + sizeof(DecodedPostingBlock) > max_charge_; }
+
+    SizeT Charge() const { return charge_.load(std::memory_order_relaxed); }
+
+private:
+    const u32 block_count_;
+    const SizeT max_charge_;
+    UniquePtr<Atomic<DecodedPostingBlock *>[]> blocks_;
+    Atomic<SizeT> charge_{0};
+    Atomic<SizeT> *usage_;
+};
+
+export struct PostingBlockCacheStats {
+    u64 hits_{0};
+    u64 misses_{0};
+    u64 admitted_terms_{0};
+    u64 rejected_terms_{0};
+    u64 evicted_terms_{0};
+    SizeT usage_{0};
+    SizeT capacity_{0};
+
+    String ToString() const;
+};
+
+// Size bounded cache of decoded posting blocks, keyed by (posting file, term, block).
+//
+// Terms are admitted only after they were looked up kAdmitThreshold times within the recent
+// window of a small frequency sketch, so that one-off terms don't flush the hot ones.
+// Eviction is LRU at term granularity and happens only when a term is looked up.
+export class PostingBlockCache : public Singleton<PostingBlockCache> {
+public:
+    static constexpr SizeT kDefaultCapacity = DEFAULT_POSTING_BLOCK_CACHE_SIZE;
+    static constexpr SizeT kShardNum = 16;
+    static constexpr SizeT kSketchSize = 1UL << 16;
+    static constexpr u8 kAdmitThreshold = 2;
+
+    explicit PostingBlockCache(SizeT capacity = kDefaultCapacity);
+
+    ~PostingBlockCache();
+
+    // Returns nullptr if the term is not admitted (yet). `term_key` is the offset of the term posting in the file.
+    SharedPtr<CachedPostingTerm> GetTerm(const SharedPtr<const PostingFileId> &file_id, u64 term_key, u32 block_count);
+
+    void RecordAccess(u64 hits, u64 misses) {
+        hits_.fetch_add(hits, std::memory_order_relaxed);
+        misses_.fetch_add(misses, std::memory_order_relaxed);
+    }
+
+    void SetCapacity(SizeT capacity) { capacity_.store(capacity, std::memory_order_relaxed); }
+
+    void Clear();
+
+    PostingBlockCacheStats GetStats() const;
+
+private:
+    // the file identity is compared in full, not by its hash
+    struct Key {
+        SharedPtr<const PostingFileId> file_id_;
+        u64 term_key_;
+
+        bool operator==(const Key &other) const {
+            return term_key_ == other.term_key_ && (file_id_ == other.file_id_ || *file_id_ == *other.file_id_);
+        }
+    };
+
+    struct KeyHash {
+        SizeT operator()(const Key &key) const { return Mix(key.file_id_->hash_ ^ Mix(key.term_key_)); }
+    };
+
+    struct Shard {
+        mutex mutex_;
+        List<Pair<Key, SharedPtr<CachedPostingTerm>>> lru_;
+        HashMap<Key, List<Pair<Key, SharedPtr<CachedPostingTerm>>>::iterator, KeyHash> map_;
+        Atomic<SizeT> usage_{0};
+    };
+
+    // Bumps the sketch counter of the key and returns its new value.
+    u8 IncrementFrequency(u64 hash);
+
+    Array<Shard, kShardNum> shards_;
+    UniquePtr<Atomic<u8>[]> sketch_;
+    Atomic<u64> sketch_increments_{0};
+    Atomic<SizeT> capacity_;
+
+    Atomic<u64> hits_{0};
+    Atomic<u64> misses_{0};
+    Atomic<u64> admitted_terms_{0};
+    Atomic<u64> rejected_terms_{0};
+    Atomic<u64> evicted_terms_{0};
+};
+
+} // namespace infinity
@@ -19,7 +19,7 @@ module posting_writer;
 namespace infinity {
 
 PostingWriter::PostingWriter(const PostingFormat &posting_format, VectorWithLock<u32> &column_lengths)
-    : posting_format_(posting_format), column_lengths_(column_lengths) {
+    : posting_format_(posting_format), column_lengths_(column_lengths), quantized_norm_(posting_format.GetOption().HasQuantizedNorm()) {
     if (posting_format.GetOption().HasPositionList()) {
         position_list_encoder_ = new PositionListEncoder(posting_format.GetOption(), posting_format.GetPositionListFormat());
     }
@@ -13,6 +13,7 @@ import posting_list_format;
 import index_defines;
 import term_meta;
 import vector_with_lock;
+import small_float;
 
 namespace infinity {
 export class PostingWriter {
@@ -45,7 +46,11 @@ public:
 
     InMemPostingDecoder *CreateInMemPostingDecoder() const;
 
-    u32 GetDocColumnLength(docid_t doc_id) { return column_lengths_.Get(doc_id); }
+    // Block max info shall be computed with the lengths used for scoring
+    u32 GetDocColumnLength(docid_t doc_id) {
+        u32 doc_len = column_lengths_.Get(doc_id);
+        return quantized_norm_ ? SmallFloat::Quantize(doc_len) : doc_len;
+    }
 
 private:
     const PostingFormat &posting_format_;
@@ -53,6 +58,7 @@ private:
     PositionListEncoder *position_list_encoder_{nullptr};
     // for column length info
     VectorWithLock<u32> &column_lengths_;
+    bool quantized_norm_{false};
 };
 
 export using PostingWriterProvider = std::function<SharedPtr<PostingWriter>(const String &)>;
@@ -25,12 +25,14 @@ import chunk_index_entry;
 import memory_indexer;
 import buffer_obj;
 import buffer_handle;
+import index_defines;
+import small_float;
 
 namespace infinity {
 
 FullTextColumnLengthReader::FullTextColumnLengthReader(ColumnIndexReader *reader)
     : index_dir_(reader->index_dir_), chunk_index_entries_(reader->chunk_index_entries_),
-      memory_indexer_(reader->memory_indexer_) {
+      memory_indexer_(reader->memory_indexer_), quantize_norm_(reader->GetOptionFlag() & of_quantized_norm) {
     Pair<u64, float> df_and_avg_column_len = reader->GetTotalDfAndAvgColumnLength();
     total_df_ = df_and_avg_column_len.first;
     avg_column_len_ = df_and_avg_column_len.second;
@@ -57,11 +59,16 @@ u32 FullTextColumnLengthReader::SeekFile(RowID row_id) {
         return 0;
     }
 
+    current_chunk_base_rowid_ = chunk_index_entries_[current_chunk]->base_rowid_;
+    current_chunk_row_count_ = chunk_index_entries_[current_chunk]->row_count_;
+    if (quantize_norm_) {
+        current_chunk_norms_ = chunk_index_entries_[current_chunk]->GetQuantizedNorms();
+        quantized_norms_ = current_chunk_norms_->data();
+        return SmallFloat::Byte4ToInt(quantized_norms_[row_id - current_chunk_base_rowid_]);
+    }
     // Load the column-length file of the ChunkIndexEntry
     current_chunk_buffer_handle_ = chunk_index_entries_[current_chunk]->GetBufferObj()->Load();
     column_lengths_ = (const u32 *)current_chunk_buffer_handle_.GetData();
-    current_chunk_base_rowid_ = chunk_index_entries_[current_chunk]->base_rowid_;
-    current_chunk_row_count_ = chunk_index_entries_[current_chunk]->row_count_;
     return column_lengths_[row_id - current_chunk_base_rowid_];
 }
 } // namespace infinity
\ No newline at end of file
@@ -26,6 +26,7 @@ import memory_indexer;
 import buffer_obj;
 import buffer_handle;
 import column_index_reader;
+import small_float;
 
 namespace infinity {
 class FileSystem;
@@ -36,6 +37,9 @@ public:
 
     inline u32 GetColumnLength(RowID row_id) {
         if (row_id >= current_chunk_base_rowid_ && row_id < current_chunk_base_rowid_ + current_chunk_row_count_) [[likely]] {
+            if (quantized_norms_ != nullptr) {
+                return SmallFloat::Byte4ToInt(quantized_norms_[row_id - current_chunk_base_rowid_]);
+            }
             assert(column_lengths_ != nullptr);
             return column_lengths_[row_id - current_chunk_base_rowid_];
         }
@@ -43,7 +47,8 @@ public:
             RowID base_rowid = memory_indexer_->GetBaseRowId();
             u32 doc_count = memory_indexer_->GetDocCount();
             if (row_id >= base_rowid && row_id < base_rowid + doc_count) {
-                return memory_indexer_->GetColumnLength(row_id - base_rowid);
+                u32 column_length = memory_indexer_->GetColumnLength(row_id - base_rowid);
+                return quantize_norm_ ? SmallFloat::Quantize(column_length) : column_length;
             }
         }
         return SeekFile(row_id);
@@ -60,6 +65,10 @@ private:
     u64 total_df_;
     float avg_column_len_;
     const u32 *column_lengths_{nullptr};
+    // set instead of column_lengths_ if the index is built with of_quantized_norm
+    bool quantize_norm_{false};
+    const u8 *quantized_norms_{nullptr};
+    SharedPtr<Vector<u8>> current_chunk_norms_{};
     RowID current_chunk_base_rowid_{(u64)0};
     u32 current_chunk_row_count_{0};
     BufferHandle current_chunk_buffer_handle_{};
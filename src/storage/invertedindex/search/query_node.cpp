@@ -20,6 +20,7 @@ import term_doc_iterator;
 import phrase_doc_iterator;
 import blockmax_wand_iterator;
 import blockmax_maxscore_iterator;
+import fst;
 
 namespace infinity {
 
@@ -56,7 +57,10 @@ std::unique_ptr<QueryNode> QueryNode::GetOptimizedQueryTree(std::unique_ptr<Quer
             optimized_root = std::move(root);
             break;
         }
-        case QueryNodeType::PHRASE: {
+        case QueryNodeType::PHRASE:
+        case QueryNodeType::PREFIX_TERM:
+        case QueryNodeType::WILDCARD_TERM:
+        case QueryNodeType::FUZZY_TERM: {
             // no need to optimize
             optimized_root = std::move(root);
             break;
@@ -109,7 +113,10 @@ std::unique_ptr<QueryNode> MultiQueryNode::GetNewOptimizedQueryTree() {
                 // no need to optimize
                 break;
             }
-            case QueryNodeType::PHRASE: {
+            case QueryNodeType::PHRASE:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM: {
                 break;
             }
             case QueryNodeType::AND_NOT: {
@@ -164,6 +171,9 @@ std::unique_ptr<QueryNode> NotQueryNode::InnerGetNewOptimizedQueryTree() {
             }
             case QueryNodeType::TERM:
             case QueryNodeType::PHRASE:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM:
             case QueryNodeType::AND:
             case QueryNodeType::AND_NOT: {
                 new_not_list.emplace_back(std::move(child));
@@ -218,6 +228,9 @@ std::unique_ptr<QueryNode> AndQueryNode::InnerGetNewOptimizedQueryTree() {
             }
             case QueryNodeType::TERM:
             case QueryNodeType::PHRASE:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM:
             case QueryNodeType::OR: {
                 and_list.emplace_back(std::move(child));
                 break;
@@ -309,6 +322,9 @@ std::unique_ptr<QueryNode> OrQueryNode::InnerGetNewOptimizedQueryTree() {
             }
             case QueryNodeType::TERM:
             case QueryNodeType::PHRASE:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM:
             case QueryNodeType::AND:
             case QueryNodeType::AND_NOT: {
                 or_list.emplace_back(std::move(child));
@@ -456,6 +472,51 @@ PhraseQueryNode::CreateSearch(const TableEntry *table_entry, const IndexReader &
     return search;
 }
 
+std::unique_ptr<DocIterator>
+MultiTermQueryNode::CreateSearch(const TableEntry *table_entry, const IndexReader &index_reader, EarlyTermAlgo early_term_algo) const {
+    ColumnID column_id = table_entry->GetColumnIdByName(column_);
+    ColumnIndexReader *column_index_reader = index_reader.GetColumnIndexReader(column_id);
+    if (!column_index_reader) {
+        RecoverableError(Status::SyntaxError(fmt::format(R"(Invalid query statement: Column "{}" has no fulltext index)", column_)));
+        return nullptr;
+    }
+    // the index reader is fixed for a query tree, so the expansion is done once and kept alive for the iterators
+    std::call_once(expand_flag_, [&] {
+        UniquePtr<Automaton> automaton;
+        switch (type_) {
+            case QueryNodeType::PREFIX_TERM: {
+                automaton = MakeUnique<PrefixAutomaton>(term_);
+                break;
+            }
+            case QueryNodeType::WILDCARD_TERM: {
+                automaton = MakeUnique<WildcardAutomaton>(term_);
+                break;
+            }
+            case QueryNodeType::FUZZY_TERM: {
+                u32 distance = static_cast<const FuzzyTermQueryNode *>(this)->distance_;
+                automaton = MakeUnique<LevenshteinAutomaton>(term_, std::min(distance, FuzzyTermQueryNode::kMaxDistance));
+                break;
+            }
+            default: {
+                UnrecoverableError("MultiTermQueryNode: Unexpected query node type!");
+                return;
+            }
+        }
+        Vector<String> terms = column_index_reader->ExpandTerms(*automaton, max_expansions_);
+        // reuse the "or" of terms, so that block max algorithms apply to the expanded terms
+        auto or_node = std::make_unique<OrQueryNode>();
+        for (auto &term : terms) {
+            auto term_node = std::make_unique<TermQueryNode>();
+            term_node->term_ = std::move(term);
+            term_node->column_ = column_;
+            term_node->MultiplyWeight(GetWeight());
+            or_node->Add(std::move(term_node));
+        }
+        expanded_ = std::move(or_node);
+    });
+    return expanded_->CreateSearch(table_entry, index_reader, early_term_algo);
+}
+
 std::unique_ptr<DocIterator>
 AndQueryNode::CreateSearch(const TableEntry *table_entry, const IndexReader &index_reader, EarlyTermAlgo early_term_algo) const {
     Vector<std::unique_ptr<DocIterator>> sub_doc_iters;
@@ -556,6 +617,10 @@ std::string QueryNodeTypeToString(QueryNodeType type) {
             return "PHRASE";
         case QueryNodeType::PREFIX_TERM:
             return "PREFIX_TERM";
+        case QueryNodeType::WILDCARD_TERM:
+            return "WILDCARD_TERM";
+        case QueryNodeType::FUZZY_TERM:
+            return "FUZZY_TERM";
         case QueryNodeType::SUFFIX_TERM:
             return "SUFFIX_TERM";
         case QueryNodeType::SUBSTRING_TERM:
@@ -575,6 +640,26 @@ void TermQueryNode::PrintTree(std::ostream &os, const std::string &prefix, bool
 
 void TermQueryNode::GetQueryTerms(std::vector<std::string> &terms) const { terms.push_back(term_); }
 
+void MultiTermQueryNode::PrintTree(std::ostream &os, const std::string &prefix, bool is_final) const {
+    os << prefix;
+    os << (is_final ? "└──" : "├──");
+    os << QueryNodeTypeToString(type_);
+    os << " (weight: " << weight_ << ")";
+    os << " (column: " << column_ << ")";
+    os << " (term: " << term_ << ")";
+    if (type_ == QueryNodeType::FUZZY_TERM) {
+        os << " (distance: " << static_cast<const FuzzyTermQueryNode *>(this)->distance_ << ")";
+    }
+    os << " (max_expansions: " << max_expansions_ << ")";
+    os << '\n';
+}
+
+void MultiTermQueryNode::GetQueryTerms(std::vector<std::string> &terms) const {
+    if (expanded_) {
+        expanded_->GetQueryTerms(terms);
+    }
+}
+
 void PhraseQueryNode::PrintTree(std::ostream &os, const std::string &prefix, bool is_final) const {
     os << prefix;
     os << (is_final ? "└──" : "├──");
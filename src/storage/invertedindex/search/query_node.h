@@ -16,6 +16,7 @@
 #define QUERY_NODE_H
 
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -37,8 +38,11 @@ enum class QueryNodeType : char {
     AND,
     AND_NOT,
     OR,
-    // unimplemented:
+    // terms expanded against the term dictionary:
     PREFIX_TERM,
+    WILDCARD_TERM,
+    FUZZY_TERM,
+    // unimplemented:
     SUFFIX_TERM,
     SUBSTRING_TERM,
 };
@@ -117,6 +121,44 @@ struct PhraseQueryNode final : public QueryNode {
     void AddTerm(const std::string &term) { terms_.emplace_back(term); }
 };
 
+// A pattern expanded to the matching terms of the dictionary.
+// The expanded terms are searched as an "or" of term queries sharing the weight of this node.
+struct MultiTermQueryNode : public QueryNode {
+    static constexpr uint32_t kDefaultMaxExpansions = 50;
+
+    std::string term_;
+    std::string column_;
+    uint32_t max_expansions_ = kDefaultMaxExpansions;
+
+    explicit MultiTermQueryNode(QueryNodeType type) : QueryNode(type) {}
+
+    void PushDownWeight(float factor) final { MultiplyWeight(factor); }
+    std::unique_ptr<DocIterator> CreateSearch(const TableEntry *table_entry, const IndexReader &index_reader, EarlyTermAlgo early_term_algo) const final;
+    void PrintTree(std::ostream &os, const std::string &prefix, bool is_final) const final;
+    void GetQueryTerms(std::vector<std::string> &terms) const final;
+
+private:
+    mutable std::once_flag expand_flag_;
+    mutable std::unique_ptr<QueryNode> expanded_;
+};
+
+struct PrefixTermQueryNode final : public MultiTermQueryNode {
+    PrefixTermQueryNode() : MultiTermQueryNode(QueryNodeType::PREFIX_TERM) {}
+};
+
+// "*" matches any sequence of characters, "?" matches a single character
+struct WildcardTermQueryNode final : public MultiTermQueryNode {
+    WildcardTermQueryNode() : MultiTermQueryNode(QueryNodeType::WILDCARD_TERM) {}
+};
+
+struct FuzzyTermQueryNode final : public MultiTermQueryNode {
+    static constexpr uint32_t kMaxDistance = 2;
+
+    uint32_t distance_ = kMaxDistance;
+
+    FuzzyTermQueryNode() : MultiTermQueryNode(QueryNodeType::FUZZY_TERM) {}
+};
+
 struct MultiQueryNode : public QueryNode {
     std::vector<std::unique_ptr<QueryNode>> children_;
 
@@ -164,7 +206,6 @@ struct OrQueryNode final : public MultiQueryNode {
 // unimplemented
 struct WandQueryNode;
 // struct PhraseQueryNode;
-struct PrefixTermQueryNode;
 struct SuffixTermQueryNode;
 struct SubstringTermQueryNode;
 
@@ -12,7 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <cassert>
+#include <cctype>
 #include <iostream>
 #include <sstream>
 #include <utility>
@@ -114,7 +116,9 @@ std::unique_ptr<QueryNode> SearchDriver::ParseSingleWithFields(const std::string
 }
 
 std::unique_ptr<QueryNode> SearchDriver::ParseSingle(const std::string &query, const std::string *default_field_ptr) const {
-    std::istringstream iss(query);
+    // the plain syntax scanner drops every special character, so wildcards are only supported by the infinity syntax
+    const bool escape_wildcards = wildcard_ && operator_option_ == FulltextQueryOperatorOption::kInfinitySyntax;
+    std::istringstream iss(escape_wildcards ? EscapeWildcards(query) : query);
     if (!iss.good()) {
         return nullptr;
     }
@@ -153,6 +157,21 @@ SearchDriver::AnalyzeAndBuildQueryNode(const std::string &field, std::string &&t
         RecoverableError(status);
         return nullptr;
     }
+    if (wildcard_ && !from_quoted && text.find_first_of("*?") != std::string::npos) {
+        // patterns are not analyzed, only lowercased like the standard analyzers do
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+        std::unique_ptr<MultiTermQueryNode> result;
+        if (auto pos = text.find_first_of("*?"); pos + 1 == text.size() && text.back() == '*') {
+            result = std::make_unique<PrefixTermQueryNode>();
+            text.pop_back();
+        } else {
+            result = std::make_unique<WildcardTermQueryNode>();
+        }
+        result->term_ = std::move(text);
+        result->column_ = field;
+        result->max_expansions_ = max_expansions_;
+        return result;
+    }
     Term input_term;
     input_term.text_ = std::move(text);
     TermList terms;
@@ -205,6 +224,14 @@ SearchDriver::AnalyzeAndBuildQueryNode(const std::string &field, std::string &&t
         result->term_ = std::move(input_term.text_);
         result->column_ = field;
         return result;
+    } else if (fuzzy_ && terms.size() == 1 && !from_quoted && slop > 0) {
+        // with the fuzzy option, "term~N" of a single term is a fuzzy query, as in Lucene
+        auto result = std::make_unique<FuzzyTermQueryNode>();
+        result->term_ = std::move(terms.front().text_);
+        result->column_ = field;
+        result->distance_ = std::min<uint32_t>(slop, FuzzyTermQueryNode::kMaxDistance);
+        result->max_expansions_ = max_expansions_;
+        return result;
     } else if (terms.size() == 1) {
         auto result = std::make_unique<TermQueryNode>();
         result->term_ = std::move(terms.front().text_);
@@ -293,4 +320,27 @@ std::string SearchDriver::Unescape(const std::string &text) {
     return result;
 }
 
+std::string SearchDriver::EscapeWildcards(const std::string &query) {
+    std::string result;
+    result.reserve(query.size());
+    char quote = 0;
+    for (size_t i = 0; i < query.size(); ++i) {
+        char c = query[i];
+        if (quote) {
+            if (c == quote) {
+                quote = 0;
+            }
+        } else if (c == '\\' && i + 1 < query.size()) {
+            result.push_back(c);
+            c = query[++i];
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '*' || c == '?') {
+            result.push_back('\\');
+        }
+        result.push_back(c);
+    }
+    return result;
+}
+
 } // namespace infinity
@@ -18,9 +18,9 @@
 #include <memory>
 #include <string>
 
-namespace infinity {
+#include "query_node.h"
 
-struct QueryNode;
+namespace infinity {
 
 enum class FulltextQueryOperatorOption {
     kInfinitySyntax, // use parser's syntax
@@ -35,8 +35,12 @@ class SearchDriver {
 public:
     SearchDriver(const std::map<std::string, std::string> &field2analyzer,
                  const std::string &default_field,
-                 const FulltextQueryOperatorOption operator_option = FulltextQueryOperatorOption::kInfinitySyntax)
-        : field2analyzer_{field2analyzer}, default_field_{SearchDriver::Unescape(default_field)}, operator_option_(operator_option) {}
+                 const FulltextQueryOperatorOption operator_option = FulltextQueryOperatorOption::kInfinitySyntax,
+                 const bool wildcard = false,
+                 const uint32_t max_expansions = MultiTermQueryNode::kDefaultMaxExpansions,
+                 const bool fuzzy = false)
+        : field2analyzer_{field2analyzer}, default_field_{SearchDriver::Unescape(default_field)}, operator_option_(operator_option),
+          wildcard_(wildcard), max_expansions_(max_expansions), fuzzy_(fuzzy) {}
 
     // used in PhysicalMatch
     [[nodiscard]] std::unique_ptr<QueryNode> ParseSingleWithFields(const std::string &fields_str, const std::string &query) const;
@@ -53,12 +57,21 @@ public:
 
     [[nodiscard]] static std::string Unescape(const std::string &text);
 
+    // escape "*" and "?" outside of quoted strings so that they reach the parser as part of the term
+    [[nodiscard]] static std::string EscapeWildcards(const std::string &query);
+
     /**
      * parsing options
      */
     const std::map<std::string, std::string> &field2analyzer_;
     const std::string default_field_;
     const FulltextQueryOperatorOption operator_option_ = FulltextQueryOperatorOption::kInfinitySyntax;
+    // "*" and "?" in unquoted text are wildcards, and a trailing "*" alone makes a prefix query
+    const bool wildcard_ = false;
+    // max number of terms a prefix, wildcard or fuzzy term expands to
+    const uint32_t max_expansions_ = MultiTermQueryNode::kDefaultMaxExpansions;
+    // "term~N" of a single unquoted term is a fuzzy query, otherwise the slop of a single term is ignored
+    const bool fuzzy_ = false;
 };
 
 } // namespace infinity
@@ -22,6 +22,7 @@ import term_meta;
 import index_defines;
 import internal_types;
 import file_reader;
+import posting_block_cache;
 
 export module segment_posting;
 
@@ -51,6 +52,14 @@ public:
     u32 GetDocCount() const { return doc_count_; }
     void SetDocCount(const u32 doc_count) { doc_count_ = doc_count; }
 
+    // identify the posting for PostingBlockCache, no file id if blocks of this posting shall not be cached
+    const SharedPtr<const PostingFileId> &GetPostingFileId() const { return posting_file_id_; }
+    u64 GetTermKey() const { return term_key_; }
+    void SetCacheKey(SharedPtr<const PostingFileId> posting_file_id, u64 term_key) {
+        posting_file_id_ = std::move(posting_file_id);
+        term_key_ = term_key;
+    }
+
     const SharedPtr<PostingWriter> &GetInMemPostingWriter() const { return posting_writer_; }
     bool IsInMemorySegment() const { return posting_writer_.get(); }
 
@@ -74,6 +83,8 @@ private:
     SharedPtr<ByteSliceList> doc_slice_list_{nullptr};
     SharedPtr<ByteSliceList> pos_slice_list_{nullptr};
     RowID base_row_id_ = INVALID_ROWID;
+    SharedPtr<const PostingFileId> posting_file_id_;
+    u64 term_key_ = 0;
     u32 doc_count_ = 0;
     TermMeta term_meta_;
     SharedPtr<PostingWriter> posting_writer_{nullptr};
@@ -12,9 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+
 module;
 
-#include <cassert>
+#include <filesystem>
+#include <fstream>
 
 module object_storage_process;
 
@@ -24,12 +26,32 @@ import logger;
 import blocking_queue;
 import infinity_exception;
 import third_party;
+import virtual_store;
+import status;
+import default_values;
+
+namespace fs = std::filesystem;
 
 namespace infinity {
 
+namespace {
+
+SizeT PartCount(SizeT object_size) { return (object_size + OBJECT_STORAGE_PART_SIZE - 1) / OBJECT_STORAGE_PART_SIZE; }
+
+u64 ElapsedMicros(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+}
+
+} // namespace
+
 void ObjectStorageProcess::Start() {
+    // The client looks up and caches the bucket region on the first request, do it before the transfer threads share the client.
+    VirtualStore::BucketExists();
+    for (SizeT i = 0; i < max_in_flight_; ++i) {
+        transfer_threads_.emplace_back([this] { Transfer(); });
+    }
     processor_thread_ = Thread([this] { Process(); });
-    LOG_INFO("Object storage processor is started.");
+    LOG_INFO(fmt::format("Object storage processor is started with {} transfer threads.", max_in_flight_));
 }
 
 void ObjectStorageProcess::Stop() {
@@ -38,7 +60,13 @@ void ObjectStorageProcess::Stop() {
     task_queue_.Enqueue(stop_task);
     stop_task->Wait();
     processor_thread_.join();
-    LOG_INFO("Object storage processor is stopped.");
+    LOG_INFO(fmt::format("Object storage processor is stopped, {} tasks, {} failed, {} requests, {} retries, {} bytes uploaded, {} bytes downloaded.",
+                         finished_tasks_.load(),
+                         failed_tasks_.load(),
+                         requests_.load(),
+                         retries_.load(),
+                         uploaded_bytes_.load(),
+                         downloaded_bytes_.load()));
 }
 
 void ObjectStorageProcess::Submit(SharedPtr<BaseObjectStorageTask> object_storage_task) {
@@ -46,12 +74,33 @@ void ObjectStorageProcess::Submit(SharedPtr<BaseObjectStorageTask> object_storag
     task_queue_.Enqueue(std::move(object_storage_task));
 }
 
+ObjectStorageMetrics ObjectStorageProcess::GetMetrics() const {
+    ObjectStorageMetrics metrics;
+    metrics.finished_tasks_ = finished_tasks_;
+    metrics.failed_tasks_ = failed_tasks_;
+    metrics.requests_ = requests_;
+    metrics.retries_ = retries_;
+    metrics.uploaded_bytes_ = uploaded_bytes_;
+    metrics.downloaded_bytes_ = downloaded_bytes_;
+    metrics.request_time_us_ = request_time_us_;
+    metrics.task_time_us_ = task_time_us_;
+    return metrics;
+}
+
 void ObjectStorageProcess::Process() {
     bool running{true};
     Deque<SharedPtr<BaseObjectStorageTask>> tasks;
     while (running) {
         task_queue_.DequeueBulk(tasks);
+        Vector<TransferRequest> requests;
         for (const auto &object_storage_task : tasks) {
+            if (!running) {
+                String error_message = fmt::format("{} is submitted after the processor is stopped", object_storage_task->ToString());
+                object_storage_task->status_ = Status::IOError(error_message);
+                --task_count_;
+                object_storage_task->Complete();
+                continue;
+            }
             switch (object_storage_task->type_) {
                 case ObjectStorageTaskType::kStopProcessor: {
                     LOG_INFO("Stop the Object storage processor");
@@ -59,35 +108,31 @@ void ObjectStorageProcess::Process() {
                         std::unique_lock<std::mutex> locker(task_mutex_);
                         task_text_ = object_storage_task->ToString();
                     }
+                    // Tasks submitted before the stop task are finished first
+                    PushRequests(std::move(requests), false);
+                    requests.clear();
+                    {
+                        std::unique_lock<std::mutex> locker(transfer_mutex_);
+                        stopping_ = true;
+                    }
+                    transfer_cv_.notify_all();
+                    for (auto &transfer_thread : transfer_threads_) {
+                        transfer_thread.join();
+                    }
+                    transfer_threads_.clear();
+                    task_text_.clear();
+                    object_storage_task->Complete();
                     running = false;
                     break;
                 }
-                case ObjectStorageTaskType::kDownload: {
-                    LOG_DEBUG("Download task");
-//                    DownloadTask *download_task = static_cast<DownloadTask *>(object_storage_task.get());
-//                    assert(download_task != nullptr);
-                    LOG_DEBUG("Download task done");
-                    break;
-                }
-                case ObjectStorageTaskType::kUpload: {
-                    LOG_DEBUG("Upload task");
-//                    UploadTask *upload_task = static_cast<UploadTask *>(object_storage_task.get());
-//                    assert(upload_task != nullptr);
-                    LOG_DEBUG("Upload task done");
-                    break;
-                }
-                case ObjectStorageTaskType::kCopy: {
-                    LOG_DEBUG("Copy task");
-//                    CopyTask *copy_task = static_cast<CopyTask *>(object_storage_task.get());
-//                    assert(copy_task != nullptr);
-                    LOG_DEBUG("Copy task done");
-                    break;
-                }
+                case ObjectStorageTaskType::kDownload:
+                case ObjectStorageTaskType::kUpload:
+                case ObjectStorageTaskType::kCopy:
                 case ObjectStorageTaskType::kRemove: {
-                    LOG_DEBUG("Remove task");
-//                    RemoveTask *remove_task = static_cast<RemoveTask *>(object_storage_task.get());
-//                    assert(remove_task != nullptr);
-                    LOG_DEBUG("Remove task done");
+                    auto transfer = MakeShared<ObjectTransfer>();
+                    transfer->task_ = object_storage_task;
+                    transfer->submit_time_ = std::chrono::steady_clock::now();
+                    requests.push_back(TransferRequest{transfer, -1});
                     break;
                 }
                 default: {
@@ -96,12 +141,254 @@ void ObjectStorageProcess::Process() {
                     break;
                 }
             }
-            task_text_.clear();
-            object_storage_task->Complete();
         }
-        task_count_ -= tasks.size();
+        PushRequests(std::move(requests), false);
         tasks.clear();
     }
 }
 
+void ObjectStorageProcess::PushRequests(Vector<TransferRequest> requests, bool to_front) {
+    if (requests.empty()) {
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> locker(transfer_mutex_);
+        if (to_front) {
+            transfer_requests_.insert(transfer_requests_.begin(), requests.begin(), requests.end());
+        } else {
+            transfer_requests_.insert(transfer_requests_.end(), requests.begin(), requests.end());
+        }
+    }
+    transfer_cv_.notify_all();
+}
+
+void ObjectStorageProcess::Transfer() {
+    while (true) {
+        TransferRequest request;
+        {
+            std::unique_lock<std::mutex> locker(transfer_mutex_);
+            transfer_cv_.wait(locker, [this] { return !transfer_requests_.empty() || (stopping_ && running_requests_ == 0); });
+            if (transfer_requests_.empty()) {
+                break;
+            }
+            request = std::move(transfer_requests_.front());
+            transfer_requests_.pop_front();
+            ++running_requests_;
+        }
+        if (request.part_idx_ < 0) {
+            StartTransfer(request.transfer_);
+        } else {
+            TransferPart(request.transfer_, request.part_idx_);
+        }
+        bool drained = false;
+        {
+            std::unique_lock<std::mutex> locker(transfer_mutex_);
+            --running_requests_;
+            drained = stopping_ && running_requests_ == 0 && transfer_requests_.empty();
+        }
+        if (drained) {
+            transfer_cv_.notify_all();
+        }
+    }
+}
+
+void ObjectStorageProcess::StartTransfer(const SharedPtr<ObjectTransfer> &transfer) {
+    BaseObjectStorageTask *task = transfer->task_.get();
+    switch (task->type_) {
+        case ObjectStorageTaskType::kUpload: {
+            auto *upload_task = static_cast<UploadTask *>(task);
+            std::error_code ec;
+            transfer->object_size_ = fs::file_size(upload_task->file_path_, ec);
+            if (ec) {
+                FinishTransfer(transfer, Status::IOError(fmt::format("Can't get file size of {}: {}", upload_task->file_path_, ec.message())));
+                return;
+            }
+            if (transfer->object_size_ <= OBJECT_STORAGE_MULTIPART_THRESHOLD) {
+                Status status = RequestWithRetry(upload_task->ToString(),
+                                                 [&] { return VirtualStore::UploadObject(upload_task->file_path_, upload_task->object_name_); });
+                if (status.ok()) {
+                    uploaded_bytes_ += transfer->object_size_;
+                }
+                FinishTransfer(transfer, std::move(status));
+                return;
+            }
+            Status status = RequestWithRetry(upload_task->ToString(),
+                                             [&] { return VirtualStore::CreateMultipartUpload(upload_task->object_name_, transfer->upload_id_); });
+            if (!status.ok()) {
+                FinishTransfer(transfer, std::move(status));
+                return;
+            }
+            transfer->etags_.resize(PartCount(transfer->object_size_));
+            break;
+        }
+        case ObjectStorageTaskType::kDownload: {
+            auto *download_task = static_cast<DownloadTask *>(task);
+            Status status = RequestWithRetry(download_task->ToString(),
+                                             [&] { return VirtualStore::StatObject(download_task->object_name_, transfer->object_size_); });
+            if (!status.ok()) {
+                FinishTransfer(transfer, std::move(status));
+                return;
+            }
+            // Each part is written at its offset of the file
+            std::error_code ec;
+            { std::ofstream file(download_task->file_path_, std::ios::binary | std::ios::trunc); }
+            fs::resize_file(download_task->file_path_, transfer->object_size_, ec);
+            if (ec) {
+                FinishTransfer(transfer, Status::IOError(fmt::format("Can't create file {}: {}", download_task->file_path_, ec.message())));
+                return;
+            }
+            if (transfer->object_size_ == 0) {
+                FinishTransfer(transfer, Status::OK());
+                return;
+            }
+            if (transfer->object_size_ <= OBJECT_STORAGE_MULTIPART_THRESHOLD) {
+                status = RequestWithRetry(download_task->ToString(), [&] {
+                    return VirtualStore::DownloadObjectRange(download_task->file_path_, download_task->object_name_, 0, transfer->object_size_);
+                });
+                if (status.ok()) {
+                    downloaded_bytes_ += transfer->object_size_;
+                }
+                FinishTransfer(transfer, std::move(status));
+                return;
+            }
+            break;
+        }
+        case ObjectStorageTaskType::kCopy: {
+            auto *copy_task = static_cast<CopyTask *>(task);
+            Status status = RequestWithRetry(copy_task->ToString(),
+                                             [&] { return VirtualStore::CopyObject(copy_task->src_object_name_, copy_task->dst_object_name_); });
+            FinishTransfer(transfer, std::move(status));
+            return;
+        }
+        case ObjectStorageTaskType::kRemove: {
+            auto *remove_task = static_cast<RemoveTask *>(task);
+            Status status = RequestWithRetry(remove_task->ToString(), [&] { return VirtualStore::RemoveObject(remove_task->object_name_); });
+            FinishTransfer(transfer, std::move(status));
+            return;
+        }
+        default: {
+            String error_message = fmt::format("Invalid object storage: {}", (u8)task->type_);
+            UnrecoverableError(error_message);
+            return;
+        }
+    }
+
+    // The parts of a started transfer go before the tasks not started yet
+    const SizeT part_count = PartCount(transfer->object_size_);
+    transfer->pending_parts_ = part_count;
+    Vector<TransferRequest> requests;
+    requests.reserve(part_count);
+    for (SizeT part_idx = 0; part_idx < part_count; ++part_idx) {
+        requests.push_back(TransferRequest{transfer, static_cast<i64>(part_idx)});
+    }
+    PushRequests(std::move(requests), true);
+}
+
+void ObjectStorageProcess::TransferPart(const SharedPtr<ObjectTransfer> &transfer, SizeT part_idx) {
+    BaseObjectStorageTask *task = transfer->task_.get();
+    const SizeT offset = part_idx * OBJECT_STORAGE_PART_SIZE;
+    const SizeT size = std::min(OBJECT_STORAGE_PART_SIZE, transfer->object_size_ - offset);
+    bool failed = false;
+    {
+        std::unique_lock<std::mutex> locker(transfer->mutex_);
+        failed = !transfer->status_.ok();
+    }
+
+    // The remaining parts are skipped once a part failed
+    Status status;
+    if (!failed && task->type_ == ObjectStorageTaskType::kUpload) {
+        auto *upload_task = static_cast<UploadTask *>(task);
+        String data(size, '\0');
+        std::ifstream file(upload_task->file_path_, std::ios::binary);
+        file.seekg(offset);
+        file.read(data.data(), size);
+        if (!file) {
+            status = Status::IOError(fmt::format("Can't read [{}, {}) of {}", offset, offset + size, upload_task->file_path_));
+        } else {
+            String etag;
+            status = RequestWithRetry(upload_task->ToString(), [&] {
+                return VirtualStore::UploadPart(upload_task->object_name_, transfer->upload_id_, static_cast<u32>(part_idx + 1), data, etag);
+            });
+            if (status.ok()) {
+                transfer->etags_[part_idx] = std::move(etag);
+                uploaded_bytes_ += size;
+            }
+        }
+    } else if (!failed) {
+        auto *download_task = static_cast<DownloadTask *>(task);
+        status = RequestWithRetry(download_task->ToString(), [&] {
+            return VirtualStore::DownloadObjectRange(download_task->file_path_, download_task->object_name_, offset, size);
+        });
+        if (status.ok()) {
+            downloaded_bytes_ += size;
+        }
+    }
+    if (!status.ok()) {
+        std::unique_lock<std::mutex> locker(transfer->mutex_);
+        if (transfer->status_.ok()) {
+            transfer->status_ = std::move(status);
+        }
+    }
+    if (transfer->pending_parts_.fetch_sub(1) != 1) {
+        return;
+    }
+
+    // The last part finishes the transfer
+    Status transfer_status = std::move(transfer->status_);
+    if (task->type_ == ObjectStorageTaskType::kUpload) {
+        auto *upload_task = static_cast<UploadTask *>(task);
+        if (transfer_status.ok()) {
+            transfer_status = RequestWithRetry(upload_task->ToString(), [&] {
+                return VirtualStore::CompleteMultipartUpload(upload_task->object_name_, transfer->upload_id_, transfer->etags_);
+            });
+        }
+        if (!transfer_status.ok()) {
+            Status abort_status = RequestWithRetry(upload_task->ToString(), [&] {
+                return VirtualStore::AbortMultipartUpload(upload_task->object_name_, transfer->upload_id_);
+            });
+            if (!abort_status.ok()) {
+                LOG_WARN(fmt::format("Failed to abort multipart upload {} of {}: {}",
+                                     transfer->upload_id_,
+                                     upload_task->object_name_,
+                                     abort_status.message()));
+            }
+        }
+    }
+    FinishTransfer(transfer, std::move(transfer_status));
+}
+
+void ObjectStorageProcess::FinishTransfer(const SharedPtr<ObjectTransfer> &transfer, Status status) {
+    BaseObjectStorageTask *task = transfer->task_.get();
+    const u64 task_time_us = ElapsedMicros(transfer->submit_time_);
+    task_time_us_ += task_time_us;
+    ++finished_tasks_;
+    if (status.ok()) {
+        LOG_DEBUG(fmt::format("{} done, {} bytes in {} us", task->ToString(), transfer->object_size_, task_time_us));
+    } else {
+        ++failed_tasks_;
+        LOG_ERROR(fmt::format("{} failed: {}", task->ToString(), status.message()));
+    }
+    task->status_ = std::move(status);
+    --task_count_;
+    task->Complete();
+}
+
+Status ObjectStorageProcess::RequestWithRetry(const String &name, const std::function<Status()> &request) {
+    Status status;
+    for (SizeT attempt = 1;; ++attempt) {
+        auto begin = std::chrono::steady_clock::now();
+        status = request();
+        ++requests_;
+        request_time_us_ += ElapsedMicros(begin);
+        if (status.ok() || attempt == OBJECT_STORAGE_MAX_ATTEMPTS) {
+            break;
+        }
+        ++retries_;
+        const SizeT backoff_ms = OBJECT_STORAGE_RETRY_BACKOFF_MS << (attempt - 1);
+        LOG_WARN(fmt::format("{} attempt {} failed: {}, retry in {} ms", name, attempt, status.message(), backoff_ms));
+        std::this_thread::sleep_for(std::chrono::milliseconds(backoff_ms));
+    }
+    return status;
+}
+
 } // namespace infinity
@@ -17,25 +17,72 @@ module;
 import blocking_queue;
 import stl;
 import object_storage_task;
+import status;
+import default_values;
 
 export module object_storage_process;
 
 namespace infinity {
 
+export struct ObjectStorageMetrics {
+    u64 finished_tasks_{};
+    u64 failed_tasks_{};
+    u64 requests_{};
+    u64 retries_{};
+    u64 uploaded_bytes_{};
+    u64 downloaded_bytes_{};
+    u64 request_time_us_{}; // sum of the latency of all requests
+    u64 task_time_us_{};    // sum of the time from submit to complete of all tasks
+};
+
+// A task being transferred, large objects are split into parts.
+struct ObjectTransfer {
+    SharedPtr<BaseObjectStorageTask> task_{};
+    std::chrono::steady_clock::time_point submit_time_{};
+    SizeT object_size_{};
+    String upload_id_{};
+    Vector<String> etags_{};
+    Atomic<SizeT> pending_parts_{};
+    std::mutex mutex_{};
+    Status status_{}; // the first failure of the parts
+};
+
+// part_idx_ is -1 for the request starting the transfer
+struct TransferRequest {
+    SharedPtr<ObjectTransfer> transfer_{};
+    i64 part_idx_{-1};
+};
+
+// Tasks are dispatched from the task queue to a pool of max_in_flight transfer threads, each running one request at a time.
 export class ObjectStorageProcess {
 public:
-    explicit ObjectStorageProcess() = default;
+    explicit ObjectStorageProcess(SizeT max_in_flight = DEFAULT_OBJECT_STORAGE_MAX_IN_FLIGHT) : max_in_flight_(max_in_flight) {}
 
     void Start();
     void Stop();
     u64 RunningTaskCount() const { return task_count_; }
 
+    ObjectStorageMetrics GetMetrics() const;
+
 public:
     void Submit(SharedPtr<BaseObjectStorageTask> object_storage_task);
 
 private:
     void Process();
 
+    void Transfer();
+
+    void PushRequests(Vector<TransferRequest> requests, bool to_front);
+
+    void StartTransfer(const SharedPtr<ObjectTransfer> &transfer);
+
+    void TransferPart(const SharedPtr<ObjectTransfer> &transfer, SizeT part_idx);
+
+    void FinishTransfer(const SharedPtr<ObjectTransfer> &transfer, Status status);
+
+    // Run the request until it succeeds or OBJECT_STORAGE_MAX_ATTEMPTS is reached, with exponential backoff between attempts.
+    Status RequestWithRetry(const String &name, const std::function<Status()> &request);
+
 private:
     BlockingQueue<SharedPtr<BaseObjectStorageTask>> task_queue_;
 
@@ -45,6 +92,23 @@ private:
 
     mutable std::mutex task_mutex_;
     String task_text_;
+
+    const SizeT max_in_flight_{};
+    Vector<Thread> transfer_threads_{};
+    std::mutex transfer_mutex_{};
+    std::condition_variable transfer_cv_{};
+    Deque<TransferRequest> transfer_requests_{};
+    SizeT running_requests_{};
+    bool stopping_{false};
+
+    Atomic<u64> finished_tasks_{};
+    Atomic<u64> failed_tasks_{};
+    Atomic<u64> requests_{};
+    Atomic<u64> retries_{};
+    Atomic<u64> uploaded_bytes_{};
+    Atomic<u64> downloaded_bytes_{};
+    Atomic<u64> request_time_us_{};
+    Atomic<u64> task_time_us_{};
 };
 
 } // namespace infinity
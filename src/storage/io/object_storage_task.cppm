@@ -17,6 +17,7 @@ module;
 export module object_storage_task;
 
 import stl;
+import status;
 // import txn;
 // import catalog;
 // import catalog_delta_entry;
@@ -34,6 +35,7 @@ export struct BaseObjectStorageTask {
 
     ObjectStorageTaskType type_{ObjectStorageTaskType::kInvalid};
 
+    Status status_{}; // result of the task, valid after Wait() returns
     bool complete_{false};
     std::mutex mutex_{};
     std::condition_variable cv_{};
@@ -53,35 +55,50 @@ export struct BaseObjectStorageTask {
 };
 
 export struct DownloadTask final : public BaseObjectStorageTask {
-    DownloadTask() : BaseObjectStorageTask(ObjectStorageTaskType::kDownload) {}
+    DownloadTask(String file_path, String object_name)
+        : BaseObjectStorageTask(ObjectStorageTaskType::kDownload), file_path_(std::move(file_path)), object_name_(std::move(object_name)) {}
 
     ~DownloadTask() = default;
 
-    String ToString() const final { return "Download Task"; }
+    String ToString() const final { return "Download Task: " + object_name_; }
+
+    String file_path_{};
+    String object_name_{};
 };
 
 export struct UploadTask final : public BaseObjectStorageTask {
-    UploadTask() : BaseObjectStorageTask(ObjectStorageTaskType::kUpload) {}
+    UploadTask(String file_path, String object_name)
+        : BaseObjectStorageTask(ObjectStorageTaskType::kUpload), file_path_(std::move(file_path)), object_name_(std::move(object_name)) {}
 
     ~UploadTask() = default;
 
-    String ToString() const final { return "Download Task"; }
+    String ToString() const final { return "Upload Task: " + object_name_; }
+
+    String file_path_{};
+    String object_name_{};
 };
 
 export struct CopyTask final : public BaseObjectStorageTask {
-    CopyTask() : BaseObjectStorageTask(ObjectStorageTaskType::kCopy) {}
+    CopyTask(String src_object_name, String dst_object_name)
+        : BaseObjectStorageTask(ObjectStorageTaskType::kCopy), src_object_name_(std::move(src_object_name)),
+          dst_object_name_(std::move(dst_object_name)) {}
 
     ~CopyTask() = default;
 
-    String ToString() const final { return "Copy Task"; }
+    String ToString() const final { return "Copy Task: " + src_object_name_; }
+
+    String src_object_name_{};
+    String dst_object_name_{};
 };
 
 export struct RemoveTask final : public BaseObjectStorageTask {
-    RemoveTask() : BaseObjectStorageTask(ObjectStorageTaskType::kRemove) {}
+    explicit RemoveTask(String object_name) : BaseObjectStorageTask(ObjectStorageTaskType::kRemove), object_name_(std::move(object_name)) {}
 
     ~RemoveTask() = default;
 
-    String ToString() const final { return "Remove Task"; }
+    String ToString() const final { return "Remove Task: " + object_name_; }
+
+    String object_name_{};
 };
 
 export struct StopObjectStorageProcessTask final : public BaseObjectStorageTask {
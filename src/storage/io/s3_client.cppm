@@ -20,6 +20,9 @@ public:
 
     virtual Status DownloadObject(const String &bucket_name, const String &object_name, const String &file_path) = 0;
 
+    // Download bytes [offset, offset + size) of the object and write them at the same offset of file_path, the rest of the file is kept.
+    virtual Status DownloadObjectRange(const String &bucket_name, const String &object_name, SizeT offset, SizeT size, const String &file_path) = 0;
+
     virtual Status UploadObject(const String &bucket_name, const String &object_name, const String &file_path) = 0;
 
     virtual Status RemoveObject(const String &bucket_name, const String &object_name) = 0;
@@ -29,6 +32,23 @@ public:
 
     virtual bool BucketExists(const String &bucket_name) = 0;
 
+    virtual Status StatObject(const String &bucket_name, const String &object_name, SizeT &object_size) = 0;
+
+    // Multipart upload, parts are numbered from 1 and etags are in part number order when completing.
+    virtual Status CreateMultipartUpload(const String &bucket_name, const String &object_name, String &upload_id) = 0;
+
+    virtual Status UploadPart(const String &bucket_name,
+                              const String &object_name,
+                              const String &upload_id,
+                              u32 part_number,
+                              std::string_view data,
+                              String &etag) = 0;
+
+    virtual Status
+    CompleteMultipartUpload(const String &bucket_name, const String &object_name, const String &upload_id, const Vector<String> &etags) = 0;
+
+    virtual Status AbortMultipartUpload(const String &bucket_name, const String &object_name, const String &upload_id) = 0;
+
 protected:
     String url;
     bool https;
@@ -1,11 +1,14 @@
 module;
 
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
 #include <string>
+#include <unistd.h>
 
 module s3_client_minio;
 
 import stl;
-import infinity_exception;
 import status;
 import third_party;
 import logger;
@@ -35,7 +38,56 @@ Status S3ClientMinio::DownloadObject(const String &bucket_name, const String &ob
     if (resp) {
         LOG_TRACE(fmt::format("{} downloaded to {} successfully", file_path, object_name));
     } else {
-        UnrecoverableError("unable to download object; " + resp.Error().String());
+        return Status::IOError("unable to download object; " + resp.Error().String());
+    }
+    return Status::OK();
+}
+
+Status S3ClientMinio::DownloadObjectRange(const String &bucket_name,
+                                          const String &object_name,
+                                          SizeT offset,
+                                          SizeT size,
+                                          const String &file_path) {
+    int fd = ::open(file_path.c_str(), O_WRONLY | O_CREAT, 0666);
+    if (fd == -1) {
+        return Status::IOError(fmt::format("Can't open file: {}: {}", file_path, strerror(errno)));
+    }
+
+    // Create get object arguments, the chunks are written at their offset of the object.
+    minio::s3::GetObjectArgs args;
+    args.bucket = bucket_name;
+    args.object = object_name;
+    args.offset = &offset;
+    args.length = &size;
+    SizeT write_offset = offset;
+    bool write_ok = true;
+    args.datafunc = [&](minio::http::DataFunctionArgs data_args) -> bool {
+        const String &chunk = data_args.datachunk;
+        SizeT written = 0;
+        while (written < chunk.size()) {
+            ssize_t n = ::pwrite(fd, chunk.data() + written, chunk.size() - written, write_offset + written);
+            if (n <= 0) {
+                write_ok = false;
+                return false;
+            }
+            written += n;
+        }
+        write_offset += written;
+        return true;
+    };
+
+    // Call get object.
+    minio::s3::GetObjectResponse resp = client_->GetObject(args);
+    ::close(fd);
+
+    // Handle response.
+    if (!write_ok) {
+        return Status::IOError(fmt::format("Can't write range [{}, {}) of {} to {}", offset, offset + size, object_name, file_path));
+    }
+    if (resp) {
+        LOG_TRACE(fmt::format("{} range [{}, {}) downloaded to {} successfully", object_name, offset, offset + size, file_path));
+    } else {
+        return Status::IOError("unable to download object range; " + resp.Error().String());
     }
     return Status::OK();
 }
@@ -54,7 +106,7 @@ Status S3ClientMinio::UploadObject(const String &bucket_name, const String &obje
     if (resp) {
         LOG_TRACE(fmt::format("{} uploaded to {} successfully", file_path, object_name));
     } else {
-        UnrecoverableError("unable to upload object; " + resp.Error().String());
+        return Status::IOError("unable to upload object; " + resp.Error().String());
     }
     return Status::OK();
 }
@@ -72,7 +124,7 @@ Status S3ClientMinio::RemoveObject(const String &bucket_name, const String &obje
     if (resp) {
         LOG_TRACE(fmt::format("{} is removed from {} successfully", object_name, bucket_name));
     } else {
-        UnrecoverableError("unable to remove object; " + resp.Error().String());
+        return Status::IOError("unable to remove object; " + resp.Error().String());
     }
     return Status::OK();
 }
@@ -98,7 +150,7 @@ Status S3ClientMinio::CopyObject(const String &src_bucket_name,
     if (resp) {
         LOG_TRACE(fmt::format("{} is copied to {} successfully", src_object_name, dst_object_name));
     } else {
-        UnrecoverableError("unable to do copy object; " + resp.Error().String());
+        return Status::IOError("unable to do copy object; " + resp.Error().String());
     }
     return Status::OK();
 }
@@ -120,4 +172,82 @@ bool S3ClientMinio::BucketExists(const String &bucket_name) {
     return false;
 }
 
+Status S3ClientMinio::StatObject(const String &bucket_name, const String &object_name, SizeT &object_size) {
+    minio::s3::StatObjectArgs args;
+    args.bucket = bucket_name;
+    args.object = object_name;
+
+    minio::s3::StatObjectResponse resp = client_->StatObject(args);
+    if (!resp) {
+        return Status::IOError("unable to stat object; " + resp.Error().String());
+    }
+    object_size = resp.size;
+    return Status::OK();
+}
+
+Status S3ClientMinio::CreateMultipartUpload(const String &bucket_name, const String &object_name, String &upload_id) {
+    minio::s3::CreateMultipartUploadArgs args;
+    args.bucket = bucket_name;
+    args.object = object_name;
+
+    minio::s3::CreateMultipartUploadResponse resp = client_->CreateMultipartUpload(args);
+    if (!resp) {
+        return Status::IOError("unable to create multipart upload; " + resp.Error().String());
+    }
+    upload_id = resp.upload_id;
+    return Status::OK();
+}
+
+Status S3ClientMinio::UploadPart(const String &bucket_name,
+                                 const String &object_name,
+                                 const String &upload_id,
+                                 u32 part_number,
+                                 std::string_view data,
+                                 String &etag) {
+    minio::s3::UploadPartArgs args;
+    args.bucket = bucket_name;
+    args.object = object_name;
+    args.upload_id = upload_id;
+    args.part_number = part_number;
+    args.data = data;
+
+    minio::s3::UploadPartResponse resp = client_->UploadPart(args);
+    if (!resp) {
+        return Status::IOError(fmt::format("unable to upload part {} of {}; {}", part_number, object_name, resp.Error().String()));
+    }
+    etag = resp.etag;
+    return Status::OK();
+}
+
+Status
+S3ClientMinio::CompleteMultipartUpload(const String &bucket_name, const String &object_name, const String &upload_id, const Vector<String> &etags) {
+    minio::s3::CompleteMultipartUploadArgs args;
+    args.bucket = bucket_name;
+    args.object = object_name;
+    args.upload_id = upload_id;
+    for (SizeT i = 0; i < etags.size(); ++i) {
+        args.parts.emplace_back(static_cast<unsigned int>(i + 1), etags[i]);
+    }
+
+    minio::s3::CompleteMultipartUploadResponse resp = client_->CompleteMultipartUpload(args);
+    if (!resp) {
+        return Status::IOError("unable to complete multipart upload; " + resp.Error().String());
+    }
+    LOG_TRACE(fmt::format("{} uploaded in {} parts successfully", object_name, etags.size()));
+    return Status::OK();
+}
+
+Status S3ClientMinio::AbortMultipartUpload(const String &bucket_name, const String &object_name, const String &upload_id) {
+    minio::s3::AbortMultipartUploadArgs args;
+    args.bucket = bucket_name;
+    args.object = object_name;
+    args.upload_id = upload_id;
+
+    minio::s3::AbortMultipartUploadResponse resp = client_->AbortMultipartUpload(args);
+    if (!resp) {
+        return Status::IOError("unable to abort multipart upload; " + resp.Error().String());
+    }
+    return Status::OK();
+}
+
 } // namespace infinity
@@ -22,10 +22,21 @@ public:
     Status UnInit() final;
 
     Status DownloadObject(const String &bucket_name, const String &object_name, const String &file_path) final;
+    Status DownloadObjectRange(const String &bucket_name, const String &object_name, SizeT offset, SizeT size, const String &file_path) final;
     Status UploadObject(const String &bucket_name, const String &object_name, const String &file_path) final;
     Status RemoveObject(const String &bucket_name, const String &object_name) final;
     Status CopyObject(const String &src_bucket_name, const String &src_object_name, const String &dst_bucket_name, const String &dst_object_name) final;
     bool BucketExists(const String &bucket_name) final;
+    Status StatObject(const String &bucket_name, const String &object_name, SizeT &object_size) final;
+    Status CreateMultipartUpload(const String &bucket_name, const String &object_name, String &upload_id) final;
+    Status UploadPart(const String &bucket_name,
+                      const String &object_name,
+                      const String &upload_id,
+                      u32 part_number,
+                      std::string_view data,
+                      String &etag) final;
+    Status CompleteMultipartUpload(const String &bucket_name, const String &object_name, const String &upload_id, const Vector<String> &etags) final;
+    Status AbortMultipartUpload(const String &bucket_name, const String &object_name, const String &upload_id) final;
 
 private:
     minio::s3::BaseUrl base_url;
@@ -472,6 +472,22 @@ Status VirtualStore::DownloadObject(const String &file_path, const String &objec
     return Status::OK();
 }
 
+Status VirtualStore::DownloadObjectRange(const String &file_path, const String &object_name, SizeT offset, SizeT size) {
+    if (VirtualStore::storage_type_ == StorageType::kLocal) {
+        return Status::OK();
+    }
+    switch (VirtualStore::storage_type_) {
+        case StorageType::kMinio: {
+            return s3_client_->DownloadObjectRange(VirtualStore::bucket_, object_name, offset, size, file_path);
+        }
+        default: {
+            return Status::NotSupport("Not support storage type");
+        }
+    }
+
+    return Status::OK();
+}
+
 Status VirtualStore::UploadObject(const String &file_path, const String &object_name) {
     if (VirtualStore::storage_type_ == StorageType::kLocal) {
         return Status::OK();
@@ -519,6 +535,86 @@ Status VirtualStore::CopyObject(const String &src_object_name, const String &dst
     return Status::OK();
 }
 
+Status VirtualStore::StatObject(const String &object_name, SizeT &object_size) {
+    if (VirtualStore::storage_type_ == StorageType::kLocal) {
+        return Status::OK();
+    }
+    switch (VirtualStore::storage_type_) {
+        case StorageType::kMinio: {
+            return s3_client_->StatObject(VirtualStore::bucket_, object_name, object_size);
+        }
+        default: {
+            return Status::NotSupport("Not support storage type");
+        }
+    }
+
+    return Status::OK();
+}
+
+Status VirtualStore::CreateMultipartUpload(const String &object_name, String &upload_id) {
+    if (VirtualStore::storage_type_ == StorageType::kLocal) {
+        return Status::OK();
+    }
+    switch (VirtualStore::storage_type_) {
+        case StorageType::kMinio: {
+            return s3_client_->CreateMultipartUpload(VirtualStore::bucket_, object_name, upload_id);
+        }
+        default: {
+            return Status::NotSupport("Not support storage type");
+        }
+    }
+
+    return Status::OK();
+}
+
+Status VirtualStore::UploadPart(const String &object_name, const String &upload_id, u32 part_number, std::string_view data, String &etag) {
+    if (VirtualStore::storage_type_ == StorageType::kLocal) {
+        return Status::OK();
+    }
+    switch (VirtualStore::storage_type_) {
+        case StorageType::kMinio: {
+            return s3_client_->UploadPart(VirtualStore::bucket_, object_name, upload_id, part_number, data, etag);
+        }
+        default: {
+            return Status::NotSupport("Not support storage type");
+        }
+    }
+
+    return Status::OK();
+}
+
+Status VirtualStore::CompleteMultipartUpload(const String &object_name, const String &upload_id, const Vector<String> &etags) {
+    if (VirtualStore::storage_type_ == StorageType::kLocal) {
+        return Status::OK();
+    }
+    switch (VirtualStore::storage_type_) {
+        case StorageType::kMinio: {
+            return s3_client_->CompleteMultipartUpload(VirtualStore::bucket_, object_name, upload_id, etags);
+        }
+        default: {
+            return Status::NotSupport("Not support storage type");
+        }
+    }
+
+    return Status::OK();
+}
+
+Status VirtualStore::AbortMultipartUpload(const String &object_name, const String &upload_id) {
+    if (VirtualStore::storage_type_ == StorageType::kLocal) {
+        return Status::OK();
+    }
+    switch (VirtualStore::storage_type_) {
+        case StorageType::kMinio: {
+            return s3_client_->AbortMultipartUpload(VirtualStore::bucket_, object_name, upload_id);
+        }
+        default: {
+            return Status::NotSupport("Not support storage type");
+        }
+    }
+
+    return Status::OK();
+}
+
 bool VirtualStore::BucketExists() {
     if (VirtualStore::storage_type_ == StorageType::kLocal) {
         return false;
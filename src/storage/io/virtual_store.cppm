@@ -81,9 +81,15 @@ public:
 
     static bool IsInit();
     static Status DownloadObject(const String &file_dir, const String& object_name);
+    static Status DownloadObjectRange(const String &file_dir, const String &object_name, SizeT offset, SizeT size);
     static Status UploadObject(const String &file_dir, const String& object_name);
     static Status RemoveObject(const String &object_name);
     static Status CopyObject(const String &src_object_name, const String &dst_object_name);
+    static Status StatObject(const String &object_name, SizeT &object_size);
+    static Status CreateMultipartUpload(const String &object_name, String &upload_id);
+    static Status UploadPart(const String &object_name, const String &upload_id, u32 part_number, std::string_view data, String &etag);
+    static Status CompleteMultipartUpload(const String &object_name, const String &upload_id, const Vector<String> &etags);
+    static Status AbortMultipartUpload(const String &object_name, const String &upload_id);
     //
     static bool BucketExists();
 
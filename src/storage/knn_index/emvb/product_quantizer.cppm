@@ -31,6 +31,10 @@ public:
     GetMultipleIPDistance(u32 embedding_offset, u32 embedding_num, u32 query_id, u32 query_num, const f32 *ip_table, f32 *output_ptr) const = 0;
     virtual void Save(LocalFileHandle &file_handle) = 0;
     virtual void Load(LocalFileHandle &file_handle) = 0;
+    // the trained codebook, for users that keep the codes themselves
+    virtual const f32 *GetSubspaceCentroids(u32 subspace_id) const = 0;
+    // embeddings are encoded after the rotation x * R, R is dimension * dimension in row major
+    virtual const f32 *GetRotationMatrix() const = 0;
 };
 
 template <std::unsigned_integral SUBSPACE_CENTROID_TAG, u32 SUBSPACE_NUM>
@@ -58,6 +62,9 @@ protected:
     void EncodeEmbedding(const f32 *embedding_data, u32 embedding_num, auto output_iter) const;
 
     UniquePtr<f32[]> DecodeEmbedding(auto input_iter_begin, u32 embedding_num) const;
+
+public:
+    const f32 *GetSubspaceCentroids(u32 subspace_id) const override { return subspace_centroids_[subspace_id].data(); }
 };
 
 // Optimized Product Quantization
@@ -79,6 +86,8 @@ public:
     void Save(LocalFileHandle &file_handle) override;
 
     void Load(LocalFileHandle &file_handle) override;
+
+    const f32 *GetRotationMatrix() const override { return matrix_R_.get(); }
 };
 
 export UniquePtr<EMVBProductQuantizer> GetEMVBOPQ(u32 pq_subspace_num, u32 pq_subspace_bits, u32 embedding_dimension);
@@ -382,6 +382,16 @@ public:
         loaded_.store(true);
     }
 
+    u32 num_pq_chunks() const { return num_pq_chunks_; }
+
+    u32 num_centers() const { return num_centers_; }
+
+    const SharedPtr<f32[]> &full_pivot_data() const { return full_pivot_data_; }
+
+    const SharedPtr<f32[]> &centroid() const { return centroid_; }
+
+    const Vector<u32> &chunk_offsets() const { return chunk_offsets_; }
+
     void UnitTest() {
         LOG_TRACE("DiskAnnIndexData::UnitTest()");
 
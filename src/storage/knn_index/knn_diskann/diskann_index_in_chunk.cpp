@@ -0,0 +1,437 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+module diskann_index_in_chunk;
+
+import stl;
+import column_def;
+import index_base;
+import index_diskann;
+import embedding_info;
+import internal_types;
+import logical_type;
+import segment_entry;
+import block_entry;
+import buffer_manager;
+import column_vector;
+import infinity_exception;
+import status;
+import logger;
+import third_party;
+import default_values;
+import local_file_handle;
+import virtual_store;
+import infinity_context;
+import defer_op;
+import diskann_index_data;
+import vector_distance;
+import ivf_index_util_func;
+
+namespace infinity {
+
+namespace {
+
+void PReadAll(i32 fd, char *buffer, SizeT size, u64 offset) {
+    SizeT read_n = 0;
+    while (read_n < size) {
+        const i64 read_count = ::pread(fd, buffer + read_n, size - read_n, offset + read_n);
+        if (read_count == -1 && errno == EINTR) {
+            continue;
+        }
+        if (read_count <= 0) {
+            UnrecoverableError(fmt::format("DiskAnn: failed to read {} bytes at offset {}: {}", size, offset, strerror(errno)));
+        }
+        read_n += read_count;
+    }
+}
+
+struct DiskAnnCandidate {
+    f32 distance_;
+    u32 id_;
+    bool expanded_;
+
+    bool operator<(const DiskAnnCandidate &other) const { return distance_ < other.distance_; }
+};
+
+} // namespace
+
+DiskAnnIndexInChunk::~DiskAnnIndexInChunk() { CloseGraph(); }
+
+DiskAnnIndexInChunk *DiskAnnIndexInChunk::GetNewDiskAnnIndexInChunk(const IndexBase *index_base, const ColumnDef *column_def) {
+    const auto *index_diskann = static_cast<const IndexDiskAnn *>(index_base);
+    const auto *data_type = column_def->type().get();
+    if (data_type->type() != LogicalType::kEmbedding) {
+        UnrecoverableError("Invalid DataType for DiskAnn index");
+    }
+    const auto *embedding_info = static_cast<const EmbeddingInfo *>(data_type->type_info().get());
+    return new DiskAnnIndexInChunk(embedding_info->Dimension(), index_diskann->R_, index_diskann->L_, index_diskann->num_pq_chunks_);
+}
+
+void DiskAnnIndexInChunk::BuildDiskAnnIndex(const RowID base_rowid,
+                                            const u32 row_count,
+                                            const SegmentEntry *segment_entry,
+                                            const SharedPtr<ColumnDef> &column_def,
+                                            BufferManager *buffer_mgr) {
+    if (segment_entry->segment_id() != base_rowid.segment_id_) {
+        UnrecoverableError(fmt::format("{}: segment_id mismatch: segment_entry_id: {}, row_id_segment_id: {}.",
+                                       __func__,
+                                       segment_entry->segment_id(),
+                                       base_rowid.segment_id_));
+    }
+    row_count_ = row_count;
+    if (row_count <= DISKANN_NUM_CENTERS) {
+        LOG_TRACE(fmt::format("DiskAnn: chunk of {} rows is too small to train pq, it is scanned brute force", row_count));
+        return;
+    }
+
+    const String build_dir =
+        fmt::format("{}/diskann_{}_{}", InfinityContext::instance().config()->TempDir(), base_rowid.ToUint64(), reinterpret_cast<uintptr_t>(this));
+    if (Status status = VirtualStore::MakeDirectory(build_dir); !status.ok()) {
+        UnrecoverableError(status.message());
+    }
+    DeferFn remove_build_dir([&] { VirtualStore::RemoveDirectory(build_dir); });
+    const Path build_path(build_dir);
+    const Path data_path = build_path / "data.bin";
+    const Path mem_index_path = build_path / "mem_index.bin";
+    const Path index_path = build_path / "disk_index.bin";
+    const Path pq_data_path = build_path / "pq_data.bin";
+    const Path pq_pivot_path = build_path / "pq_pivot.bin";
+
+    // dump the rows of the chunk as f32 vectors
+    {
+        auto [data_handle, status] = VirtualStore::Open(data_path, FileAccessMode::kWrite);
+        if (!status.ok()) {
+            UnrecoverableError(status.message());
+        }
+        Vector<SharedPtr<BlockEntry>> block_entries;
+        {
+            const BlocksGuard blocks_guard = segment_entry->GetBlocksGuard();
+            block_entries = blocks_guard.block_entries_;
+        }
+        const ColumnID column_id = column_def->id();
+        auto dump_rows = [&]<EmbeddingDataType embedding_t> {
+            using EmbeddingElementT = EmbeddingDataTypeToCppTypeT<embedding_t>;
+            Vector<f32> f32_buffer;
+            SegmentOffset segment_offset = base_rowid.segment_offset_;
+            u32 segment_row_to_read = row_count;
+            while (segment_row_to_read) {
+                const BlockID block_id = segment_offset / DEFAULT_BLOCK_CAPACITY;
+                const BlockOffset block_offset = segment_offset % DEFAULT_BLOCK_CAPACITY;
+                const auto block_row_to_read = std::min<u32>(segment_row_to_read, DEFAULT_BLOCK_CAPACITY - block_offset);
+                ColumnVector column_vector = block_entries[block_id]->GetColumnBlockEntry(column_id)->GetConstColumnVector(buffer_mgr);
+                const auto *src_ptr = reinterpret_cast<const EmbeddingElementT *>(column_vector.data()) + block_offset * dimension_;
+                const SizeT elem_count = SizeT(block_row_to_read) * dimension_;
+                if constexpr (std::is_same_v<EmbeddingElementT, f32>) {
+                    data_handle->Append(src_ptr, elem_count * sizeof(f32));
+                } else {
+                    f32_buffer.resize(elem_count);
+                    for (SizeT i = 0; i < elem_count; ++i) {
+                        f32_buffer[i] = static_cast<f32>(src_ptr[i]);
+                    }
+                    data_handle->Append(f32_buffer.data(), elem_count * sizeof(f32));
+                }
+                segment_row_to_read -= block_row_to_read;
+                segment_offset += block_row_to_read;
+            }
+        };
+        switch (static_cast<const EmbeddingInfo *>(column_def->type()->type_info().get())->Type()) {
+            case EmbeddingDataType::kElemUInt8: {
+                dump_rows.template operator()<EmbeddingDataType::kElemUInt8>();
+                break;
+            }
+            case EmbeddingDataType::kElemInt8: {
+                dump_rows.template operator()<EmbeddingDataType::kElemInt8>();
+                break;
+            }
+            case EmbeddingDataType::kElemDouble: {
+                dump_rows.template operator()<EmbeddingDataType::kElemDouble>();
+                break;
+            }
+            case EmbeddingDataType::kElemFloat: {
+                dump_rows.template operator()<EmbeddingDataType::kElemFloat>();
+                break;
+            }
+            case EmbeddingDataType::kElemFloat16: {
+                dump_rows.template operator()<EmbeddingDataType::kElemFloat16>();
+                break;
+            }
+            case EmbeddingDataType::kElemBFloat16: {
+                dump_rows.template operator()<EmbeddingDataType::kElemBFloat16>();
+                break;
+            }
+            default: {
+                UnrecoverableError(fmt::format("Invalid embedding data type {} for DiskAnn index", column_def->type()->ToString()));
+            }
+        }
+    }
+
+    // merging vamana graphs of several parts is not implemented, the chunk is always built as one part
+    using DiskAnnIndexDataT = DiskAnnIndexData<f32, SizeT, MetricType::kMetricL2>;
+    auto index_data = DiskAnnIndexDataT::Make(dimension_, row_count, R_, L_, num_pq_chunks_, 1, DISKANN_NUM_CENTERS);
+    Vector<SizeT> labels(row_count);
+    std::iota(labels.begin(), labels.end(), 0);
+    index_data->BuildIndex(dimension_, row_count, labels, data_path, mem_index_path, index_path, pq_data_path, build_path, pq_pivot_path);
+
+    num_pq_chunks_ = index_data->num_pq_chunks();
+    num_centers_ = index_data->num_centers();
+    pivots_ = MakeUniqueForOverwrite<f32[]>(SizeT(num_centers_) * dimension_);
+    std::copy_n(index_data->full_pivot_data().get(), SizeT(num_centers_) * dimension_, pivots_.get());
+    centroid_ = MakeUniqueForOverwrite<f32[]>(dimension_);
+    std::copy_n(index_data->centroid().get(), dimension_, centroid_.get());
+    chunk_offsets_ = index_data->chunk_offsets();
+
+    // the pq data file keeps every code in u32, codes are below num_centers_ so u8 is enough in memory
+    {
+        auto [pq_data_handle, status] = VirtualStore::Open(pq_data_path, FileAccessMode::kRead);
+        if (!status.ok()) {
+            UnrecoverableError(status.message());
+        }
+        const SizeT code_count = SizeT(row_count_) * num_pq_chunks_;
+        auto codes = MakeUniqueForOverwrite<u32[]>(code_count);
+        pq_data_handle->Read(codes.get(), code_count * sizeof(u32));
+        pq_codes_ = MakeUniqueForOverwrite<u8[]>(code_count);
+        for (SizeT i = 0; i < code_count; ++i) {
+            pq_codes_[i] = static_cast<u8>(codes[i]);
+        }
+    }
+
+    // the graph stays readable after the build directory is removed
+    const i32 graph_fd = ::open(index_path.c_str(), O_RDONLY);
+    if (graph_fd < 0) {
+        UnrecoverableError(fmt::format("DiskAnn: failed to open {}: {}", index_path.string(), strerror(errno)));
+    }
+    OpenGraph(graph_fd, 0);
+}
+
+void DiskAnnIndexInChunk::SaveIndexInner(LocalFileHandle &file_handle) const {
+    file_handle.Append(&row_count_, sizeof(row_count_));
+    file_handle.Append(&dimension_, sizeof(dimension_));
+    file_handle.Append(&num_pq_chunks_, sizeof(num_pq_chunks_));
+    file_handle.Append(&num_centers_, sizeof(num_centers_));
+    file_handle.Append(&graph_size_, sizeof(graph_size_));
+    if (!HasGraph()) {
+        return;
+    }
+    file_handle.Append(pivots_.get(), SizeT(num_centers_) * dimension_ * sizeof(f32));
+    file_handle.Append(centroid_.get(), dimension_ * sizeof(f32));
+    file_handle.Append(chunk_offsets_.data(), chunk_offsets_.size() * sizeof(u32));
+    file_handle.Append(pq_codes_.get(), SizeT(row_count_) * num_pq_chunks_);
+    // the graph is the tail of the file, it is not loaded back in memory
+    const SizeT copy_size = DISKANN_SECTOR_LEN * DISKANN_MAX_N_SECTOR_READS;
+    auto buffer = MakeUniqueForOverwrite<char[]>(copy_size);
+    for (u64 offset = 0; offset < graph_size_; offset += copy_size) {
+        const SizeT size = std::min<u64>(copy_size, graph_size_ - offset);
+        PReadAll(graph_fd_, buffer.get(), size, graph_offset_ + offset);
+        file_handle.Append(buffer.get(), size);
+    }
+}
+
+void DiskAnnIndexInChunk::ReadIndexInner(LocalFileHandle &file_handle) {
+    u32 dimension = 0;
+    file_handle.Read(&row_count_, sizeof(row_count_));
+    file_handle.Read(&dimension, sizeof(dimension));
+    file_handle.Read(&num_pq_chunks_, sizeof(num_pq_chunks_));
+    file_handle.Read(&num_centers_, sizeof(num_centers_));
+    file_handle.Read(&graph_size_, sizeof(graph_size_));
+    if (dimension != dimension_) {
+        UnrecoverableError(fmt::format("DiskAnn: dimension mismatch: file: {}, column: {}", dimension, dimension_));
+    }
+    if (!HasGraph()) {
+        return;
+    }
+    pivots_ = MakeUniqueForOverwrite<f32[]>(SizeT(num_centers_) * dimension_);
+    file_handle.Read(pivots_.get(), SizeT(num_centers_) * dimension_ * sizeof(f32));
+    centroid_ = MakeUniqueForOverwrite<f32[]>(dimension_);
+    file_handle.Read(centroid_.get(), dimension_ * sizeof(f32));
+    chunk_offsets_.resize(num_pq_chunks_ + 1);
+    file_handle.Read(chunk_offsets_.data(), chunk_offsets_.size() * sizeof(u32));
+    pq_codes_ = MakeUniqueForOverwrite<u8[]>(SizeT(row_count_) * num_pq_chunks_);
+    file_handle.Read(pq_codes_.get(), SizeT(row_count_) * num_pq_chunks_);
+
+    // the file may be a part of a composed object, the graph starts at the current position
+    const i32 fd = file_handle.FileDescriptor();
+    const off_t graph_offset = ::lseek(fd, 0, SEEK_CUR);
+    const i32 graph_fd = ::dup(fd);
+    if (graph_offset < 0 || graph_fd < 0) {
+        UnrecoverableError(fmt::format("DiskAnn: failed to open the graph of {}: {}", file_handle.Path(), strerror(errno)));
+    }
+    OpenGraph(graph_fd, graph_offset);
+}
+
+void DiskAnnIndexInChunk::OpenGraph(i32 fd, u64 graph_offset) {
+    CloseGraph();
+    graph_fd_ = fd;
+    graph_offset_ = graph_offset;
+    // meta sector: npts, ndims, medoid, max_node_len, nnodes_per_sector, n_sectors, frozen_num, frozen_loc, reorder, file_size
+    Vector<u64> meta(DISKANN_SECTOR_LEN / sizeof(u64));
+    PReadAll(graph_fd_, reinterpret_cast<char *>(meta.data()), DISKANN_SECTOR_LEN, graph_offset_);
+    if (meta[0] != row_count_ || meta[1] != dimension_) {
+        UnrecoverableError(fmt::format("DiskAnn: graph of {} points, {} dimensions does not match chunk of {} rows, {} dimensions",
+                                       meta[0],
+                                       meta[1],
+                                       row_count_,
+                                       dimension_));
+    }
+    medoid_ = meta[2];
+    max_node_len_ = meta[3];
+    nnodes_per_sector_ = meta[4];
+    graph_size_ = meta[9];
+}
+
+void DiskAnnIndexInChunk::CloseGraph() {
+    if (graph_fd_ >= 0) {
+        ::close(graph_fd_);
+        graph_fd_ = -1;
+    }
+}
+
+SizeT DiskAnnIndexInChunk::NodeSectorCount() const {
+    return nnodes_per_sector_ > 0 ? 1 : (max_node_len_ + DISKANN_SECTOR_LEN - 1) / DISKANN_SECTOR_LEN;
+}
+
+u64 DiskAnnIndexInChunk::NodeSector(u32 node_id) const {
+    // sector 0 is the meta sector
+    return nnodes_per_sector_ > 0 ? 1 + node_id / nnodes_per_sector_ : 1 + u64(node_id) * NodeSectorCount();
+}
+
+void DiskAnnIndexInChunk::ReadNodes(const Vector<u32> &node_ids, char *buffer, Vector<const char *> &node_ptrs) const {
+    const SizeT node_sector_count = NodeSectorCount();
+    Vector<u64> sectors;
+    sectors.reserve(node_ids.size() * node_sector_count);
+    for (const u32 node_id : node_ids) {
+        const u64 first_sector = NodeSector(node_id);
+        for (SizeT i = 0; i < node_sector_count; ++i) {
+            sectors.push_back(first_sector + i);
+        }
+    }
+    std::sort(sectors.begin(), sectors.end());
+    sectors.erase(std::unique(sectors.begin(), sectors.end()), sectors.end());
+
+    // one read for every run of adjacent sectors
+    for (SizeT run_begin = 0; run_begin < sectors.size();) {
+        SizeT run_end = run_begin + 1;
+        while (run_end < sectors.size() && sectors[run_end] == sectors[run_end - 1] + 1) {
+            ++run_end;
+        }
+        PReadAll(graph_fd_,
+                 buffer + run_begin * DISKANN_SECTOR_LEN,
+                 (run_end - run_begin) * DISKANN_SECTOR_LEN,
+                 graph_offset_ + sectors[run_begin] * DISKANN_SECTOR_LEN);
+        run_begin = run_end;
+    }
+
+    node_ptrs.clear();
+    for (const u32 node_id : node_ids) {
+        const u64 first_sector = NodeSector(node_id);
+        const SizeT sector_idx = std::lower_bound(sectors.begin(), sectors.end(), first_sector) - sectors.begin();
+        const u64 offset_in_sector = nnodes_per_sector_ > 0 ? (node_id % nnodes_per_sector_) * max_node_len_ : 0;
+        node_ptrs.push_back(buffer + sector_idx * DISKANN_SECTOR_LEN + offset_in_sector);
+    }
+}
+
+Vector<Pair<f32, u32>> DiskAnnIndexInChunk::Search(const f32 *query, u32 search_l, u32 beam_width) const {
+    Vector<Pair<f32, u32>> result;
+    if (!HasGraph()) {
+        return result;
+    }
+    search_l = std::max<u32>(search_l, 1);
+    const SizeT node_sector_count = NodeSectorCount();
+    beam_width = std::clamp<u32>(beam_width, 1, std::max<SizeT>(DISKANN_MAX_N_SECTOR_READS / node_sector_count, 1));
+
+    // distance from the query to every pivot of every pq chunk, the pivots are trained on mean centered data
+    Vector<f32> dist_table(SizeT(num_pq_chunks_) * num_centers_);
+    for (u32 chunk = 0; chunk < num_pq_chunks_; ++chunk) {
+        for (u32 center = 0; center < num_centers_; ++center) {
+            const f32 *pivot = pivots_.get() + SizeT(center) * dimension_;
+            f32 distance = 0;
+            for (u32 d = chunk_offsets_[chunk]; d < chunk_offsets_[chunk + 1]; ++d) {
+                const f32 diff = query[d] - centroid_[d] - pivot[d];
+                distance += diff * diff;
+            }
+            dist_table[SizeT(chunk) * num_centers_ + center] = distance;
+        }
+    }
+    auto pq_distance = [&](u32 node_id) {
+        const u8 *codes = pq_codes_.get() + SizeT(node_id) * num_pq_chunks_;
+        f32 distance = 0;
+        for (u32 chunk = 0; chunk < num_pq_chunks_; ++chunk) {
+            distance += dist_table[SizeT(chunk) * num_centers_ + codes[chunk]];
+        }
+        return distance;
+    };
+
+    // best search_l candidates by pq distance, sorted
+    Vector<DiskAnnCandidate> candidates;
+    candidates.reserve(search_l + 1);
+    auto insert_candidate = [&](u32 node_id) {
+        const DiskAnnCandidate candidate{pq_distance(node_id), node_id, false};
+        if (candidates.size() == search_l && !(candidate < candidates.back())) {
+            return;
+        }
+        candidates.insert(std::upper_bound(candidates.begin(), candidates.end(), candidate), candidate);
+        if (candidates.size() > search_l) {
+            candidates.pop_back();
+        }
+    };
+    HashSet<u32> visited;
+    visited.insert(medoid_);
+    insert_candidate(medoid_);
+
+    auto sector_buffer = MakeUniqueForOverwrite<char[]>(SizeT(beam_width) * node_sector_count * DISKANN_SECTOR_LEN);
+    Vector<u32> beam;
+    Vector<const char *> node_ptrs;
+    Vector<SizeT> neighbors;
+    while (true) {
+        beam.clear();
+        for (auto &candidate : candidates) {
+            if (!candidate.expanded_) {
+                candidate.expanded_ = true;
+                beam.push_back(candidate.id_);
+                if (beam.size() == beam_width) {
+                    break;
+                }
+            }
+        }
+        if (beam.empty()) {
+            break;
+        }
+        ReadNodes(beam, sector_buffer.get(), node_ptrs);
+        for (SizeT i = 0; i < beam.size(); ++i) {
+            // node: [vector(f32) * dimension, neighbor_num(u32), neighbor_id(SizeT) * neighbor_num]
+            const char *node_ptr = node_ptrs[i];
+            const auto *vector = reinterpret_cast<const f32 *>(node_ptr);
+            result.emplace_back(L2Distance<f32>(query, vector, dimension_), beam[i]);
+            u32 neighbor_num = 0;
+            std::memcpy(&neighbor_num, node_ptr + dimension_ * sizeof(f32), sizeof(u32));
+            neighbors.resize(neighbor_num);
+            std::memcpy(neighbors.data(), node_ptr + dimension_ * sizeof(f32) + sizeof(u32), neighbor_num * sizeof(SizeT));
+            for (const SizeT neighbor : neighbors) {
+                if (neighbor < row_count_ && visited.insert(neighbor).second) {
+                    insert_candidate(neighbor);
+                }
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace infinity
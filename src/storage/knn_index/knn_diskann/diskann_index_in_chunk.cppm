@@ -0,0 +1,96 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module diskann_index_in_chunk;
+
+import stl;
+import column_def;
+import internal_types;
+import local_file_handle;
+
+namespace infinity {
+
+class IndexBase;
+struct SegmentEntry;
+class BufferManager;
+
+// DiskAnn index of one segment chunk
+// pq pivots and pq codes of all rows are kept in memory, the vamana graph together with the full vectors stays in the index file
+// and is read sector by sector while searching
+export class DiskAnnIndexInChunk {
+public:
+    DiskAnnIndexInChunk(u32 dimension, u32 R, u32 L, u32 num_pq_chunks) : dimension_(dimension), R_(R), L_(L), num_pq_chunks_(num_pq_chunks) {}
+
+    ~DiskAnnIndexInChunk();
+
+    static DiskAnnIndexInChunk *GetNewDiskAnnIndexInChunk(const IndexBase *index_base, const ColumnDef *column_def);
+
+    void BuildDiskAnnIndex(RowID base_rowid,
+                           u32 row_count,
+                           const SegmentEntry *segment_entry,
+                           const SharedPtr<ColumnDef> &column_def,
+                           BufferManager *buffer_mgr);
+
+    void SaveIndexInner(LocalFileHandle &file_handle) const;
+
+    void ReadIndexInner(LocalFileHandle &file_handle);
+
+    // chunks too small to train pq on have no graph, their rows are scanned brute force
+    bool HasGraph() const { return graph_size_ > 0; }
+
+    u32 row_count() const { return row_count_; }
+
+    // beam search on the graph with pq distances, every node read from disk is scored by its full vector
+    // returns (l2 distance, offset in chunk) of all scored nodes, sorted by distance
+    Vector<Pair<f32, u32>> Search(const f32 *query, u32 search_l, u32 beam_width) const;
+
+private:
+    SizeT NodeSectorCount() const;
+
+    u64 NodeSector(u32 node_id) const;
+
+    // reads the sectors of the nodes, adjacent sectors are merged into one read
+    // node_ptrs[i] points to node_ids[i] in buffer
+    void ReadNodes(const Vector<u32> &node_ids, char *buffer, Vector<const char *> &node_ptrs) const;
+
+    void OpenGraph(i32 fd, u64 graph_offset);
+
+    void CloseGraph();
+
+    u32 dimension_{};
+    u32 R_{};
+    u32 L_{};
+    u32 num_pq_chunks_{};
+    u32 num_centers_{};
+    u32 row_count_{};
+
+    // graph layout, see DiskAnnIndexData::CreateDiskLayout
+    u64 medoid_{};
+    u64 max_node_len_{};
+    u64 nnodes_per_sector_{};
+    u64 graph_size_{};
+
+    UniquePtr<f32[]> pivots_{};        // [num_centers_ * dimension_], pivots of the mean centered data
+    UniquePtr<f32[]> centroid_{};      // [dimension_]
+    Vector<u32> chunk_offsets_{};      // [num_pq_chunks_ + 1], first dimension of each pq chunk
+    UniquePtr<u8[]> pq_codes_{};       // [row_count_ * num_pq_chunks_]
+
+    // the graph is read with pread on a descriptor owned by the chunk, it outlives the buffer file handle
+    i32 graph_fd_{-1};
+    u64 graph_offset_{};
+};
+
+} // namespace infinity
@@ -218,12 +218,16 @@ void GeneratePqDataFromPivots(LocalFileHandle &data_file, LocalFileHandle &pqCom
         size_t cur_blk_size = end_id - start_id;
 
         data_file.Read(block_data_T.get(), cur_blk_size * dim * sizeof(VectorDataType));
-        ConvertTypes<VectorDataType, f32>(block_data_T.get(), block_data_float.get(), cur_blk_size, dim);
+        if constexpr (std::is_same_v<VectorDataType, f32>) {
+            std::memcpy(block_data_float.get(), block_data_T.get(), cur_blk_size * dim * sizeof(f32));
+        } else {
+            ConvertTypes<VectorDataType, f32>(block_data_T.get(), block_data_float.get(), cur_blk_size, dim);
+        }
 
         // mean centering
         for (SizeT p = 0; p < cur_blk_size; p++) {
             for (SizeT d = 0; d < dim; d++) {
-                block_data_tmp[p * dim + d] -= centroid[d];
+                block_data_tmp[p * dim + d] = block_data_float[p * dim + d] - centroid[d];
             }
         }
         // rearrange the data
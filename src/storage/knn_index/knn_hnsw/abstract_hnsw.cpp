@@ -23,6 +23,7 @@ import buffer_handle;
 import block_column_iter;
 import segment_iter;
 import segment_entry;
+import knn_filter;
 import table_index_entry;
 import table_entry;
 import memindex_tracer;
@@ -61,7 +62,7 @@ HnswIndexInMem::HnswIndexInMem(RowID begin_row_id,
                                const ColumnDef *column_def,
                                SegmentIndexEntry *segment_index_entry,
                                bool trace)
-    : begin_row_id_(begin_row_id), hnsw_(InitAbstractIndex(index_base, column_def)), segment_index_entry_(segment_index_entry), trace_(trace),
+    : begin_row_id_(begin_row_id), hnsw_(InitAbstractIndex(index_base, column_def, true /*in_mem*/)), segment_index_entry_(segment_index_entry), trace_(trace),
       own_memory_(true) {
     const auto *index_hnsw = static_cast<const IndexHnsw *>(index_base);
     const auto *embedding_info = static_cast<const EmbeddingInfo *>(column_def->type()->type_info().get());
@@ -83,19 +84,19 @@ HnswIndexInMem::HnswIndexInMem(RowID begin_row_id,
         hnsw_);
 }
 
-AbstractHnsw HnswIndexInMem::InitAbstractIndex(const IndexBase *index_base, const ColumnDef *column_def) {
+AbstractHnsw HnswIndexInMem::InitAbstractIndex(const IndexBase *index_base, const ColumnDef *column_def, bool in_mem) {
     const auto *index_hnsw = static_cast<const IndexHnsw *>(index_base);
     const auto *embedding_info = static_cast<const EmbeddingInfo *>(column_def->type()->type_info().get());
 
     switch (embedding_info->Type()) {
         case EmbeddingDataType::kElemFloat: {
-            return InitAbstractIndex<float>(index_hnsw);
+            return InitAbstractIndex<float>(index_hnsw, in_mem);
         }
         case EmbeddingDataType::kElemUInt8: {
-            return InitAbstractIndex<u8>(index_hnsw);
+            return InitAbstractIndex<u8>(index_hnsw, in_mem);
         }
         case EmbeddingDataType::kElemInt8: {
-            return InitAbstractIndex<i8>(index_hnsw);
+            return InitAbstractIndex<i8>(index_hnsw, in_mem);
         }
         default: {
             return nullptr;
@@ -220,6 +221,117 @@ void HnswIndexInMem::InsertVecs(const SegmentEntry *segment_entry,
         hnsw_);
 }
 
+void HnswIndexInMem::MergeChunks(const SegmentEntry *segment_entry,
+                                 BufferManager *buffer_mgr,
+                                 SizeT column_id,
+                                 TxnTimeStamp begin_ts,
+                                 SizeT row_count,
+                                 Vector<ChunkIndexEntry *> old_chunks) {
+    std::sort(old_chunks.begin(), old_chunks.end(), [](const ChunkIndexEntry *lhs, const ChunkIndexEntry *rhs) {
+        return lhs->base_rowid_ < rhs->base_rowid_;
+    });
+    Vector<BufferHandle> old_handles;
+    old_handles.reserve(old_chunks.size());
+    for (auto *old_chunk : old_chunks) {
+        old_handles.push_back(old_chunk->GetIndex());
+    }
+    auto old_index_vec_num = [&](SizeT i) {
+        const auto *old_abstract_hnsw = static_cast<const AbstractHnsw *>(old_handles[i].GetData());
+        return std::visit(
+            [](auto &&old_index) {
+                using OldT = std::decay_t<decltype(old_index)>;
+                if constexpr (std::is_same_v<OldT, std::nullptr_t>) {
+                    return SizeT(0);
+                } else {
+                    return old_index->GetVecNum();
+                }
+            },
+            *old_abstract_hnsw);
+    };
+
+    std::visit(
+        [&](auto &&index) {
+            using T = std::decay_t<decltype(index)>;
+            if constexpr (!std::is_same_v<T, std::nullptr_t>) {
+                using IndexT = std::decay_t<decltype(*index)>;
+                using DataType = typename IndexT::DataType;
+
+                SizeT mem1 = index->mem_usage();
+                HnswInsertConfig insert_config;
+                insert_config.optimize_ = true;
+                CappedOneColumnIterator<DataType, true /*check ts*/> iter(segment_entry, buffer_mgr, column_id, begin_ts, row_count);
+                auto [start_i, end_i] = index->StoreData(std::move(iter), insert_config);
+
+                // the vertex of old chunks are stored in order, so the vertex offset of chunk i is the sum of preceding chunk sizes
+                Vector<SizeT> vertex_offsets;
+                SizeT vec_num = 0;
+                SizeT largest_i = 0;
+                for (SizeT i = 0; i < old_chunks.size(); ++i) {
+                    vertex_offsets.push_back(start_i + vec_num);
+                    SizeT chunk_vec_num = old_index_vec_num(i);
+                    if (chunk_vec_num > old_index_vec_num(largest_i)) {
+                        largest_i = i;
+                    }
+                    vec_num += chunk_vec_num;
+                }
+                if (vec_num != SizeT(end_i - start_i)) {
+                    LOG_WARN(fmt::format("Hnsw chunks have {} vectors, but {} vectors in segment. Rebuild the graph.", vec_num, end_i - start_i));
+                    for (VertexType vertex_i = start_i; vertex_i < end_i; ++vertex_i) {
+                        index->Build(vertex_i);
+                    }
+                } else {
+                    auto merge_old_index = [&](SizeT i, bool copy) {
+                        const auto *old_abstract_hnsw = static_cast<const AbstractHnsw *>(old_handles[i].GetData());
+                        std::visit(
+                            [&](auto &&old_index) {
+                                using OldT = std::decay_t<decltype(old_index)>;
+                                if constexpr (std::is_same_v<OldT, std::nullptr_t>) {
+                                    UnrecoverableError("Invalid index type.");
+                                } else if (copy) {
+                                    index->CopyGraph(*old_index, vertex_offsets[i]);
+                                } else {
+                                    index->MergeGraph(*old_index, vertex_offsets[i]);
+                                }
+                            },
+                            *old_abstract_hnsw);
+                    };
+                    merge_old_index(largest_i, true);
+                    for (SizeT i = 0; i < old_chunks.size(); ++i) {
+                        if (i != largest_i) {
+                            merge_old_index(i, false);
+                        }
+                    }
+                }
+                SizeT mem2 = index->mem_usage();
+                this->AddMemUsed(mem2 - mem1);
+            }
+        },
+        hnsw_);
+    RepairDeleted(segment_entry, begin_ts, row_count);
+}
+
+SizeT HnswIndexInMem::RepairDeleted(const SegmentEntry *segment_entry, TxnTimeStamp begin_ts, SizeT row_count) {
+    // the old chunks are still visible to the txns older than begin_ts, so the deletes before begin_ts can be dropped from the graph
+    if (!segment_entry->CheckAnyDelete(begin_ts)) {
+        return 0;
+    }
+    SizeT removed_n = 0;
+    std::visit(
+        [&](auto &&index) {
+            using T = std::decay_t<decltype(index)>;
+            if constexpr (!std::is_same_v<T, std::nullptr_t>) {
+                SizeT mem1 = index->mem_usage();
+                DeleteFilter alive_filter(segment_entry, begin_ts, row_count);
+                removed_n = index->RepairDeleted(alive_filter);
+                SizeT mem2 = index->mem_usage();
+                this->AddMemUsed(mem2 - mem1);
+            }
+        },
+        hnsw_);
+    LOG_INFO(fmt::format("Removed {} deleted vertices from hnsw graph of segment {}", removed_n, segment_entry->segment_id()));
+    return removed_n;
+}
+
 SharedPtr<ChunkIndexEntry> HnswIndexInMem::Dump(SegmentIndexEntry *segment_index_entry, BufferManager *buffer_mgr, SizeT *dump_size_ptr) {
     SizeT row_count = 0;
     SizeT index_size = 0;
@@ -232,11 +344,38 @@ SharedPtr<ChunkIndexEntry> HnswIndexInMem::Dump(SegmentIndexEntry *segment_index
                 return;
             } else {
                 row_count = index->GetVecNum();
-                index_size = index->GetSizeInBytes();
                 dump_size = index->mem_usage();
             }
         },
         hnsw_);
+    // The pq index is a copy put only in the chunk, this index may still be searched through a snapshot of the memory index
+    // and is freed with it.
+    AbstractHnsw dump_hnsw = hnsw_;
+    bool compressed = false;
+    const auto *index_hnsw = static_cast<const IndexHnsw *>(segment_index_entry->table_index_entry()->index_base());
+    if (index_hnsw->encode_type_ == HnswEncodeType::kPQ) {
+        std::visit(
+            [&](auto &&index) {
+                using T = std::decay_t<decltype(index)>;
+                if constexpr (!std::is_same_v<T, std::nullptr_t>) {
+                    using IndexT = std::decay_t<decltype(*index)>;
+                    using PQIndexT = KnnHnsw<typename IndexT::PQVecStoreType, SegmentOffset>;
+                    if constexpr (std::is_same_v<typename IndexT::DataType, float> && !std::is_same_v<PQIndexT, IndexT>) {
+                        dump_hnsw = index->CompressToPQ().release();
+                        compressed = true;
+                    }
+                }
+            },
+            hnsw_);
+    }
+    std::visit(
+        [&](auto &&index) {
+            using T = std::decay_t<decltype(index)>;
+            if constexpr (!std::is_same_v<T, std::nullptr_t>) {
+                index_size = index->GetSizeInBytes();
+            }
+        },
+        dump_hnsw);
     auto new_chunk_indey_entry = segment_index_entry->CreateHnswIndexChunkIndexEntry(begin_row_id_, row_count, buffer_mgr, index_size);
     if (dump_size_ptr != nullptr) {
         *dump_size_ptr = dump_size;
@@ -244,8 +383,8 @@ SharedPtr<ChunkIndexEntry> HnswIndexInMem::Dump(SegmentIndexEntry *segment_index
 
     BufferHandle handle = new_chunk_indey_entry->GetIndex();
     auto *data_ptr = static_cast<AbstractHnsw *>(handle.GetDataMut());
-    *data_ptr = hnsw_;
-    own_memory_ = false;
+    *data_ptr = dump_hnsw;
+    own_memory_ = compressed;
     chunk_handle_ = std::move(handle);
     return new_chunk_indey_entry;
 }
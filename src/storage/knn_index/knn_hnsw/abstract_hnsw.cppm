@@ -62,6 +62,9 @@ export using AbstractHnsw = std::variant<KnnHnsw<PlainCosVecStoreType<float>, Se
                                          KnnHnsw<LVQCosVecStoreType<float, i8>, SegmentOffset> *,
                                          KnnHnsw<LVQIPVecStoreType<float, i8>, SegmentOffset> *,
                                          KnnHnsw<LVQL2VecStoreType<float, i8>, SegmentOffset> *,
+                                         KnnHnsw<PQCosVecStoreType<float>, SegmentOffset> *,
+                                         KnnHnsw<PQIPVecStoreType<float>, SegmentOffset> *,
+                                         KnnHnsw<PQL2VecStoreType<float>, SegmentOffset> *,
                                          std::nullptr_t>;
 
 export struct HnswIndexInMem : public BaseMemIndex {
@@ -74,9 +77,14 @@ public:
     HnswIndexInMem(RowID begin_row_id, const IndexBase *index_base, const ColumnDef *column_def, SegmentIndexEntry *segment_index_entry, bool trace);
 
 private:
+    // PQ index is built in plain encoding and compressed when dumped, because the codebook is trained on the whole chunk
     template <typename DataType>
-    static AbstractHnsw InitAbstractIndex(const IndexHnsw *index_hnsw) {
-        switch (index_hnsw->encode_type_) {
+    static AbstractHnsw InitAbstractIndex(const IndexHnsw *index_hnsw, bool in_mem) {
+        HnswEncodeType encode_type = index_hnsw->encode_type_;
+        if (in_mem && encode_type == HnswEncodeType::kPQ) {
+            encode_type = HnswEncodeType::kPlain;
+        }
+        switch (encode_type) {
             case HnswEncodeType::kPlain: {
                 switch (index_hnsw->metric_type_) {
                     case MetricType::kMetricL2: {
@@ -119,6 +127,29 @@ private:
                     }
                 }
             }
+            case HnswEncodeType::kPQ: {
+                if constexpr (std::is_same_v<DataType, u8> || std::is_same_v<DataType, i8>) {
+                    return nullptr;
+                } else {
+                    switch (index_hnsw->metric_type_) {
+                        case MetricType::kMetricL2: {
+                            using HnswIndex = KnnHnsw<PQL2VecStoreType<DataType>, SegmentOffset>;
+                            return static_cast<HnswIndex *>(nullptr);
+                        }
+                        case MetricType::kMetricInnerProduct: {
+                            using HnswIndex = KnnHnsw<PQIPVecStoreType<DataType>, SegmentOffset>;
+                            return static_cast<HnswIndex *>(nullptr);
+                        }
+                        case MetricType::kMetricCosine: {
+                            using HnswIndex = KnnHnsw<PQCosVecStoreType<DataType>, SegmentOffset>;
+                            return static_cast<HnswIndex *>(nullptr);
+                        }
+                        default: {
+                            return nullptr;
+                        }
+                    }
+                }
+            }
             default: {
                 return nullptr;
             }
@@ -155,7 +186,7 @@ private:
     }
 
 public:
-    static AbstractHnsw InitAbstractIndex(const IndexBase *index_base, const ColumnDef *column_def);
+    static AbstractHnsw InitAbstractIndex(const IndexBase *index_base, const ColumnDef *column_def, bool in_mem = false);
 
     HnswIndexInMem(const HnswIndexInMem &) = delete;
     HnswIndexInMem &operator=(const HnswIndexInMem &) = delete;
@@ -178,6 +209,17 @@ public:
                     bool check_ts,
                     const HnswInsertConfig &config = kDefaultHnswInsertConfig);
 
+    // Build the index of rows [0, row_count) from the chunks covering them, reusing the graph of the largest chunk.
+    void MergeChunks(const SegmentEntry *segment_entry,
+                     BufferManager *buffer_mgr,
+                     SizeT column_id,
+                     TxnTimeStamp begin_ts,
+                     SizeT row_count,
+                     Vector<ChunkIndexEntry *> old_chunks);
+
+    // Drop the rows deleted before begin_ts from the neighbor lists of the graph built on rows [0, row_count), returns the removed count.
+    SizeT RepairDeleted(const SegmentEntry *segment_entry, TxnTimeStamp begin_ts, SizeT row_count);
+
     SharedPtr<ChunkIndexEntry> Dump(SegmentIndexEntry *segment_index_entry, BufferManager *buffer_mgr, SizeT *dump_size = nullptr);
 
     const AbstractHnsw &get() const { return hnsw_; }
@@ -26,6 +26,7 @@ import local_file_handle;
 import vec_store_type;
 import graph_store;
 import infinity_exception;
+import serialize;
 
 namespace infinity {
 
@@ -61,6 +62,12 @@ public:
     template <typename T>
     struct has_compress_type<T, std::void_t<typename T::CompressType>> : std::true_type {};
 
+    // Whether the store can be searched in place from a mapped index file, see LoadFromPtr.
+    static constexpr bool kLoadFromPtr = requires(const char *&ptr, SizeT n, const VecStoreMeta &meta) {
+        VecStoreMeta::LoadFromPtr(ptr);
+        VecStoreInner::LoadFromPtr(ptr, n, meta);
+    };
+
 private:
     DataStore(SizeT chunk_size, SizeT max_chunk_n, VecStoreMeta &&vec_store_meta, GraphStoreMeta &&graph_store_meta)
         : chunk_size_(chunk_size), max_chunk_n_(max_chunk_n), vec_store_meta_(std::move(vec_store_meta)),
@@ -119,11 +126,12 @@ public:
         return ret;
     }
 
-    void SetGraph(GraphStoreMeta &&graph_meta, Vector<GraphStoreInner> &&graph_inners) {
+    void SetGraph(GraphStoreMeta &&graph_meta, Vector<GraphStoreInner> &&graph_inners, SizeT graph_mem_usage = 0) {
         graph_store_meta_ = std::move(graph_meta);
         for (SizeT i = 0; i < graph_inners.size(); ++i) {
             inners_[i].SetGraphStoreInner(std::move(graph_inners[i]));
         }
+        mem_usage_.fetch_add(graph_mem_usage);
     }
 
     SizeT GetSizeInBytes() const {
@@ -187,6 +195,45 @@ public:
         return ret;
     }
 
+    // Deep copy into a writable store on the heap, this store may be loaded in place.
+    This Copy() const {
+        This ret(chunk_size_, max_chunk_n_, vec_store_meta_.Copy(), GraphStoreMeta::Make(Mmax0(), Mmax()));
+        SizeT cur_vec_num = this->cur_vec_num();
+        ret.cur_vec_num_ = cur_vec_num;
+
+        SizeT mem_usage = 0;
+        auto [chunk_num, last_chunk_size] = ChunkInfo(cur_vec_num);
+        for (SizeT i = 0; i < chunk_num; ++i) {
+            SizeT cur_chunk_size = (i < chunk_num - 1) ? chunk_size_ : last_chunk_size;
+            ret.inners_[i] = inners_[i].Copy(cur_chunk_size, chunk_size_, vec_store_meta_, graph_store_meta_, mem_usage);
+        }
+        auto [max_layer, enterpoint] = GetEnterPoint();
+        ret.TryUpdateEnterPoint(max_layer, enterpoint);
+        ret.mem_usage_.store(mem_usage);
+        return ret;
+    }
+
+    // Load the layout written by Save from memory, e.g. a mapped index file, without copying the vectors, the neighbor
+    // lists and the labels. `ptr` must outlive the returned store, which can only be searched.
+    static This LoadFromPtr(const char *&ptr) {
+        static_assert(kLoadFromPtr);
+        SizeT chunk_size = ReadBufAdv<SizeT>(ptr);
+        SizeT max_chunk_n = ReadBufAdv<SizeT>(ptr);
+        SizeT cur_vec_num = ReadBufAdv<SizeT>(ptr);
+        VecStoreMeta vec_store_meta = VecStoreMeta::LoadFromPtr(ptr);
+        GraphStoreMeta graph_store_meta = GraphStoreMeta::LoadFromPtr(ptr);
+
+        This ret = This(chunk_size, max_chunk_n, std::move(vec_store_meta), std::move(graph_store_meta));
+        ret.cur_vec_num_ = cur_vec_num;
+
+        auto [chunk_num, last_chunk_size] = ret.ChunkInfo(cur_vec_num);
+        for (SizeT i = 0; i < chunk_num; ++i) {
+            SizeT cur_chunk_size = (i < chunk_num - 1) ? chunk_size : last_chunk_size;
+            ret.inners_[i] = Inner::LoadFromPtr(ptr, cur_chunk_size, ret.vec_store_meta_, ret.graph_store_meta_);
+        }
+        return ret;
+    }
+
     template <DataIteratorConcept<QueryVecType, LabelType> Iterator>
     Pair<SizeT, SizeT> AddVec(Iterator &&query_iter) {
         SizeT mem_usage = 0;
@@ -248,7 +295,10 @@ public:
     }
 
     template <typename CompressVecStoreType>
-    DataStore<CompressVecStoreType, LabelType> CompressToLVQ() &&;
+    DataStore<CompressVecStoreType, LabelType> CompressTo() &&;
+    // Same as above but leaves this store intact, the graph is copied. A store of the target type is copied as it is.
+    template <typename CompressVecStoreType>
+    DataStore<CompressVecStoreType, LabelType> CompressTo() const &;
 
     typename VecStoreT::QueryType MakeQuery(QueryVecType query) const { return vec_store_meta_.MakeQuery(query); }
 
@@ -269,6 +319,11 @@ public:
         mem_usage_.fetch_add(mem_usage);
     }
 
+    i32 GetLayerN(VertexType vertex_i) const {
+        const auto &[inner, idx] = GetInner(vertex_i);
+        return inner.GetLayerN(idx, graph_store_meta_);
+    }
+
     Pair<const VertexType *, VertexListSize> GetNeighbors(VertexType vertex_i, i32 layer_i) const {
         const auto &[inner, idx] = GetInner(vertex_i);
         return inner.GetNeighbors(idx, layer_i, graph_store_meta_);
@@ -388,7 +443,10 @@ public:
 private:
     DataStoreInner(SizeT chunk_size, VecStoreInner vec_store_inner, GraphStoreInner graph_store_inner)
         : vec_store_inner_(std::move(vec_store_inner)), graph_store_inner_(std::move(graph_store_inner)),
-          labels_(MakeUnique<LabelType[]>(chunk_size)), vertex_mutex_(MakeUnique<std::shared_mutex[]>(chunk_size)) {}
+          labels_(MakeUnique<LabelType[]>(chunk_size)), labels_data_(labels_.get()), vertex_mutex_(MakeUnique<std::shared_mutex[]>(chunk_size)) {}
+
+    DataStoreInner(VecStoreInner vec_store_inner, GraphStoreInner graph_store_inner)
+        : vec_store_inner_(std::move(vec_store_inner)), graph_store_inner_(std::move(graph_store_inner)) {}
 
 public:
     DataStoreInner() = default;
@@ -412,7 +470,7 @@ public:
     void Save(LocalFileHandle &file_handle, SizeT cur_vec_num, const VecStoreMeta &vec_store_meta, const GraphStoreMeta &graph_store_meta) const {
         vec_store_inner_.Save(file_handle, cur_vec_num, vec_store_meta);
         graph_store_inner_.Save(file_handle, cur_vec_num, graph_store_meta);
-        file_handle.Append(labels_.get(), sizeof(LabelType) * cur_vec_num);
+        file_handle.Append(labels_data_, sizeof(LabelType) * cur_vec_num);
     }
 
     static This Load(LocalFileHandle &file_handle,
@@ -428,6 +486,27 @@ public:
         return ret;
     }
 
+    This Copy(SizeT cur_vec_num,
+              SizeT chunk_size,
+              const VecStoreMeta &vec_store_meta,
+              const GraphStoreMeta &graph_store_meta,
+              SizeT &mem_usage) const {
+        auto vec_store_inner = vec_store_inner_.Copy(cur_vec_num, chunk_size, vec_store_meta, mem_usage);
+        auto graph_store_inner = graph_store_inner_.Copy(cur_vec_num, chunk_size, graph_store_meta, mem_usage);
+        This ret(chunk_size, std::move(vec_store_inner), std::move(graph_store_inner));
+        std::copy(labels_data_, labels_data_ + cur_vec_num, ret.labels_.get());
+        return ret;
+    }
+
+    // Read only, so no vertex lock is allocated.
+    static This LoadFromPtr(const char *&ptr, SizeT cur_vec_num, const VecStoreMeta &vec_store_meta, const GraphStoreMeta &graph_store_meta) {
+        auto vec_store_inner = VecStoreInner::LoadFromPtr(ptr, cur_vec_num, vec_store_meta);
+        auto graph_store_inner = GraphStoreInner::LoadFromPtr(ptr, cur_vec_num, graph_store_meta);
+        This ret(std::move(vec_store_inner), std::move(graph_store_inner));
+        ret.labels_data_ = ViewOrCopy(ptr, cur_vec_num, ret.labels_);
+        return ret;
+    }
+
     // vec store
     template <DataIteratorConcept<QueryVecType, LabelType> Iterator>
     Pair<SizeT, bool> AddVec(Iterator &&query_iter, VertexType start_idx, SizeT remain_num, const VecStoreMeta &meta, SizeT &mem_usage) {
@@ -456,6 +535,8 @@ public:
         graph_store_inner_.AddVertex(vec_i, layer_n, meta, mem_usage);
     }
 
+    i32 GetLayerN(VertexType vertex_i, const GraphStoreMeta &meta) const { return graph_store_inner_.GetLayerN(vertex_i, meta); }
+
     Pair<const VertexType *, VertexListSize> GetNeighbors(VertexType vertex_i, i32 layer_i, const GraphStoreMeta &meta) const {
         return graph_store_inner_.GetNeighbors(vertex_i, layer_i, meta);
     }
@@ -463,21 +544,28 @@ public:
         return graph_store_inner_.GetNeighborsMut(vertex_i, layer_i, meta);
     }
 
-    LabelType GetLabel(VertexType vec_i) const { return labels_[vec_i]; }
+    LabelType GetLabel(VertexType vec_i) const { return labels_data_[vec_i]; }
 
-    std::shared_lock<std::shared_mutex> SharedLock(VertexType vec_i) const { return std::shared_lock<std::shared_mutex>(vertex_mutex_[vec_i]); }
+    std::shared_lock<std::shared_mutex> SharedLock(VertexType vec_i) const {
+        if (vertex_mutex_ == nullptr) {
+            return {};
+        }
+        return std::shared_lock<std::shared_mutex>(vertex_mutex_[vec_i]);
+    }
 
     std::unique_lock<std::shared_mutex> UniqueLock(VertexType vec_i) { return std::unique_lock<std::shared_mutex>(vertex_mutex_[vec_i]); }
 
     VecStoreInner *vec_store_inner() { return &vec_store_inner_; }
 
     GraphStoreInner *graph_store_inner() { return &graph_store_inner_; }
+    const GraphStoreInner *graph_store_inner() const { return &graph_store_inner_; }
     void SetGraphStoreInner(GraphStoreInner &&graph_store_inner) { graph_store_inner_ = std::move(graph_store_inner); }
 
 protected:
     VecStoreInner vec_store_inner_;
     GraphStoreInner graph_store_inner_;
     UniquePtr<LabelType[]> labels_;
+    const LabelType *labels_data_{};
 
 private:
     mutable UniquePtr<std::shared_mutex[]> vertex_mutex_;
@@ -491,7 +579,7 @@ public:
         vec_store_inner_.Dump(os, offset, chunk_size, meta);
         os << "labels: [";
         for (SizeT i = 0; i < chunk_size; ++i) {
-            os << labels_[i] << ", ";
+            os << labels_data_[i] << ", ";
         }
         os << "]" << std::endl;
     }
@@ -586,7 +674,7 @@ private:
 
 template <typename VecStoreT, typename LabelType>
 template <typename CompressVecStoreType>
-DataStore<CompressVecStoreType, LabelType> DataStore<VecStoreT, LabelType>::CompressToLVQ() && {
+DataStore<CompressVecStoreType, LabelType> DataStore<VecStoreT, LabelType>::CompressTo() && {
     if constexpr (std::is_same_v<CompressVecStoreType, VecStoreT>) {
         return std::move(*this);
     } else {
@@ -603,4 +691,26 @@ DataStore<CompressVecStoreType, LabelType> DataStore<VecStoreT, LabelType>::Comp
     }
 }
 
-} // namespace infinity
\ No newline at end of file
+template <typename VecStoreT, typename LabelType>
+template <typename CompressVecStoreType>
+DataStore<CompressVecStoreType, LabelType> DataStore<VecStoreT, LabelType>::CompressTo() const & {
+    if constexpr (std::is_same_v<CompressVecStoreType, VecStoreT>) {
+        return Copy();
+    } else {
+        const auto [chunk_num, last_chunk_size] = ChunkInfo(cur_vec_num());
+        SizeT mem_usage = 0;
+        Vector<GraphStoreInner> graph_inners;
+        for (SizeT i = 0; i < chunk_num; ++i) {
+            SizeT cur_chunk_size = (i < chunk_num - 1) ? chunk_size_ : last_chunk_size;
+            graph_inners.emplace_back(inners_[i].graph_store_inner()->Copy(cur_chunk_size, chunk_size_, graph_store_meta_, mem_usage));
+        }
+        auto ret = DataStore<CompressVecStoreType, LabelType>::Make(chunk_size_, max_chunk_n_, vec_store_meta_.dim(), Mmax0(), Mmax());
+        ret.OptAddVec(DataStoreIter<VecStoreT, LabelType>(this));
+        ret.SetGraph(GraphStoreMeta::Make(Mmax0(), Mmax()), std::move(graph_inners), mem_usage);
+        auto [max_layer, enterpoint] = GetEnterPoint();
+        ret.TryUpdateEnterPoint(max_layer, enterpoint);
+        return ret;
+    }
+}
+
+} // namespace infinity
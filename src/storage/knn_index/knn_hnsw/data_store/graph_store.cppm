@@ -16,12 +16,15 @@ module;
 
 #include <cassert>
 #include <ostream>
+#include <sys/mman.h>
 
 export module graph_store;
 
 import stl;
 import hnsw_common;
 import local_file_handle;
+import serialize;
+import infinity_exception;
 
 namespace infinity {
 
@@ -91,6 +94,15 @@ public:
         return meta;
     }
 
+    static GraphStoreMeta LoadFromPtr(const char *&ptr) {
+        SizeT Mmax0 = ReadBufAdv<SizeT>(ptr);
+        SizeT Mmax = ReadBufAdv<SizeT>(ptr);
+        GraphStoreMeta meta(Mmax0, Mmax);
+        meta.max_layer_ = ReadBufAdv<i32>(ptr);
+        meta.enterpoint_ = ReadBufAdv<VertexType>(ptr);
+        return meta;
+    }
+
     SizeT Mmax0() const { return Mmax0_; }
     SizeT Mmax() const { return Mmax_; }
     SizeT level0_size() const { return level0_size_; }
@@ -136,7 +148,7 @@ public:
 export class GraphStoreInner {
 private:
     GraphStoreInner(SizeT max_vertex, const GraphStoreMeta &meta, SizeT loaded_vertex_n)
-        : graph_(MakeUnique<char[]>(max_vertex * meta.level0_size())), loaded_vertex_n_(loaded_vertex_n) {}
+        : graph_(MakeUnique<char[]>(max_vertex * meta.level0_size())), graph_data_(graph_.get()), loaded_vertex_n_(loaded_vertex_n) {}
 
 public:
     GraphStoreInner() = default;
@@ -160,7 +172,7 @@ public:
             const VertexL0 *v = GetLevel0(vertex_i, meta);
             size += sizeof(v->layer_n_) + sizeof(v->neighbor_n_) + sizeof(VertexType) * v->neighbor_n_;
             for (i32 layer_i = 1; layer_i <= v->layer_n_; ++layer_i) {
-                const VertexLX *vx = GetLevelX(v->layers_p_, layer_i, meta);
+                const VertexLX *vx = GetLevelX(GetLayers(vertex_i, v, meta), layer_i, meta);
                 size += sizeof(vx->neighbor_n_) + sizeof(VertexType) * vx->neighbor_n_;
             }
         }
@@ -173,11 +185,11 @@ public:
             layer_sum += GetLevel0(vertex_i, meta)->layer_n_;
         }
         file_handle.Append(&layer_sum, sizeof(layer_sum));
-        file_handle.Append(graph_.get(), cur_vertex_n * meta.level0_size());
+        file_handle.Append(graph_data_, cur_vertex_n * meta.level0_size());
         for (VertexType vertex_i = 0; vertex_i < (VertexType)cur_vertex_n; ++vertex_i) {
             const VertexL0 *v = GetLevel0(vertex_i, meta);
             if (v->layer_n_) {
-                file_handle.Append(v->layers_p_, meta.levelx_size() * v->layer_n_);
+                file_handle.Append(GetLayers(vertex_i, v, meta), meta.levelx_size() * v->layer_n_);
             }
         }
     }
@@ -209,6 +221,59 @@ public:
         return graph_store;
     }
 
+    // The neighbor lists are read in place from `ptr`, which must outlive the returned store. The upper layer pointers
+    // saved in the level 0 records are stale, so the upper layers of each vertex are located by `layer_offsets_` instead.
+    // The store is read only.
+    static GraphStoreInner LoadFromPtr(const char *&ptr, SizeT cur_vertex_n, const GraphStoreMeta &meta) {
+        GraphStoreInner graph_store;
+        graph_store.loaded_vertex_n_ = cur_vertex_n;
+        SizeT layer_sum = ReadBufAdv<SizeT>(ptr);
+        graph_store.graph_data_ = ViewOrCopy<char, alignof(VertexL0)>(ptr, cur_vertex_n * meta.level0_size(), graph_store.graph_);
+        graph_store.layers_data_ = ViewOrCopy<char, alignof(VertexLX)>(ptr, layer_sum * meta.levelx_size(), graph_store.loaded_layers_);
+        if (graph_store.loaded_layers_.get() == nullptr) {
+            // every search descends through the upper layers, so read them ahead of the random level 0 accesses
+            AdviseMapped(graph_store.layers_data_, layer_sum * meta.levelx_size(), MADV_WILLNEED);
+        }
+
+        graph_store.layer_offsets_ = MakeUniqueForOverwrite<u32[]>(cur_vertex_n);
+        u32 layer_offset = 0;
+        for (VertexType vertex_i = 0; vertex_i < (VertexType)cur_vertex_n; ++vertex_i) {
+            graph_store.layer_offsets_[vertex_i] = layer_offset;
+            layer_offset += std::as_const(graph_store).GetLevel0(vertex_i, meta)->layer_n_;
+        }
+        return graph_store;
+    }
+
+    // Deep copy of the first `cur_vertex_n` vertices into a writable store, the source may be loaded in place.
+    GraphStoreInner Copy(SizeT cur_vertex_n, SizeT max_vertex, const GraphStoreMeta &meta, SizeT &mem_usage) const {
+        assert(cur_vertex_n <= max_vertex);
+
+        SizeT layer_sum = 0;
+        for (VertexType vertex_i = 0; vertex_i < (VertexType)cur_vertex_n; ++vertex_i) {
+            layer_sum += GetLevel0(vertex_i, meta)->layer_n_;
+        }
+        GraphStoreInner graph_store(max_vertex, meta, cur_vertex_n);
+        std::copy(graph_data_, graph_data_ + cur_vertex_n * meta.level0_size(), graph_store.graph_.get());
+
+        auto loaded_layers = MakeUnique<char[]>(meta.levelx_size() * layer_sum);
+        char *loaded_layers_p = loaded_layers.get();
+        for (VertexType vertex_i = 0; vertex_i < (VertexType)cur_vertex_n; ++vertex_i) {
+            VertexL0 *v = graph_store.GetLevel0(vertex_i, meta);
+            if (v->layer_n_) {
+                const char *layers = GetLayers(vertex_i, GetLevel0(vertex_i, meta), meta);
+                std::copy(layers, layers + meta.levelx_size() * v->layer_n_, loaded_layers_p);
+                v->layers_p_ = loaded_layers_p;
+                loaded_layers_p += meta.levelx_size() * v->layer_n_;
+            } else {
+                v->layers_p_ = nullptr;
+            }
+        }
+        graph_store.loaded_layers_ = std::move(loaded_layers);
+
+        mem_usage += max_vertex * meta.level0_size() + layer_sum * meta.levelx_size();
+        return graph_store;
+    }
+
     void AddVertex(VertexType vertex_i, i32 layer_n, const GraphStoreMeta &meta, SizeT &mem_usage) {
         VertexL0 *v = GetLevel0(vertex_i, meta);
         v->neighbor_n_ = 0;
@@ -225,12 +290,14 @@ public:
         }
     }
 
+    i32 GetLayerN(VertexType vertex_i, const GraphStoreMeta &meta) const { return GetLevel0(vertex_i, meta)->layer_n_; }
+
     Pair<const VertexType *, VertexListSize> GetNeighbors(VertexType vertex_i, i32 layer_i, const GraphStoreMeta &meta) const {
         const VertexL0 *v = GetLevel0(vertex_i, meta);
         if (layer_i == 0) {
             return {v->neighbors_, v->neighbor_n_};
         }
-        const VertexLX *vx = GetLevelX(v->layers_p_, layer_i, meta);
+        const VertexLX *vx = GetLevelX(GetLayers(vertex_i, v, meta), layer_i, meta);
         return {vx->neighbors_, vx->neighbor_n_};
     }
     Pair<VertexType *, VertexListSize *> GetNeighborsMut(VertexType vertex_i, i32 layer_i, const GraphStoreMeta &meta) {
@@ -244,12 +311,22 @@ public:
 
 private:
     const VertexL0 *GetLevel0(VertexType vertex_i, const GraphStoreMeta &meta) const {
-        return reinterpret_cast<const VertexL0 *>(graph_.get() + vertex_i * meta.level0_size());
+        return reinterpret_cast<const VertexL0 *>(graph_data_ + vertex_i * meta.level0_size());
     }
     VertexL0 *GetLevel0(VertexType vertex_i, const GraphStoreMeta &meta) {
+        if (graph_ == nullptr) {
+            UnrecoverableError("The graph is loaded in place and can't be modified.");
+        }
         return reinterpret_cast<VertexL0 *>(graph_.get() + vertex_i * meta.level0_size());
     }
 
+    const char *GetLayers(VertexType vertex_i, const VertexL0 *v, const GraphStoreMeta &meta) const {
+        if (layer_offsets_ == nullptr) {
+            return v->layers_p_;
+        }
+        return layers_data_ + layer_offsets_[vertex_i] * meta.levelx_size();
+    }
+
     const VertexLX *GetLevelX(const char *layer_p, i32 layer_i, const GraphStoreMeta &meta) const {
         assert(layer_i > 0);
         return reinterpret_cast<const VertexLX *>(layer_p + (layer_i - 1) * meta.levelx_size());
@@ -261,8 +338,12 @@ private:
 
 private:
     UniquePtr<char[]> graph_;
+    const char *graph_data_{};
     SizeT loaded_vertex_n_;
     UniquePtr<char[]> loaded_layers_;
+    // only set when loaded in place
+    const char *layers_data_{};
+    UniquePtr<u32[]> layer_offsets_;
 
     //---------------------------------------------- Following is the tmp debug function. ----------------------------------------------
 
@@ -283,7 +364,7 @@ public:
                 assert(neighbor_idx != out_vertex_i);
             }
             for (int layer_i = 1; layer_i <= v->layer_n_; ++layer_i) {
-                const VertexLX *vx = GetLevelX(v->layers_p_, layer_i, meta);
+                const VertexLX *vx = GetLevelX(GetLayers(vertex_i, v, meta), layer_i, meta);
                 for (int i = 0; i < vx->neighbor_n_; ++i) {
                     VertexType neighbor_idx = vx->neighbors_[i];
                     assert(neighbor_idx < (VertexType)cur_vec_num && neighbor_idx >= 0);
@@ -323,7 +404,7 @@ public:
                     neighbors = v->neighbors_;
                     neighbor_n = v->neighbor_n_;
                 } else {
-                    const VertexLX *vx = GetLevelX(v->layers_p_, layer, meta);
+                    const VertexLX *vx = GetLevelX(GetLayers(vertex_i, v, meta), layer, meta);
                     neighbors = vx->neighbors_;
                     neighbor_n = vx->neighbor_n_;
                 }
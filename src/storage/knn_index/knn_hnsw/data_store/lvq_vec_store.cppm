@@ -15,6 +15,7 @@
 module;
 
 #include <cassert>
+#include <cstring>
 #include <ostream>
 
 #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
@@ -28,6 +29,7 @@ export module lvq_vec_store;
 import stl;
 import local_file_handle;
 import hnsw_common;
+import serialize;
 
 namespace infinity {
 
@@ -113,6 +115,24 @@ public:
         return meta;
     }
 
+    This Copy() const {
+        This meta(dim_);
+        std::copy(mean_.get(), mean_.get() + dim_, meta.mean_.get());
+        meta.global_cache_ = global_cache_;
+        meta.normalize_ = normalize_;
+        return meta;
+    }
+
+    static This LoadFromPtr(const char *&ptr) {
+        SizeT dim = ReadBufAdv<SizeT>(ptr);
+        This meta(dim);
+        std::memcpy(meta.mean_.get(), ptr, sizeof(MeanType) * dim);
+        ptr += sizeof(MeanType) * dim;
+        std::memcpy(static_cast<void *>(&meta.global_cache_), ptr, sizeof(GlobalCacheType));
+        ptr += sizeof(GlobalCacheType);
+        return meta;
+    }
+
     LVQQuery MakeQuery(const DataType *vec) const {
         LVQQuery query(compress_data_size_);
         CompressTo(vec, query.inner_.get());
@@ -252,7 +272,7 @@ public:
     using LVQData = LVQData<DataType, LocalCacheType, CompressType>;
 
 private:
-    LVQVecStoreInner(SizeT max_vec_num, const Meta &meta) : ptr_(MakeUnique<char[]>(max_vec_num * meta.compress_data_size())) {}
+    LVQVecStoreInner(SizeT max_vec_num, const Meta &meta) : ptr_(MakeUnique<char[]>(max_vec_num * meta.compress_data_size())), data_(ptr_.get()) {}
 
 public:
     LVQVecStoreInner() = default;
@@ -266,7 +286,7 @@ public:
     SizeT GetSizeInBytes(SizeT cur_vec_num, const Meta &meta) const { return cur_vec_num * meta.compress_data_size(); }
 
     void Save(LocalFileHandle &file_handle, SizeT cur_vec_num, const Meta &meta) const {
-        file_handle.Append(ptr_.get(), cur_vec_num * meta.compress_data_size());
+        file_handle.Append(data_, cur_vec_num * meta.compress_data_size());
     }
 
     static This Load(LocalFileHandle &file_handle, SizeT cur_vec_num, SizeT max_vec_num, const Meta &meta, SizeT &mem_usage) {
@@ -277,10 +297,31 @@ public:
         return ret;
     }
 
+    // The compressed vectors are read in place from `ptr`, which must outlive the returned store. The store is read only.
+    static This LoadFromPtr(const char *&ptr, SizeT cur_vec_num, const Meta &meta) {
+        This ret;
+        if (reinterpret_cast<uintptr_t>(ptr) % alignof(LVQData) == 0) {
+            ret.data_ = ptr;
+        } else {
+            ret.ptr_ = MakeUniqueForOverwrite<char[]>(cur_vec_num * meta.compress_data_size());
+            std::memcpy(ret.ptr_.get(), ptr, cur_vec_num * meta.compress_data_size());
+            ret.data_ = ret.ptr_.get();
+        }
+        ptr += cur_vec_num * meta.compress_data_size();
+        return ret;
+    }
+
+    // Writable copy of the first `cur_vec_num` vectors, this store may be loaded in place.
+    This Copy(SizeT cur_vec_num, SizeT max_vec_num, const Meta &meta, SizeT &mem_usage) const {
+        This ret = Make(max_vec_num, meta, mem_usage);
+        std::memcpy(ret.ptr_.get(), data_, cur_vec_num * meta.compress_data_size());
+        return ret;
+    }
+
     void SetVec(SizeT idx, const DataType *vec, const Meta &meta, SizeT &mem_usage) { meta.CompressTo(vec, GetVecMut(idx, meta)); }
 
     const LVQData *GetVec(SizeT idx, const Meta &meta) const {
-        return reinterpret_cast<const LVQData *>(ptr_.get() + idx * meta.compress_data_size());
+        return reinterpret_cast<const LVQData *>(data_ + idx * meta.compress_data_size());
     }
 
     void Prefetch(VertexType vec_i, const Meta &meta) const { _mm_prefetch(reinterpret_cast<const char *>(GetVec(vec_i, meta)), _MM_HINT_T0); }
@@ -290,6 +331,7 @@ private:
 
 private:
     UniquePtr<char[]> ptr_;
+    const char *data_{};
 
 public:
     void Dump(std::ostream &os, SizeT offset, SizeT chunk_size, const Meta &meta) const {
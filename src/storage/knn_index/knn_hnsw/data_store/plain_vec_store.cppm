@@ -27,6 +27,7 @@ export module plain_vec_store;
 import stl;
 import local_file_handle;
 import hnsw_common;
+import serialize;
 
 namespace infinity {
 
@@ -64,6 +65,11 @@ public:
         return This(dim);
     }
 
+    static This LoadFromPtr(const char *&ptr) {
+        SizeT dim = ReadBufAdv<SizeT>(ptr);
+        return This(dim);
+    }
+
     QueryType MakeQuery(const DataType *vec) const { return vec; }
 
     SizeT dim() const { return dim_; }
@@ -82,7 +88,7 @@ public:
     using Meta = PlainVecStoreMeta<DataType>;
 
 private:
-    PlainVecStoreInner(SizeT max_vec_num, const Meta &meta) : ptr_(MakeUnique<DataType[]>(max_vec_num * meta.dim())) {}
+    PlainVecStoreInner(SizeT max_vec_num, const Meta &meta) : ptr_(MakeUnique<DataType[]>(max_vec_num * meta.dim())), data_(ptr_.get()) {}
 
 public:
     PlainVecStoreInner() = default;
@@ -95,7 +101,7 @@ public:
     SizeT GetSizeInBytes(SizeT cur_vec_num, const Meta &meta) const { return sizeof(DataType) * cur_vec_num * meta.dim(); }
 
     void Save(LocalFileHandle &file_handle, SizeT cur_vec_num, const Meta &meta) const {
-        file_handle.Append(ptr_.get(), sizeof(DataType) * cur_vec_num * meta.dim());
+        file_handle.Append(data_, sizeof(DataType) * cur_vec_num * meta.dim());
     }
 
     static This Load(LocalFileHandle &file_handle, SizeT cur_vec_num, SizeT max_vec_num, const Meta &meta, SizeT &mem_usage) {
@@ -106,9 +112,16 @@ public:
         return ret;
     }
 
+    // The vectors are read in place from `ptr`, which must outlive the returned store. The store is read only.
+    static This LoadFromPtr(const char *&ptr, SizeT cur_vec_num, const Meta &meta) {
+        This ret;
+        ret.data_ = ViewOrCopy(ptr, cur_vec_num * meta.dim(), ret.ptr_);
+        return ret;
+    }
+
     void SetVec(SizeT idx, const DataType *vec, const Meta &meta, SizeT &mem_usage) { Copy(vec, vec + meta.dim(), GetVecMut(idx, meta)); }
 
-    const DataType *GetVec(SizeT idx, const Meta &meta) const { return ptr_.get() + idx * meta.dim(); }
+    const DataType *GetVec(SizeT idx, const Meta &meta) const { return data_ + idx * meta.dim(); }
 
     void Prefetch(VertexType vec_i, const Meta &meta) const { _mm_prefetch(reinterpret_cast<const char *>(GetVec(vec_i, meta)), _MM_HINT_T0); }
 
@@ -117,6 +130,7 @@ private:
 
 private:
     UniquePtr<DataType[]> ptr_;
+    const DataType *data_{};
 
 public:
     void Dump(std::ostream &os, SizeT offset, SizeT chunk_size, const Meta &meta) const {
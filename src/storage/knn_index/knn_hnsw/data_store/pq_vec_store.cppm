@@ -0,0 +1,455 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <cassert>
+#include <ostream>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <xmmintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__)
+#include <simde/x86/sse.h>
+#endif
+
+export module pq_vec_store;
+
+import stl;
+import local_file_handle;
+import hnsw_common;
+import emvb_product_quantization;
+import mlas_matrix_multiply;
+import default_values;
+import infinity_exception;
+import third_party;
+
+namespace infinity {
+
+export enum class PQMetric : i8 {
+    kL2,
+    kIP,
+    kCos, // normalized, then compared by inner product
+};
+
+// one byte code per subspace
+export constexpr SizeT kPQMaxCentroidNum = 256;
+// the emvb product quantizer is instantiated for the power of two subspace numbers up to 128
+export constexpr SizeT kPQMaxSubspaceNum = 128;
+
+// Stored vectors only have codes. A query has the ADC table instead, [subspace_num][centroid_num], precomputed once per query.
+export struct PQVecRef {
+    const u8 *codes_ = nullptr;
+    const f32 *table_ = nullptr;
+};
+
+export template <typename DataType, PQMetric Metric>
+class PQVecStoreInner;
+
+// The codebook is trained by the OPQ of emvb: the vectors are rotated by its matrix R before they are split into subspaces.
+// The subspace number is the largest power of two up to kPQMaxSubspaceNum that keeps about HNSW_PQ_SUBSPACE_DIM dims per
+// subspace, and the vectors are padded with zeros to a multiple of it, e.g. a 131-dim vector has 16 subspaces of 9 dims.
+// The zero padding changes neither the l2 distance nor the inner product.
+export template <typename DataType, PQMetric Metric>
+class PQVecStoreMeta {
+public:
+    using This = PQVecStoreMeta<DataType, Metric>;
+    using Inner = PQVecStoreInner<DataType, Metric>;
+    using StoreType = PQVecRef;
+    struct PQQuery {
+        UniquePtr<f32[]> table_;
+        operator PQVecRef() const { return {nullptr, table_.get()}; }
+    };
+    using QueryType = PQQuery;
+    using DistanceType = f32;
+
+private:
+    PQVecStoreMeta(SizeT dim) : dim_(dim) {
+        const SizeT max_subspace_num = std::min(kPQMaxSubspaceNum, std::max(SizeT(1), (dim + HNSW_PQ_SUBSPACE_DIM - 1) / HNSW_PQ_SUBSPACE_DIM));
+        subspace_num_ = 1;
+        while (subspace_num_ * 2 <= max_subspace_num) {
+            subspace_num_ *= 2;
+        }
+        subspace_dim_ = (dim + subspace_num_ - 1) / subspace_num_;
+        padded_dim_ = subspace_num_ * subspace_dim_;
+        centroids_ = MakeUnique<f32[]>(subspace_num_ * kPQMaxCentroidNum * subspace_dim_);
+        rotation_ = MakeUnique<f32[]>(padded_dim_ * padded_dim_);
+    }
+
+public:
+    PQVecStoreMeta() : dim_(0), padded_dim_(0), subspace_dim_(0), subspace_num_(0), centroid_num_(0) {}
+    PQVecStoreMeta(This &&other)
+        : dim_(std::exchange(other.dim_, 0)), padded_dim_(std::exchange(other.padded_dim_, 0)), subspace_dim_(std::exchange(other.subspace_dim_, 0)),
+          subspace_num_(std::exchange(other.subspace_num_, 0)), centroid_num_(std::exchange(other.centroid_num_, 0)),
+          centroids_(std::move(other.centroids_)), rotation_(std::move(other.rotation_)), sdc_table_(std::move(other.sdc_table_)) {}
+    PQVecStoreMeta &operator=(This &&other) {
+        if (this != &other) {
+            dim_ = std::exchange(other.dim_, 0);
+            padded_dim_ = std::exchange(other.padded_dim_, 0);
+            subspace_dim_ = std::exchange(other.subspace_dim_, 0);
+            subspace_num_ = std::exchange(other.subspace_num_, 0);
+            centroid_num_ = std::exchange(other.centroid_num_, 0);
+            centroids_ = std::move(other.centroids_);
+            rotation_ = std::move(other.rotation_);
+            sdc_table_ = std::move(other.sdc_table_);
+        }
+        return *this;
+    }
+
+    static This Make(SizeT dim) { return This(dim); }
+    static This Make(SizeT dim, bool) { return This(dim); }
+
+    // the SDC table isn't saved, it's rebuilt from the codebook on load
+    SizeT GetSizeInBytes() const {
+        return sizeof(dim_) + sizeof(centroid_num_) + sizeof(f32) * subspace_num_ * centroid_num_ * subspace_dim_ + sizeof(f32) * padded_dim_ * padded_dim_;
+    }
+
+    void Save(LocalFileHandle &file_handle) const {
+        file_handle.Append(&dim_, sizeof(dim_));
+        file_handle.Append(&centroid_num_, sizeof(centroid_num_));
+        for (SizeT i = 0; i < subspace_num_; ++i) {
+            file_handle.Append(GetCentroid(i, 0), sizeof(f32) * centroid_num_ * subspace_dim_);
+        }
+        file_handle.Append(rotation_.get(), sizeof(f32) * padded_dim_ * padded_dim_);
+    }
+
+    static This Load(LocalFileHandle &file_handle) {
+        SizeT dim;
+        file_handle.Read(&dim, sizeof(dim));
+        This meta(dim);
+        file_handle.Read(&meta.centroid_num_, sizeof(meta.centroid_num_));
+        for (SizeT i = 0; i < meta.subspace_num_; ++i) {
+            file_handle.Read(meta.GetCentroidMut(i, 0), sizeof(f32) * meta.centroid_num_ * meta.subspace_dim_);
+        }
+        file_handle.Read(meta.rotation_.get(), sizeof(f32) * meta.padded_dim_ * meta.padded_dim_);
+        if (meta.centroid_num_ > 0) {
+            meta.BuildSDCTable();
+        }
+        return meta;
+    }
+
+    PQQuery MakeQuery(const DataType *vec) const {
+        auto query_f32 = Rotate(ToF32(vec).get(), rotation_.get());
+        PQQuery query{MakeUniqueForOverwrite<f32[]>(subspace_num_ * centroid_num_)};
+        f32 *table = query.table_.get();
+        for (SizeT i = 0; i < subspace_num_; ++i) {
+            const f32 *sub_query = query_f32.get() + i * subspace_dim_;
+            for (SizeT j = 0; j < centroid_num_; ++j) {
+                table[i * centroid_num_ + j] = SubspaceDistance(sub_query, GetCentroid(i, j));
+            }
+        }
+        return query;
+    }
+
+    void CompressTo(const DataType *src, u8 *dest) const {
+        if (centroid_num_ == 0) {
+            UnrecoverableError("PQ codebook is not trained.");
+        }
+        CompressF32To(ToF32(src).get(), dest);
+    }
+
+    // decode with the codebook `centroids` and the rotation `rotation`, laid out as centroids_ and rotation_, into the padded vector
+    void DecompressTo(const u8 *codes, f32 *dest, const f32 *centroids, const f32 *rotation) const {
+        auto rotated = MakeUniqueForOverwrite<f32[]>(padded_dim_);
+        for (SizeT i = 0; i < subspace_num_; ++i) {
+            const f32 *centroid = centroids + (i * kPQMaxCentroidNum + codes[i]) * subspace_dim_;
+            Copy(centroid, centroid + subspace_dim_, rotated.get() + i * subspace_dim_);
+        }
+        // R is orthogonal, x = (x * R) * R^T
+        matrixA_multiply_transpose_matrixB_output_to_C(rotated.get(), rotation, 1, padded_dim_, padded_dim_, dest);
+    }
+
+    // Train the codebook on a sample of the existing and the new vectors, then re-encode the existing vectors.
+    template <typename LabelType, DataIteratorConcept<const DataType *, LabelType> Iterator>
+    void Optimize(Iterator &&query_iter, const Vector<Pair<Inner *, SizeT>> &inners, SizeT &mem_usage) {
+        // the reservoir is capped by bytes, HNSW_PQ_TRAIN_SAMPLE_NUM wide vectors alone would take hundreds of MB
+        const SizeT sample_cap =
+            std::max(kPQMaxCentroidNum, std::min(HNSW_PQ_TRAIN_SAMPLE_NUM, HNSW_PQ_TRAIN_SAMPLE_BYTES / (padded_dim_ * sizeof(f32))));
+        std::mt19937 rng(0);
+        Vector<f32> sample;
+        SizeT seen_n = 0;
+        auto add_sample = [&](const f32 *vec) {
+            if (seen_n < sample_cap) {
+                sample.insert(sample.end(), vec, vec + padded_dim_);
+            } else if (SizeT pos = std::uniform_int_distribution<SizeT>(0, seen_n)(rng); pos < sample_cap) {
+                Copy(vec, vec + padded_dim_, sample.data() + pos * padded_dim_);
+            }
+            ++seen_n;
+        };
+        // the existing codes are decoded one at a time by a copy of the old codebook and re-encoded after training
+        UniquePtr<f32[]> old_centroids;
+        UniquePtr<f32[]> old_rotation;
+        Vector<f32> old_vec(padded_dim_);
+        if (centroid_num_ > 0) {
+            const SizeT centroids_size = subspace_num_ * kPQMaxCentroidNum * subspace_dim_;
+            old_centroids = MakeUniqueForOverwrite<f32[]>(centroids_size);
+            Copy(centroids_.get(), centroids_.get() + centroids_size, old_centroids.get());
+            old_rotation = MakeUniqueForOverwrite<f32[]>(padded_dim_ * padded_dim_);
+            Copy(rotation_.get(), rotation_.get() + padded_dim_ * padded_dim_, old_rotation.get());
+            for (const auto [inner, size] : inners) {
+                for (SizeT i = 0; i < size; ++i) {
+                    DecompressTo(inner->GetVec(i, *this).codes_, old_vec.data(), old_centroids.get(), old_rotation.get());
+                    add_sample(old_vec.data());
+                }
+            }
+        }
+        while (true) {
+            if (auto ret = query_iter.Next(); ret) {
+                auto &[vec, _] = *ret;
+                add_sample(ToF32(vec).get());
+            } else {
+                break;
+            }
+        }
+        SizeT sample_n = sample.size() / padded_dim_;
+        if (sample_n == 0) {
+            return;
+        }
+        Train(sample, sample_n);
+        if (old_centroids == nullptr) {
+            return;
+        }
+        for (const auto [inner, size] : inners) {
+            for (SizeT i = 0; i < size; ++i) {
+                DecompressTo(inner->GetVec(i, *this).codes_, old_vec.data(), old_centroids.get(), old_rotation.get());
+                inner->SetCodes(i, old_vec.data(), *this);
+            }
+        }
+    }
+
+    // the vector is already converted to f32, padded and normalized if needed
+    void CompressF32To(const f32 *src, u8 *dest) const {
+        auto rotated = Rotate(src, rotation_.get());
+        for (SizeT i = 0; i < subspace_num_; ++i) {
+            const f32 *sub_vec = rotated.get() + i * subspace_dim_;
+            f32 min_dist = std::numeric_limits<f32>::max();
+            SizeT min_j = 0;
+            for (SizeT j = 0; j < centroid_num_; ++j) {
+                f32 dist = L2(sub_vec, GetCentroid(i, j));
+                if (dist < min_dist) {
+                    min_dist = dist;
+                    min_j = j;
+                }
+            }
+            dest[i] = min_j;
+        }
+    }
+
+    // asymmetric distance between a query and a stored vector, by table lookup
+    f32 ADCDistance(const f32 *table, const u8 *codes) const {
+        f32 sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+        SizeT i = 0;
+        for (; i + 4 <= subspace_num_; i += 4) {
+            sum0 += table[i * centroid_num_ + codes[i]];
+            sum1 += table[(i + 1) * centroid_num_ + codes[i + 1]];
+            sum2 += table[(i + 2) * centroid_num_ + codes[i + 2]];
+            sum3 += table[(i + 3) * centroid_num_ + codes[i + 3]];
+        }
+        for (; i < subspace_num_; ++i) {
+            sum0 += table[i * centroid_num_ + codes[i]];
+        }
+        return (sum0 + sum1) + (sum2 + sum3);
+    }
+
+    // symmetric distance between two stored vectors, by lookup in the centroid-to-centroid table
+    f32 SDCDistance(const u8 *codes1, const u8 *codes2) const {
+        const SizeT table_size = centroid_num_ * centroid_num_;
+        const f32 *table = sdc_table_.get();
+        f32 sum0 = 0, sum1 = 0;
+        SizeT i = 0;
+        for (; i + 2 <= subspace_num_; i += 2) {
+            sum0 += table[i * table_size + codes1[i] * centroid_num_ + codes2[i]];
+            sum1 += table[(i + 1) * table_size + codes1[i + 1] * centroid_num_ + codes2[i + 1]];
+        }
+        for (; i < subspace_num_; ++i) {
+            sum0 += table[i * table_size + codes1[i] * centroid_num_ + codes2[i]];
+        }
+        return sum0 + sum1;
+    }
+
+    SizeT dim() const { return dim_; }
+    SizeT compress_data_size() const { return subspace_num_; }
+    SizeT subspace_num() const { return subspace_num_; }
+    SizeT subspace_dim() const { return subspace_dim_; }
+    SizeT centroid_num() const { return centroid_num_; }
+
+private:
+    void Train(Vector<f32> &sample, SizeT sample_n) {
+        // the quantizer always trains kPQMaxCentroidNum centroids, repeat a small sample up to that
+        for (SizeT i = 0; sample_n + i < kPQMaxCentroidNum; ++i) {
+            sample.insert(sample.end(), sample.begin() + (i % sample_n) * padded_dim_, sample.begin() + (i % sample_n + 1) * padded_dim_);
+        }
+        sample_n = std::max(sample_n, kPQMaxCentroidNum);
+        UniquePtr<EMVBProductQuantizer> quantizer = GetEMVBOPQ(subspace_num_, 8, padded_dim_);
+        quantizer->Train(sample.data(), sample_n, HNSW_PQ_TRAIN_ITER);
+        centroid_num_ = kPQMaxCentroidNum;
+        for (SizeT i = 0; i < subspace_num_; ++i) {
+            const f32 *sub_centroids = quantizer->GetSubspaceCentroids(i);
+            Copy(sub_centroids, sub_centroids + centroid_num_ * subspace_dim_, GetCentroidMut(i, 0));
+        }
+        const f32 *rotation = quantizer->GetRotationMatrix();
+        Copy(rotation, rotation + padded_dim_ * padded_dim_, rotation_.get());
+        BuildSDCTable();
+    }
+
+    // [subspace_num][centroid_num][centroid_num], subspace_num * 256KB, e.g. 32MB for 1536 dims
+    void BuildSDCTable() {
+        const SizeT table_size = centroid_num_ * centroid_num_;
+        sdc_table_ = MakeUniqueForOverwrite<f32[]>(subspace_num_ * table_size);
+        for (SizeT i = 0; i < subspace_num_; ++i) {
+            f32 *table = sdc_table_.get() + i * table_size;
+            for (SizeT j = 0; j < centroid_num_; ++j) {
+                for (SizeT k = 0; k < centroid_num_; ++k) {
+                    table[j * centroid_num_ + k] = SubspaceDistance(GetCentroid(i, j), GetCentroid(i, k));
+                }
+            }
+        }
+    }
+
+    // the vector converted to f32, normalized for cosine and padded with zeros
+    UniquePtr<f32[]> ToF32(const DataType *vec) const {
+        auto ret = MakeUnique<f32[]>(padded_dim_);
+        for (SizeT i = 0; i < dim_; ++i) {
+            ret[i] = static_cast<f32>(vec[i]);
+        }
+        if constexpr (Metric == PQMetric::kCos) {
+            f32 norm = std::sqrt(IP(ret.get(), ret.get(), dim_));
+            if (norm > 0) {
+                for (SizeT i = 0; i < dim_; ++i) {
+                    ret[i] /= norm;
+                }
+            }
+        }
+        return ret;
+    }
+
+    // x * R
+    UniquePtr<f32[]> Rotate(const f32 *vec, const f32 *rotation) const {
+        auto ret = MakeUniqueForOverwrite<f32[]>(padded_dim_);
+        matrixA_multiply_matrixB_output_to_C(vec, rotation, 1, padded_dim_, padded_dim_, ret.get());
+        return ret;
+    }
+
+    f32 SubspaceDistance(const f32 *v1, const f32 *v2) const {
+        if constexpr (Metric == PQMetric::kL2) {
+            return L2(v1, v2);
+        } else {
+            return -IP(v1, v2);
+        }
+    }
+
+    f32 L2(const f32 *v1, const f32 *v2) const {
+        f32 sum = 0;
+        for (SizeT i = 0; i < subspace_dim_; ++i) {
+            f32 diff = v1[i] - v2[i];
+            sum += diff * diff;
+        }
+        return sum;
+    }
+
+    f32 IP(const f32 *v1, const f32 *v2) const { return IP(v1, v2, subspace_dim_); }
+
+    static f32 IP(const f32 *v1, const f32 *v2, SizeT dim) {
+        f32 sum = 0;
+        for (SizeT i = 0; i < dim; ++i) {
+            sum += v1[i] * v2[i];
+        }
+        return sum;
+    }
+
+    const f32 *GetCentroid(SizeT subspace_i, SizeT centroid_i) const {
+        return centroids_.get() + (subspace_i * kPQMaxCentroidNum + centroid_i) * subspace_dim_;
+    }
+
+    f32 *GetCentroidMut(SizeT subspace_i, SizeT centroid_i) { return centroids_.get() + (subspace_i * kPQMaxCentroidNum + centroid_i) * subspace_dim_; }
+
+private:
+    SizeT dim_;
+    SizeT padded_dim_; // subspace_num * subspace_dim
+    SizeT subspace_dim_;
+    SizeT subspace_num_;
+    SizeT centroid_num_; // 0 if not trained
+
+    // [subspace_num][kPQMaxCentroidNum][subspace_dim]
+    UniquePtr<f32[]> centroids_;
+    // [padded_dim][padded_dim], the OPQ rotation
+    UniquePtr<f32[]> rotation_;
+    // distances between the centroids of each subspace, built when the codebook is trained or loaded
+    UniquePtr<f32[]> sdc_table_;
+
+public:
+    void Dump(std::ostream &os) const {
+        os << "[CONST] dim: " << dim_ << ", padded_dim: " << padded_dim_ << ", subspace_dim: " << subspace_dim_ << ", subspace_num: " << subspace_num_
+           << ", centroid_num: " << centroid_num_ << std::endl;
+    }
+};
+
+export template <typename DataType, PQMetric Metric>
+class PQVecStoreInner {
+public:
+    using This = PQVecStoreInner<DataType, Metric>;
+    using Meta = PQVecStoreMeta<DataType, Metric>;
+
+private:
+    PQVecStoreInner(SizeT max_vec_num, const Meta &meta) : ptr_(MakeUnique<u8[]>(max_vec_num * meta.compress_data_size())) {}
+
+public:
+    PQVecStoreInner() = default;
+
+    static This Make(SizeT max_vec_num, const Meta &meta, SizeT &mem_usage) {
+        mem_usage += max_vec_num * meta.compress_data_size();
+        return This(max_vec_num, meta);
+    }
+
+    SizeT GetSizeInBytes(SizeT cur_vec_num, const Meta &meta) const { return cur_vec_num * meta.compress_data_size(); }
+
+    void Save(LocalFileHandle &file_handle, SizeT cur_vec_num, const Meta &meta) const {
+        file_handle.Append(ptr_.get(), cur_vec_num * meta.compress_data_size());
+    }
+
+    static This Load(LocalFileHandle &file_handle, SizeT cur_vec_num, SizeT max_vec_num, const Meta &meta, SizeT &mem_usage) {
+        assert(cur_vec_num <= max_vec_num);
+        This ret(max_vec_num, meta);
+        file_handle.Read(ret.ptr_.get(), cur_vec_num * meta.compress_data_size());
+        mem_usage += max_vec_num * meta.compress_data_size();
+        return ret;
+    }
+
+    void SetVec(SizeT idx, const DataType *vec, const Meta &meta, SizeT &mem_usage) { meta.CompressTo(vec, GetCodesMut(idx, meta)); }
+
+    void SetCodes(SizeT idx, const f32 *vec, const Meta &meta) { meta.CompressF32To(vec, GetCodesMut(idx, meta)); }
+
+    PQVecRef GetVec(SizeT idx, const Meta &meta) const { return {ptr_.get() + idx * meta.compress_data_size(), nullptr}; }
+
+    void Prefetch(VertexType vec_i, const Meta &meta) const { _mm_prefetch(reinterpret_cast<const char *>(GetVec(vec_i, meta).codes_), _MM_HINT_T0); }
+
+private:
+    u8 *GetCodesMut(SizeT idx, const Meta &meta) { return ptr_.get() + idx * meta.compress_data_size(); }
+
+private:
+    UniquePtr<u8[]> ptr_;
+
+public:
+    void Dump(std::ostream &os, SizeT offset, SizeT chunk_size, const Meta &meta) const {
+        for (int i = 0; i < (int)chunk_size; ++i) {
+            os << "vec " << i << "(" << offset + i << "): ";
+            const u8 *codes = GetVec(i, meta).codes_;
+            for (SizeT j = 0; j < meta.compress_data_size(); ++j) {
+                os << static_cast<int>(codes[j]) << " ";
+            }
+            os << std::endl;
+        }
+    }
+};
+
+} // namespace infinity
@@ -20,6 +20,7 @@ import stl;
 import plain_vec_store;
 import sparse_vec_store;
 import lvq_vec_store;
+import pq_vec_store;
 import dist_func_cos;
 import dist_func_l2;
 import dist_func_ip;
@@ -37,6 +38,15 @@ class LVQL2VecStoreType;
 export template <typename DataT, typename CompressT>
 class LVQIPVecStoreType;
 
+export template <typename DataT>
+class PQCosVecStoreType;
+
+export template <typename DataT>
+class PQL2VecStoreType;
+
+export template <typename DataT>
+class PQIPVecStoreType;
+
 export template <typename DataT>
 class PlainCosVecStoreType {
 public:
@@ -55,6 +65,10 @@ public:
     static constexpr LVQCosVecStoreType<DataType, CompressType> ToLVQ() {
         return {};
     }
+
+    static constexpr PQCosVecStoreType<DataType> ToPQ() {
+        return {};
+    }
 };
 
 export template <typename DataT>
@@ -75,6 +89,10 @@ public:
     static constexpr LVQL2VecStoreType<DataType, CompressType> ToLVQ() {
         return {};
     }
+
+    static constexpr PQL2VecStoreType<DataType> ToPQ() {
+        return {};
+    }
 };
 
 export template <typename DataT>
@@ -95,6 +113,10 @@ public:
     static constexpr LVQIPVecStoreType<DataType, CompressType> ToLVQ() {
         return {};
     }
+
+    static constexpr PQIPVecStoreType<DataType> ToPQ() {
+        return {};
+    }
 };
 
 export template <typename DataT, typename IndexT>
@@ -115,6 +137,10 @@ public:
     static constexpr SparseIPVecStoreType<DataType, IndexT> ToLVQ() {
         return {};
     }
+
+    static constexpr SparseIPVecStoreType<DataType, IndexT> ToPQ() {
+        return {};
+    }
 };
 
 export template <typename DataT, typename CompressT>
@@ -135,6 +161,10 @@ public:
     static constexpr LVQCosVecStoreType<DataType, CompressType> ToLVQ() {
         return {};
     }
+
+    static constexpr LVQCosVecStoreType<DataType, CompressType> ToPQ() {
+        return {};
+    }
 };
 
 export template <typename DataT, typename CompressT>
@@ -155,6 +185,10 @@ public:
     static constexpr LVQL2VecStoreType<DataType, CompressType> ToLVQ() {
         return {};
     }
+
+    static constexpr LVQL2VecStoreType<DataType, CompressType> ToPQ() {
+        return {};
+    }
 };
 
 export template <typename DataT, typename CompressT>
@@ -175,6 +209,83 @@ public:
     static constexpr LVQIPVecStoreType<DataType, CompressType> ToLVQ() {
         return {};
     }
+
+    static constexpr LVQIPVecStoreType<DataType, CompressType> ToPQ() {
+        return {};
+    }
+};
+
+export template <typename DataT>
+class PQCosVecStoreType {
+public:
+    using DataType = DataT;
+    using CompressType = void;
+    using Meta = PQVecStoreMeta<DataType, PQMetric::kCos>;
+    using Inner = PQVecStoreInner<DataType, PQMetric::kCos>;
+    using QueryVecType = const DataType *;
+    using StoreType = typename Meta::StoreType;
+    using QueryType = typename Meta::QueryType;
+    using Distance = PQCosDist<DataType>;
+
+    // the codebook is trained in Optimize
+    static constexpr bool HasOptimize = true;
+
+    template <typename CompressType>
+    static constexpr PQCosVecStoreType<DataType> ToLVQ() {
+        return {};
+    }
+
+    static constexpr PQCosVecStoreType<DataType> ToPQ() {
+        return {};
+    }
+};
+
+export template <typename DataT>
+class PQL2VecStoreType {
+public:
+    using DataType = DataT;
+    using CompressType = void;
+    using Meta = PQVecStoreMeta<DataType, PQMetric::kL2>;
+    using Inner = PQVecStoreInner<DataType, PQMetric::kL2>;
+    using QueryVecType = const DataType *;
+    using StoreType = typename Meta::StoreType;
+    using QueryType = typename Meta::QueryType;
+    using Distance = PQL2Dist<DataType>;
+
+    static constexpr bool HasOptimize = true;
+
+    template <typename CompressType>
+    static constexpr PQL2VecStoreType<DataType> ToLVQ() {
+        return {};
+    }
+
+    static constexpr PQL2VecStoreType<DataType> ToPQ() {
+        return {};
+    }
+};
+
+export template <typename DataT>
+class PQIPVecStoreType {
+public:
+    using DataType = DataT;
+    using CompressType = void;
+    using Meta = PQVecStoreMeta<DataType, PQMetric::kIP>;
+    using Inner = PQVecStoreInner<DataType, PQMetric::kIP>;
+    using QueryVecType = const DataType *;
+    using StoreType = typename Meta::StoreType;
+    using QueryType = typename Meta::QueryType;
+    using Distance = PQIPDist<DataType>;
+
+    static constexpr bool HasOptimize = true;
+
+    template <typename CompressType>
+    static constexpr PQIPVecStoreType<DataType> ToLVQ() {
+        return {};
+    }
+
+    static constexpr PQIPVecStoreType<DataType> ToPQ() {
+        return {};
+    }
 };
 
 } // namespace infinity
@@ -22,6 +22,7 @@ import third_party;
 import hnsw_common;
 import plain_vec_store;
 import lvq_vec_store;
+import pq_vec_store;
 import simd_functions;
 
 export module dist_func_cos;
@@ -164,6 +165,27 @@ public:
     }
 };
 
+export template <typename DataType>
+class PQCosDist {
+public:
+    using VecStoreMeta = PQVecStoreMeta<DataType, PQMetric::kCos>;
+    using StoreType = typename VecStoreMeta::StoreType;
+    using DistanceType = typename VecStoreMeta::DistanceType;
+
+    PQCosDist() = default;
+    PQCosDist(SizeT) {}
+
+    DistanceType operator()(const StoreType &v1, const StoreType &v2, const VecStoreMeta &vec_store_meta) const {
+        if (v1.table_ != nullptr) {
+            return vec_store_meta.ADCDistance(v1.table_, v2.codes_);
+        }
+        if (v2.table_ != nullptr) {
+            return vec_store_meta.ADCDistance(v2.table_, v1.codes_);
+        }
+        return vec_store_meta.SDCDistance(v1.codes_, v2.codes_);
+    }
+};
+
 template<typename DataType>
 LVQCosDist<DataType, i8> PlainCosDist<DataType>::ToLVQDistance(SizeT dim) && {
     return LVQCosDist<DataType, i8>(dim);
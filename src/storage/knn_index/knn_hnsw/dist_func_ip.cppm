@@ -20,6 +20,7 @@ import stl;
 import hnsw_common;
 import plain_vec_store;
 import lvq_vec_store;
+import pq_vec_store;
 import simd_functions;
 
 export module dist_func_ip;
@@ -178,6 +179,27 @@ public:
     }
 };
 
+export template <typename DataType>
+class PQIPDist {
+public:
+    using VecStoreMeta = PQVecStoreMeta<DataType, PQMetric::kIP>;
+    using StoreType = typename VecStoreMeta::StoreType;
+    using DistanceType = typename VecStoreMeta::DistanceType;
+
+    PQIPDist() = default;
+    PQIPDist(SizeT) {}
+
+    DistanceType operator()(const StoreType &v1, const StoreType &v2, const VecStoreMeta &vec_store_meta) const {
+        if (v1.table_ != nullptr) {
+            return vec_store_meta.ADCDistance(v1.table_, v2.codes_);
+        }
+        if (v2.table_ != nullptr) {
+            return vec_store_meta.ADCDistance(v2.table_, v1.codes_);
+        }
+        return vec_store_meta.SDCDistance(v1.codes_, v2.codes_);
+    }
+};
+
 template <typename DataType>
 LVQIPDist<DataType, i8> PlainIPDist<DataType>::ToLVQDistance(SizeT dim) && {
     return LVQIPDist<DataType, i8>(dim);
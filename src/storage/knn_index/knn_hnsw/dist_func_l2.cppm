@@ -20,6 +20,7 @@ import stl;
 import hnsw_common;
 import plain_vec_store;
 import lvq_vec_store;
+import pq_vec_store;
 import simd_functions;
 
 export module dist_func_l2;
@@ -167,6 +168,28 @@ public:
     }
 };
 
+export template <typename DataType>
+class PQL2Dist {
+public:
+    using VecStoreMeta = PQVecStoreMeta<DataType, PQMetric::kL2>;
+    using StoreType = typename VecStoreMeta::StoreType;
+    using DistanceType = typename VecStoreMeta::DistanceType;
+
+    PQL2Dist() = default;
+    PQL2Dist(SizeT) {}
+
+    // a query carries its ADC table, two stored vectors are compared by their centroids
+    DistanceType operator()(const StoreType &v1, const StoreType &v2, const VecStoreMeta &vec_store_meta) const {
+        if (v1.table_ != nullptr) {
+            return vec_store_meta.ADCDistance(v1.table_, v2.codes_);
+        }
+        if (v2.table_ != nullptr) {
+            return vec_store_meta.ADCDistance(v2.table_, v1.codes_);
+        }
+        return vec_store_meta.SDCDistance(v1.codes_, v2.codes_);
+    }
+};
+
 template <typename DataType>
 LVQL2Dist<DataType, i8> PlainL2Dist<DataType>::ToLVQDistance(SizeT dim) && {
     return LVQL2Dist<DataType, i8>(dim);
@@ -27,6 +27,7 @@ import multivector_result_handler;
 import logical_type;
 import hnsw_common;
 import data_store;
+import serialize;
 import third_party;
 
 // Fixme: some variable has implicit type conversion.
@@ -41,8 +42,18 @@ namespace infinity {
 export struct KnnSearchOption {
     SizeT ef_ = 0;
     LogicalType column_logical_type_ = LogicalType::kEmbedding;
+    // fraction of the indexed labels accepted by the filter, used to choose the filtered search strategy
+    f32 filter_ratio_ = 1.0f;
+    // k-th best distance of each query found so far outside of this index, one per query of KnnSearchBatch
+    // the results of layer 0 farther than it cannot make the top-k and are not returned, only applied when the index distance is exact
+    const Atomic<f32> *distance_bounds_ = nullptr;
+    // incremented by the number of results dropped because of distance_bounds_
+    u64 *bound_pruned_count_ = nullptr;
 };
 
+// below this filter ratio, vertices rejected by the filter are bridged to their neighbors instead of being searched
+export constexpr f32 kHnswTwoHopFilterRatio = 0.2f;
+
 export template <typename VecStoreType, typename LabelType>
 class KnnHnsw {
 public:
@@ -60,10 +71,21 @@ public:
     using CMPReverse = CompareByFirstReverse<DistanceType, VertexType>;
     using DistHeap = Heap<PDV, CMP>;
 
+    // the candidate heap of the calling thread, its storage is kept between searches like the VisitedList
+    class LocalDistHeap : public DistHeap {
+    public:
+        static DistHeap &Get() {
+            thread_local LocalDistHeap heap;
+            heap.c.clear();
+            return heap;
+        }
+    };
+
     constexpr static int prefetch_offset_ = 0;
     constexpr static int prefetch_step_ = 2;
 
     using CompressVecStoreType = decltype(VecStoreType::template ToLVQ<i8>());
+    using PQVecStoreType = decltype(VecStoreType::ToPQ());
 
     // private:
     KnnHnsw(SizeT M, SizeT ef_construction, DataStore data_store, Distance distance, SizeT random_seed)
@@ -119,6 +141,19 @@ public:
         return MakeUnique<This>(M, ef_construction, std::move(data_store), std::move(distance), 0);
     }
 
+    static constexpr bool kLoadFromPtr = DataStore::kLoadFromPtr;
+
+    // The index is searched in place from `ptr`, see DataStore::LoadFromPtr.
+    static UniquePtr<This> LoadFromPtr(const char *&ptr) {
+        SizeT M = ReadBufAdv<SizeT>(ptr);
+        SizeT ef_construction = ReadBufAdv<SizeT>(ptr);
+
+        auto data_store = DataStore::LoadFromPtr(ptr);
+        Distance distance(data_store.dim());
+
+        return MakeUnique<This>(M, ef_construction, std::move(data_store), std::move(distance), 0);
+    }
+
 private:
     // >= 0
     i32 GenerateRandomLayer() {
@@ -137,7 +172,43 @@ private:
               LogicalType ColumnLogicalType = LogicalType::kEmbedding,
               typename MultiVectorInnerTopnIndexType = void>
     Tuple<SizeT, UniquePtr<DistanceType[]>, UniquePtr<SearchLayerReturnParam3T<ColumnLogicalType>[]>>
-    SearchLayer(VertexType enter_point, const StoreType &query, i32 layer_idx, SizeT result_n, const Filter &filter) const {
+    SearchLayer(VertexType enter_point,
+                const StoreType &query,
+                i32 layer_idx,
+                SizeT result_n,
+                const Filter &filter,
+                bool two_hop = false,
+                const Atomic<f32> *distance_bound = nullptr,
+                u64 *bound_pruned_count = nullptr) const {
+        return SearchLayer<WithLock, Filter, ColumnLogicalType, MultiVectorInnerTopnIndexType>(&enter_point,
+                                                                                               1,
+                                                                                               query,
+                                                                                               layer_idx,
+                                                                                               result_n,
+                                                                                               filter,
+                                                                                               two_hop,
+                                                                                               distance_bound,
+                                                                                               bound_pruned_count);
+    }
+
+    // search from several enter points at once, used when good starting vertices are known, e.g. in graph merge
+    // if `two_hop` is set, a neighbor rejected by the filter is not searched, its own neighbors that pass the filter are visited instead
+    // if `distance_bound` is given, the results farther than it are dropped and counted in `bound_pruned_count`, the traversal itself
+    // still stops at the ef-th result: a tighter stop leaves the candidates that lead to the nearest vertices unexpanded
+    template <bool WithLock,
+              FilterConcept<LabelType> Filter = NoneType,
+              LogicalType ColumnLogicalType = LogicalType::kEmbedding,
+              typename MultiVectorInnerTopnIndexType = void>
+    Tuple<SizeT, UniquePtr<DistanceType[]>, UniquePtr<SearchLayerReturnParam3T<ColumnLogicalType>[]>>
+    SearchLayer(const VertexType *enter_points,
+                SizeT enter_point_n,
+                const StoreType &query,
+                i32 layer_idx,
+                SizeT result_n,
+                const Filter &filter,
+                bool two_hop = false,
+                const Atomic<f32> *distance_bound = nullptr,
+                u64 *bound_pruned_count = nullptr) const {
         static_assert(ColumnLogicalType == LogicalType::kEmbedding || ColumnLogicalType == LogicalType::kMultiVector);
         auto d_ptr = MakeUniqueForOverwrite<DistanceType[]>(result_n);
         auto i_ptr = MakeUniqueForOverwrite<SearchLayerReturnParam3T<ColumnLogicalType>[]>(result_n);
@@ -168,20 +239,39 @@ private:
                 static_assert(false, "Unsupported column logical type");
             }
         };
-        DistHeap candidate;
+        auto pass_filter = [&](VertexType v) {
+            if constexpr (!std::is_same_v<Filter, NoneType>) {
+                return filter(this->GetLabel(v));
+            } else {
+                return true;
+            }
+        };
+        DistHeap &candidate = LocalDistHeap::Get();
+        auto visit = [&](VertexType n_idx) {
+            auto dist = distance_(query, data_store_.GetVec(n_idx), data_store_.vec_store_meta());
+            if (result_handler.GetSize(0) < result_n || dist <= result_handler.GetDistance0(0)) {
+                candidate.emplace(-dist, n_idx);
+                add_result(dist, n_idx);
+            }
+        };
 
-        data_store_.PrefetchVec(enter_point);
-        // enter_point will not be added to result_handler, the distance is not used
-        {
+        SizeT cur_vec_num = data_store_.cur_vec_num();
+        VisitedList &visited = VisitedList::Local(cur_vec_num);
+
+        for (SizeT i = 0; i < enter_point_n; ++i) {
+            data_store_.PrefetchVec(enter_points[i]);
+        }
+        for (SizeT i = 0; i < enter_point_n; ++i) {
+            VertexType enter_point = enter_points[i];
+            if (visited.Visited(enter_point)) {
+                continue;
+            }
+            visited.Visit(enter_point);
             auto dist = distance_(query, data_store_.GetVec(enter_point), data_store_.vec_store_meta());
             candidate.emplace(-dist, enter_point);
             add_result(dist, enter_point);
         }
 
-        SizeT cur_vec_num = data_store_.cur_vec_num();
-        Vector<bool> visited(cur_vec_num, false);
-        visited[enter_point] = true;
-
         while (!candidate.empty()) {
             const auto [minus_c_dist, c_idx] = candidate.top();
             candidate.pop();
@@ -195,13 +285,23 @@ private:
             }
 
             const auto [neighbors_p, neighbor_size] = data_store_.GetNeighbors(c_idx, layer_idx);
+            if constexpr (!std::is_same_v<Filter, NoneType>) {
+                if (two_hop) {
+                    Vector<VertexType> neighbors(neighbors_p, neighbors_p + neighbor_size);
+                    if constexpr (WithLock) {
+                        lock.unlock(); // do not hold two vertex locks at once
+                    }
+                    SearchTwoHop<WithLock>(neighbors, layer_idx, cur_vec_num, visited, pass_filter, visit);
+                    continue;
+                }
+            }
             int prefetch_start = neighbor_size - 1 - prefetch_offset_;
             for (int i = neighbor_size - 1; i >= 0; --i) {
                 VertexType n_idx = neighbors_p[i];
-                if (n_idx >= (VertexType)cur_vec_num || visited[n_idx]) {
+                if (n_idx >= (VertexType)cur_vec_num || visited.Visited(n_idx)) {
                     continue;
                 }
-                visited[n_idx] = true;
+                visited.Visit(n_idx);
                 if (prefetch_start >= 0) {
                     int lower = std::max(0, prefetch_start - prefetch_step_);
                     for (int j = prefetch_start; j >= lower; --j) {
@@ -210,15 +310,76 @@ private:
                     }
                     prefetch_start -= prefetch_step_;
                 }
-                auto dist = distance_(query, data_store_.GetVec(n_idx), data_store_.vec_store_meta());
-                if (result_handler.GetSize(0) < result_n || dist <= result_handler.GetDistance0(0)) {
-                    candidate.emplace(-dist, n_idx);
-                    add_result(dist, n_idx);
-                }
+                visit(n_idx);
             }
         }
         result_handler.EndWithoutSort();
-        return {result_handler.GetSize(0), std::move(d_ptr), std::move(i_ptr)};
+        SizeT result_size = result_handler.GetSize(0);
+        if constexpr (ColumnLogicalType == LogicalType::kEmbedding && !VecStoreType::HasOptimize) {
+            // compressed vectors only give an estimate of the distance, which cannot be compared with the bound
+            if (distance_bound != nullptr) {
+                const f32 bound = distance_bound->load(std::memory_order_relaxed);
+                SizeT kept = 0;
+                for (SizeT i = 0; i < result_size; ++i) {
+                    if (static_cast<f32>(d_ptr[i]) <= bound) {
+                        d_ptr[kept] = d_ptr[i];
+                        i_ptr[kept] = i_ptr[i];
+                        ++kept;
+                    }
+                }
+                if (bound_pruned_count != nullptr) {
+                    *bound_pruned_count += result_size - kept;
+                }
+                result_size = kept;
+            }
+        }
+        return {result_size, std::move(d_ptr), std::move(i_ptr)};
+    }
+
+    // visit the neighbors passing the filter, and the neighbors of those rejected, at most Mmax0 vertices per expansion
+    template <bool WithLock, typename PassFilter, typename Visit>
+    void SearchTwoHop(const Vector<VertexType> &neighbors,
+                      i32 layer_idx,
+                      SizeT cur_vec_num,
+                      VisitedList &visited,
+                      const PassFilter &pass_filter,
+                      const Visit &visit) const {
+        SizeT visit_limit = layer_idx == 0 ? data_store_.Mmax0() : data_store_.Mmax();
+        SizeT visit_n = 0;
+        Vector<VertexType> rejected;
+        for (auto it = neighbors.rbegin(); it != neighbors.rend() && visit_n < visit_limit; ++it) {
+            VertexType n_idx = *it;
+            if (n_idx >= (VertexType)cur_vec_num || visited.Visited(n_idx)) {
+                continue;
+            }
+            visited.Visit(n_idx);
+            if (pass_filter(n_idx)) {
+                data_store_.PrefetchVec(n_idx);
+                visit(n_idx);
+                ++visit_n;
+            } else {
+                rejected.push_back(n_idx);
+            }
+        }
+        for (VertexType r_idx : rejected) {
+            if (visit_n >= visit_limit) {
+                break;
+            }
+            std::shared_lock<std::shared_mutex> lock;
+            if constexpr (WithLock) {
+                lock = data_store_.SharedLock(r_idx);
+            }
+            const auto [r_neighbors_p, r_neighbor_size] = data_store_.GetNeighbors(r_idx, layer_idx);
+            for (int i = r_neighbor_size - 1; i >= 0 && visit_n < visit_limit; --i) {
+                VertexType n_idx = r_neighbors_p[i];
+                if (n_idx >= (VertexType)cur_vec_num || visited.Visited(n_idx) || !pass_filter(n_idx)) {
+                    continue;
+                }
+                visited.Visit(n_idx);
+                visit(n_idx);
+                ++visit_n;
+            }
+        }
     }
 
     template <bool WithLock>
@@ -312,18 +473,32 @@ private:
     LabelType GetLabel(VertexType vertex_i) const { return data_store_.GetLabel(vertex_i); }
 
     template <bool WithLock, FilterConcept<LabelType> Filter, LogicalType ColumnLogicalType>
-    auto SearchLayerHelper(VertexType enter_point, const StoreType &query, i32 layer_idx, SizeT result_n, const Filter &filter) const {
+    auto SearchLayerHelper(VertexType enter_point,
+                           const StoreType &query,
+                           i32 layer_idx,
+                           SizeT result_n,
+                           const Filter &filter,
+                           bool two_hop,
+                           const Atomic<f32> *distance_bound = nullptr,
+                           u64 *bound_pruned_count = nullptr) const {
         if constexpr (ColumnLogicalType == LogicalType::kEmbedding) {
-            return SearchLayer<WithLock, Filter, ColumnLogicalType>(enter_point, query, layer_idx, result_n, filter);
+            return SearchLayer<WithLock, Filter, ColumnLogicalType>(enter_point,
+                                                                    query,
+                                                                    layer_idx,
+                                                                    result_n,
+                                                                    filter,
+                                                                    two_hop,
+                                                                    distance_bound,
+                                                                    bound_pruned_count);
         } else if constexpr (ColumnLogicalType == LogicalType::kMultiVector) {
             if (result_n <= std::numeric_limits<u8>::max()) {
-                return SearchLayer<WithLock, Filter, ColumnLogicalType, u8>(enter_point, query, layer_idx, result_n, filter);
+                return SearchLayer<WithLock, Filter, ColumnLogicalType, u8>(enter_point, query, layer_idx, result_n, filter, two_hop);
             }
             if (result_n <= std::numeric_limits<u16>::max()) {
-                return SearchLayer<WithLock, Filter, ColumnLogicalType, u16>(enter_point, query, layer_idx, result_n, filter);
+                return SearchLayer<WithLock, Filter, ColumnLogicalType, u16>(enter_point, query, layer_idx, result_n, filter, two_hop);
             }
             if (result_n <= std::numeric_limits<u32>::max()) {
-                return SearchLayer<WithLock, Filter, ColumnLogicalType, u32>(enter_point, query, layer_idx, result_n, filter);
+                return SearchLayer<WithLock, Filter, ColumnLogicalType, u32>(enter_point, query, layer_idx, result_n, filter, two_hop);
             }
             UnrecoverableError(fmt::format("Unsupported result_n : {}, which is larger than u32::max()", result_n));
             return Tuple<SizeT, UniquePtr<DistanceType[]>, UniquePtr<SearchLayerReturnParam3T<ColumnLogicalType>[]>>{};
@@ -335,10 +510,6 @@ private:
     template <bool WithLock, FilterConcept<LabelType> Filter = NoneType, LogicalType ColumnLogicalType = LogicalType::kEmbedding>
     Tuple<SizeT, UniquePtr<DistanceType[]>, UniquePtr<SearchLayerReturnParam3T<ColumnLogicalType>[]>>
     KnnSearchInner(const QueryVecType &q, SizeT k, const Filter &filter, const KnnSearchOption &option) const {
-        SizeT ef = option.ef_;
-        if (ef == 0) {
-            ef = k;
-        }
         QueryType query = data_store_.MakeQuery(q);
         auto [max_layer, ep] = data_store_.GetEnterPoint();
         if (ep == -1) {
@@ -347,7 +518,33 @@ private:
         for (i32 cur_layer = max_layer; cur_layer > 0; --cur_layer) {
             ep = SearchLayerNearest<WithLock>(ep, query, cur_layer);
         }
-        return SearchLayerHelper<WithLock, Filter, ColumnLogicalType>(ep, query, 0, ef, filter);
+        auto [ef, two_hop] = Layer0SearchParam<Filter>(k, option);
+        return SearchLayerHelper<WithLock, Filter, ColumnLogicalType>(ep,
+                                                                      query,
+                                                                      0,
+                                                                      ef,
+                                                                      filter,
+                                                                      two_hop,
+                                                                      option.distance_bounds_,
+                                                                      option.bound_pruned_count_);
+    }
+
+    // the beam width of the search in layer 0, and whether to search over the vertices rejected by the filter
+    template <FilterConcept<LabelType> Filter>
+    Pair<SizeT, bool> Layer0SearchParam(SizeT k, const KnnSearchOption &option) const {
+        SizeT ef = option.ef_;
+        if (ef == 0) {
+            ef = k;
+        }
+        bool two_hop = false;
+        if constexpr (!std::is_same_v<Filter, NoneType>) {
+            if (option.filter_ratio_ < kHnswTwoHopFilterRatio) {
+                two_hop = true;
+                // fewer vertices pass the filter, widen the beam so that enough valid ones are kept as candidates
+                ef = std::max(ef, SizeT(k / std::max(option.filter_ratio_ / kHnswTwoHopFilterRatio, 0.25f)));
+            }
+        }
+        return {ef, two_hop};
     }
 
 public:
@@ -370,10 +567,148 @@ public:
 
     void Optimize() { data_store_.Optimize(); }
 
-    void Build(VertexType vertex_i) {
-        std::unique_lock<std::shared_mutex> lock = data_store_.UniqueLock(vertex_i);
+    void Build(VertexType vertex_i) { BuildWithLayer(vertex_i, GenerateRandomLayer()); }
 
+    // Build `vertex_i` in layer 0 only, starting the search from `seeds` instead of descending from the enter point.
+    // Fall back to normal build if the vertex is assigned to an upper layer.
+    void Build(VertexType vertex_i, const Vector<VertexType> &seeds) {
         i32 q_layer = GenerateRandomLayer();
+        if (seeds.empty() || q_layer > 0) {
+            BuildWithLayer(vertex_i, q_layer);
+            return;
+        }
+        std::unique_lock<std::shared_mutex> lock = data_store_.UniqueLock(vertex_i);
+
+        StoreType query = data_store_.GetVec(vertex_i);
+        data_store_.AddVertex(vertex_i, 0);
+
+        auto [result_n, d_ptr, v_ptr] = SearchLayer<true>(seeds.data(), seeds.size(), query, 0, ef_construction_, None);
+        auto search_result = Vector<PDV>(result_n);
+        for (SizeT i = 0; i < result_n; ++i) {
+            search_result[i] = {d_ptr[i], v_ptr[i]};
+        }
+        const auto [q_neighbors_p, q_neighbor_size_p] = data_store_.GetNeighborsMut(vertex_i, 0);
+        SelectNeighborsHeuristic(std::move(search_result), M_, q_neighbors_p, q_neighbor_size_p);
+        ConnectNeighbors(vertex_i, q_neighbors_p, *q_neighbor_size_p, 0);
+    }
+
+    // Copy the graph of `other` to vertex [offset, offset + other.GetVecNum()).
+    // The vectors must be stored in the same order as in `other`.
+    template <typename OtherHnsw>
+    void CopyGraph(const OtherHnsw &other, VertexType offset) {
+        SizeT vec_num = other.GetVecNum();
+        for (VertexType vertex_i = 0; vertex_i < VertexType(vec_num); ++vertex_i) {
+            VertexType new_vertex_i = offset + vertex_i;
+            i32 layer_n = other.GetLayerN(vertex_i);
+            std::unique_lock<std::shared_mutex> lock = data_store_.UniqueLock(new_vertex_i);
+            data_store_.AddVertex(new_vertex_i, layer_n);
+            for (i32 layer_i = 0; layer_i <= layer_n; ++layer_i) {
+                const auto [neighbors_p, neighbor_size] = other.GetNeighbors(vertex_i, layer_i);
+                auto [new_neighbors_p, new_neighbor_size_p] = data_store_.GetNeighborsMut(new_vertex_i, layer_i);
+                SizeT Mmax = layer_i == 0 ? data_store_.Mmax0() : data_store_.Mmax();
+                VertexListSize copy_n = std::min(neighbor_size, VertexListSize(Mmax));
+                for (VertexListSize i = 0; i < copy_n; ++i) {
+                    new_neighbors_p[i] = offset + neighbors_p[i];
+                }
+                *new_neighbor_size_p = copy_n;
+            }
+        }
+        auto [max_layer, ep] = other.GetEnterPoint();
+        if (ep != -1) {
+            data_store_.TryUpdateEnterPoint(max_layer, offset + ep);
+        }
+    }
+
+    // Insert the vertex [offset, offset + other.GetVecNum()) into the graph.
+    // The neighbors of a vertex in `other` that are already inserted are used as the search seeds.
+    template <typename OtherHnsw>
+    void MergeGraph(const OtherHnsw &other, VertexType offset) {
+        SizeT vec_num = other.GetVecNum();
+        Vector<VertexType> seeds;
+        for (VertexType vertex_i = 0; vertex_i < VertexType(vec_num); ++vertex_i) {
+            seeds.clear();
+            const auto [neighbors_p, neighbor_size] = other.GetNeighbors(vertex_i, 0);
+            for (VertexListSize i = 0; i < neighbor_size; ++i) {
+                if (neighbors_p[i] < vertex_i) {
+                    seeds.push_back(offset + neighbors_p[i]);
+                }
+            }
+            Build(offset + vertex_i, seeds);
+        }
+    }
+
+    // Remove the vertices rejected by `alive` from the neighbor lists of the live vertices, and reconnect the live vertices
+    // with the neighbors of the removed ones. The removed vertices keep their own edges so that a search entering from them
+    // can still pass through. Their vectors are kept because vertex id is positional.
+    // Must not run concurrently with insertion. Return the number of removed vertices.
+    template <FilterConcept<LabelType> Filter>
+    SizeT RepairDeleted(const Filter &alive) {
+        SizeT vec_num = GetVecNum();
+        Vector<bool> deleted(vec_num, false);
+        SizeT deleted_n = 0;
+        for (VertexType vertex_i = 0; vertex_i < VertexType(vec_num); ++vertex_i) {
+            if (!alive(GetLabel(vertex_i))) {
+                deleted[vertex_i] = true;
+                ++deleted_n;
+            }
+        }
+        if (deleted_n == 0 || deleted_n == vec_num) {
+            return 0;
+        }
+        Vector<PDV> candidates;
+        for (VertexType vertex_i = 0; vertex_i < VertexType(vec_num); ++vertex_i) {
+            if (deleted[vertex_i]) {
+                continue;
+            }
+            StoreType v_data = data_store_.GetVec(vertex_i);
+            i32 layer_n = data_store_.GetLayerN(vertex_i);
+            for (i32 layer_i = 0; layer_i <= layer_n; ++layer_i) {
+                auto [neighbors_p, neighbor_size_p] = data_store_.GetNeighborsMut(vertex_i, layer_i);
+                VertexListSize neighbor_size = *neighbor_size_p;
+                if (std::none_of(neighbors_p, neighbors_p + neighbor_size, [&](VertexType n_idx) { return deleted[n_idx]; })) {
+                    continue;
+                }
+                candidates.clear();
+                auto add_candidate = [&](VertexType c_idx) {
+                    if (c_idx == vertex_i || deleted[c_idx]) {
+                        return;
+                    }
+                    candidates.emplace_back(distance_(v_data, data_store_.GetVec(c_idx), data_store_.vec_store_meta()), c_idx);
+                };
+                for (VertexListSize i = 0; i < neighbor_size; ++i) {
+                    VertexType n_idx = neighbors_p[i];
+                    if (!deleted[n_idx]) {
+                        add_candidate(n_idx);
+                        continue;
+                    }
+                    const auto [nn_p, nn_size] = data_store_.GetNeighbors(n_idx, layer_i);
+                    for (VertexListSize j = 0; j < nn_size; ++j) {
+                        add_candidate(nn_p[j]);
+                    }
+                }
+                std::sort(candidates.begin(), candidates.end(), [](const PDV &lhs, const PDV &rhs) { return lhs.second < rhs.second; });
+                candidates.erase(std::unique(candidates.begin(),
+                                             candidates.end(),
+                                             [](const PDV &lhs, const PDV &rhs) { return lhs.second == rhs.second; }),
+                                 candidates.end());
+                SizeT Mmax = layer_i == 0 ? data_store_.Mmax0() : data_store_.Mmax();
+                SelectNeighborsHeuristic(std::move(candidates), Mmax, neighbors_p, neighbor_size_p);
+            }
+        }
+        return deleted_n;
+    }
+
+    // graph accessor for merging graphs of different store type
+    i32 GetLayerN(VertexType vertex_i) const { return data_store_.GetLayerN(vertex_i); }
+
+    Pair<const VertexType *, VertexListSize> GetNeighbors(VertexType vertex_i, i32 layer_i) const { return data_store_.GetNeighbors(vertex_i, layer_i); }
+
+    Pair<i32, VertexType> GetEnterPoint() const { return data_store_.GetEnterPoint(); }
+
+private:
+    void BuildWithLayer(VertexType vertex_i, i32 q_layer) {
+        std::unique_lock<std::shared_mutex> lock = data_store_.UniqueLock(vertex_i);
+
         auto [max_layer, ep] = data_store_.TryUpdateEnterPoint(q_layer, vertex_i);
 
         StoreType query = data_store_.GetVec(vertex_i);
@@ -397,13 +732,14 @@ public:
         }
     }
 
+public:
     UniquePtr<KnnHnsw<CompressVecStoreType, LabelType>> CompressToLVQ() && {
         if constexpr (std::is_same_v<VecStoreType, CompressVecStoreType>) {
             return MakeUnique<This>(std::move(*this));
         } else {
             using CompressedDistance = typename CompressVecStoreType::Distance;
             CompressedDistance distance = std::move(distance_).ToLVQDistance(data_store_.dim());
-            auto compressed_datastore = std::move(data_store_).template CompressToLVQ<CompressVecStoreType>();
+            auto compressed_datastore = std::move(data_store_).template CompressTo<CompressVecStoreType>();
             return MakeUnique<KnnHnsw<CompressVecStoreType, LabelType>>(M_,
                                                                         ef_construction_,
                                                                         std::move(compressed_datastore),
@@ -412,6 +748,37 @@ public:
         }
     }
 
+    // Same as above but this index is left intact for its concurrent readers, the graph is copied.
+    // The result is always on the heap, so this is also how an index loaded in place is made writable.
+    UniquePtr<KnnHnsw<CompressVecStoreType, LabelType>> CompressToLVQ() const & {
+        using CompressedDistance = typename CompressVecStoreType::Distance;
+        CompressedDistance distance(data_store_.dim());
+        auto compressed_datastore = data_store_.template CompressTo<CompressVecStoreType>();
+        return MakeUnique<KnnHnsw<CompressVecStoreType, LabelType>>(M_, ef_construction_, std::move(compressed_datastore), std::move(distance), 0);
+    }
+
+    static constexpr bool kIsLVQ = std::is_same_v<VecStoreType, CompressVecStoreType>;
+
+    // the codebook is trained on the vectors of this index, the graph is kept
+    UniquePtr<KnnHnsw<PQVecStoreType, LabelType>> CompressToPQ() && {
+        if constexpr (std::is_same_v<VecStoreType, PQVecStoreType>) {
+            return MakeUnique<This>(std::move(*this));
+        } else {
+            using PQDistance = typename PQVecStoreType::Distance;
+            PQDistance distance(data_store_.dim());
+            auto compressed_datastore = std::move(data_store_).template CompressTo<PQVecStoreType>();
+            return MakeUnique<KnnHnsw<PQVecStoreType, LabelType>>(M_, ef_construction_, std::move(compressed_datastore), std::move(distance), 0);
+        }
+    }
+
+    // Same as above but this index is left intact for its concurrent readers, the graph is copied.
+    UniquePtr<KnnHnsw<PQVecStoreType, LabelType>> CompressToPQ() const & {
+        using PQDistance = typename PQVecStoreType::Distance;
+        PQDistance distance(data_store_.dim());
+        auto compressed_datastore = data_store_.template CompressTo<PQVecStoreType>();
+        return MakeUnique<KnnHnsw<PQVecStoreType, LabelType>>(M_, ef_construction_, std::move(compressed_datastore), std::move(distance), 0);
+    }
+
     template <FilterConcept<LabelType> Filter = NoneType, bool WithLock = true>
     Tuple<SizeT, UniquePtr<DistanceType[]>, UniquePtr<LabelType[]>>
     KnnSearch(const QueryVecType &q, SizeT k, const Filter &filter, const KnnSearchOption &option = {}) const {
@@ -440,6 +807,57 @@ public:
         return KnnSearch<NoneType, WithLock>(q, k, None, option);
     }
 
+    // Search `query_n` queries of an embedding column together. The queries descend the upper layers side by side so that
+    // the few upper layer vertices stay in cache, and the enter point of the next query is prefetched while the current
+    // one is searched. The result of each query is the same as KnnSearch.
+    template <FilterConcept<LabelType> Filter = NoneType, bool WithLock = true>
+    Vector<Tuple<SizeT, UniquePtr<DistanceType[]>, UniquePtr<LabelType[]>>>
+    KnnSearchBatch(const QueryVecType *queries, SizeT query_n, SizeT k, const Filter &filter, const KnnSearchOption &option = {}) const {
+        Vector<Tuple<SizeT, UniquePtr<DistanceType[]>, UniquePtr<LabelType[]>>> results(query_n);
+        auto [max_layer, ep] = data_store_.GetEnterPoint();
+        if (ep == -1) {
+            return results;
+        }
+        Vector<QueryType> query_stores;
+        query_stores.reserve(query_n);
+        for (SizeT i = 0; i < query_n; ++i) {
+            query_stores.emplace_back(data_store_.MakeQuery(queries[i]));
+        }
+        Vector<VertexType> enter_points(query_n, ep);
+        for (i32 cur_layer = max_layer; cur_layer > 0; --cur_layer) {
+            for (SizeT i = 0; i < query_n; ++i) {
+                enter_points[i] = SearchLayerNearest<WithLock>(enter_points[i], query_stores[i], cur_layer);
+            }
+        }
+        auto [ef, two_hop] = Layer0SearchParam<Filter>(k, option);
+        for (SizeT i = 0; i < query_n; ++i) {
+            if (i + 1 < query_n) {
+                data_store_.PrefetchVec(enter_points[i + 1]);
+            }
+            const Atomic<f32> *distance_bound = option.distance_bounds_ != nullptr ? option.distance_bounds_ + i : nullptr;
+            auto [result_n, d_ptr, v_ptr] = SearchLayerHelper<WithLock, Filter, LogicalType::kEmbedding>(enter_points[i],
+                                                                                                         query_stores[i],
+                                                                                                         0,
+                                                                                                         ef,
+                                                                                                         filter,
+                                                                                                         two_hop,
+                                                                                                         distance_bound,
+                                                                                                         option.bound_pruned_count_);
+            auto labels = MakeUniqueForOverwrite<LabelType[]>(result_n);
+            for (SizeT j = 0; j < result_n; ++j) {
+                labels[j] = GetLabel(v_ptr[j]);
+            }
+            results[i] = {result_n, std::move(d_ptr), std::move(labels)};
+        }
+        return results;
+    }
+
+    template <bool WithLock = true>
+    Vector<Tuple<SizeT, UniquePtr<DistanceType[]>, UniquePtr<LabelType[]>>>
+    KnnSearchBatch(const QueryVecType *queries, SizeT query_n, SizeT k, const KnnSearchOption &option = {}) const {
+        return KnnSearchBatch<NoneType, WithLock>(queries, query_n, k, None, option);
+    }
+
     // function for test, add sort for convenience
     template <FilterConcept<LabelType> Filter = NoneType, bool WithLock = true>
     Vector<Pair<DistanceType, LabelType>>
@@ -14,7 +14,10 @@
 
 module;
 
+#include <cstring>
 #include <limits>
+#include <sys/mman.h>
+#include <unistd.h>
 #include <utility>
 
 export module hnsw_common;
@@ -31,11 +34,68 @@ export struct HnswConfig {
 
 export constexpr SizeT AlignTo(SizeT a, SizeT b) { return (a + b - 1) / b * b; }
 
+// Applies madvise `advice` to the pages holding the `len` bytes at `data`, a range of a mapped index file.
+// The start is rounded down to its page, the file may be mapped once and shared by the objects packed in it.
+export void AdviseMapped(const void *data, SizeT len, int advice) {
+    if (len == 0) {
+        return;
+    }
+    static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+    uintptr_t begin = reinterpret_cast<uintptr_t>(data) / page_size * page_size;
+    uintptr_t end = reinterpret_cast<uintptr_t>(data) + len;
+    madvise(reinterpret_cast<void *>(begin), end - begin, advice);
+}
+
+// Returns `n` elements of T stored at `ptr` and advances `ptr` past them. The elements are used in place, unless `ptr`
+// is not aligned to `Align`, in which case they are copied into `buffer`.
+export template <typename T, SizeT Align = alignof(T)>
+const T *ViewOrCopy(const char *&ptr, SizeT n, UniquePtr<T[]> &buffer) {
+    const char *data = ptr;
+    ptr += sizeof(T) * n;
+    if (reinterpret_cast<uintptr_t>(data) % Align == 0) {
+        return reinterpret_cast<const T *>(data);
+    }
+    buffer = MakeUniqueForOverwrite<T[]>(n);
+    std::memcpy(static_cast<void *>(buffer.get()), data, sizeof(T) * n);
+    return buffer.get();
+}
+
 export using MeanType = double;
 export using VertexType = i32;
 export using VertexListSize = i32;
 export using LayerSize = i32;
 
+// Visited marks of one graph search. Clearing only bumps the epoch, so each thread keeps one list for all its searches
+// instead of allocating a bitmap of the whole graph per search.
+export class VisitedList {
+public:
+    // The list of the calling thread, cleared for `vertex_n` vertices. Valid until the next call on the same thread.
+    static VisitedList &Local(SizeT vertex_n) {
+        thread_local VisitedList list;
+        list.Reset(vertex_n);
+        return list;
+    }
+
+    void Reset(SizeT vertex_n) {
+        if (tags_.size() < vertex_n) {
+            tags_.assign(vertex_n, 0);
+            epoch_ = 0;
+        }
+        if (++epoch_ == 0) {
+            std::fill(tags_.begin(), tags_.end(), 0);
+            epoch_ = 1;
+        }
+    }
+
+    bool Visited(VertexType vertex_i) const { return tags_[vertex_i] == epoch_; }
+
+    void Visit(VertexType vertex_i) { tags_[vertex_i] = epoch_; }
+
+private:
+    Vector<u8> tags_;
+    u8 epoch_ = 0;
+};
+
 export template <typename Iterator, typename RtnType, typename LabelType>
 concept DataIteratorConcept = requires(Iterator iter) {
     { iter.Next() } -> std::same_as<Optional<Pair<RtnType, LabelType>>>;
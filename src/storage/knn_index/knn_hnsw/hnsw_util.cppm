@@ -28,6 +28,7 @@ namespace infinity {
 export struct HnswOptimizeOptions {
     bool compress_to_lvq = false;
     bool lvq_avg = false;
+    bool merge_chunks = false;
 };
 
 export struct HnswUtil {
@@ -38,12 +39,14 @@ export struct HnswUtil {
                 options.compress_to_lvq = true;
             } else if (IsEqual(param->param_name_, "lvq_avg")) {
                 options.lvq_avg = true;
+            } else if (IsEqual(param->param_name_, "merge_chunks")) {
+                options.merge_chunks = true;
             }
         }
         if (options.compress_to_lvq && options.lvq_avg) {
             RecoverableError(Status::InvalidIndexParam("compress_to_lvq and lvq_avg cannot be set at the same time"));
         }
-        if (!options.compress_to_lvq && !options.lvq_avg) {
+        if (!options.compress_to_lvq && !options.lvq_avg && !options.merge_chunks) {
             return None;
         }
         return options;
@@ -0,0 +1,236 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <bit>
+#include <cstring>
+
+export module maxsim_kernel;
+
+import stl;
+import internal_types;
+import default_values;
+import infinity_exception;
+import logger;
+import mlas_matrix_multiply;
+import simd_functions;
+
+namespace infinity {
+
+// maxsim score of document tensors against one query tensor:
+// sum over query embeddings of the max similarity to an embedding of the document
+// all element type pairs share the interface, a kernel keeps its buffers and is used by one thread
+//  - TensorElemT: f32, f64, f16, bf16, QueryElemT: f32 (aligned)
+//    the documents of a batch are gathered into one matrix and scored by one gemm, then reduced by a simd row max
+//  - TensorElemT: bit, QueryElemT: bit (unaligned), f32, i32, i64 (aligned)
+//  - TensorElemT: u8, QueryElemT: u8 (unaligned)
+//  - TensorElemT: i8, QueryElemT: i8 (unaligned)
+//    every pair of embeddings is scored by the simd inner product of the type
+// the query is cast to QueryElemT before, see GetMatchTensorExprForCalculation
+export template <typename TensorElemT, typename QueryElemT>
+class MaxSimKernel {
+public:
+    static constexpr bool USE_GEMM = std::is_same_v<QueryElemT, f32> && (std::is_same_v<TensorElemT, f32> || std::is_same_v<TensorElemT, f64> ||
+                                                                        std::is_same_v<TensorElemT, Float16T> ||
+                                                                        std::is_same_v<TensorElemT, BFloat16T>);
+    static constexpr bool SUPPORTED =
+        USE_GEMM ||
+        (std::is_same_v<TensorElemT, bool> && (std::is_same_v<QueryElemT, bool> || std::is_same_v<QueryElemT, f32> ||
+                                               std::is_same_v<QueryElemT, i32> || std::is_same_v<QueryElemT, i64>)) ||
+        (std::is_same_v<TensorElemT, u8> && std::is_same_v<QueryElemT, u8>) || (std::is_same_v<TensorElemT, i8> && std::is_same_v<QueryElemT, i8>);
+
+    MaxSimKernel(const char *query_tensor, u32 query_embedding_num, u32 dimension)
+        : query_tensor_(query_tensor), query_embedding_num_(query_embedding_num), dimension_(dimension) {
+        if constexpr (!SUPPORTED) {
+            UnrecoverableError("Unreachable code!");
+        }
+    }
+
+    f32 Score(const char *tensor, u32 embedding_num) {
+        f32 score{};
+        ScoreBatch(&tensor, &embedding_num, 1, &score);
+        return score;
+    }
+
+    // scores[i] is the score of tensors[i], which has embedding_nums[i] embeddings
+    void ScoreBatch(const char *const *tensors, const u32 *embedding_nums, SizeT tensor_num, f32 *scores) {
+        if constexpr (USE_GEMM) {
+            ScoreBatchGemm(tensors, embedding_nums, tensor_num, scores);
+        } else if constexpr (SUPPORTED) {
+            for (SizeT i = 0; i < tensor_num; ++i) {
+                scores[i] = ScorePairwise(tensors[i], embedding_nums[i]);
+            }
+        }
+    }
+
+private:
+    static f32 *Reserve(UniquePtr<f32[]> &buffer, SizeT &capacity, SizeT size) {
+        if (capacity < size) {
+            buffer = MakeUniqueForOverwrite<f32[]>(size);
+            capacity = size;
+        }
+        return buffer.get();
+    }
+
+    void ScoreBatchGemm(const char *const *tensors, const u32 *embedding_nums, SizeT tensor_num, f32 *scores) {
+        const auto row_max_sum_func_ptr = GetSIMD_FUNCTIONS().MaxSimRowMaxSum_func_ptr_;
+        const auto *query_ptr = reinterpret_cast<const f32 *>(query_tensor_);
+        SizeT begin = 0;
+        while (begin < tensor_num) {
+            // documents are added until the batch is full, a document larger than the batch is scored alone
+            SizeT end = begin;
+            SizeT batch_embedding_num = 0;
+            do {
+                batch_embedding_num += embedding_nums[end++];
+            } while (end < tensor_num && batch_embedding_num + embedding_nums[end] <= MAXSIM_BATCH_EMBEDDING_NUM);
+            f32 *score_ptr = Reserve(score_buffer_, score_buffer_size_, query_embedding_num_ * batch_embedding_num);
+            if (batch_embedding_num > 0) {
+                const f32 *batch_ptr = nullptr;
+                if (std::is_same_v<TensorElemT, f32> && end == begin + 1) {
+                    batch_ptr = reinterpret_cast<const f32 *>(tensors[begin]);
+                } else {
+                    f32 *dst = Reserve(doc_buffer_, doc_buffer_size_, batch_embedding_num * dimension_);
+                    batch_ptr = dst;
+                    for (SizeT i = begin; i < end; ++i) {
+                        const SizeT elem_num = static_cast<SizeT>(embedding_nums[i]) * dimension_;
+                        if constexpr (std::is_same_v<TensorElemT, f32>) {
+                            std::memcpy(dst, tensors[i], elem_num * sizeof(f32));
+                        } else {
+                            const auto *src = reinterpret_cast<const TensorElemT *>(tensors[i]);
+                            for (SizeT j = 0; j < elem_num; ++j) {
+                                dst[j] = static_cast<f32>(src[j]);
+                            }
+                        }
+                        dst += elem_num;
+                    }
+                }
+                matrixA_multiply_transpose_matrixB_output_to_C(query_ptr,
+                                                               batch_ptr,
+                                                               query_embedding_num_,
+                                                               batch_embedding_num,
+                                                               dimension_,
+                                                               score_ptr);
+            }
+            // row q of the batch similarity matrix holds query embedding q against all embeddings of the batch
+            SizeT column_offset = 0;
+            for (SizeT i = begin; i < end; ++i) {
+                scores[i] = row_max_sum_func_ptr(score_ptr + column_offset, query_embedding_num_, embedding_nums[i], batch_embedding_num);
+                column_offset += embedding_nums[i];
+            }
+            begin = end;
+        }
+    }
+
+    f32 ScorePairwise(const char *raw_target_tensor_ptr, const u32 target_embedding_num) const {
+        const char *raw_query_tensor_ptr = query_tensor_;
+        const u32 query_embedding_num = query_embedding_num_;
+        const u32 basic_embedding_dimension = dimension_;
+        if constexpr (std::is_same_v<TensorElemT, bool> && std::is_same_v<QueryElemT, bool>) {
+            // TODO: hamming distance?
+            const auto unit_embedding_bytes = basic_embedding_dimension / 8;
+            if (unit_embedding_bytes % 4 == 0) {
+                if (reinterpret_cast<uintptr_t>(raw_query_tensor_ptr) % alignof(u32) == 0 &&
+                    reinterpret_cast<uintptr_t>(raw_target_tensor_ptr) % alignof(u32) == 0) {
+                    const auto u32_cnt = unit_embedding_bytes / 4;
+                    const auto query_tensor_u32_ptr = reinterpret_cast<const u32 *>(raw_query_tensor_ptr);
+                    const auto target_tensor_u32_ptr = reinterpret_cast<const u32 *>(raw_target_tensor_ptr);
+                    u32 maxsim_score = 0;
+                    for (u32 query_i = 0; query_i < query_embedding_num; ++query_i) {
+                        const auto query_ptr = query_tensor_u32_ptr + query_i * u32_cnt;
+                        auto min_score_i = std::numeric_limits<u32>::max();
+                        for (u32 target_j = 0; target_j < target_embedding_num; ++target_j) {
+                            const auto target_ptr = target_tensor_u32_ptr + target_j * u32_cnt;
+                            u32 score_ij = 0;
+                            for (u32 k = 0; k < u32_cnt; ++k) {
+                                score_ij += std::popcount(query_ptr[k] ^ target_ptr[k]);
+                            }
+                            min_score_i = std::min(min_score_i, score_ij);
+                        }
+                        maxsim_score += min_score_i;
+                    }
+                    // hamming distance, higher score means more different
+                    return -static_cast<f32>(maxsim_score);
+                }
+                // memory allocated by new char[] should be aligned to any basic type
+                LOG_ERROR("MaxSimKernel<bool, bool> Score: input tensor is not aligned to int");
+            }
+            const auto query_tensor_ptr = reinterpret_cast<const u8 *>(raw_query_tensor_ptr);
+            const auto target_tensor_ptr = reinterpret_cast<const u8 *>(raw_target_tensor_ptr);
+            u32 maxsim_score = 0;
+            for (u32 query_i = 0; query_i < query_embedding_num; ++query_i) {
+                const auto query_ptr = query_tensor_ptr + query_i * unit_embedding_bytes;
+                auto min_score_i = std::numeric_limits<u32>::max();
+                for (u32 target_j = 0; target_j < target_embedding_num; ++target_j) {
+                    const auto target_ptr = target_tensor_ptr + target_j * unit_embedding_bytes;
+                    u32 score_ij = 0;
+                    for (u32 k = 0; k < unit_embedding_bytes; ++k) {
+                        score_ij += std::popcount(static_cast<u32>(query_ptr[k] ^ target_ptr[k]));
+                    }
+                    min_score_i = std::min(min_score_i, score_ij);
+                }
+                maxsim_score += min_score_i;
+            }
+            // hamming distance, higher score means more different
+            return -static_cast<f32>(maxsim_score);
+        } else {
+            // TensorElemT: bit, QueryElemT: f32, i32, i64, the target is bit packed
+            // TensorElemT: u8, i8, QueryElemT: the same type
+            constexpr bool bit_target = std::is_same_v<TensorElemT, bool>;
+            using TargetT = std::conditional_t<bit_target, u8, TensorElemT>;
+            using ScoreT = std::conditional_t<std::is_same_v<QueryElemT, f32>, f32, std::conditional_t<std::is_same_v<QueryElemT, i64>, i64, i32>>;
+            const auto ip_func_ptr = GetIPFuncPtr();
+            const auto query_tensor_ptr = reinterpret_cast<const QueryElemT *>(raw_query_tensor_ptr);
+            const auto target_tensor_ptr = reinterpret_cast<const TargetT *>(raw_target_tensor_ptr);
+            const auto unit_target_elems = bit_target ? basic_embedding_dimension / 8 : basic_embedding_dimension;
+            ScoreT maxsim_score = 0;
+            for (u32 query_i = 0; query_i < query_embedding_num; ++query_i) {
+                const auto query_ptr = query_tensor_ptr + query_i * basic_embedding_dimension;
+                auto max_score_i = std::numeric_limits<ScoreT>::lowest();
+                for (u32 target_j = 0; target_j < target_embedding_num; ++target_j) {
+                    const auto target_ptr = target_tensor_ptr + target_j * unit_target_elems;
+                    const ScoreT score_ij = ip_func_ptr(query_ptr, target_ptr, basic_embedding_dimension);
+                    max_score_i = std::max(max_score_i, score_ij);
+                }
+                maxsim_score += max_score_i;
+            }
+            return static_cast<f32>(maxsim_score);
+        }
+    }
+
+    static auto GetIPFuncPtr() {
+        if constexpr (std::is_same_v<TensorElemT, bool> && std::is_same_v<QueryElemT, f32>) {
+            return GetSIMD_FUNCTIONS().MaxSimF32BitIP_func_ptr_;
+        } else if constexpr (std::is_same_v<TensorElemT, bool> && std::is_same_v<QueryElemT, i32>) {
+            return GetSIMD_FUNCTIONS().MaxSimI32BitIP_func_ptr_;
+        } else if constexpr (std::is_same_v<TensorElemT, bool> && std::is_same_v<QueryElemT, i64>) {
+            return GetSIMD_FUNCTIONS().MaxSimI64BitIP_func_ptr_;
+        } else if constexpr (std::is_same_v<TensorElemT, u8>) {
+            return GetSIMD_FUNCTIONS().HNSW_U8IP_ptr_;
+        } else {
+            return GetSIMD_FUNCTIONS().HNSW_I8IP_ptr_;
+        }
+    }
+
+    const char *query_tensor_{};
+    u32 query_embedding_num_{};
+    u32 dimension_{};
+
+    UniquePtr<f32[]> doc_buffer_{};
+    SizeT doc_buffer_size_{};
+    UniquePtr<f32[]> score_buffer_{};
+    SizeT score_buffer_size_{};
+};
+
+} // namespace infinity
@@ -73,6 +73,18 @@ public:
 
     i64 total_count() const { return total_count_; }
 
+    // the number of results of the query, valid after End()
+    i64 result_count(u64 query_id) const { return result_counts_[query_id]; }
+
+    // false until topk results of the query are collected, otherwise the current k-th best distance
+    bool GetKthDistance(u64 query_id, DistType &distance) const {
+        if (static_cast<i64>(result_handler_->GetSize(query_id)) < topk_) {
+            return false;
+        }
+        distance = result_handler_->GetDistance0(query_id);
+        return true;
+    }
+
 private:
     i64 total_count_{};
     bool begin_{false};
@@ -80,6 +92,7 @@ private:
     i64 topk_{};
     UniquePtr<RowID[]> idx_array_{};
     UniquePtr<DistType[]> distance_array_{};
+    Vector<i64> result_counts_{};
 
 private:
     UniquePtr<ResultHandler> result_handler_{};
@@ -174,6 +187,10 @@ void MergeKnn<QueryElemType, C, DistType>::End() {
     if (!this->begin_)
         return;
 
+    result_counts_.resize(query_count_);
+    for (u64 i = 0; i < query_count_; ++i) {
+        result_counts_[i] = result_handler_->GetSize(i);
+    }
     result_handler_->End();
 
     this->begin_ = false;
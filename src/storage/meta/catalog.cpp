@@ -553,7 +553,10 @@ UniquePtr<CatalogDeltaEntry> Catalog::LoadFromFileDelta(const DeltaCatalogFileIn
     const auto &catalog_path = delta_ckp_info.path_;
 
     if(!VirtualStore::Exists(catalog_path)){
-        VirtualStore::DownloadObject(catalog_path, catalog_path);
+        Status download_status = VirtualStore::DownloadObject(catalog_path, catalog_path);
+        if (!download_status.ok()) {
+            UnrecoverableError(download_status.message());
+        }
     }
 
     auto [catalog_file_handle, status] = VirtualStore::Open(catalog_path, FileAccessMode::kRead);
@@ -952,7 +955,10 @@ UniquePtr<Catalog> Catalog::LoadFromFile(const FullCatalogFileInfo &full_ckp_inf
     const auto &catalog_path = Path(InfinityContext::instance().config()->DataDir()) / full_ckp_info.path_;
 
     if(!VirtualStore::Exists(catalog_path)){
-        VirtualStore::DownloadObject(catalog_path, catalog_path);
+        Status download_status = VirtualStore::DownloadObject(catalog_path, catalog_path);
+        if (!download_status.ok()) {
+            UnrecoverableError(download_status.message());
+        }
     }
 
     auto [catalog_file_handle, status] = VirtualStore::Open(catalog_path, FileAccessMode::kRead);
@@ -1023,7 +1029,10 @@ void Catalog::SaveFullCatalog(TxnTimeStamp max_commit_ts, String &full_catalog_p
     // Rename temp file to regular catalog file
     VirtualStore::Rename(catalog_tmp_path, full_path);
     if(InfinityContext::instance().GetServerRole() == NodeRole::kLeader){
-        VirtualStore::UploadObject(full_path, full_path);
+        Status upload_status = VirtualStore::UploadObject(full_path, full_path);
+        if (!upload_status.ok()) {
+            UnrecoverableError(upload_status.message());
+        }
     }
 
     global_catalog_delta_entry_->InitFullCheckpointTs(max_commit_ts);
@@ -1111,7 +1120,10 @@ bool Catalog::SaveDeltaCatalog(TxnTimeStamp last_ckp_ts, TxnTimeStamp &max_commi
     out_file_handle->Append((reinterpret_cast<const char *>(buf.data())), act_size);
     out_file_handle->Sync();
     if(InfinityContext::instance().GetServerRole() == NodeRole::kLeader){
-        VirtualStore::UploadObject(full_path, full_path);
+        Status upload_status = VirtualStore::UploadObject(full_path, full_path);
+        if (!upload_status.ok()) {
+            UnrecoverableError(upload_status.message());
+        }
     }
     // {
     // log for delta op debug
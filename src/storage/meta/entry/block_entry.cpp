@@ -97,12 +97,18 @@ BlockEntry::NewBlockEntry(const SegmentEntry *segment_entry, BlockID block_id, T
 
     block_entry->block_dir_ = BlockEntry::DetermineDir(*segment_entry->segment_dir(), block_id);
     block_entry->columns_.reserve(column_count);
+    Vector<SharedPtr<DataType>> zone_map_types;
     for (SizeT column_idx = 0; column_idx < column_count; ++column_idx) {
         const SharedPtr<ColumnDef> column_def = table_entry->column_defs()[column_idx];
         ColumnID column_id = column_def->id();
         auto column_entry = BlockColumnEntry::NewBlockColumnEntry(block_entry.get(), column_id, txn);
         block_entry->columns_.emplace_back(std::move(column_entry));
+        if (zone_map_types.size() <= column_id) {
+            zone_map_types.resize(column_id + 1);
+        }
+        zone_map_types[column_id] = column_def->type();
     }
+    block_entry->zone_map_.Init(zone_map_types);
 
     auto *buffer_mgr = txn->buffer_mgr();
     auto version_file_worker = MakeUnique<VersionFileWorker>(MakeShared<String>(InfinityContext::instance().config()->DataDir()),
@@ -301,6 +307,7 @@ u16 BlockEntry::AppendData(TransactionID txn_id,
     SizeT column_count = this->columns_.size();
     for (SizeT column_id = 0; column_id < column_count; ++column_id) {
         this->columns_[column_id]->Append(input_data_block->column_vectors[column_id].get(), input_block_offset, actual_copied, buffer_mgr);
+        zone_map_.Update(this->columns_[column_id]->column_id(), *input_data_block->column_vectors[column_id], input_block_offset, actual_copied);
 
         LOG_TRACE(fmt::format("Segment: {}, Block: {}, Column: {} is appended with {} rows",
                               this->segment_entry_->segment_id(),
@@ -309,6 +316,7 @@ u16 BlockEntry::AppendData(TransactionID txn_id,
                               actual_copied));
     }
 
+    zone_map_.FinishAppend(this->block_row_count_, actual_copied);
     this->block_row_count_ += actual_copied;
 
     auto block_version_handle = version_buffer_object_->Load();
@@ -615,7 +623,9 @@ void BlockEntry::AppendBlock(const Vector<ColumnVector> &column_vectors, SizeT r
     }
     for (ColumnID column_id = 0; column_id < columns_.size(); ++column_id) {
         columns_[column_id]->Append(&column_vectors[column_id], row_begin, read_size, buffer_mgr);
+        zone_map_.Update(columns_[column_id]->column_id(), column_vectors[column_id], row_begin, read_size);
     }
+    zone_map_.FinishAppend(block_row_count_, read_size);
     IncreaseRowCount(read_size);
 }
 
@@ -30,6 +30,7 @@ import base_entry;
 import block_column_entry;
 import block_version;
 import fast_rough_filter;
+import block_zone_map;
 import value;
 import buffer_obj;
 import wal_entry;
@@ -154,6 +155,8 @@ public:
 
     const FastRoughFilter *GetFastRoughFilter() const { return fast_rough_filter_.get(); }
 
+    const BlockZoneMap &zone_map() const { return zone_map_; }
+
     SizeT row_count(TxnTimeStamp check_ts) const;
 
     // Get visible range of the BlockEntry since the given row number for a txn
@@ -209,6 +212,9 @@ protected:
     // check if a value must not exist in the block
     SharedPtr<FastRoughFilter> fast_rough_filter_ = MakeShared<FastRoughFilter>();
 
+    // min / max of the appended rows, usable before the block is sealed
+    BlockZoneMap zone_map_{};
+
     TxnTimeStamp min_row_ts_{UNCOMMIT_TS}; // Indicate the commit_ts which create this BlockEntry
     TxnTimeStamp max_row_ts_{0};           // Indicate the max commit_ts which create/update/delete data inside this BlockEntry
     TxnTimeStamp checkpoint_ts_{0};        // replay not set
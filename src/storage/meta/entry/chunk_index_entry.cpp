@@ -37,11 +37,13 @@ import buffer_obj;
 import buffer_handle;
 import infinity_exception;
 import index_defines;
+import small_float;
 import virtual_store;
 import secondary_index_file_worker;
 import ivf_index_file_worker;
 import emvb_index_file_worker;
 import bmp_index_file_worker;
+import diskann_index_file_worker;
 import column_def;
 import internal_types;
 import infinity_context;
@@ -213,6 +215,32 @@ SharedPtr<ChunkIndexEntry> ChunkIndexEntry::NewIVFIndexChunkIndexEntry(ChunkID c
     return chunk_index_entry;
 }
 
+SharedPtr<ChunkIndexEntry> ChunkIndexEntry::NewDiskAnnIndexChunkIndexEntry(ChunkID chunk_id,
+                                                                           SegmentIndexEntry *segment_index_entry,
+                                                                           const String &base_name,
+                                                                           RowID base_rowid,
+                                                                           u32 row_count,
+                                                                           BufferManager *buffer_mgr) {
+    auto chunk_index_entry = MakeShared<ChunkIndexEntry>(chunk_id, segment_index_entry, base_name, base_rowid, row_count);
+    const auto &index_dir = segment_index_entry->index_dir();
+    assert(index_dir.get() != nullptr);
+    if (buffer_mgr != nullptr) {
+        const SegmentID segment_id = segment_index_entry->segment_id();
+        auto diskann_index_file_name = MakeShared<String>(IndexFileName(segment_id, chunk_id));
+        const auto &index_base = segment_index_entry->table_index_entry()->table_index_def();
+        const auto &column_def = segment_index_entry->table_index_entry()->column_def();
+        auto file_worker = MakeUnique<DiskAnnIndexFileWorker>(MakeShared<String>(InfinityContext::instance().config()->DataDir()),
+                                                              MakeShared<String>(InfinityContext::instance().config()->TempDir()),
+                                                              index_dir,
+                                                              diskann_index_file_name,
+                                                              index_base,
+                                                              column_def,
+                                                              buffer_mgr->persistence_manager());
+        chunk_index_entry->buffer_obj_ = buffer_mgr->AllocateBufferObject(std::move(file_worker));
+    }
+    return chunk_index_entry;
+}
+
 SharedPtr<ChunkIndexEntry> ChunkIndexEntry::NewEMVBIndexChunkIndexEntry(ChunkID chunk_id,
                                                                         SegmentIndexEntry *segment_index_entry,
                                                                         const String &base_name,
@@ -349,6 +377,19 @@ SharedPtr<ChunkIndexEntry> ChunkIndexEntry::NewReplayChunkIndexEntry(ChunkID chu
             chunk_index_entry->buffer_obj_ = buffer_mgr->GetBufferObject(std::move(file_worker));
             break;
         }
+        case IndexType::kDiskAnn: {
+            const SegmentID segment_id = segment_index_entry->segment_id();
+            auto diskann_index_file_name = MakeShared<String>(IndexFileName(segment_id, chunk_id));
+            auto file_worker = MakeUnique<DiskAnnIndexFileWorker>(MakeShared<String>(InfinityContext::instance().config()->DataDir()),
+                                                                  MakeShared<String>(InfinityContext::instance().config()->TempDir()),
+                                                                  index_dir,
+                                                                  std::move(diskann_index_file_name),
+                                                                  index_base,
+                                                                  column_def,
+                                                                  buffer_mgr->persistence_manager());
+            chunk_index_entry->buffer_obj_ = buffer_mgr->GetBufferObject(std::move(file_worker));
+            break;
+        }
         case IndexType::kBMP: {
             const SegmentID segment_id = segment_index_entry->segment_id();
             auto index_file_name = MakeShared<String>(IndexFileName(segment_id, chunk_id));
@@ -383,6 +424,20 @@ u64 ChunkIndexEntry::GetColumnLengthSum() const {
     return column_length_sum;
 }
 
+SharedPtr<Vector<u8>> ChunkIndexEntry::GetQuantizedNorms() {
+    std::lock_guard<std::mutex> lock(norms_mutex_);
+    if (quantized_norms_.get() == nullptr) {
+        BufferHandle buffer_handle = buffer_obj_->Load();
+        const u32 *column_lengths = (const u32 *)buffer_handle.GetData();
+        auto norms = MakeShared<Vector<u8>>(row_count_);
+        for (SizeT i = 0; i < row_count_; i++) {
+            (*norms)[i] = SmallFloat::IntToByte4(column_lengths[i]);
+        }
+        quantized_norms_ = std::move(norms);
+    }
+    return quantized_norms_;
+}
+
 BufferHandle ChunkIndexEntry::GetIndex() { return buffer_obj_->Load(); }
 
 nlohmann::json ChunkIndexEntry::Serialize() {
@@ -83,6 +83,13 @@ public:
                                                                  u32 row_count,
                                                                  BufferManager *buffer_mgr);
 
+    static SharedPtr<ChunkIndexEntry> NewDiskAnnIndexChunkIndexEntry(ChunkID chunk_id,
+                                                                     SegmentIndexEntry *segment_index_entry,
+                                                                     const String &base_name,
+                                                                     RowID base_rowid,
+                                                                     u32 row_count,
+                                                                     BufferManager *buffer_mgr);
+
     static SharedPtr<ChunkIndexEntry> NewEMVBIndexChunkIndexEntry(ChunkID chunk_id,
                                                                   SegmentIndexEntry *segment_index_entry,
                                                                   const String &base_name,
@@ -116,6 +123,10 @@ public:
     // Only for fulltext
     u64 GetColumnLengthSum() const;
 
+    // Only for fulltext. Column lengths quantized to one byte each, built from the column length file on first use
+    // and kept resident in place of it.
+    SharedPtr<Vector<u8>> GetQuantizedNorms();
+
     inline u32 GetPartNum() const { return (row_count_ + 8191) / 8192; }
 
     inline u32 GetPartRowCount(const u32 part_id) const { return std::min<u32>(8192, row_count_ - part_id * 8192); }
@@ -162,6 +173,9 @@ public:
 private:
     BufferObj *buffer_obj_{};
     Vector<BufferObj *> part_buffer_objs_;
+
+    std::mutex norms_mutex_{};
+    SharedPtr<Vector<u8>> quantized_norms_{};
 };
 
 } // namespace infinity
@@ -92,6 +92,7 @@ SegmentEntry::SegmentEntry(const SegmentEntry &other)
         status_ = other.status_;
         delete_txns_ = other.delete_txns_;
     }
+    scan_count_ = other.scan_count_.load();
 }
 
 UniquePtr<SegmentEntry> SegmentEntry::Clone(TableEntry *table_entry) const {
@@ -208,6 +208,11 @@ public:
 
     SharedPtr<BlockEntry> GetBlockEntryByID(BlockID block_id) const;
 
+    // scan statistics, used by compaction to find hot segments. Counted once per table, knn, match tensor or fulltext scan of the segment
+    void IncreaseScanCount() const { scan_count_.fetch_add(1, std::memory_order_relaxed); }
+
+    u64 scan_count() const { return scan_count_.load(std::memory_order_relaxed); }
+
     BlocksGuard GetBlocksGuard() const { return BlocksGuard{block_entries_, std::shared_lock(rw_locker_)}; }
 
 public:
@@ -270,6 +275,8 @@ private:
 
     HashSet<TransactionID> delete_txns_; // current number of delete txn that write this segment
 
+    mutable atomic_u64 scan_count_{0}; // not persisted
+
 public:
     void Cleanup(CleanupInfoTracer *info_tracer = nullptr, bool dropped = true) override;
 
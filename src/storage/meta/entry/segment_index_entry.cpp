@@ -16,6 +16,7 @@ module;
 
 #include <cassert>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 module segment_index_entry;
@@ -60,6 +61,7 @@ import txn_store;
 import secondary_index_in_mem;
 import ivf_index_data_in_mem;
 import ivf_index_data;
+import diskann_index_in_chunk;
 import emvb_index;
 import emvb_index_in_mem;
 import bmp_util;
@@ -273,9 +275,8 @@ void SegmentIndexEntry::MemIndexInsert(SharedPtr<BlockEntry> block_entry,
             break;
         }
         case IndexType::kDiskAnn: {
-            UniquePtr<String> err_msg =
-                MakeUnique<String>(fmt::format("{} realtime index is not supported yet", IndexInfo::IndexTypeToString(index_base->index_type_)));
-            LOG_WARN(*err_msg);
+            // no realtime index, appended rows are scanned brute force until optimize rebuilds the segment index
+            LOG_TRACE(fmt::format("{} realtime index is not supported yet", IndexInfo::IndexTypeToString(index_base->index_type_)));
             break;
         }
         default: {
@@ -534,10 +535,18 @@ void SegmentIndexEntry::PopulateEntirely(const SegmentEntry *segment_entry, Txn
             dumped_memindex_entry = MemIndexDump();
             break;
         }
-        case IndexType::kDiskAnn: { // TODO
-            UniquePtr<String> err_msg =
-                MakeUnique<String>(fmt::format("{} PopulateEntirely is not supported yet", IndexInfo::IndexTypeToString(index_base->index_type_)));
-            LOG_WARN(*err_msg);
+        case IndexType::kDiskAnn: {
+            const u32 row_count = segment_entry->row_count();
+            if (row_count == 0) {
+                break;
+            }
+            SharedPtr<ChunkIndexEntry> diskann_chunk_index_entry = CreateDiskAnnIndexChunkIndexEntry(base_row_id, row_count, buffer_mgr);
+            this->AddChunkIndexEntry(diskann_chunk_index_entry);
+            BufferHandle handle = diskann_chunk_index_entry->GetIndex();
+            auto data_ptr = static_cast<DiskAnnIndexInChunk *>(handle.GetDataMut());
+            data_ptr->BuildDiskAnnIndex(base_row_id, row_count, segment_entry, column_def, buffer_mgr);
+            diskann_chunk_index_entry->SaveIndexFile();
+            dumped_memindex_entry = std::move(diskann_chunk_index_entry);
             break;
         }
         default: {
@@ -707,19 +716,24 @@ void SegmentIndexEntry::OptIndex(IndexBase *index_base,
                         if constexpr (std::is_same_v<T, std::nullptr_t>) {
                             UnrecoverableError("Invalid index type.");
                         } else {
-                            using HnswIndexDataType = typename std::remove_pointer_t<T>::DataType;
-                            if (params->compress_to_lvq) {
-                                if constexpr (IsAnyOf<HnswIndexDataType, i8, u8>) {
+                            using HnswIndexT = std::remove_pointer_t<T>;
+                            using HnswIndexDataType = typename HnswIndexT::DataType;
+                            if constexpr (IsAnyOf<HnswIndexDataType, i8, u8>) {
+                                if (params->compress_to_lvq) {
                                     UnrecoverableError("Invalid index type.");
-                                } else {
-                                    auto *p = std::move(*index).CompressToLVQ().release();
+                                }
+                            } else {
+                                // A chunk may be searched in place from its index file, which is rewritten below. The optimized
+                                // index is built on the heap and replaces the old one.
+                                if (params->compress_to_lvq || (params->lvq_avg && HnswIndexT::kIsLVQ)) {
+                                    auto *p = std::as_const(*index).CompressToLVQ().release();
                                     delete index;
                                     *abstract_hnsw = p;
+                                    if (params->lvq_avg) {
+                                        p->Optimize();
+                                    }
                                 }
                             }
-                            if (params->lvq_avg) {
-                                index->Optimize();
-                            }
                         }
                     },
                     *abstract_hnsw);
@@ -805,7 +819,7 @@ void SegmentIndexEntry::ReplaceChunkIndexEntries(TxnTableStore *txn_table_store,
     txn_index_store->optimize_data_.emplace_back(this, merged_chunk_index_entry.get(), std::move(old_chunks));
 }
 
-ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_table_store, SegmentEntry *segment_entry) {
+ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_table_store, SegmentEntry *segment_entry, bool merge_hnsw_graph) {
     const auto &index_name = *table_index_entry_->GetIndexName();
     if (!TrySetOptimizing()) {
         LOG_INFO(fmt::format("Index {} segment {} is optimizing, skip optimize.", index_name, segment_id_));
@@ -828,6 +842,7 @@ ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_
     Vector<ChunkIndexEntry *> old_chunks;
     Vector<ChunkID> old_ids;
     u32 row_count = 0;
+    const u32 segment_row_count = segment_entry->row_count(begin_ts);
     {
         std::shared_lock lock(rw_locker_);
         for (const auto &chunk_index_entry : chunk_index_entries_) {
@@ -837,7 +852,13 @@ ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_
                 old_ids.push_back(chunk_index_entry->chunk_id_);
             }
         }
-        if (old_chunks.size() <= 1) { // TODO
+        if (index_base->index_type_ == IndexType::kDiskAnn) {
+            // a graph takes no appended rows, the segment is rebuilt once it has rows past its chunks
+            if (row_count >= segment_row_count) {
+                return nullptr;
+            }
+            row_count = segment_row_count;
+        } else if (old_chunks.size() <= 1) { // TODO
             return nullptr;
         }
     }
@@ -846,6 +867,11 @@ ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_
     switch (index_base->index_type_) {
         case IndexType::kHnsw: {
             auto memory_hnsw_index = HnswIndexInMem::Make(base_rowid, index_base, column_def.get(), this);
+            if (merge_hnsw_graph) {
+                memory_hnsw_index->MergeChunks(segment_entry, buffer_mgr, column_def->id(), begin_ts, row_count, old_chunks);
+                merged_chunk_index_entry = memory_hnsw_index->Dump(this, buffer_mgr);
+                break;
+            }
             const AbstractHnsw &abstract_hnsw = memory_hnsw_index->get();
 
             std::visit(
@@ -863,6 +889,8 @@ ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_
                     }
                 },
                 abstract_hnsw);
+            // the rebuilt graph still has a vertex for every deleted row, the background optimize repairs it the same as a merge
+            memory_hnsw_index->RepairDeleted(segment_entry, begin_ts, row_count);
             merged_chunk_index_entry = memory_hnsw_index->Dump(this, buffer_mgr);
             break;
         }
@@ -910,6 +938,14 @@ ChunkIndexEntry *SegmentIndexEntry::RebuildChunkIndexEntries(TxnTableStore *txn_
             data_ptr->BuildIVFIndex(base_rowid, row_count, segment_entry, column_def, buffer_mgr);
             break;
         }
+        case IndexType::kDiskAnn: {
+            // rebuild, with the appended rows
+            merged_chunk_index_entry = CreateDiskAnnIndexChunkIndexEntry(base_rowid, row_count, buffer_mgr);
+            BufferHandle handle = merged_chunk_index_entry->GetIndex();
+            auto data_ptr = static_cast<DiskAnnIndexInChunk *>(handle.GetDataMut());
+            data_ptr->BuildDiskAnnIndex(base_rowid, row_count, segment_entry, column_def, buffer_mgr);
+            break;
+        }
         default: {
             String error_message = "RebuildChunkIndexEntries is not supported for this index type.";
             UnrecoverableError(error_message);
@@ -954,6 +990,11 @@ SharedPtr<ChunkIndexEntry> SegmentIndexEntry::CreateIVFIndexChunkIndexEntry(RowI
     return ChunkIndexEntry::NewIVFIndexChunkIndexEntry(chunk_id, this, "", base_rowid, row_count, buffer_mgr);
 }
 
+SharedPtr<ChunkIndexEntry> SegmentIndexEntry::CreateDiskAnnIndexChunkIndexEntry(RowID base_rowid, u32 row_count, BufferManager *buffer_mgr) {
+    ChunkID chunk_id = this->GetNextChunkID();
+    return ChunkIndexEntry::NewDiskAnnIndexChunkIndexEntry(chunk_id, this, "", base_rowid, row_count, buffer_mgr);
+}
+
 SharedPtr<ChunkIndexEntry> SegmentIndexEntry::CreateEMVBIndexChunkIndexEntry(RowID base_rowid, u32 row_count, BufferManager *buffer_mgr) {
     ChunkID chunk_id = this->GetNextChunkID();
     return ChunkIndexEntry::NewEMVBIndexChunkIndexEntry(chunk_id, this, "", base_rowid, row_count, buffer_mgr);
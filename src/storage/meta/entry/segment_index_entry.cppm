@@ -167,7 +167,8 @@ public:
                                   SharedPtr<ChunkIndexEntry> merged_chunk_index_entry,
                                   Vector<ChunkIndexEntry *> old_chunks);
 
-    ChunkIndexEntry *RebuildChunkIndexEntries(TxnTableStore *txn_table_store, SegmentEntry *segment_entry);
+    // merge_hnsw_graph: build hnsw index from the graph of old chunks instead of inserting all vectors again
+    ChunkIndexEntry *RebuildChunkIndexEntries(TxnTableStore *txn_table_store, SegmentEntry *segment_entry, bool merge_hnsw_graph = false);
 
     BaseMemIndex *GetMemIndex() const;
 
@@ -186,6 +187,12 @@ public:
         return {chunk_index_entries_, memory_ivf_index_};
     }
 
+    // diskann has no memory index, rows behind the last chunk are not indexed
+    Vector<SharedPtr<ChunkIndexEntry>> GetDiskAnnIndexSnapshot() {
+        std::shared_lock lock(rw_locker_);
+        return chunk_index_entries_;
+    }
+
     Tuple<Vector<SharedPtr<ChunkIndexEntry>>, SharedPtr<SecondaryIndexInMem>> GetSecondaryIndexSnapshot() {
         std::shared_lock lock(rw_locker_);
         return {chunk_index_entries_, memory_secondary_index_};
@@ -216,6 +223,8 @@ public:
 
     SharedPtr<ChunkIndexEntry> CreateIVFIndexChunkIndexEntry(RowID base_rowid, u32 row_count, BufferManager *buffer_mgr);
 
+    SharedPtr<ChunkIndexEntry> CreateDiskAnnIndexChunkIndexEntry(RowID base_rowid, u32 row_count, BufferManager *buffer_mgr);
+
     SharedPtr<ChunkIndexEntry> CreateEMVBIndexChunkIndexEntry(RowID base_rowid, u32 row_count, BufferManager *buffer_mgr);
 
     SharedPtr<ChunkIndexEntry> CreateBMPIndexChunkIndexEntry(RowID base_rowid, u32 row_count, BufferManager *buffer_mgr, SizeT index_size);
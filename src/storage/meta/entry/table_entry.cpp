@@ -115,7 +115,9 @@ TableEntry::TableEntry(bool is_delete,
 
     // this->SetCompactionAlg(nullptr);
     if (!is_delete) {
-        this->SetCompactionAlg(MakeUnique<DBTCompactionAlg>(DBT_COMPACTION_M, DBT_COMPACTION_C, DBT_COMPACTION_S, DEFAULT_SEGMENT_CAPACITY, this));
+        DBTRewriteConfig rewrite_config{DBT_REWRITE_DELETE_RATIO, DBT_REWRITE_MIN_DELETE_ROWS, DBT_REWRITE_MAX_RUNNING, DBT_REWRITE_ROWS_PER_SEC};
+        this->SetCompactionAlg(
+            MakeUnique<DBTCompactionAlg>(DBT_COMPACTION_M, DBT_COMPACTION_C, DBT_COMPACTION_S, DEFAULT_SEGMENT_CAPACITY, this, rewrite_config));
         compaction_alg_->Enable({});
     }
 }
@@ -409,7 +411,8 @@ void TableEntry::Import(SharedPtr<SegmentEntry> segment_entry, Txn *txn) {
             case IndexType::kEMVB:
             case IndexType::kIVF:
             case IndexType::kHnsw:
-            case IndexType::kBMP: {
+            case IndexType::kBMP:
+            case IndexType::kDiskAnn: {
                 // support realtime index
                 break;
             }
@@ -999,7 +1002,8 @@ void TableEntry::OptimizeIndex(Txn *txn) {
             case IndexType::kIVF:
             case IndexType::kEMVB:
             case IndexType::kSecondary:
-            case IndexType::kBMP: {
+            case IndexType::kBMP:
+            case IndexType::kDiskAnn: {
                 TxnTimeStamp begin_ts = txn->BeginTS();
                 Map<SegmentID, SharedPtr<SegmentIndexEntry>> index_by_segment = table_index_entry->GetIndexBySegmentSnapshot(this, txn);
                 for (auto &[segment_id, segment_index_entry] : index_by_segment) {
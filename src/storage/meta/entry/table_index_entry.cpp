@@ -38,6 +38,7 @@ import embedding_info;
 import block_entry;
 import segment_entry;
 import table_entry;
+import txn;
 import infinity_context;
 
 namespace infinity {
@@ -303,7 +304,8 @@ SharedPtr<SegmentIndexEntry> TableIndexEntry::PopulateEntirely(SegmentEntry *seg
         case IndexType::kEMVB:
         case IndexType::kFullText:
         case IndexType::kSecondary:
-        case IndexType::kBMP: {
+        case IndexType::kBMP:
+        case IndexType::kDiskAnn: {
             break;
         }
         default: {
@@ -467,6 +469,17 @@ void TableIndexEntry::OptIndex(TxnTableStore *txn_table_store, const Vector<Uniq
                     segment_index_entry->OptIndex(hnsw_index, txn_table_store, opt_params, false /*replay*/);
                 }
             }
+            if (params->merge_chunks && !replay) {
+                // the merged chunk is recorded by its own index dump wal
+                TxnTimeStamp begin_ts = txn_table_store->GetTxn()->BeginTS();
+                TableEntry *table_entry = txn_table_store->GetTableEntry();
+                for (const auto &[segment_id, segment_index_entry] : index_by_segment_) {
+                    SegmentEntry *segment_entry = table_entry->GetSegmentByID(segment_id, begin_ts).get();
+                    if (segment_entry != nullptr) {
+                        segment_index_entry->RebuildChunkIndexEntries(txn_table_store, segment_entry, true /*merge_hnsw_graph*/);
+                    }
+                }
+            }
             break;
         }
         default: {
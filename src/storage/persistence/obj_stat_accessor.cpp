@@ -46,7 +46,7 @@ ObjStat *ObjectStatMap::Get(const String &key) {
     LRUListIter lru_iter = map_iter->second;
     ObjStat *obj_stat = &lru_iter->obj_stat_;
     if (obj_stat->ref_count_ == 0) {
-        using_list_.splice(using_list_.begin(), lru_list_, lru_iter);
+        MoveTo(lru_iter, LRUListType::kUsing);
     }
     ++obj_stat->ref_count_;
     return obj_stat;
@@ -74,7 +74,7 @@ Pair<bool, ObjStat *> ObjectStatMap::Release(const String &key) {
     if (obj_stat->ref_count_ > 0) {
         return {false, obj_stat};
     }
-    lru_list_.splice(lru_list_.begin(), using_list_, lru_iter);
+    MoveTo(lru_iter, LRUListType::kLRU);
     return {true, obj_stat};
 }
 
@@ -99,7 +99,10 @@ void ObjectStatMap::Recover(const String &key) {
     if (obj_stat.ref_count_ > 0) {
         UnrecoverableError(fmt::format("Recover object {} ref count is {}", key, lru_iter->obj_stat_.ref_count_));
     }
-    lru_list_.splice(lru_list_.begin(), cleanuped_list_, lru_iter);
+    if (lru_iter->list_type_ != LRUListType::kCleanuped) {
+        UnrecoverableError(fmt::format("Recover object {} not in cleanuped list", key));
+    }
+    MoveTo(lru_iter, LRUListType::kLRU);
     if (obj_stat.cached_) {
         UnrecoverableError(fmt::format("Recover object {} not cleaned", key));
     }
@@ -116,16 +119,12 @@ Optional<ObjStat> ObjectStatMap::Invalidate(const String &key) {
     if (obj_stat.ref_count_ > 0) {
         UnrecoverableError(fmt::format("Invalidate object {} ref count is {}", key, obj_stat.ref_count_));
     }
-    if (obj_stat.cached_) {
-        lru_list_.erase(lru_iter);
-    } else {
-        cleanuped_list_.erase(lru_iter);
-    }
+    List(lru_iter->list_type_).erase(lru_iter);
     obj_map_.erase(map_iter);
     return obj_stat;
 }
 
-LRUListEntry *ObjectStatMap::EnvictLast() {
+LRUListEntry *ObjectStatMap::EnvictLast(SizeT &envicted_size) {
     if (lru_list_.empty()) {
         return nullptr;
     }
@@ -134,14 +133,35 @@ LRUListEntry *ObjectStatMap::EnvictLast() {
     if (obj_stat.ref_count_ > 0) {
         UnrecoverableError(fmt::format("EnvictLast object {} ref count is {}", lru_iter->key_, obj_stat.ref_count_));
     }
-    if (!obj_stat.cached_) {
-        UnrecoverableError(fmt::format("EnvictLast object {} is already cleaned", lru_iter->key_));
-    }
+    // An object is envicted with the ranges of it that were downloaded, they share one local file
+    envicted_size = obj_stat.CachedSize();
     obj_stat.cached_ = false;
-    cleanuped_list_.splice(cleanuped_list_.begin(), lru_list_, lru_iter);
+    obj_stat.cached_ranges_.clear();
+    MoveTo(lru_iter, LRUListType::kCleanuped);
     return &(*lru_iter);
 }
 
+ObjectStatMap::LRUList &ObjectStatMap::List(LRUListType list_type) {
+    switch (list_type) {
+        case LRUListType::kLRU: {
+            return lru_list_;
+        }
+        case LRUListType::kUsing: {
+            return using_list_;
+        }
+        case LRUListType::kCleanuped: {
+            return cleanuped_list_;
+        }
+    }
+    UnrecoverableError("Invalid lru list type");
+    return lru_list_;
+}
+
+void ObjectStatMap::MoveTo(LRUListIter lru_iter, LRUListType list_type) {
+    List(list_type).splice(List(list_type).begin(), List(lru_iter->list_type_), lru_iter);
+    lru_iter->list_type_ = list_type;
+}
+
 // ObjectStatAccessor_LocalStorage
 
 ObjectStatAccessor_LocalStorage::~ObjectStatAccessor_LocalStorage() {
@@ -262,10 +282,10 @@ ObjStat *ObjectStatAccessor_ObjectStorage::Get(const String &key) {
     if (obj_stat == nullptr) {
         return nullptr;
     }
-    if (disk_used_ < obj_stat->obj_size_) {
-        UnrecoverableError(fmt::format("Object {} size {} is larger than disk used {}", key, obj_stat->obj_size_, disk_used_));
+    if (disk_used_ < obj_stat->CachedSize()) {
+        UnrecoverableError(fmt::format("Object {} size {} is larger than disk used {}", key, obj_stat->CachedSize(), disk_used_));
     }
-    disk_used_ -= obj_stat->obj_size_;
+    disk_used_ -= obj_stat->CachedSize();
     return obj_stat;
 }
 
@@ -276,7 +296,8 @@ ObjStat *ObjectStatAccessor_ObjectStorage::Release(const String &key, Vector<Str
     if (!release_ok) {
         return obj_stat;
     }
-    disk_used_ += obj_stat->obj_size_;
+    // ranges downloaded while the object was in use are counted from now on
+    disk_used_ += obj_stat->CachedSize();
     if (disk_used_ > disk_capacity_limit_) {
         Envict(drop_keys);
     }
@@ -284,8 +305,8 @@ ObjStat *ObjectStatAccessor_ObjectStorage::Release(const String &key, Vector<Str
 }
 
 void ObjectStatAccessor_ObjectStorage::PutNew(const String &key, ObjStat obj_stat, Vector<String> &drop_keys) {
+    disk_used_ += obj_stat.CachedSize();
     obj_map_.PutNew(key, std::move(obj_stat));
-    disk_used_ += obj_stat.obj_size_;
     if (disk_used_ > disk_capacity_limit_) {
         Envict(drop_keys);
     }
@@ -298,7 +319,7 @@ Optional<ObjStat> ObjectStatAccessor_ObjectStorage::Invalidate(const String &key
     if (!obj_stat.has_value()) {
         return None;
     }
-    disk_used_ -= obj_stat->obj_size_;
+    disk_used_ -= obj_stat->CachedSize();
     return obj_stat;
 }
 
@@ -347,12 +368,13 @@ HashMap<String, ObjStat> ObjectStatAccessor_ObjectStorage::GetAllObjects() const
 
 bool ObjectStatAccessor_ObjectStorage::Envict(Vector<String> &drop_keys) {
     while (disk_used_ > disk_capacity_limit_) {
-        LRUListEntry *lru_entry = obj_map_.EnvictLast();
+        SizeT envicted_size = 0;
+        LRUListEntry *lru_entry = obj_map_.EnvictLast(envicted_size);
         if (lru_entry == nullptr) {
             break;
         }
         drop_keys.push_back(lru_entry->key_);
-        disk_used_ -= lru_entry->obj_stat_.obj_size_;
+        disk_used_ -= envicted_size;
     }
     if (disk_used_ > disk_capacity_limit_) {
         LOG_WARN(fmt::format("Envict disk used {} is larger than disk capacity limit {}", disk_used_, disk_capacity_limit_));
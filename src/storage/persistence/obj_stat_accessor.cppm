@@ -22,11 +22,19 @@ import third_party;
 
 namespace infinity {
 
+// The list of ObjectStatMap an entry is in. A partly downloaded object is in the lru list but isn't cached_
+enum class LRUListType : u8 {
+    kLRU,
+    kUsing,
+    kCleanuped,
+};
+
 struct LRUListEntry {
     LRUListEntry(String key, ObjStat obj_stat) : key_(std::move(key)), obj_stat_(std::move(obj_stat)) {}
 
     String key_{};
     ObjStat obj_stat_{};
+    LRUListType list_type_{LRUListType::kLRU};
 };
 
 class ObjectStatMap {
@@ -62,11 +70,17 @@ public:
 
     // Envict old object
     // move the last object in lru_list to cleanuped_list. called when disk used over limit, return nullptr if lru_list is empty
-    LRUListEntry *EnvictLast();
+    // envicted_size is the local disk bytes of the object, including partly downloaded ranges
+    LRUListEntry *EnvictLast(SizeT &envicted_size);
 
     const LRUMap &obj_map() const { return obj_map_; }
 
 private:
+    LRUList &List(LRUListType list_type);
+
+    // Moves the entry to the front of the list
+    void MoveTo(LRUListIter lru_iter, LRUListType list_type);
+
     LRUMap obj_map_{};
     LRUList lru_list_{};
     LRUList using_list_{};
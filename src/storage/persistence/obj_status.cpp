@@ -15,6 +15,7 @@
 module;
 
 #include <__iterator/next.h>
+#include <__iterator/prev.h>
 
 module obj_status;
 
@@ -117,4 +118,51 @@ void ObjStat::CheckValid(const String &obj_key, SizeT current_object_size) const
     }
 }
 
+SizeT ObjStat::CachedSize() const {
+    if (cached_) {
+        return obj_size_;
+    }
+    SizeT cached_size = 0;
+    for (const Range &range : cached_ranges_) {
+        cached_size += range.end_ - range.start_;
+    }
+    return cached_size;
+}
+
+bool ObjStat::RangeCached(const Range &range) const {
+    if (cached_) {
+        return true;
+    }
+    auto it = cached_ranges_.upper_bound(range);
+    if (it == cached_ranges_.begin()) {
+        return false;
+    }
+    return std::prev(it)->Cover(range);
+}
+
+void ObjStat::AddCachedRange(Range range) {
+    if (cached_) {
+        return;
+    }
+    auto it = cached_ranges_.lower_bound(range);
+    if (it != cached_ranges_.begin()) {
+        auto it_prev = std::prev(it);
+        if (it_prev->end_ >= range.start_) {
+            range.start_ = it_prev->start_;
+            range.end_ = std::max(range.end_, it_prev->end_);
+            it = cached_ranges_.erase(it_prev);
+        }
+    }
+    while (it != cached_ranges_.end() && it->start_ <= range.end_) {
+        range.end_ = std::max(range.end_, it->end_);
+        it = cached_ranges_.erase(it);
+    }
+    if (range.start_ == 0 && range.end_ >= obj_size_) {
+        cached_ranges_.clear();
+        cached_ = true;
+        return;
+    }
+    cached_ranges_.insert(range);
+}
+
 } // namespace infinity
@@ -38,7 +38,8 @@ export struct ObjStat {
     SizeT ref_count_{}; // the number of user (R and W) of some part of this object
     Set<Range> deleted_ranges_{};
 
-    bool cached_ = true; // whether the object is in localdisk cache
+    bool cached_ = true;          // whether the object is in localdisk cache
+    Set<Range> cached_ranges_{};  // ranges downloaded to localdisk cache while the whole object isn't, not persisted
 
     ObjStat() = default;
 
@@ -55,6 +56,14 @@ export struct ObjStat {
     static ObjStat ReadBufAdv(const char *&buf);
 
     void CheckValid(const String &obj_key, SizeT current_object_size) const;
+
+    // Bytes of the object on local disk
+    SizeT CachedSize() const;
+
+    bool RangeCached(const Range &range) const;
+
+    // Merge range into cached_ranges_, the object becomes cached once the ranges cover it
+    void AddCachedRange(Range range);
 };
 
 }
\ No newline at end of file
@@ -24,16 +24,43 @@ import third_party;
 import virtual_store;
 import infinity_context;
 import peer_task;
+import storage;
+import object_storage_process;
+import object_storage_task;
+import status;
 
 namespace fs = std::filesystem;
 
 namespace infinity {
 
 void PersistResultHandler::HandleWriteResult(const PersistWriteResult &result) {
-    for (const String &persist_key : result.persist_keys_) {
-        String persist_path = pm_->GetObjPath(persist_key);
-        if(InfinityContext::instance().GetServerRole() == NodeRole::kLeader){
-            VirtualStore::UploadObject(persist_path, persist_path);
+    // followers and learners read the objects uploaded by the leader. a standalone node uploads its own objects,
+    // since the local copies may be evicted from the disk cache of remote storage
+    NodeRole server_role = InfinityContext::instance().GetServerRole();
+    const bool owns_remote_objects = server_role == NodeRole::kLeader || server_role == NodeRole::kStandalone;
+    if (owns_remote_objects) {
+        Storage *storage = InfinityContext::instance().storage();
+        ObjectStorageProcess *object_storage_processor = storage != nullptr ? storage->object_storage_processor() : nullptr;
+        // Objects are uploaded in parallel by the object storage processor, the result is handled once all of them are done
+        Vector<SharedPtr<UploadTask>> upload_tasks;
+        for (const String &persist_key : result.persist_keys_) {
+            String persist_path = pm_->GetObjPath(persist_key);
+            if (object_storage_processor == nullptr) {
+                Status status = VirtualStore::UploadObject(persist_path, persist_path);
+                if (!status.ok()) {
+                    UnrecoverableError(status.message());
+                }
+                continue;
+            }
+            auto upload_task = MakeShared<UploadTask>(persist_path, persist_path);
+            object_storage_processor->Submit(upload_task);
+            upload_tasks.push_back(std::move(upload_task));
+        }
+        for (const auto &upload_task : upload_tasks) {
+            upload_task->Wait();
+            if (!upload_task->status_.ok()) {
+                UnrecoverableError(upload_task->status_.message());
+            }
         }
     }
     for (const String &drop_key : result.drop_keys_) {
@@ -43,8 +70,11 @@ void PersistResultHandler::HandleWriteResult(const PersistWriteResult &result) {
     for (const String &drop_key : result.drop_from_remote_keys_) {
         String drop_path = pm_->GetObjPath(drop_key);
         fs::remove(drop_path);
-        if(InfinityContext::instance().GetServerRole() == NodeRole::kLeader){
-            VirtualStore::RemoveObject(drop_path);
+        if (owns_remote_objects) {
+            Status status = VirtualStore::RemoveObject(drop_path);
+            if (!status.ok()) {
+                UnrecoverableError(status.message());
+            }
         }
     }
 }
@@ -24,11 +24,13 @@ import third_party;
 import infinity_exception;
 import virtual_store;
 import logger;
+import status;
 
 namespace fs = std::filesystem;
 
 namespace infinity {
 constexpr SizeT BUFFER_SIZE = 1024 * 1024; // 1 MB
+constexpr SizeT RANGE_BLOCK_SIZE = 1024 * 1024; // 1 MB, parts of an object not in cache are downloaded in aligned blocks
 
 nlohmann::json ObjAddr::Serialize() const {
     nlohmann::json obj;
@@ -60,12 +62,16 @@ ObjAddr ObjAddr::ReadBufAdv(const char *&buf) {
     return ret;
 }
 
-PersistenceManager::PersistenceManager(const String &workspace, const String &data_dir, SizeT object_size_limit, bool local_storage)
+PersistenceManager::PersistenceManager(const String &workspace,
+                                       const String &data_dir,
+                                       SizeT object_size_limit,
+                                       bool local_storage,
+                                       SizeT disk_cache_limit)
     : workspace_(workspace), local_data_dir_(data_dir), object_size_limit_(object_size_limit) {
     if (local_storage) {
         objects_ = MakeUnique<ObjectStatAccessor_LocalStorage>();
     } else {
-        UnrecoverableError("Remote storage is not supported yet.");
+        objects_ = MakeUnique<ObjectStatAccessor_ObjectStorage>(disk_cache_limit);
     }
     current_object_key_ = ObjCreate();
     current_object_size_ = 0;
@@ -237,15 +243,21 @@ PersistReadResult PersistenceManager::GetObjCache(const String &file_path) {
     result.obj_addr_ = it->second;
     if (ObjStat *obj_stat = objects_->Get(it->second.obj_key_); obj_stat != nullptr) {
         LOG_TRACE(fmt::format("GetObjCache object {} ref count {}", it->second.obj_key_, obj_stat->ref_count_));
-        if(!obj_stat->cached_){
+        Range part_range{.start_ = result.obj_addr_.part_offset_, .end_ = result.obj_addr_.part_offset_ + result.obj_addr_.part_size_};
+        if (!obj_stat->RangeCached(part_range)) {
+            // Download the blocks covering the part instead of the whole composed object
+            Range block_range{.start_ = part_range.start_ / RANGE_BLOCK_SIZE * RANGE_BLOCK_SIZE,
+                              .end_ = std::min(obj_stat->obj_size_, (part_range.end_ + RANGE_BLOCK_SIZE - 1) / RANGE_BLOCK_SIZE * RANGE_BLOCK_SIZE)};
             String read_path = GetObjPath(result.obj_addr_.obj_key_);
-            VirtualStore::DownloadObject(read_path, read_path);
-            if(VirtualStore::Exists(read_path)){
-                LOG_TRACE(fmt::format("GetObjCache download object {}", read_path));
-                obj_stat->cached_ = true;
+            Status status = VirtualStore::DownloadObjectRange(read_path, read_path, block_range.start_, block_range.end_ - block_range.start_);
+            if (!status.ok()) {
+                LOG_WARN(fmt::format("GetObjCache failed to download object {}: {}", read_path, status.message()));
+            } else if (VirtualStore::Exists(read_path)) {
+                LOG_TRACE(fmt::format("GetObjCache download object {} range [{}, {})", read_path, block_range.start_, block_range.end_));
+                obj_stat->AddCachedRange(block_range);
             }
         }
-        result.cached_ = obj_stat->cached_;
+        result.cached_ = obj_stat->RangeCached(part_range);
     } else {
         if (it->second.obj_key_ != current_object_key_) {
             String error_message = fmt::format("GetObjCache object {} not found", it->second.obj_key_);
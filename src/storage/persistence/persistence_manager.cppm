@@ -21,6 +21,7 @@ import serialize;
 import third_party;
 import obj_status;
 import obj_stat_accessor;
+import default_values;
 
 // A view means a logical plan
 namespace infinity {
@@ -52,7 +53,7 @@ export struct PersistWriteResult {
 
 export struct PersistReadResult {
     ObjAddr obj_addr_;                     // where data should read from
-    bool cached_;                          // whether the object is in localdisk cache
+    bool cached_;                          // whether the part of the object is in localdisk cache
     Vector<String> drop_keys_;             // object that should be removed from local disk. because of 1. disk used over limit
     Vector<String> drop_from_remote_keys_; // object that should be removed from remote storage. because of object's all parts are deleted
 };
@@ -60,7 +61,12 @@ export struct PersistReadResult {
 export class PersistenceManager {
 public:
     // TODO: build cache from existing files under workspace
-    PersistenceManager(const String &workspace, const String &data_dir, SizeT object_size_limit, bool local_storage = true);
+    // with remote storage, objects are uploaded once persisted, and the local copies are evicted beyond disk_cache_limit
+    PersistenceManager(const String &workspace,
+                       const String &data_dir,
+                       SizeT object_size_limit,
+                       bool local_storage = true,
+                       SizeT disk_cache_limit = DEFAULT_OBJECT_STORAGE_DISK_CACHE_LIMIT);
 
     ~PersistenceManager();
 
@@ -72,7 +78,8 @@ public:
     // Force finalize current object. Subsequent append on the finalized object is forbidden.
     [[nodiscard]] PersistWriteResult CurrentObjFinalize(bool validate = false);
 
-    // Download the whole object from object store if it's not in cache. Increase refcount and return the cached object file path.
+    // Download the blocks of the object covering the part from object store if they're not in cache. Increase refcount and return the
+    // cached object file path, the downloaded bytes are at their offset of the object.
     [[nodiscard]] PersistReadResult GetObjCache(const String &local_path);
 
     ObjAddr GetObjCacheWithoutCnt(const String &local_path);
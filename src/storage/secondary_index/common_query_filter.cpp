@@ -145,6 +145,14 @@ void CommonQueryFilter::BuildFilter(u32 task_id, Txn *txn) {
              block_entry = block_entry_iter.Next()) {
             const auto block_row_count = block_entry->row_count();
             const auto row_count = std::min<SizeT>(segment_row_count - segment_row_count_read, block_row_count);
+            if (!fast_rough_filter_evaluator_->EvaluateZoneMap(block_entry->zone_map(), row_count)) {
+                // no row of the block can pass the filter, skip reading it
+                if (row_count > 0) {
+                    result_elem.SetFalseRange(segment_row_count_read, segment_row_count_read + row_count);
+                }
+                segment_row_count_read += row_count;
+                continue;
+            }
             db_for_filter->Reset(row_count);
             ReadDataBlock(db_for_filter, buffer_mgr, row_count, block_entry, column_ids);
             bool_column->Initialize(ColumnVectorType::kCompactBit, row_count);
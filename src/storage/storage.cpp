@@ -51,6 +51,7 @@ import cleanup_scanner;
 import persistence_manager;
 import extra_ddl_info;
 import virtual_store;
+import posting_block_cache;
 
 namespace infinity {
 
@@ -121,7 +122,8 @@ void Storage::SetStorageMode(StorageMode target_mode) {
                     if (object_storage_processor_ != nullptr) {
                         UnrecoverableError("Object storage processor was initialized before.");
                     }
-                    object_storage_processor_ = MakeUnique<ObjectStorageProcess>();
+                    object_storage_processor_ = MakeUnique<ObjectStorageProcess>(config_ptr_->ObjectStorageMaxInFlight());
+                    object_storage_processor_->Start();
                     break;
                 }
                 default: {
@@ -135,7 +137,15 @@ void Storage::SetStorageMode(StorageMode target_mode) {
                     UnrecoverableError("persistence_manager was initialized before.");
                 }
                 i64 persistence_object_size_limit = config_ptr_->PersistenceObjectSizeLimit();
-                persistence_manager_ = MakeUnique<PersistenceManager>(persistence_dir, config_ptr_->DataDir(), (SizeT)persistence_object_size_limit);
+                if (config_ptr_->StorageType() == StorageType::kLocal) {
+                    persistence_manager_ = MakeUnique<PersistenceManager>(persistence_dir, config_ptr_->DataDir(), (SizeT)persistence_object_size_limit);
+                } else {
+                    persistence_manager_ = MakeUnique<PersistenceManager>(persistence_dir,
+                                                                          config_ptr_->DataDir(),
+                                                                          (SizeT)persistence_object_size_limit,
+                                                                          false,
+                                                                          (SizeT)config_ptr_->ObjectStorageDiskCacheLimit());
+                }
             }
 
             // Construct buffer manager
@@ -189,6 +199,7 @@ void Storage::SetStorageMode(StorageMode target_mode) {
                 UnrecoverableError("Memory index tracer was initialized before.");
             }
             memory_index_tracer_ = MakeUnique<BGMemIndexTracer>(config_ptr_->MemIndexMemoryQuota(), new_catalog_.get(), txn_mgr_.get());
+            PostingBlockCache::instance().SetCapacity(config_ptr_->PostingBlockCacheSize());
 
             new_catalog_->StartMemoryIndexCommit();
             new_catalog_->MemIndexRecover(buffer_mgr_.get(), system_start_ts);
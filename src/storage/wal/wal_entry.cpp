@@ -15,6 +15,7 @@
 module;
 
 #include <cassert>
+#include <future>
 #include <vector>
 #include <sstream>
 
@@ -221,7 +222,8 @@ WalChunkIndexInfo::WalChunkIndexInfo(ChunkIndexEntry *chunk_index_entry)
         case IndexType::kEMVB:
         case IndexType::kIVF:
         case IndexType::kSecondary:
-        case IndexType::kBMP: {
+        case IndexType::kBMP:
+        case IndexType::kDiskAnn: {
             String file_name = ChunkIndexEntry::IndexFileName(segment_index_entry->segment_id(), chunk_index_entry->chunk_id_);
             String file_path = Path(*(segment_index_entry->index_dir())) / file_name;
             paths_.push_back(file_path);
@@ -1297,7 +1299,7 @@ void WalEntry::WriteAdv(char *&ptr) const {
 
 SharedPtr<WalEntry> WalEntry::ReadAdv(const char *&ptr, i32 max_bytes) {
     const char *const ptr_end = ptr + max_bytes;
-    if (max_bytes <= 0) {
+    if (max_bytes <= 0 || (SizeT)max_bytes < sizeof(WalEntryHeader)) {
         String error_message = "ptr goes out of range when reading WalEntry";
         LOG_WARN(error_message);
         return nullptr;
@@ -1308,6 +1310,11 @@ SharedPtr<WalEntry> WalEntry::ReadAdv(const char *&ptr, i32 max_bytes) {
     entry->checksum_ = header->checksum_;
     entry->txn_id_ = header->txn_id_;
     entry->commit_ts_ = header->commit_ts_;
+    // the size comes from the possibly torn entry itself, so check it before reading the trailing size
+    if (entry->size_ < (i32)(sizeof(WalEntryHeader) + sizeof(i32)) || entry->size_ > max_bytes) {
+        LOG_WARN(fmt::format("Bad WalEntry size {}, {} bytes left", entry->size_, max_bytes));
+        return nullptr;
+    }
     if (const i32 size2 = ReadBuf<i32>(ptr + entry->size_ - sizeof(i32)); entry->size_ != size2) {
         return nullptr;
     }
@@ -1493,6 +1500,59 @@ SharedPtr<WalEntry> WalEntryIterator::Next() {
     }
 }
 
+Vector<SharedPtr<WalEntry>> WalEntryIterator::NextBatch(SizeT max_count, ThreadPool &pool) {
+    Vector<SharedPtr<WalEntry>> entries;
+    if (!is_backward_) {
+        while (entries.size() < max_count && HasNext()) {
+            entries.push_back(Next());
+            if (entries.back().get() == nullptr) {
+                break;
+            }
+        }
+        return entries;
+    }
+    // Entry boundaries only need the trailing size of each entry, so locate them first and decode concurrently.
+    Vector<Pair<SizeT, i32>> spans;
+    for (SizeT off = off_; off > 0 && spans.size() < max_count;) {
+        const i32 entry_size = ReadBuf<i32>(buf_.data() + off - sizeof(i32));
+        if (entry_size <= 0 || (SizeT)entry_size > off) {
+            // left to the sequential path to report
+            break;
+        }
+        off -= entry_size;
+        spans.emplace_back(off, entry_size);
+    }
+    if (spans.empty()) {
+        entries.push_back(Next());
+        return entries;
+    }
+    entries.resize(spans.size());
+    Vector<std::future<void>> futures;
+    SizeT task_num = std::min<SizeT>(pool.size(), spans.size());
+    for (SizeT task_id = 0; task_id < task_num; ++task_id) {
+        futures.emplace_back(pool.push([&, task_id](int) {
+            for (SizeT i = task_id; i < spans.size(); i += task_num) {
+                const char *ptr = buf_.data() + spans[i].first;
+                entries[i] = WalEntry::ReadAdv(ptr, spans[i].second);
+            }
+        }));
+    }
+    for (auto &future : futures) {
+        future.wait();
+    }
+    for (auto &future : futures) {
+        future.get();
+    }
+    for (SizeT i = 0; i < entries.size(); ++i) {
+        if (entries[i].get() == nullptr) {
+            entries.resize(i + 1);
+            break;
+        }
+        off_ = spans[i].first;
+    }
+    return entries;
+}
+
 SharedPtr<WalEntry> WalEntryIterator::GetEntryByIndex(i64 index) {
     i64 count = 0;
     while (HasNext()) {
@@ -1519,8 +1579,11 @@ Vector<SharedPtr<WalEntry>> WalEntryIterator::GetAllEntries() {
 
 bool WalEntryIterator::IsGood() const { return (is_backward_ && off_ == 0) || (!is_backward_ && off_ == buf_.size()); }
 
-WalListIterator::WalListIterator(const Vector<String> &wal_list) {
+WalListIterator::WalListIterator(const Vector<String> &wal_list, SizeT decode_parallelism) {
     assert(!wal_list.empty());
+    if (decode_parallelism > 1) {
+        decode_pool_ = MakeUnique<ThreadPool>(decode_parallelism);
+    }
     for (SizeT i = 0; i < wal_list.size(); ++i) {
         wal_list_.push_back(wal_list[i]);
     }
@@ -1579,6 +1642,9 @@ void WalListIterator::PurgeBadEntriesAfterLatestCheckpoint() {
 }
 
 bool WalListIterator::HasNext() {
+    if (!decoded_.empty()) {
+        return true;
+    }
     if (iter_.get() == nullptr) {
         return false;
     }
@@ -1598,7 +1664,18 @@ bool WalListIterator::HasNext() {
 }
 
 SharedPtr<WalEntry> WalListIterator::Next() {
-    auto entry = iter_->Next();
+    SharedPtr<WalEntry> entry;
+    if (decode_pool_.get() != nullptr) {
+        if (decoded_.empty()) {
+            auto entries = iter_->NextBatch(decode_pool_->size() * 16, *decode_pool_);
+            decoded_.insert(decoded_.end(), entries.begin(), entries.end());
+        }
+        // a bad entry is always the last one of a batch
+        entry = decoded_.front();
+        decoded_.pop_front();
+    } else {
+        entry = iter_->Next();
+    }
     if (entry.get() == nullptr) {
         auto off = iter_->GetOffset();
         String error_message = fmt::format("Found bad wal entry {}@{}", wal_list_.front(), off);
@@ -556,6 +556,10 @@ public:
 
     SharedPtr<WalEntry> Next();
 
+    // Decodes up to `max_count` following entries on `pool`, in iteration order.
+    // Decoding stops at the first bad entry, which is returned as nullptr like Next() does.
+    Vector<SharedPtr<WalEntry>> NextBatch(SizeT max_count, ThreadPool &pool);
+
     [[nodiscard]] i64 GetOffset() { return off_; };
 
     SharedPtr<WalEntry> GetEntryByIndex(i64 index);
@@ -572,7 +576,8 @@ private:
 // Backward iterator of WAL entries in given WAL files
 export class WalListIterator {
 public:
-    explicit WalListIterator(const Vector<String> &wal_list);
+    // With decode_parallelism > 1, entries are decoded ahead in batches by a private thread pool.
+    explicit WalListIterator(const Vector<String> &wal_list, SizeT decode_parallelism = 1);
 
     [[nodiscard]] bool HasNext();
 
@@ -583,6 +588,8 @@ private:
     void PurgeBadEntriesAfterLatestCheckpoint();
     List<String> wal_list_{};
     UniquePtr<WalEntryIterator> iter_{};
+    UniquePtr<ThreadPool> decode_pool_{};
+    Deque<SharedPtr<WalEntry>> decoded_{};
 };
 
 } // namespace infinity
@@ -91,6 +91,9 @@ private:
     i64 GetLastCkpWalSize();
     void SetLastCkpWalSize(i64 wal_size);
 
+    // Replay Helper
+    void ReplayWalEntries(const Vector<SharedPtr<WalEntry>> &entries, SizeT parallelism);
+
     void WalCmdCreateDatabaseReplay(const WalCmdCreateDatabase &cmd, TransactionID txn_id, TxnTimeStamp commit_ts);
     void WalCmdDropDatabaseReplay(const WalCmdDropDatabase &cmd, TransactionID txn_id, TxnTimeStamp commit_ts);
     void WalCmdCreateTableReplay(const WalCmdCreateTable &cmd, TransactionID txn_id, TxnTimeStamp commit_ts);
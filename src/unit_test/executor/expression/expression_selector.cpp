@@ -0,0 +1,141 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import catalog;
+import scalar_function;
+import scalar_function_set;
+import function_set;
+import and_func;
+import or_func;
+import less;
+import greater;
+import base_expression;
+import value_expression;
+import reference_expression;
+import function_expression;
+import expression_state;
+import expression_selector;
+import column_vector;
+import value;
+import data_block;
+import default_values;
+import logical_type;
+import internal_types;
+import data_type;
+
+using namespace infinity;
+class ExpressionSelectorTest : public BaseTestParamStr {};
+
+INSTANTIATE_TEST_SUITE_P(TestWithDifferentParams, ExpressionSelectorTest, ::testing::Values(BaseTestParamStr::NULL_CONFIG_PATH));
+
+// (c0 < 100 AND c1 > 50) OR c0 > 8000, the second conjunct only sees the rows selected by the first one
+TEST_P(ExpressionSelectorTest, and_or_select) {
+    using namespace infinity;
+    UniquePtr<Catalog> catalog_ptr = MakeUnique<Catalog>();
+    RegisterAndFunction(catalog_ptr);
+    RegisterOrFunction(catalog_ptr);
+    RegisterLessFunction(catalog_ptr);
+    RegisterGreaterFunction(catalog_ptr);
+
+    auto make_function = [&](const String &func_name, Vector<SharedPtr<BaseExpression>> arguments) -> SharedPtr<BaseExpression> {
+        SharedPtr<FunctionSet> function_set = Catalog::GetFunctionSetByName(catalog_ptr.get(), func_name);
+        auto scalar_function_set = std::static_pointer_cast<ScalarFunctionSet>(function_set);
+        ScalarFunction func = scalar_function_set->GetMostMatchFunction(arguments);
+        return MakeShared<FunctionExpression>(func, std::move(arguments));
+    };
+    auto c0 = MakeShared<ReferenceExpression>(DataType(LogicalType::kBigInt), "t1", "c0", String(), 0);
+    auto c1 = MakeShared<ReferenceExpression>(DataType(LogicalType::kBigInt), "t1", "c1", String(), 1);
+    auto c0_less = make_function("<", {c0, MakeShared<ValueExpression>(Value::MakeBigInt(100))});
+    auto c1_greater = make_function(">", {c1, MakeShared<ValueExpression>(Value::MakeBigInt(50))});
+    auto c0_greater = make_function(">", {c0, MakeShared<ValueExpression>(Value::MakeBigInt(8000))});
+    auto condition = make_function("OR", {make_function("AND", {c0_less, c1_greater}), c0_greater});
+    SharedPtr<ExpressionState> condition_state = ExpressionState::CreateState(condition);
+
+    const SizeT row_count = DEFAULT_VECTOR_SIZE;
+    SharedPtr<DataType> bigint_type = MakeShared<DataType>(LogicalType::kBigInt);
+    Vector<SharedPtr<ColumnVector>> columns;
+    for (SizeT column_idx = 0; column_idx < 2; ++column_idx) {
+        auto column = MakeShared<ColumnVector>(bigint_type);
+        column->Initialize(ColumnVectorType::kFlat, row_count);
+        for (SizeT i = 0; i < row_count; ++i) {
+            column->AppendValue(Value::MakeBigInt(static_cast<BigIntT>(i)));
+        }
+        columns.push_back(column);
+    }
+    DataBlock input_block;
+    input_block.Init(columns);
+
+    // the second block is evaluated with the conjunct order from the statistics of the first one
+    for (SizeT round = 0; round < 2; ++round) {
+        ExpressionSelector selector;
+        DataBlock output_block;
+        SizeT selected_count = selector.Select(condition, condition_state, &input_block, &output_block, row_count);
+        EXPECT_EQ(selected_count, (99u - 50u) + (row_count - 1 - 8000));
+        for (SizeT i = 0; i < selected_count; ++i) {
+            i64 value = output_block.GetValue(0, i).value_.big_int;
+            EXPECT_EQ(value, i < 49 ? i64(51 + i) : i64(8001 + i - 49));
+        }
+    }
+}
+
+// c0 < 3 AND c1 > -1, the second conjunct is evaluated on the selected rows only and must see the null of c1
+TEST_P(ExpressionSelectorTest, and_select_null) {
+    using namespace infinity;
+    UniquePtr<Catalog> catalog_ptr = MakeUnique<Catalog>();
+    RegisterAndFunction(catalog_ptr);
+    RegisterLessFunction(catalog_ptr);
+    RegisterGreaterFunction(catalog_ptr);
+
+    auto make_function = [&](const String &func_name, Vector<SharedPtr<BaseExpression>> arguments) -> SharedPtr<BaseExpression> {
+        SharedPtr<FunctionSet> function_set = Catalog::GetFunctionSetByName(catalog_ptr.get(), func_name);
+        auto scalar_function_set = std::static_pointer_cast<ScalarFunctionSet>(function_set);
+        ScalarFunction func = scalar_function_set->GetMostMatchFunction(arguments);
+        return MakeShared<FunctionExpression>(func, std::move(arguments));
+    };
+    auto c0 = MakeShared<ReferenceExpression>(DataType(LogicalType::kBigInt), "t1", "c0", String(), 0);
+    auto c1 = MakeShared<ReferenceExpression>(DataType(LogicalType::kBigInt), "t1", "c1", String(), 1);
+    auto c0_less = make_function("<", {c0, MakeShared<ValueExpression>(Value::MakeBigInt(3))});
+    auto c1_greater = make_function(">", {c1, MakeShared<ValueExpression>(Value::MakeBigInt(-1))});
+    auto condition = make_function("AND", {c0_less, c1_greater});
+    SharedPtr<ExpressionState> condition_state = ExpressionState::CreateState(condition);
+
+    const SizeT row_count = DEFAULT_VECTOR_SIZE;
+    SharedPtr<DataType> bigint_type = MakeShared<DataType>(LogicalType::kBigInt);
+    Vector<SharedPtr<ColumnVector>> columns;
+    for (SizeT column_idx = 0; column_idx < 2; ++column_idx) {
+        auto column = MakeShared<ColumnVector>(bigint_type);
+        column->Initialize(ColumnVectorType::kFlat, row_count);
+        for (SizeT i = 0; i < row_count; ++i) {
+            column->AppendValue(Value::MakeBigInt(static_cast<BigIntT>(i)));
+        }
+        columns.push_back(column);
+    }
+    // c1 of the second row is null
+    columns[1]->nulls_ptr_->SetFalse(1);
+    DataBlock input_block;
+    input_block.Init(columns);
+
+    for (SizeT round = 0; round < 2; ++round) {
+        ExpressionSelector selector;
+        DataBlock output_block;
+        SizeT selected_count = selector.Select(condition, condition_state, &input_block, &output_block, row_count);
+        EXPECT_EQ(selected_count, 2u);
+        EXPECT_EQ(output_block.GetValue(0, 0).value_.big_int, 0);
+        EXPECT_EQ(output_block.GetValue(0, 1).value_.big_int, 2);
+    }
+}
@@ -0,0 +1,101 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import sort_key_encoder;
+import column_vector;
+import value;
+import data_type;
+import logical_type;
+import internal_types;
+import select_statement;
+
+using namespace infinity;
+
+class SortKeyEncoderTest : public BaseTest {};
+
+TEST_F(SortKeyEncoderTest, test_order) {
+    constexpr u32 row_count = 1000;
+    auto int_column = MakeShared<ColumnVector>(MakeShared<DataType>(LogicalType::kInteger));
+    int_column->Initialize();
+    auto double_column = MakeShared<ColumnVector>(MakeShared<DataType>(LogicalType::kDouble));
+    double_column->Initialize();
+    Vector<i32> ints(row_count);
+    Vector<f64> doubles(row_count);
+    for (u32 i = 0; i < row_count; ++i) {
+        ints[i] = i32(i * 7919 % 13) - 6;
+        doubles[i] = (f64(i * 104729 % 101) - 50) / 3;
+        int_column->AppendValue(Value::MakeInt(ints[i]));
+        double_column->AppendValue(Value::MakeDouble(doubles[i]));
+    }
+    auto is_null = [](u32 i) { return i % 17 == 0; };
+    for (u32 i = 0; i < row_count; ++i) {
+        if (is_null(i)) {
+            double_column->nulls_ptr_->SetFalse(i);
+        }
+    }
+
+    // ORDER BY int ASC, double DESC
+    SortKeyEncoder encoder;
+    encoder.Init({DataType(LogicalType::kInteger), DataType(LogicalType::kDouble)}, {OrderType::kAsc, OrderType::kDesc});
+    EXPECT_TRUE(encoder.complete());
+    EXPECT_EQ(encoder.key_size(), 5u + 9u);
+    Vector<u8> keys(row_count * encoder.key_size());
+    encoder.Encode({int_column, double_column}, row_count, keys.data());
+    Vector<u32> rows = SortEncodedRows(encoder, keys.data(), row_count, [](u32, u32) { return false; });
+
+    ASSERT_EQ(rows.size(), row_count);
+    for (u32 i = 1; i < row_count; ++i) {
+        u32 x = rows[i - 1], y = rows[i];
+        ASSERT_LE(ints[x], ints[y]);
+        if (ints[x] != ints[y]) {
+            continue;
+        }
+        // NULL is the smallest value, so it comes last in DESC
+        if (is_null(x) || is_null(y)) {
+            EXPECT_TRUE(!is_null(x) || (is_null(y) && x < y));
+        } else {
+            EXPECT_GE(doubles[x], doubles[y]);
+            if (doubles[x] == doubles[y]) {
+                EXPECT_LT(x, y);
+            }
+        }
+    }
+}
+
+TEST_F(SortKeyEncoderTest, test_varchar_prefix) {
+    Vector<String> strs = {"b", "abcdefghijklmnopqrstuvwxyz1", "", "abcdefghijklmnopqrstuvwxyz0", "ab", "abcdefghijklmnop"};
+    auto column = MakeShared<ColumnVector>(MakeShared<DataType>(LogicalType::kVarchar));
+    column->Initialize();
+    for (const auto &str : strs) {
+        column->AppendValue(Value::MakeVarchar(str));
+    }
+
+    SortKeyEncoder encoder;
+    encoder.Init({DataType(LogicalType::kVarchar), DataType(LogicalType::kInteger)}, {OrderType::kAsc, OrderType::kAsc});
+    EXPECT_FALSE(encoder.complete());
+    EXPECT_EQ(encoder.key_size(), 1 + SortKeyEncoder::kVarcharPrefixSize);
+    Vector<u8> keys(strs.size() * encoder.key_size());
+    encoder.Encode({column}, strs.size(), keys.data());
+    Vector<u32> rows = SortEncodedRows(encoder, keys.data(), strs.size(), [&](u32 left, u32 right) { return strs[left] < strs[right]; });
+
+    Vector<String> sorted = strs;
+    std::sort(sorted.begin(), sorted.end());
+    for (SizeT i = 0; i < rows.size(); ++i) {
+        EXPECT_EQ(strs[rows[i]], sorted[i]);
+    }
+}
@@ -0,0 +1,185 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import infinity_exception;
+
+import global_resource_usage;
+import third_party;
+
+import logger;
+import stl;
+import infinity_context;
+import catalog;
+import like;
+import scalar_function;
+import scalar_function_set;
+import function_set;
+import function;
+import column_expression;
+import value_expression;
+import value;
+import default_values;
+import data_block;
+import base_expression;
+import column_vector;
+import logical_type;
+import internal_types;
+import data_type;
+
+using namespace infinity;
+class LikeFunctionsTest : public BaseTestParamStr {};
+
+INSTANTIATE_TEST_SUITE_P(TestWithDifferentParams, LikeFunctionsTest, ::testing::Values(BaseTestParamStr::NULL_CONFIG_PATH));
+
+TEST_P(LikeFunctionsTest, like_matcher) {
+    using namespace infinity;
+
+    // exact, prefix, suffix, contains and generic patterns
+    EXPECT_TRUE(LikeMatcher("abc", false).Match("abc"));
+    EXPECT_FALSE(LikeMatcher("abc", false).Match("abcd"));
+    EXPECT_TRUE(LikeMatcher("ab%", false).Match("abcd"));
+    EXPECT_FALSE(LikeMatcher("ab%", false).Match("a"));
+    EXPECT_TRUE(LikeMatcher("%cd", false).Match("abcd"));
+    EXPECT_FALSE(LikeMatcher("%cd", false).Match("abcde"));
+    EXPECT_TRUE(LikeMatcher("%bc%", false).Match("abcd"));
+    EXPECT_FALSE(LikeMatcher("%bd%", false).Match("abcd"));
+    EXPECT_TRUE(LikeMatcher("a_c%e", false).Match("abcde"));
+    EXPECT_TRUE(LikeMatcher("%a%a%a", false).Match("aaa"));
+    EXPECT_FALSE(LikeMatcher("%a%a%a", false).Match("aab"));
+    EXPECT_TRUE(LikeMatcher("%", false).Match(""));
+    EXPECT_FALSE(LikeMatcher("_", false).Match(""));
+
+    // '_' is one UTF-8 character, '\' escapes a wildcard
+    EXPECT_TRUE(LikeMatcher("_b", false).Match("éb"));
+    EXPECT_TRUE(LikeMatcher("100\\%", false).Match("100%"));
+    EXPECT_FALSE(LikeMatcher("100\\%", false).Match("1000"));
+
+    // ILIKE
+    EXPECT_TRUE(LikeMatcher("HeL%o", true).Match("hello"));
+    EXPECT_FALSE(LikeMatcher("HeL%o", false).Match("hello"));
+
+    bool exact = false;
+    EXPECT_EQ(LikeLiteralPrefix("abc%d", exact), "abc");
+    EXPECT_FALSE(exact);
+    EXPECT_EQ(LikeLiteralPrefix("a\\_b", exact), "a_b");
+    EXPECT_TRUE(exact);
+}
+
+TEST_P(LikeFunctionsTest, like_func) {
+    using namespace infinity;
+
+    UniquePtr<Catalog> catalog_ptr = MakeUnique<Catalog>();
+    RegisterLikeFunction(catalog_ptr);
+    RegisterNotLikeFunction(catalog_ptr);
+    RegisterRegexpMatchFunction(catalog_ptr);
+
+    SharedPtr<DataType> varchar_type = MakeShared<DataType>(LogicalType::kVarchar);
+    SharedPtr<DataType> result_type = MakeShared<DataType>(LogicalType::kBoolean);
+    SizeT row_count = DEFAULT_VECTOR_SIZE;
+
+    SharedPtr<ColumnVector> str_column = ColumnVector::Make(varchar_type);
+    str_column->Initialize();
+    for (SizeT i = 0; i < row_count; ++i) {
+        str_column->AppendValue(Value::MakeVarchar((i % 3 == 0 ? "infinity_" : "db_") + std::to_string(i)));
+    }
+
+    auto run = [&](const String &func_name, const String &pattern) {
+        SharedPtr<FunctionSet> function_set = Catalog::GetFunctionSetByName(catalog_ptr.get(), func_name);
+        EXPECT_EQ(function_set->type_, FunctionType::kScalar);
+        SharedPtr<ScalarFunctionSet> scalar_function_set = std::static_pointer_cast<ScalarFunctionSet>(function_set);
+
+        Vector<SharedPtr<BaseExpression>> inputs;
+        inputs.emplace_back(MakeShared<ColumnExpression>(*varchar_type, "t1", 1, "c1", 0, 0));
+        inputs.emplace_back(MakeShared<ValueExpression>(Value::MakeVarchar(pattern)));
+        ScalarFunction func = scalar_function_set->GetMostMatchFunction(inputs);
+
+        SharedPtr<ColumnVector> pattern_column = ColumnVector::Make(varchar_type);
+        pattern_column->Initialize(ColumnVectorType::kConstant);
+        pattern_column->AppendValue(Value::MakeVarchar(pattern));
+
+        DataBlock data_block;
+        data_block.Init({str_column, pattern_column});
+        SharedPtr<ColumnVector> result = MakeShared<ColumnVector>(result_type);
+        result->Initialize();
+        func.function_(data_block, result);
+        return result;
+    };
+
+    auto like_result = run("like", "infinity%");
+    auto not_like_result = run("not_like", "infinity%");
+    auto ilike_result = run("ilike", "INFINITY%");
+    auto regexp_result = run("regexp_match", "^infinity_[0-9]*3$");
+    for (SizeT i = 0; i < row_count; ++i) {
+        const bool expected = i % 3 == 0;
+        EXPECT_EQ(like_result->GetValue(i).value_.boolean, expected);
+        EXPECT_EQ(not_like_result->GetValue(i).value_.boolean, !expected);
+        EXPECT_EQ(ilike_result->GetValue(i).value_.boolean, expected);
+        EXPECT_EQ(regexp_result->GetValue(i).value_.boolean, expected && i % 10 == 3);
+    }
+}
+
+TEST_P(LikeFunctionsTest, like_func_state) {
+    using namespace infinity;
+
+    UniquePtr<Catalog> catalog_ptr = MakeUnique<Catalog>();
+    RegisterLikeFunction(catalog_ptr);
+
+    SharedPtr<DataType> varchar_type = MakeShared<DataType>(LogicalType::kVarchar);
+    SharedPtr<DataType> result_type = MakeShared<DataType>(LogicalType::kBoolean);
+    SizeT row_count = 16;
+
+    SharedPtr<ColumnVector> str_column = ColumnVector::Make(varchar_type);
+    str_column->Initialize();
+    for (SizeT i = 0; i < row_count; ++i) {
+        str_column->AppendValue(Value::MakeVarchar((i % 2 == 0 ? "infinity_" : "db_") + std::to_string(i)));
+    }
+
+    SharedPtr<FunctionSet> function_set = Catalog::GetFunctionSetByName(catalog_ptr.get(), "like");
+    SharedPtr<ScalarFunctionSet> scalar_function_set = std::static_pointer_cast<ScalarFunctionSet>(function_set);
+    Vector<SharedPtr<BaseExpression>> inputs;
+    inputs.emplace_back(MakeShared<ColumnExpression>(*varchar_type, "t1", 1, "c1", 0, 0));
+    inputs.emplace_back(MakeShared<ValueExpression>(Value::MakeVarchar("infinity%")));
+    ScalarFunction func = scalar_function_set->GetMostMatchFunction(inputs);
+    ASSERT_TRUE(func.state_function_);
+
+    // the state keeps the compiled pattern across blocks and is replaced when the pattern changes
+    SharedPtr<void> state;
+    auto run = [&](const String &pattern) {
+        SharedPtr<ColumnVector> pattern_column = ColumnVector::Make(varchar_type);
+        pattern_column->Initialize(ColumnVectorType::kConstant);
+        pattern_column->AppendValue(Value::MakeVarchar(pattern));
+
+        DataBlock data_block;
+        data_block.Init({str_column, pattern_column});
+        SharedPtr<ColumnVector> result = MakeShared<ColumnVector>(result_type);
+        result->Initialize();
+        func.state_function_(data_block, result, state);
+        return result;
+    };
+
+    auto first_result = run("infinity%");
+    void *first_state = state.get();
+    EXPECT_NE(first_state, nullptr);
+    auto second_result = run("infinity%");
+    EXPECT_EQ(state.get(), first_state);
+    auto db_result = run("db%");
+    for (SizeT i = 0; i < row_count; ++i) {
+        EXPECT_EQ(first_result->GetValue(i).value_.boolean, i % 2 == 0);
+        EXPECT_EQ(second_result->GetValue(i).value_.boolean, i % 2 == 0);
+        EXPECT_EQ(db_result->GetValue(i).value_.boolean, i % 2 == 1);
+    }
+}
@@ -0,0 +1,118 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "gtest/gtest.h"
+import base_test;
+import stl;
+import internal_types;
+import parsed_expr;
+import constant_expr;
+
+import http_json;
+
+using namespace infinity;
+
+class HTTPJsonTest : public BaseTest {};
+
+TEST_F(HTTPJsonTest, test_members_and_vector) {
+    String body = R"({"output": ["id"], "search": [{"match_method": "dense", "query_vector": [0.5, 2, -1e1]}, {"topn": 2}], "limit": 3})";
+    Vector<JsonMember> members;
+    String error_message;
+    ASSERT_TRUE(HTTPJson::ListMembers(body, members, error_message));
+    ASSERT_EQ(members.size(), 3u);
+    EXPECT_EQ(members[0].key_, "output");
+    EXPECT_EQ(members[0].raw_value_, R"(["id"])");
+    EXPECT_TRUE(members[0].is_array_);
+    EXPECT_FALSE(members[0].all_numbers_);
+    EXPECT_FALSE(members[0].all_objects_);
+    EXPECT_EQ(members[1].raw_value_, R"([{"match_method": "dense", "query_vector": [0.5, 2, -1e1]}, {"topn": 2}])");
+    EXPECT_FALSE(members[2].is_array_);
+
+    // the search objects are listed in the same pass
+    const auto &search_objects = members[1].objects_;
+    ASSERT_TRUE(members[1].all_objects_);
+    ASSERT_EQ(search_objects.size(), 2u);
+    ASSERT_EQ(search_objects[0].size(), 2u);
+    EXPECT_EQ(search_objects[0][0].raw_value_, R"("dense")");
+    EXPECT_EQ(search_objects[1][0].key_, "topn");
+    const JsonMember &query_vector = search_objects[0][1];
+    EXPECT_EQ(query_vector.raw_value_, "[0.5, 2, -1e1]");
+    ASSERT_TRUE(query_vector.all_numbers_);
+    EXPECT_FALSE(query_vector.all_integers_);
+
+    auto [dimension, embedding] = HTTPJson::DecodeVector(query_vector, EmbeddingDataType::kElemFloat, error_message);
+    ASSERT_EQ(dimension, 3);
+    auto *floats = static_cast<f32 *>(embedding);
+    EXPECT_EQ(floats[0], 0.5F);
+    EXPECT_EQ(floats[1], 2.0F);
+    EXPECT_EQ(floats[2], -10.0F);
+    delete[] floats;
+
+    auto [int_dimension, int_embedding] = HTTPJson::DecodeVector(query_vector, EmbeddingDataType::kElemInt8, error_message);
+    EXPECT_EQ(int_embedding, nullptr);
+    auto [raw_dimension, raw_embedding] = HTTPJson::DecodeVector(members[2], EmbeddingDataType::kElemFloat, error_message);
+    EXPECT_EQ(raw_embedding, nullptr);
+
+    members.clear();
+    EXPECT_FALSE(HTTPJson::ListMembers(R"({"limit": )", members, error_message));
+}
+
+TEST_F(HTTPJsonTest, test_trailing_content) {
+    Vector<JsonMember> members;
+    String error_message;
+    EXPECT_TRUE(HTTPJson::ListMembers(" {\"limit\": [1, 2] } \n", members, error_message));
+    members.clear();
+    EXPECT_FALSE(HTTPJson::ListMembers(R"({"limit": 3} garbage)", members, error_message));
+    members.clear();
+    EXPECT_FALSE(HTTPJson::ListMembers(R"({"limit": 3}{"offset": 1})", members, error_message));
+
+    Vector<String> columns;
+    Vector<Vector<ParsedExpr *> *> rows;
+    EXPECT_FALSE(HTTPJson::ParseInsertRows(R"([{"id": 1}] [{"id": 2}])", columns, rows));
+    EXPECT_TRUE(rows.empty());
+    EXPECT_TRUE(columns.empty());
+}
+
+TEST_F(HTTPJsonTest, test_insert_rows) {
+    Vector<String> columns;
+    Vector<Vector<ParsedExpr *> *> rows;
+    ASSERT_TRUE(HTTPJson::ParseInsertRows(R"([{"id": 1, "name": "a\"b", "vec": [0.5, 1.5]}, {"vec": [2.5, 3.5], "name": "c", "id": 2}])",
+                                          columns,
+                                          rows));
+    ASSERT_EQ(columns, (Vector<String>{"id", "name", "vec"}));
+    ASSERT_EQ(rows.size(), 2u);
+    auto *second_id = static_cast<ConstantExpr *>((*rows[1])[0]);
+    auto *first_name = static_cast<ConstantExpr *>((*rows[0])[1]);
+    auto *second_vec = static_cast<ConstantExpr *>((*rows[1])[2]);
+    EXPECT_EQ(second_id->integer_value_, 2);
+    EXPECT_STREQ(first_name->str_value_, "a\"b");
+    EXPECT_EQ(second_vec->literal_type_, LiteralType::kDoubleArray);
+    EXPECT_EQ(second_vec->double_array_, (Vector<double>{2.5, 3.5}));
+    for (auto *values_row : rows) {
+        for (auto *value : *values_row) {
+            delete value;
+        }
+        delete values_row;
+    }
+    rows.clear();
+    columns.clear();
+
+    // left to the DOM path
+    EXPECT_FALSE(HTTPJson::ParseInsertRows(R"([{"id": 1, "tensor": [[1.0], [2.0]]}])", columns, rows));
+    EXPECT_FALSE(HTTPJson::ParseInsertRows(R"([{"id": 1}, {"other": 2}])", columns, rows));
+    EXPECT_FALSE(HTTPJson::ParseInsertRows(R"([{"vec": [1, 2.5]}])", columns, rows));
+    EXPECT_TRUE(rows.empty());
+    EXPECT_TRUE(columns.empty());
+}
@@ -0,0 +1,66 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "gtest/gtest.h"
+import base_test;
+import stl;
+import status;
+import third_party;
+
+import peer_log_batch;
+
+using namespace infinity;
+
+class PeerLogBatchTest : public BaseTest {};
+
+TEST_F(PeerLogBatchTest, test_pack_unpack) {
+    Vector<SharedPtr<String>> logs;
+    SizeT raw_bytes = 0;
+    for (SizeT i = 0; i < 1000; ++i) {
+        auto log_str = MakeShared<String>(fmt::format("{:08}", i));
+        log_str->append(i % 100, char('a' + i % 26));
+        raw_bytes += log_str->size();
+        logs.emplace_back(std::move(log_str));
+    }
+    // one oversized entry gets a frame of its own
+    logs.emplace_back(MakeShared<String>(20000, 'x'));
+    raw_bytes += 20000;
+
+    Vector<SharedPtr<String>> frames = PeerLogBatch::Pack(logs, 16 * 1024);
+    EXPECT_GT(frames.size(), 1u);
+    SizeT frame_bytes = 0;
+    Vector<String> unpacked;
+    for (const auto &frame : frames) {
+        ASSERT_TRUE(PeerLogBatch::IsFrame(*frame));
+        frame_bytes += frame->size();
+        Status status = PeerLogBatch::Unpack(*frame, unpacked);
+        ASSERT_TRUE(status.ok());
+    }
+    EXPECT_LT(frame_bytes, raw_bytes);
+    ASSERT_EQ(unpacked.size(), logs.size());
+    for (SizeT i = 0; i < logs.size(); ++i) {
+        EXPECT_EQ(unpacked[i], *logs[i]);
+    }
+
+    // plain entries start with a positive size and are never taken for a frame
+    String plain_entry(64, '\0');
+    plain_entry[0] = 64;
+    EXPECT_FALSE(PeerLogBatch::IsFrame(plain_entry));
+
+    String broken = *frames[0];
+    broken.resize(broken.size() / 2);
+    unpacked.clear();
+    EXPECT_FALSE(PeerLogBatch::Unpack(broken, unpacked).ok());
+}
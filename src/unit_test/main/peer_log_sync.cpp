@@ -0,0 +1,99 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+#include <thread>
+import base_test;
+
+import stl;
+import status;
+import third_party;
+import infinity_context;
+import storage;
+import txn_manager;
+import txn;
+import extra_ddl_info;
+import config;
+import cluster_manager;
+import peer_task;
+import peer_thrift_client;
+import peer_thrift_server;
+import peer_log_batch;
+import wal_manager;
+
+using namespace infinity;
+
+class PeerLogSyncTest : public BaseTest {};
+
+// The leader and the follower share this process and its peer server: the follower registers to the leader, which
+// connects back to the same server to ship the WAL, and the SyncLog handler decodes what it receives.
+TEST_F(PeerLogSyncTest, leader_to_follower) {
+    RemoveDbDirs();
+    InfinityContext::instance().Init(nullptr, true);
+    Status status = InfinityContext::instance().ChangeRole(NodeRole::kLeader, "leader");
+    ASSERT_TRUE(status.ok());
+
+    Config *config = InfinityContext::instance().config();
+    const String peer_ip = config->PeerServerIP();
+    const i64 peer_port = config->PeerServerPort();
+    PoolPeerThriftServer peer_server;
+    peer_server.Init(peer_ip, peer_port, config->PeerServerConnectionPoolSize());
+    Thread peer_server_thread([&] { peer_server.Start(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    TxnManager *txn_mgr = InfinityContext::instance().storage()->txn_manager();
+    for (SizeT i = 0; i < 100; ++i) {
+        auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("create db"));
+        EXPECT_TRUE(txn->CreateDatabase(fmt::format("db{}", i), ConflictType::kError).ok());
+        txn_mgr->CommitTxn(txn);
+    }
+
+    ClusterManager follower(txn_mgr);
+    ASSERT_TRUE(follower.InitAsFollower("follower", peer_ip, peer_port).ok());
+    ASSERT_TRUE(follower.RegisterToLeader().ok());
+
+    ClusterManager *leader = InfinityContext::instance().cluster_manager();
+    auto [node_status, follower_info] = leader->GetNodeInfoPtrByName("follower");
+    ASSERT_TRUE(node_status.ok());
+    EXPECT_EQ(follower_info->log_batch_version_, PeerLogBatch::kVersion);
+
+    auto peer_client = MakeShared<PeerClient>(peer_ip, peer_port);
+    ASSERT_TRUE(peer_client->Init().ok());
+    WalManager *wal_mgr = InfinityContext::instance().storage()->wal_manager();
+    // the WAL since the checkpoint, once as batch frames and once as plain entries for a node that registered without a version
+    for (i64 log_batch_version : {PeerLogBatch::kVersion, i64(0)}) {
+        auto node_info = MakeShared<NodeInfo>(*follower_info);
+        node_info->txn_timestamp_ = wal_mgr->GetCheckpointedTS();
+        node_info->log_batch_version_ = log_batch_version;
+        status = leader->SyncLogsOnRegistration(node_info, peer_client);
+        EXPECT_TRUE(status.ok()) << status.message();
+    }
+
+    // the logs before a checkpoint are recycled, a node behind it is refused
+    wal_mgr->Checkpoint(true /*is_full_checkpoint*/);
+    {
+        auto node_info = MakeShared<NodeInfo>(*follower_info);
+        node_info->txn_timestamp_ = wal_mgr->GetCheckpointedTS() - 1;
+        status = leader->SyncLogsOnRegistration(node_info, peer_client);
+        EXPECT_EQ(status.code(), ErrorCode::kNodeBehindCheckpoint);
+    }
+    peer_client->UnInit();
+
+    follower.UnInit();
+    status = InfinityContext::instance().ChangeRole(NodeRole::kAdmin);
+    EXPECT_TRUE(status.ok());
+    peer_server.Shutdown();
+    peer_server_thread.join();
+    InfinityContext::instance().UnInit();
+}
@@ -0,0 +1,79 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import block_zone_map;
+import column_vector;
+import value;
+import data_type;
+import logical_type;
+import filter_expression_push_down_helper;
+
+using namespace infinity;
+class BlockZoneMapTest : public BaseTest {};
+
+TEST_F(BlockZoneMapTest, append_and_prune) {
+    using namespace infinity;
+    auto bigint_type = MakeShared<DataType>(LogicalType::kBigInt);
+    auto double_type = MakeShared<DataType>(LogicalType::kDouble);
+    auto varchar_type = MakeShared<DataType>(LogicalType::kVarchar);
+    BlockZoneMap zone_map;
+    zone_map.Init({bigint_type, double_type, varchar_type});
+    EXPECT_TRUE(zone_map.Covers(0));
+    EXPECT_FALSE(zone_map.Covers(1));
+
+    ColumnVector bigint_column(bigint_type);
+    bigint_column.Initialize();
+    ColumnVector double_column(double_type);
+    double_column.Initialize();
+    for (i64 i = 0; i < 100; ++i) {
+        bigint_column.AppendValue(Value::MakeBigInt(100 + i));
+        double_column.AppendValue(Value::MakeDouble(0.5 * i));
+        if (i % 10 == 0) {
+            bigint_column.nulls_ptr_->SetFalse(i);
+        }
+    }
+    // only rows [10, 60) are appended
+    zone_map.Update(0, bigint_column, 10, 50);
+    zone_map.Update(1, double_column, 10, 50);
+    zone_map.FinishAppend(0, 50);
+    EXPECT_TRUE(zone_map.Covers(50));
+    EXPECT_EQ(zone_map.NullCount(0), 5u);
+
+    // bigint in [111, 159]
+    EXPECT_FALSE(zone_map.MayInRange(0, Value::MakeBigInt(110), FilterCompareType::kLessEqual));
+    EXPECT_TRUE(zone_map.MayInRange(0, Value::MakeBigInt(111), FilterCompareType::kLessEqual));
+    EXPECT_FALSE(zone_map.MayInRange(0, Value::MakeBigInt(160), FilterCompareType::kGreaterEqual));
+    EXPECT_TRUE(zone_map.MayInRange(0, Value::MakeBigInt(159), FilterCompareType::kGreaterEqual));
+    // double in [5.0, 29.5]
+    EXPECT_FALSE(zone_map.MayInRange(1, Value::MakeDouble(4.5), FilterCompareType::kLessEqual));
+    EXPECT_TRUE(zone_map.MayInRange(1, Value::MakeDouble(29.5), FilterCompareType::kGreaterEqual));
+    // varchar and unknown columns are never ruled out
+    EXPECT_TRUE(zone_map.MayInRange(2, Value::MakeVarchar("abc"), FilterCompareType::kLessEqual));
+    EXPECT_TRUE(zone_map.MayInRange(5, Value::MakeBigInt(0), FilterCompareType::kLessEqual));
+
+    // the range only grows with later appends
+    zone_map.Update(0, bigint_column, 61, 1);
+    zone_map.Update(1, double_column, 61, 1);
+    zone_map.FinishAppend(50, 1);
+    EXPECT_TRUE(zone_map.Covers(51));
+    EXPECT_TRUE(zone_map.MayInRange(0, Value::MakeBigInt(161), FilterCompareType::kGreaterEqual));
+
+    // rows added behind the zone map make it incomplete
+    zone_map.FinishAppend(60, 1);
+    EXPECT_FALSE(zone_map.Covers(0));
+}
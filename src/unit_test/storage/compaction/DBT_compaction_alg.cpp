@@ -505,3 +505,127 @@ TEST_F(DBTCompactionTest, RollbackTest) {
         }
     }
 }
+
+TEST_F(DBTCompactionTest, RewriteDeletedSegment) {
+    TransactionID txn_id = 0;
+
+    int m = 3;
+    int c = 3;
+    int s = 1;
+    DBTRewriteConfig rewrite_config{0.5, 10, 1, 0};
+    DBTCompactionAlg DBTCompact(m, c, s, MockSegmentEntry::segment_capacity, nullptr, rewrite_config);
+    DBTCompact.Enable(Vector<SegmentEntry *>{});
+
+    Vector<SharedPtr<SegmentEntry>> segment_entries; // hold lifetime
+    auto segment1 = MockSegmentEntry::Make(100);
+    auto segment2 = MockSegmentEntry::Make(300);
+    segment_entries.emplace_back(segment1);
+    segment_entries.emplace_back(segment2);
+    DBTCompact.AddSegment(segment1.get());
+    DBTCompact.AddSegment(segment2.get());
+    {
+        auto segments = DBTCompact.CheckCompaction(++txn_id);
+        EXPECT_TRUE(segments.empty());
+    }
+    {
+        segment1->ShrinkSegment(5);
+        DBTCompact.DeleteInSegment(segment1->segment_id());
+        auto segments = DBTCompact.CheckCompaction(++txn_id);
+        EXPECT_TRUE(segments.empty());
+    }
+    TransactionID rewrite_txn_id = 0;
+    {
+        segment1->ShrinkSegment(55);
+        DBTCompact.DeleteInSegment(segment1->segment_id());
+        auto segments = DBTCompact.CheckCompaction(rewrite_txn_id = ++txn_id);
+        EXPECT_EQ(segments.size(), 1u);
+        EXPECT_EQ(segments[0], segment1.get());
+    }
+    {
+        // only one rewrite task is allowed
+        segment2->ShrinkSegment(150);
+        DBTCompact.DeleteInSegment(segment2->segment_id());
+        auto segments = DBTCompact.CheckCompaction(++txn_id);
+        EXPECT_TRUE(segments.empty());
+    }
+    {
+        auto compacted_segments = MockSegmentEntry::MockCompact({segment1.get()});
+        segment_entries.insert(segment_entries.end(), compacted_segments.begin(), compacted_segments.end());
+        EXPECT_EQ(compacted_segments.size(), 1u);
+        EXPECT_EQ(compacted_segments[0]->actual_row_count(), 40u);
+        DBTCompact.CommitCompact(rewrite_txn_id);
+        DBTCompact.AddSegment(compacted_segments[0].get());
+    }
+    {
+        auto segments = DBTCompact.CheckCompaction(++txn_id);
+        EXPECT_EQ(segments.size(), 1u);
+        EXPECT_EQ(segments[0], segment2.get());
+        DBTCompact.RollbackCompact(txn_id);
+    }
+}
+
+TEST_F(DBTCompactionTest, RewriteHotSegment) {
+    TransactionID txn_id = 0;
+
+    int m = 3;
+    int c = 3;
+    int s = 1;
+    DBTRewriteConfig rewrite_config{0.5, 10, 1, 0};
+    DBTCompactionAlg DBTCompact(m, c, s, MockSegmentEntry::segment_capacity, nullptr, rewrite_config);
+    DBTCompact.Enable(Vector<SegmentEntry *>{});
+
+    Vector<SharedPtr<SegmentEntry>> segment_entries; // hold lifetime
+    auto cold_segment = MockSegmentEntry::Make(100);
+    auto hot_segment = MockSegmentEntry::Make(100);
+    segment_entries.emplace_back(cold_segment);
+    segment_entries.emplace_back(hot_segment);
+    DBTCompact.AddSegment(cold_segment.get());
+    DBTCompact.AddSegment(hot_segment.get());
+    for (auto &segment : segment_entries) {
+        static_cast<MockSegmentEntry *>(segment.get())->ShrinkSegment(40);
+        DBTCompact.DeleteInSegment(segment->segment_id());
+    }
+    {
+        auto segments = DBTCompact.CheckCompaction(++txn_id);
+        EXPECT_TRUE(segments.empty());
+    }
+    for (int i = 0; i < 1023; ++i) {
+        hot_segment->IncreaseScanCount();
+    }
+    {
+        auto segments = DBTCompact.CheckCompaction(++txn_id);
+        EXPECT_EQ(segments.size(), 1u);
+        EXPECT_EQ(segments[0], hot_segment.get());
+        DBTCompact.CommitCompact(txn_id);
+    }
+}
+
+TEST_F(DBTCompactionTest, RewriteRateLimit) {
+    TransactionID txn_id = 0;
+
+    int m = 3;
+    int c = 3;
+    int s = 1;
+    DBTRewriteConfig rewrite_config{0.5, 10, 2, 1};
+    DBTCompactionAlg DBTCompact(m, c, s, MockSegmentEntry::segment_capacity, nullptr, rewrite_config);
+    DBTCompact.Enable(Vector<SegmentEntry *>{});
+
+    Vector<SharedPtr<SegmentEntry>> segment_entries; // hold lifetime
+    for (int i = 0; i < 2; ++i) {
+        auto segment_entry = MockSegmentEntry::Make(100);
+        segment_entries.emplace_back(segment_entry);
+        DBTCompact.AddSegment(segment_entry.get());
+        segment_entry->ShrinkSegment(80);
+        DBTCompact.DeleteInSegment(segment_entry->segment_id());
+    }
+    {
+        auto segments = DBTCompact.CheckCompaction(++txn_id);
+        EXPECT_EQ(segments.size(), 1u);
+        DBTCompact.CommitCompact(txn_id);
+    }
+    {
+        // 100 rows at 1 row per second, the next rewrite is deferred
+        auto segments = DBTCompact.CheckCompaction(++txn_id);
+        EXPECT_TRUE(segments.empty());
+    }
+}
@@ -0,0 +1,102 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+#include <random>
+import base_test;
+import stl;
+
+import small_float;
+
+using namespace infinity;
+
+class SmallFloatTest : public BaseTest {};
+
+TEST_F(SmallFloatTest, test_round_trip) {
+    for (u32 b = 1; b < 256; ++b) {
+        EXPECT_LT(SmallFloat::Byte4ToInt(u8(b - 1)), SmallFloat::Byte4ToInt(u8(b)));
+        EXPECT_EQ(SmallFloat::IntToByte4(SmallFloat::Byte4ToInt(u8(b))), b);
+    }
+    for (u32 i = 0; i < 1000000; ++i) {
+        u32 decoded = SmallFloat::Quantize(i);
+        // never shorter, so that tf / length stays in [0, 1]
+        EXPECT_GE(decoded, i);
+        if (i < SmallFloat::kNumFreeValues) {
+            EXPECT_EQ(decoded, i);
+        } else {
+            EXPECT_LE(decoded - i, (i - SmallFloat::kNumFreeValues) / 8 + 1);
+        }
+    }
+}
+
+// Compares BM25 rankings over exact and quantized lengths for a synthetic corpus with long tailed lengths.
+TEST_F(SmallFloatTest, test_bm25_ranking_difference) {
+    constexpr float k1 = 1.2F;
+    constexpr float b = 0.75F;
+    constexpr SizeT doc_n = 20000;
+    constexpr SizeT query_n = 20;
+    constexpr SizeT top_k = 10;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> uniform(0.0F, 1.0F);
+    Vector<u32> lengths(doc_n);
+    Vector<u8> norms(doc_n);
+    double length_sum = 0;
+    for (SizeT i = 0; i < doc_n; ++i) {
+        lengths[i] = 1 + u32(std::pow(uniform(rng), 3.0F) * 2000);
+        norms[i] = SmallFloat::IntToByte4(lengths[i]);
+        length_sum += lengths[i];
+    }
+    EXPECT_EQ(norms.size() * sizeof(norms[0]) * 4, lengths.size() * sizeof(lengths[0]));
+    const float avg_length = length_sum / doc_n;
+
+    double overlap_sum = 0;
+    float max_relative_error = 0;
+    for (SizeT q = 0; q < query_n; ++q) {
+        Vector<Pair<float, u32>> exact_scores;
+        Vector<Pair<float, u32>> quantized_scores;
+        for (u32 doc_id = 0; doc_id < doc_n; ++doc_id) {
+            if (uniform(rng) >= 0.2F) {
+                continue;
+            }
+            u32 tf = 1 + u32(std::pow(uniform(rng), 4.0F) * std::min<u32>(lengths[doc_id], 20));
+            tf = std::min(tf, lengths[doc_id]);
+            float exact = tf / (tf + k1 * (1.0F - b + b * lengths[doc_id] / avg_length));
+            float quantized = tf / (tf + k1 * (1.0F - b + b * SmallFloat::Byte4ToInt(norms[doc_id]) / avg_length));
+            max_relative_error = std::max(max_relative_error, std::abs(exact - quantized) / exact);
+            exact_scores.emplace_back(exact, doc_id);
+            quantized_scores.emplace_back(quantized, doc_id);
+        }
+        auto top = [&](Vector<Pair<float, u32>> &scores) {
+            std::partial_sort(scores.begin(), scores.begin() + top_k, scores.end(), [](const auto &l, const auto &r) {
+                return l.first > r.first || (l.first == r.first && l.second < r.second);
+            });
+            Vector<u32> ids;
+            for (SizeT i = 0; i < top_k; ++i) {
+                ids.push_back(scores[i].second);
+            }
+            std::sort(ids.begin(), ids.end());
+            return ids;
+        };
+        Vector<u32> exact_top = top(exact_scores);
+        Vector<u32> quantized_top = top(quantized_scores);
+        Vector<u32> common;
+        std::set_intersection(exact_top.begin(), exact_top.end(), quantized_top.begin(), quantized_top.end(), std::back_inserter(common));
+        overlap_sum += double(common.size()) / top_k;
+    }
+    const double mean_overlap = overlap_sum / query_n;
+    std::cout << "top-" << top_k << " overlap: " << mean_overlap << ", max relative score error: " << max_relative_error << std::endl;
+    EXPECT_GE(mean_overlap, 0.9);
+    EXPECT_LT(max_relative_error, 0.125F);
+}
@@ -0,0 +1,70 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+import stl;
+
+import term_table;
+
+using namespace infinity;
+
+class TermTableTest : public BaseTest {};
+
+TEST_F(TermTableTest, test_concurrent_get_or_add) {
+    constexpr int thread_n = 8;
+    constexpr int term_n = 20000;
+    TermTable<SharedPtr<u32>> table;
+
+    Vector<String> terms;
+    for (int i = 0; i < term_n; ++i) {
+        terms.push_back("term_" + std::to_string(i));
+    }
+    terms.push_back(String(40000, 'z')); // longer than a quarter of an arena block
+
+    Atomic<u32> created{0};
+    Vector<std::thread> threads;
+    for (int t = 0; t < thread_n; ++t) {
+        threads.emplace_back([&, t] {
+            for (SizeT i = 0; i < terms.size(); ++i) {
+                const String &term = terms[(i + t * 997) % terms.size()];
+                SharedPtr<u32> value;
+                table.GetOrAdd(term, value, [&] {
+                    created.fetch_add(1);
+                    return MakeShared<u32>(0);
+                });
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(created.load(), terms.size());
+    EXPECT_EQ(table.Size(), terms.size());
+
+    SharedPtr<u32> value;
+    EXPECT_TRUE(table.Get("term_42", value));
+    EXPECT_FALSE(table.Get("term_", value));
+
+    std::sort(terms.begin(), terms.end());
+    auto items = table.UnsafeSortedItems();
+    ASSERT_EQ(items.size(), terms.size());
+    for (SizeT i = 0; i < items.size(); ++i) {
+        EXPECT_EQ(items[i].first, terms[i]);
+    }
+
+    table.Clear();
+    EXPECT_EQ(table.Size(), 0u);
+    EXPECT_FALSE(table.Get("term_42", value));
+}
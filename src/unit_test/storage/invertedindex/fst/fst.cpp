@@ -120,3 +120,45 @@ TEST_F(FstTest, Iterate) {
     }
     EXPECT_EQ(i, b2_num);
 }
+
+TEST_F(FstTest, Automaton) {
+    Vector<u8> buffer;
+    BufferWriter wtr(buffer);
+    FstBuilder builder(wtr);
+    for (auto &month : months) {
+        builder.Insert((u8 *)month.first.c_str(), month.first.length(), month.second);
+    }
+    builder.Finish();
+
+    Fst f(buffer.data(), buffer.size());
+    auto search = [&](Automaton &aut) {
+        Vector<String> names;
+        FstAutomatonStream s(f, aut);
+        Vector<u8> key;
+        u64 val;
+        while (s.Next(key, val)) {
+            String name((char *)key.data(), key.size());
+            EXPECT_TRUE(aut.Matches(key.data(), key.size()));
+            names.push_back(std::move(name));
+        }
+        return names;
+    };
+
+    PrefixAutomaton prefix("Ju");
+    EXPECT_EQ(search(prefix), (Vector<String>{"July", "June"}));
+
+    WildcardAutomaton wildcard("*ber");
+    EXPECT_EQ(search(wildcard), (Vector<String>{"December", "November", "October", "September"}));
+    WildcardAutomaton wildcard2("M?r*");
+    EXPECT_EQ(search(wildcard2), (Vector<String>{"March"}));
+
+    LevenshteinAutomaton fuzzy("Jun", 1);
+    EXPECT_EQ(search(fuzzy), (Vector<String>{"June"}));
+    LevenshteinAutomaton fuzzy2("Mai", 2);
+    EXPECT_EQ(search(fuzzy2), (Vector<String>{"May"}));
+
+    // distance is counted in characters rather than bytes
+    LevenshteinAutomaton utf8("über", 1);
+    EXPECT_TRUE(utf8.Matches((const u8 *)"uber", 4));
+    EXPECT_FALSE(utf8.Matches((const u8 *)"ubr", 3));
+}
@@ -42,6 +42,12 @@ import segment_posting;
 import global_resource_usage;
 import infinity_context;
 import third_party;
+import term_doc_iterator;
+import column_length_io;
+import small_float;
+import chunk_index_entry;
+import buffer_manager;
+import storage;
 
 using namespace infinity;
 
@@ -268,3 +274,97 @@ TEST_P(MemoryIndexerTest, SeekPosition) {
         ASSERT_EQ(act_pos, INVALID_POSITION);
     }
 }
+
+TEST_P(MemoryIndexerTest, QuantizedNorm) {
+    // doc i holds tfs[i] "x" among lengths[i] tokens, long enough for several posting blocks
+    constexpr u32 doc_n = 600;
+    const optionflag_t flag = flag_ | of_quantized_norm;
+    auto column = ColumnVector::Make(MakeShared<DataType>(LogicalType::kVarchar));
+    column->Initialize();
+    Vector<u32> tfs(doc_n);
+    Vector<u32> lengths(doc_n);
+    for (u32 i = 0; i < doc_n; ++i) {
+        tfs[i] = 1 + i % 7;
+        lengths[i] = std::max(tfs[i], 1 + i * i * 37 % 1500);
+        String doc;
+        for (u32 j = 0; j < lengths[i]; ++j) {
+            doc += j < tfs[i] ? "x " : "filler ";
+        }
+        column->AppendValue(Value::MakeVarchar(doc));
+    }
+
+    auto indexer = MakeUnique<MemoryIndexer>(GetFullDataDir(), "chunk1", RowID(0U, 0U), flag, "standard");
+    indexer->Insert(column, 0, doc_n);
+    while (indexer->GetInflightTasks() > 0) {
+        sleep(1);
+        indexer->CommitSync();
+    }
+    for (u32 i = 0; i < doc_n; ++i) {
+        // the memory indexer keeps exact lengths
+        ASSERT_EQ(indexer->GetColumnLength(i), lengths[i]);
+    }
+    const u64 column_length_sum = indexer->GetColumnLengthSum();
+
+    auto check_scores = [&](ColumnIndexReader &reader) {
+        constexpr float k1 = 1.2F;
+        constexpr float b = 0.75F;
+        auto length_reader = MakeUnique<FullTextColumnLengthReader>(&reader);
+        FullTextColumnLengthReader *length_reader_ptr = length_reader.get();
+        const float avg_column_len = length_reader->GetAvgColumnLength();
+        const u64 total_df = length_reader->GetTotalDF();
+        ASSERT_EQ(total_df, doc_n);
+        ASSERT_FLOAT_EQ(avg_column_len, static_cast<float>(column_length_sum) / doc_n);
+        const float bm25_common_score = std::log(1.0F + (total_df - doc_n + 0.5F) / (doc_n + 0.5F)) * (k1 + 1.0F);
+
+        auto doc_iter = MakeUnique<TermDocIterator>(reader.Lookup("x"), 0, 1.0F);
+        doc_iter->InitBM25Info(std::move(length_reader));
+        u32 doc_cnt = 0;
+        for (RowID doc_id(0U, 0U); doc_iter->Next(doc_id); doc_id = doc_iter->DocID() + 1) {
+            const u32 i = doc_iter->DocID().segment_offset_;
+            const u32 quantized_len = SmallFloat::Quantize(lengths[i]);
+            const float expected = bm25_common_score * tfs[i] / (tfs[i] + k1 * (1.0F - b + b * quantized_len / avg_column_len));
+            EXPECT_EQ(length_reader_ptr->GetColumnLength(doc_iter->DocID()), quantized_len);
+            EXPECT_NEAR(doc_iter->BM25Score(), expected, 1e-5F * expected);
+            // block max info is computed from the quantized lengths too, so it stays an upper bound of the doc score
+            EXPECT_GE(doc_iter->BlockMaxBM25Score() * (1.0F + 1e-5F), expected);
+            ++doc_cnt;
+        }
+        EXPECT_EQ(doc_cnt, doc_n);
+    };
+
+    MemoryIndexer *indexer_ptr = indexer.get();
+    {
+        auto fake_segment_index_entry = SegmentIndexEntry::CreateFakeEntry(GetFullDataDir());
+        fake_segment_index_entry->SetMemoryIndexer(std::move(indexer));
+        Map<SegmentID, SharedPtr<SegmentIndexEntry>> index_by_segment = {{0, fake_segment_index_entry}};
+        ColumnIndexReader reader;
+        reader.Open(flag, GetFullDataDir(), std::move(index_by_segment), nullptr);
+        check_scores(reader);
+        indexer_ptr->Dump();
+    }
+
+    // postings loaded from disk keep the block max info written by PostingWriter, and the lengths are quantized
+    // from the dumped column length file by the chunk
+    auto fake_segment_index_entry = SegmentIndexEntry::CreateFakeEntry(GetFullDataDir());
+    BufferManager *buffer_mgr = InfinityContext::instance().storage()->buffer_manager();
+    auto chunk_index_entry = ChunkIndexEntry::NewFtChunkIndexEntry(fake_segment_index_entry.get(),
+                                                                   fake_segment_index_entry->GetNextChunkID(),
+                                                                   "chunk1",
+                                                                   RowID(0U, 0U),
+                                                                   doc_n,
+                                                                   buffer_mgr);
+    fake_segment_index_entry->AddChunkIndexEntry(chunk_index_entry);
+    fake_segment_index_entry->UpdateFulltextColumnLenInfo(column_length_sum, doc_n);
+    SharedPtr<Vector<u8>> norms = chunk_index_entry->GetQuantizedNorms();
+    ASSERT_EQ(norms->size(), doc_n);
+    for (u32 i = 0; i < doc_n; ++i) {
+        ASSERT_EQ(SmallFloat::Byte4ToInt((*norms)[i]), SmallFloat::Quantize(lengths[i]));
+    }
+    // built once, shared by the readers of the chunk
+    EXPECT_EQ(chunk_index_entry->GetQuantizedNorms(), norms);
+
+    Map<SegmentID, SharedPtr<SegmentIndexEntry>> index_by_segment = {{0, fake_segment_index_entry}};
+    ColumnIndexReader reader;
+    reader.Open(flag, GetFullDataDir(), std::move(index_by_segment), nullptr);
+    check_scores(reader);
+}
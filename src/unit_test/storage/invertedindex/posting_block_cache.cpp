@@ -0,0 +1,166 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+import stl;
+
+import posting_block_cache;
+
+using namespace infinity;
+
+class PostingBlockCacheTest : public BaseTest {};
+
+namespace {
+
+SharedPtr<const PostingFileId> MakeFileId(const String &path, u64 inode, SizeT hash) {
+    auto file_id = MakeShared<PostingFileId>();
+    file_id->path_ = path;
+    file_id->inode_ = inode;
+    file_id->size_ = 4096;
+    file_id->hash_ = hash;
+    return file_id;
+}
+
+} // namespace
+
+TEST_F(PostingBlockCacheTest, test_admission_and_lookup) {
+    PostingBlockCache cache;
+    auto file1 = MakeFileId("/chunk1.pos", 1, 1);
+    auto file2 = MakeFileId("/chunk2.pos", 2, 2);
+    // seen once, not admitted
+    EXPECT_EQ(cache.GetTerm(file1, 100, 4), nullptr);
+    SharedPtr<CachedPostingTerm> term = cache.GetTerm(file1, 100, 4);
+    ASSERT_NE(term, nullptr);
+    EXPECT_EQ(term->BlockCount(), 4u);
+    EXPECT_EQ(term->GetBlock(2), nullptr);
+
+    auto block = MakeUnique<DecodedPostingBlock>();
+    block->doc_ids_[0] = 42;
+    const DecodedPostingBlock *published = term->PutBlock(2, block);
+    ASSERT_NE(published, nullptr);
+    EXPECT_EQ(term->GetBlock(2), published);
+
+    // a second publisher gets the first block back
+    auto other = MakeUnique<DecodedPostingBlock>();
+    other->doc_ids_[0] = 7;
+    EXPECT_EQ(term->PutBlock(2, other), published);
+    EXPECT_EQ(term->GetBlock(2)->doc_ids_[0], 42u);
+
+    // once admitted the term is found without going through the sketch again
+    EXPECT_EQ(cache.GetTerm(file1, 100, 4), term);
+    EXPECT_EQ(cache.GetTerm(file2, 100, 4), nullptr);
+
+    cache.RecordAccess(3, 1);
+    PostingBlockCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.hits_, 3u);
+    EXPECT_EQ(stats.misses_, 1u);
+    EXPECT_EQ(stats.admitted_terms_, 1u);
+    EXPECT_EQ(stats.rejected_terms_, 2u);
+    EXPECT_EQ(stats.usage_, sizeof(DecodedPostingBlock));
+    term.reset();
+    cache.Clear();
+    EXPECT_EQ(cache.GetStats().usage_, 0u);
+}
+
+TEST_F(PostingBlockCacheTest, test_eviction) {
+    constexpr SizeT term_n = 256;
+    PostingBlockCache cache(PostingBlockCache::kShardNum * sizeof(DecodedPostingBlock) * 2);
+    auto file = MakeFileId("/chunk.pos", 1, 1);
+    for (SizeT i = 0; i < term_n; ++i) {
+        SharedPtr<CachedPostingTerm> term = cache.GetTerm(file, i, 1);
+        if (term == nullptr) {
+            term = cache.GetTerm(file, i, 1);
+        }
+        ASSERT_NE(term, nullptr);
+        auto block = MakeUnique<DecodedPostingBlock>();
+        term->PutBlock(0, block);
+    }
+    PostingBlockCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.admitted_terms_, term_n);
+    EXPECT_GT(stats.evicted_terms_, 0u);
+    // every shard keeps at most one block above its share of the capacity
+    EXPECT_LE(stats.usage_, stats.capacity_ + PostingBlockCache::kShardNum * sizeof(DecodedPostingBlock));
+}
+
+TEST_F(PostingBlockCacheTest, test_term_cap) {
+    constexpr u32 block_n = 64;
+    constexpr SizeT shard_block_n = 4;
+    PostingBlockCache cache(PostingBlockCache::kShardNum * sizeof(DecodedPostingBlock) * shard_block_n);
+    auto file = MakeFileId("/chunk.pos", 1, 1);
+    cache.GetTerm(file, 0, block_n);
+    SharedPtr<CachedPostingTerm> term = cache.GetTerm(file, 0, block_n);
+    ASSERT_NE(term, nullptr);
+
+    // one long posting streamed through the cache only fills the share of its shard
+    for (u32 i = 0; i < block_n; ++i) {
+        auto block = MakeUnique<DecodedPostingBlock>();
+        block->doc_ids_[0] = i;
+        const DecodedPostingBlock *published = term->PutBlock(i, block);
+        if (i < shard_block_n) {
+            ASSERT_NE(published, nullptr);
+            EXPECT_EQ(block, nullptr);
+            EXPECT_EQ(term->GetBlock(i)->doc_ids_[0], i);
+        } else {
+            EXPECT_TRUE(term->Full());
+            EXPECT_EQ(published, nullptr);
+            // the refused block is left to the reader
+            ASSERT_NE(block, nullptr);
+            EXPECT_EQ(block->doc_ids_[0], i);
+            EXPECT_EQ(term->GetBlock(i), nullptr);
+        }
+    }
+    EXPECT_EQ(term->Charge(), shard_block_n * sizeof(DecodedPostingBlock));
+    PostingBlockCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.usage_, shard_block_n * sizeof(DecodedPostingBlock));
+    EXPECT_LE(stats.usage_, stats.capacity_ / PostingBlockCache::kShardNum);
+
+    // a cached block is still served when the term is full
+    auto again = MakeUnique<DecodedPostingBlock>();
+    EXPECT_EQ(term->PutBlock(1, again), term->GetBlock(1));
+}
+
+TEST_F(PostingBlockCacheTest, test_file_identity) {
+    PostingBlockCache cache;
+    auto file = MakeFileId("/chunk.pos", 1, 7);
+    cache.GetTerm(file, 0, 1);
+    SharedPtr<CachedPostingTerm> term = cache.GetTerm(file, 0, 1);
+    ASSERT_NE(term, nullptr);
+
+    // an equal identity held by another reader finds the same term
+    EXPECT_EQ(cache.GetTerm(MakeFileId("/chunk.pos", 1, 7), 0, 1), term);
+    // the same path rewritten as another file, and another path of the same hash, don't
+    EXPECT_NE(cache.GetTerm(MakeFileId("/chunk.pos", 2, 7), 0, 1), term);
+    EXPECT_NE(cache.GetTerm(MakeFileId("/other.pos", 1, 7), 0, 1), term);
+}
+
+TEST_F(PostingBlockCacheTest, test_make_file_id) {
+    std::filesystem::create_directories(GetFullTmpDir());
+    String path = String(GetFullTmpDir()) + "/posting_block_cache.pos";
+    {
+        std::ofstream ofs(path);
+        ofs << "posting";
+    }
+    auto file_id = PostingFileId::Make(path);
+    ASSERT_NE(file_id, nullptr);
+    EXPECT_EQ(file_id->size_, 7u);
+    EXPECT_EQ(*PostingFileId::Make(path), *file_id);
+    {
+        std::ofstream ofs(path);
+        ofs << "rewritten posting";
+    }
+    EXPECT_FALSE(*PostingFileId::Make(path) == *file_id);
+    std::filesystem::remove(path);
+    EXPECT_EQ(PostingFileId::Make(path), nullptr);
+}
@@ -226,3 +226,55 @@ graphic cards
         }
     }
 }
+
+TEST_F(QueryParserAndOptimizerTest, multi_term_query_test) {
+    using namespace infinity;
+    const Map<String, String> column2analyzer;
+    const String default_field("body");
+    SearchDriver driver(column2analyzer, default_field, FulltextQueryOperatorOption::kInfinitySyntax, true, 7, true);
+    {
+        auto node = driver.ParseSingle("dun*");
+        ASSERT_NE(node, nullptr);
+        ASSERT_EQ(node->GetType(), QueryNodeType::PREFIX_TERM);
+        const auto *prefix_node = static_cast<const PrefixTermQueryNode *>(node.get());
+        EXPECT_EQ(prefix_node->term_, "dun");
+        EXPECT_EQ(prefix_node->max_expansions_, 7u);
+    }
+    {
+        auto node = driver.ParseSingle("d?n*e");
+        ASSERT_NE(node, nullptr);
+        ASSERT_EQ(node->GetType(), QueryNodeType::WILDCARD_TERM);
+        EXPECT_EQ(static_cast<const WildcardTermQueryNode *>(node.get())->term_, "d?n*e");
+    }
+    {
+        auto node = driver.ParseSingle("dnue~1");
+        ASSERT_NE(node, nullptr);
+        ASSERT_EQ(node->GetType(), QueryNodeType::FUZZY_TERM);
+        const auto *fuzzy_node = static_cast<const FuzzyTermQueryNode *>(node.get());
+        EXPECT_EQ(fuzzy_node->term_, "dnue");
+        EXPECT_EQ(fuzzy_node->distance_, 1u);
+    }
+    {
+        // a multi term node survives the optimizer
+        auto node = QueryNode::GetOptimizedQueryTree(driver.ParseSingle("name:dun* AND god"));
+        ASSERT_NE(node, nullptr);
+        OStringStream oss;
+        node->PrintTree(oss);
+        EXPECT_NE(oss.str().find(QueryNodeTypeToString(QueryNodeType::PREFIX_TERM)), String::npos);
+    }
+    {
+        // without the wildcard option "*" is not a pattern
+        SearchDriver plain_driver(column2analyzer, default_field);
+        auto node = plain_driver.ParseSingle("dun*");
+        ASSERT_NE(node, nullptr);
+        EXPECT_EQ(node->GetType(), QueryNodeType::TERM);
+    }
+    {
+        // without the fuzzy option the slop of a single term is ignored, as before fuzzy queries were added
+        SearchDriver plain_driver(column2analyzer, default_field);
+        auto node = plain_driver.ParseSingle("dnue~1");
+        ASSERT_NE(node, nullptr);
+        ASSERT_EQ(node->GetType(), QueryNodeType::TERM);
+        EXPECT_EQ(static_cast<const TermQueryNode *>(node.get())->term_, "dnue");
+    }
+}
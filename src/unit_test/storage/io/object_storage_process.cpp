@@ -0,0 +1,115 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import infinity_exception;
+
+import stl;
+import third_party;
+import logger;
+
+import virtual_store;
+import local_file_handle;
+import object_storage_process;
+import object_storage_task;
+import default_values;
+import status;
+
+using namespace infinity;
+
+class ObjectStorageProcessTest : public BaseTest {};
+
+// Runs against a local MinIO, a small object and one uploaded and downloaded in parts
+TEST_F(ObjectStorageProcessTest, minio_transfer) {
+    using namespace infinity;
+
+    VirtualStore::InitRemoteStore();
+    if (!VirtualStore::BucketExists()) {
+        LOG_INFO("bucket existence check failed, skip the test");
+        VirtualStore::UnInitRemoteStore();
+        return;
+    }
+
+    ObjectStorageProcess processor(4);
+    processor.Start();
+
+    Vector<SizeT> file_sizes{10, OBJECT_STORAGE_MULTIPART_THRESHOLD + OBJECT_STORAGE_PART_SIZE / 2};
+    Vector<String> paths;
+    Vector<Vector<char>> contents;
+    Vector<SharedPtr<BaseObjectStorageTask>> tasks;
+    for (SizeT file_idx = 0; file_idx < file_sizes.size(); ++file_idx) {
+        String path = String(GetFullTmpDir()) + fmt::format("/test_object_storage_process_{}.abc", file_idx);
+        Vector<char> content(file_sizes[file_idx]);
+        for (SizeT i = 0; i < content.size(); ++i) {
+            content[i] = static_cast<char>(i * 31 + file_idx);
+        }
+        auto [file_handle, status] = VirtualStore::Open(path, FileAccessMode::kWrite);
+        if (!status.ok()) {
+            UnrecoverableError(status.message());
+        }
+        file_handle->Append(content.data(), content.size());
+        file_handle->Sync();
+
+        auto upload_task = MakeShared<UploadTask>(path, path);
+        processor.Submit(upload_task);
+        tasks.push_back(upload_task);
+        paths.push_back(path);
+        contents.push_back(std::move(content));
+    }
+    for (const auto &task : tasks) {
+        task->Wait();
+        EXPECT_TRUE(task->status_.ok());
+    }
+    tasks.clear();
+
+    for (const String &path : paths) {
+        VirtualStore::DeleteFile(path);
+        auto download_task = MakeShared<DownloadTask>(path, path);
+        processor.Submit(download_task);
+        tasks.push_back(download_task);
+    }
+    for (SizeT file_idx = 0; file_idx < paths.size(); ++file_idx) {
+        tasks[file_idx]->Wait();
+        EXPECT_TRUE(tasks[file_idx]->status_.ok());
+        auto [file_handle, status] = VirtualStore::Open(paths[file_idx], FileAccessMode::kRead);
+        EXPECT_TRUE(status.ok());
+        Vector<char> content(file_handle->FileSize());
+        file_handle->Read(content.data(), content.size());
+        EXPECT_EQ(content, contents[file_idx]);
+    }
+    tasks.clear();
+
+    for (const String &path : paths) {
+        auto remove_task = MakeShared<RemoveTask>(path);
+        processor.Submit(remove_task);
+        tasks.push_back(remove_task);
+        VirtualStore::DeleteFile(path);
+    }
+    for (const auto &task : tasks) {
+        task->Wait();
+        EXPECT_TRUE(task->status_.ok());
+    }
+
+    ObjectStorageMetrics metrics = processor.GetMetrics();
+    EXPECT_EQ(metrics.finished_tasks_, 6u);
+    EXPECT_EQ(metrics.failed_tasks_, 0u);
+    EXPECT_EQ(metrics.uploaded_bytes_, file_sizes[0] + file_sizes[1]);
+    EXPECT_EQ(metrics.downloaded_bytes_, file_sizes[0] + file_sizes[1]);
+    EXPECT_EQ(processor.RunningTaskCount(), 0u);
+
+    processor.Stop();
+    VirtualStore::UnInitRemoteStore();
+}
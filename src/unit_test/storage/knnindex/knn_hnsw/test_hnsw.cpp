@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstring>
 #include <thread>
 
 #include "gtest/gtest.h"
@@ -29,6 +30,7 @@ import dist_func_l2;
 import dist_func_ip;
 import dist_func_cos;
 import vec_store_type;
+import pq_vec_store;
 import hnsw_common;
 import infinity_exception;
 import virtual_store;
@@ -79,6 +81,25 @@ public:
             float correct_rate = float(correct) / element_size;
             // std::printf("correct rage: %f\n", correct_rate);
             EXPECT_GE(correct_rate, 0.95);
+
+            // a batch gives the same result as searching the queries one by one
+            constexpr SizeT batch_n = 64;
+            Vector<const float *> queries;
+            for (SizeT i = 0; i < batch_n; ++i) {
+                queries.push_back(data.get() + i * dim);
+            }
+            auto batch_results = hnsw_index->KnnSearchBatch(queries.data(), batch_n, 10, search_option);
+            ASSERT_EQ(batch_results.size(), batch_n);
+            for (SizeT i = 0; i < batch_n; ++i) {
+                auto expected = hnsw_index->KnnSearchSorted(queries[i], 10, search_option);
+                auto &[result_n, d_ptr, l_ptr] = batch_results[i];
+                Vector<Pair<float, LabelT>> result;
+                for (SizeT j = 0; j < result_n; ++j) {
+                    result.emplace_back(d_ptr[j], l_ptr[j]);
+                }
+                std::sort(result.begin(), result.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+                EXPECT_EQ(result, expected);
+            }
         };
 
         {
@@ -105,11 +126,41 @@ public:
 
             test_func(hnsw_index);
         }
+
+        if constexpr (Hnsw::kLoadFromPtr) {
+            String file_path = save_dir_ + "/test_hnsw.bin";
+            u8 *data_ptr = nullptr;
+            SizeT data_len = 0;
+            ASSERT_EQ(VirtualStore::MmapFile(file_path, data_ptr, data_len), 0);
+            {
+                const char *ptr = reinterpret_cast<const char *>(data_ptr);
+                auto hnsw_index = Hnsw::LoadFromPtr(ptr);
+                EXPECT_EQ(ptr, reinterpret_cast<const char *>(data_ptr) + data_len);
+                test_func(hnsw_index);
+            }
+            {
+                // the sections that are not aligned are copied
+                auto buffer = MakeUnique<char[]>(data_len + 1);
+                std::memcpy(buffer.get() + 1, data_ptr, data_len);
+                const char *ptr = buffer.get() + 1;
+                auto hnsw_index = Hnsw::LoadFromPtr(ptr);
+                test_func(hnsw_index);
+            }
+            {
+                // the LVQ copy is on the heap, it can be optimized and outlives the mapping
+                const char *ptr = reinterpret_cast<const char *>(data_ptr);
+                auto hnsw_index = Hnsw::LoadFromPtr(ptr);
+                auto lvq_index = std::as_const(*hnsw_index).CompressToLVQ();
+                hnsw_index.reset();
+                VirtualStore::MunmapFile(file_path);
+                lvq_index->Optimize();
+                test_func(lvq_index);
+            }
+        }
     }
 
-    template <typename Hnsw, typename CompressedHnsw>
-    void TestCompress() {
-        int dim = 16;
+    template <typename Hnsw, typename CompressedHnsw, bool UsePQ = false, bool KeepSource = false>
+    void TestCompress(float min_correct_rate = 0.95, int dim = 16) {
         int M = 8;
         int ef_construction = 200;
         int chunk_size = 128;
@@ -140,7 +191,7 @@ public:
             }
             float correct_rate = float(correct) / element_size;
             // std::printf("correct rage: %f\n", correct_rate);
-            EXPECT_GE(correct_rate, 0.95);
+            EXPECT_GE(correct_rate, min_correct_rate);
         };
 
         {
@@ -152,7 +203,21 @@ public:
                 // std::fstream os("./tmp/dump_1.txt", std::fstream::out);
                 // hnsw_index->Dump(os);
             }
-            auto compress_hnsw = std::move(*hnsw_index).CompressToLVQ();
+            auto compress_hnsw = [&] {
+                if constexpr (KeepSource && UsePQ) {
+                    return std::as_const(*hnsw_index).CompressToPQ();
+                } else if constexpr (KeepSource) {
+                    return std::as_const(*hnsw_index).CompressToLVQ();
+                } else if constexpr (UsePQ) {
+                    return std::move(*hnsw_index).CompressToPQ();
+                } else {
+                    return std::move(*hnsw_index).CompressToLVQ();
+                }
+            }();
+            if constexpr (KeepSource) {
+                // the source is still searched by readers of a dumping memory index
+                test_func(hnsw_index);
+            }
             {
                 // std::fstream os("./tmp/dump_2.txt", std::fstream::out);
                 // compress_hnsw->Dump(os);
@@ -318,3 +383,77 @@ TEST_F(HnswAlgTest, test6) {
     using CompressedHnsw = KnnHnsw<LVQL2VecStoreType<float, int8_t>, LabelT>;
     TestCompress<Hnsw, CompressedHnsw>();
 }
+
+TEST_F(HnswAlgTest, test_pq) {
+    // each 8-dim subspace is coded by one byte, so self-hit rate is lower than lvq
+    using Hnsw = KnnHnsw<PlainL2VecStoreType<float>, LabelT>;
+    using CompressedHnsw = KnnHnsw<PQL2VecStoreType<float>, LabelT>;
+    TestCompress<Hnsw, CompressedHnsw, true>(0.8);
+}
+
+TEST_F(HnswAlgTest, test_pq_padded_dim) {
+    // a prime dim is padded with zeros to whole subspaces instead of being coded one dim per byte
+    using Meta = PQVecStoreMeta<float, PQMetric::kL2>;
+    auto meta = Meta::Make(131);
+    EXPECT_EQ(meta.subspace_num(), 16u);
+    EXPECT_EQ(meta.subspace_dim(), 9u);
+    auto wide_meta = Meta::Make(1536);
+    EXPECT_EQ(wide_meta.subspace_num(), kPQMaxSubspaceNum);
+    EXPECT_EQ(wide_meta.subspace_dim(), 12u);
+
+    using Hnsw = KnnHnsw<PlainL2VecStoreType<float>, LabelT>;
+    using CompressedHnsw = KnnHnsw<PQL2VecStoreType<float>, LabelT>;
+    TestCompress<Hnsw, CompressedHnsw, true>(0.7, 17);
+}
+
+TEST_F(HnswAlgTest, test_pq_keep_source) {
+    using Hnsw = KnnHnsw<PlainL2VecStoreType<float>, LabelT>;
+    using CompressedHnsw = KnnHnsw<PQL2VecStoreType<float>, LabelT>;
+    TestCompress<Hnsw, CompressedHnsw, true, true>(0.8);
+}
+
+TEST_F(HnswAlgTest, test_lvq_keep_source) {
+    using Hnsw = KnnHnsw<PlainL2VecStoreType<float>, LabelT>;
+    using CompressedHnsw = KnnHnsw<LVQL2VecStoreType<float, int8_t>, LabelT>;
+    TestCompress<Hnsw, CompressedHnsw, false, true>();
+}
+
+TEST_F(HnswAlgTest, test_distance_bound) {
+    using Hnsw = KnnHnsw<PlainL2VecStoreType<float>, LabelT>;
+    constexpr SizeT dim = 16;
+    constexpr SizeT element_size = 1024;
+    constexpr SizeT topk = 10;
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> distrib_real;
+    auto data = MakeUnique<float[]>(dim * element_size);
+    for (SizeT i = 0; i < dim * element_size; ++i) {
+        data[i] = distrib_real(rng);
+    }
+    auto hnsw_index = Hnsw::Make(128, 8, dim, 8, 200);
+    auto iter = DenseVectorIter<float, LabelT>(data.get(), dim, element_size);
+    hnsw_index->InsertVecs(std::move(iter));
+
+    Atomic<f32> distance_bound{std::numeric_limits<f32>::max()};
+    u64 pruned_count = 0;
+    KnnSearchOption search_option{.ef_ = 50};
+    KnnSearchOption bound_option{.ef_ = 50, .distance_bounds_ = &distance_bound, .bound_pruned_count_ = &pruned_count};
+    for (SizeT i = 0; i < 16; ++i) {
+        const float *query = data.get() + i * dim;
+        // ef results are returned
+        auto expected = hnsw_index->KnnSearchSorted(query, topk, search_option);
+        ASSERT_GE(expected.size(), topk);
+
+        // a loose bound changes nothing
+        distance_bound.store(std::numeric_limits<f32>::max());
+        EXPECT_EQ(hnsw_index->KnnSearchSorted(query, topk, bound_option), expected);
+
+        // with the k-th distance known from elsewhere, the same vertices are visited and only the results within the bound are kept
+        distance_bound.store(expected[topk - 1].first);
+        auto result = hnsw_index->KnnSearchSorted(query, topk, bound_option);
+        auto expected_in_bound = expected;
+        std::erase_if(expected_in_bound, [&](const auto &p) { return p.first > expected[topk - 1].first; });
+        EXPECT_EQ(result, expected_in_bound);
+        EXPECT_GE(result.size(), topk);
+    }
+    EXPECT_GT(pruned_count, 0u);
+}
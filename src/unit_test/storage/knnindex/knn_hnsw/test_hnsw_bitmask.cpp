@@ -142,4 +142,115 @@ TEST_F(HnswAlgBitmaskTest, test1) {
         EXPECT_NEAR(result[0].first, 0.2, error);
         EXPECT_NEAR(result[0].second, 3, error);
     }
-}
\ No newline at end of file
+}
+TEST_F(HnswAlgBitmaskTest, test_low_selectivity) {
+    using LabelT = u64;
+    using Hnsw = KnnHnsw<PlainL2VecStoreType<f32>, LabelT>;
+    int dimension = 16;
+    int element_size = 4000;
+    int M = 16;
+    int ef_construction = 200;
+    SizeT top_k = 10;
+
+    std::mt19937 rng;
+    rng.seed(0);
+    std::uniform_real_distribution<float> distrib_real;
+    auto data = MakeUnique<f32[]>(dimension * element_size);
+    for (int i = 0; i < dimension * element_size; ++i) {
+        data[i] = distrib_real(rng);
+    }
+    auto hnsw_index = Hnsw::Make(element_size, 1, dimension, M, ef_construction);
+    auto iter = DenseVectorIter<f32, LabelT>(data.get(), dimension, element_size);
+    hnsw_index->InsertVecs(std::move(iter));
+
+    // 2% of the labels pass the filter
+    auto p_bitmask = Bitmask::MakeSharedAllTrue(element_size);
+    for (int i = 0; i < element_size; ++i) {
+        if (i % 50 != 0) {
+            p_bitmask->SetFalse(i);
+        }
+    }
+    BitmaskFilter<LabelT> filter(*p_bitmask);
+    KnnSearchOption search_option{.ef_ = top_k, .filter_ratio_ = f32(p_bitmask->CountTrue()) / element_size};
+
+    int query_n = 50;
+    SizeT correct = 0;
+    for (int q = 0; q < query_n; ++q) {
+        const f32 *query = data.get() + (q * 37 % element_size) * dimension;
+        Vector<Pair<f32, LabelT>> truth;
+        for (int i = 0; i < element_size; i += 50) {
+            f32 dist = 0;
+            for (int d = 0; d < dimension; ++d) {
+                f32 diff = query[d] - data[i * dimension + d];
+                dist += diff * diff;
+            }
+            truth.emplace_back(dist, LabelT(i));
+        }
+        std::partial_sort(truth.begin(), truth.begin() + top_k, truth.end());
+        HashSet<LabelT> truth_set;
+        for (SizeT i = 0; i < top_k; ++i) {
+            truth_set.insert(truth[i].second);
+        }
+
+        auto result = hnsw_index->KnnSearchSorted(query, top_k, filter, search_option);
+        EXPECT_EQ(result.size(), top_k);
+        for (const auto &[dist, label] : result) {
+            EXPECT_TRUE(label % 50 == 0);
+            correct += truth_set.contains(label);
+        }
+    }
+    EXPECT_GE(f32(correct) / (query_n * top_k), 0.9);
+}
+
+TEST_F(HnswAlgBitmaskTest, test_repair_deleted) {
+    using LabelT = u64;
+    using Hnsw = KnnHnsw<PlainL2VecStoreType<f32>, LabelT>;
+    int dimension = 16;
+    int element_size = 2000;
+    int M = 16;
+    int ef_construction = 200;
+    SizeT top_k = 10;
+
+    std::mt19937 rng;
+    rng.seed(0);
+    std::uniform_real_distribution<float> distrib_real;
+    auto data = MakeUnique<f32[]>(dimension * element_size);
+    for (int i = 0; i < dimension * element_size; ++i) {
+        data[i] = distrib_real(rng);
+    }
+    auto hnsw_index = Hnsw::Make(element_size, 1, dimension, M, ef_construction);
+    auto iter = DenseVectorIter<f32, LabelT>(data.get(), dimension, element_size);
+    hnsw_index->InsertVecs(std::move(iter));
+
+    // delete one third of the labels
+    auto p_bitmask = Bitmask::MakeSharedAllTrue(element_size);
+    for (int i = 0; i < element_size; i += 3) {
+        p_bitmask->SetFalse(i);
+    }
+    BitmaskFilter<LabelT> filter(*p_bitmask);
+    SizeT removed_n = hnsw_index->RepairDeleted(filter);
+    EXPECT_EQ(removed_n, SizeT(element_size - p_bitmask->CountTrue()));
+    hnsw_index->Check();
+
+    for (int i = 0; i < element_size; ++i) {
+        if (i % 3 == 0) {
+            continue;
+        }
+        const auto [neighbors_p, neighbor_size] = hnsw_index->GetNeighbors(i, 0);
+        EXPECT_GT(neighbor_size, 0);
+        for (int j = 0; j < neighbor_size; ++j) {
+            EXPECT_NE(neighbors_p[j] % 3, 0);
+        }
+    }
+
+    KnnSearchOption search_option{.ef_ = 50};
+    int query_n = 100;
+    SizeT correct = 0;
+    for (int q = 1; q <= query_n; ++q) {
+        const f32 *query = data.get() + (q * 3 - 1) * dimension;
+        auto result = hnsw_index->KnnSearchSorted(query, top_k, filter, search_option);
+        ASSERT_FALSE(result.empty());
+        correct += result[0].second == LabelT(q * 3 - 1);
+    }
+    EXPECT_GE(f32(correct) / query_n, 0.95);
+}
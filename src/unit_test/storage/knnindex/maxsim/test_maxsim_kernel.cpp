@@ -0,0 +1,115 @@
+// Copyright(C) 2024 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import maxsim_kernel;
+import default_values;
+
+using namespace infinity;
+
+class MaxSimKernelTest : public BaseTest {};
+
+namespace {
+
+f32 NaiveMaxSim(const f32 *query, u32 query_embedding_num, const f32 *doc, u32 doc_embedding_num, u32 dimension) {
+    f32 score = 0.0f;
+    for (u32 i = 0; i < query_embedding_num; ++i) {
+        f32 max_ip = std::numeric_limits<f32>::lowest();
+        for (u32 j = 0; j < doc_embedding_num; ++j) {
+            f32 ip = 0.0f;
+            for (u32 k = 0; k < dimension; ++k) {
+                ip += query[i * dimension + k] * doc[j * dimension + k];
+            }
+            max_ip = std::max(max_ip, ip);
+        }
+        score += max_ip;
+    }
+    return score;
+}
+
+} // namespace
+
+TEST_F(MaxSimKernelTest, f32_batch) {
+    constexpr u32 query_embedding_num = 5;
+    constexpr u32 dimension = 24;
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+    Vector<f32> query(query_embedding_num * dimension);
+    for (auto &v : query) {
+        v = dist(rng);
+    }
+    // the last document alone is larger than a batch
+    Vector<u32> embedding_nums = {1, 7, 300, 13, 2, 1000, 999, 33, MAXSIM_BATCH_EMBEDDING_NUM + 3};
+    Vector<Vector<f32>> docs;
+    Vector<const char *> tensors;
+    for (const u32 embedding_num : embedding_nums) {
+        auto &doc = docs.emplace_back(embedding_num * dimension);
+        for (auto &v : doc) {
+            v = dist(rng);
+        }
+        tensors.push_back(reinterpret_cast<const char *>(doc.data()));
+    }
+
+    MaxSimKernel<f32, f32> kernel(reinterpret_cast<const char *>(query.data()), query_embedding_num, dimension);
+    Vector<f32> scores(docs.size());
+    kernel.ScoreBatch(tensors.data(), embedding_nums.data(), docs.size(), scores.data());
+    for (SizeT i = 0; i < docs.size(); ++i) {
+        const f32 expected = NaiveMaxSim(query.data(), query_embedding_num, docs[i].data(), embedding_nums[i], dimension);
+        EXPECT_NEAR(scores[i], expected, 1e-3f);
+        EXPECT_NEAR(kernel.Score(tensors[i], embedding_nums[i]), expected, 1e-3f);
+    }
+}
+
+TEST_F(MaxSimKernelTest, i8_batch) {
+    constexpr u32 query_embedding_num = 3;
+    constexpr u32 dimension = 40;
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<i32> dist(-128, 127);
+    Vector<i8> query(query_embedding_num * dimension);
+    for (auto &v : query) {
+        v = dist(rng);
+    }
+    Vector<u32> embedding_nums = {4, 1, 9};
+    Vector<Vector<i8>> docs;
+    Vector<const char *> tensors;
+    for (const u32 embedding_num : embedding_nums) {
+        auto &doc = docs.emplace_back(embedding_num * dimension);
+        for (auto &v : doc) {
+            v = dist(rng);
+        }
+        tensors.push_back(reinterpret_cast<const char *>(doc.data()));
+    }
+
+    MaxSimKernel<i8, i8> kernel(reinterpret_cast<const char *>(query.data()), query_embedding_num, dimension);
+    Vector<f32> scores(docs.size());
+    kernel.ScoreBatch(tensors.data(), embedding_nums.data(), docs.size(), scores.data());
+    for (SizeT d = 0; d < docs.size(); ++d) {
+        i32 expected = 0;
+        for (u32 i = 0; i < query_embedding_num; ++i) {
+            i32 max_ip = std::numeric_limits<i32>::lowest();
+            for (u32 j = 0; j < embedding_nums[d]; ++j) {
+                i32 ip = 0;
+                for (u32 k = 0; k < dimension; ++k) {
+                    ip += static_cast<i32>(query[i * dimension + k]) * static_cast<i32>(docs[d][j * dimension + k]);
+                }
+                max_ip = std::max(max_ip, ip);
+            }
+            expected += max_ip;
+        }
+        EXPECT_EQ(scores[d], static_cast<f32>(expected));
+    }
+}
@@ -0,0 +1,165 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+import base_test;
+
+import stl;
+import hnsw_alg;
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+import data_store;
+#pragma clang diagnostic pop
+
+import dist_func_l2;
+import vec_store_type;
+import hnsw_common;
+
+using namespace infinity;
+
+class HnswMergeTest : public BaseTest {
+public:
+    using LabelT = u64;
+    using Hnsw = KnnHnsw<PlainL2VecStoreType<float>, LabelT>;
+
+    static constexpr int dim_ = 16;
+    static constexpr int M_ = 8;
+    static constexpr int ef_construction_ = 200;
+    static constexpr int chunk_size_ = 128;
+    static constexpr int max_chunk_n_ = 16;
+
+    // recall@k against brute force, queried by the first `query_n` vectors
+    float Recall(const Hnsw &hnsw_index, const float *data, int element_size, int query_n, int k) {
+        KnnSearchOption search_option{.ef_ = 50};
+        int correct = 0;
+        for (int i = 0; i < query_n; ++i) {
+            const float *query = data + i * dim_;
+            Vector<Pair<float, LabelT>> truth;
+            for (int j = 0; j < element_size; ++j) {
+                float dist = 0;
+                for (int d = 0; d < dim_; ++d) {
+                    float diff = query[d] - data[j * dim_ + d];
+                    dist += diff * diff;
+                }
+                truth.emplace_back(dist, LabelT(j));
+            }
+            std::partial_sort(truth.begin(), truth.begin() + k, truth.end());
+            HashSet<LabelT> truth_set;
+            for (int j = 0; j < k; ++j) {
+                truth_set.insert(truth[j].second);
+            }
+            auto result = hnsw_index.KnnSearchSorted(query, k, search_option);
+            for (const auto &[dist, label] : result) {
+                correct += truth_set.contains(label);
+            }
+        }
+        return float(correct) / (query_n * k);
+    }
+};
+
+TEST_F(HnswMergeTest, test_merge_graph) {
+    Vector<int> chunk_row_cnts{800, 200, 300, 100};
+    int element_size = std::accumulate(chunk_row_cnts.begin(), chunk_row_cnts.end(), 0);
+
+    std::mt19937 rng;
+    rng.seed(0);
+    std::uniform_real_distribution<float> distrib_real;
+    auto data = MakeUnique<float[]>(dim_ * element_size);
+    for (int i = 0; i < dim_ * element_size; ++i) {
+        data[i] = distrib_real(rng);
+    }
+
+    Vector<UniquePtr<Hnsw>> chunks;
+    {
+        int offset = 0;
+        for (int row_cnt : chunk_row_cnts) {
+            auto chunk = Hnsw::Make(chunk_size_, max_chunk_n_, dim_, M_, ef_construction_);
+            auto iter = DenseVectorIter<float, LabelT>(data.get() + offset * dim_, dim_, row_cnt, offset);
+            chunk->InsertVecs(std::move(iter));
+            chunks.push_back(std::move(chunk));
+            offset += row_cnt;
+        }
+    }
+
+    auto rebuild_index = Hnsw::Make(chunk_size_, max_chunk_n_, dim_, M_, ef_construction_);
+    {
+        auto iter = DenseVectorIter<float, LabelT>(data.get(), dim_, element_size);
+        rebuild_index->InsertVecs(std::move(iter));
+    }
+
+    auto merge_index = Hnsw::Make(chunk_size_, max_chunk_n_, dim_, M_, ef_construction_);
+    {
+        auto iter = DenseVectorIter<float, LabelT>(data.get(), dim_, element_size);
+        auto [start_i, end_i] = merge_index->StoreData(std::move(iter));
+        EXPECT_EQ(start_i, 0);
+        EXPECT_EQ(end_i, element_size);
+
+        merge_index->CopyGraph(*chunks[0], 0);
+        int offset = chunk_row_cnts[0];
+        for (SizeT i = 1; i < chunks.size(); ++i) {
+            merge_index->MergeGraph(*chunks[i], offset);
+            offset += chunk_row_cnts[i];
+        }
+    }
+    merge_index->Check();
+    EXPECT_EQ(merge_index->GetVecNum(), SizeT(element_size));
+
+    int query_n = 100;
+    int k = 10;
+    float rebuild_recall = Recall(*rebuild_index, data.get(), element_size, query_n, k);
+    float merge_recall = Recall(*merge_index, data.get(), element_size, query_n, k);
+    EXPECT_GE(merge_recall, 0.9);
+    EXPECT_GE(merge_recall, rebuild_recall - 0.02);
+}
+
+TEST_F(HnswMergeTest, test_merge_graph_largest_not_first) {
+    Vector<int> chunk_row_cnts{100, 600, 200};
+    int element_size = std::accumulate(chunk_row_cnts.begin(), chunk_row_cnts.end(), 0);
+
+    std::mt19937 rng;
+    rng.seed(1);
+    std::uniform_real_distribution<float> distrib_real;
+    auto data = MakeUnique<float[]>(dim_ * element_size);
+    for (int i = 0; i < dim_ * element_size; ++i) {
+        data[i] = distrib_real(rng);
+    }
+
+    Vector<UniquePtr<Hnsw>> chunks;
+    Vector<int> offsets;
+    {
+        int offset = 0;
+        for (int row_cnt : chunk_row_cnts) {
+            auto chunk = Hnsw::Make(chunk_size_, max_chunk_n_, dim_, M_, ef_construction_);
+            auto iter = DenseVectorIter<float, LabelT>(data.get() + offset * dim_, dim_, row_cnt, offset);
+            chunk->InsertVecs(std::move(iter));
+            chunks.push_back(std::move(chunk));
+            offsets.push_back(offset);
+            offset += row_cnt;
+        }
+    }
+
+    auto merge_index = Hnsw::Make(chunk_size_, max_chunk_n_, dim_, M_, ef_construction_);
+    {
+        auto iter = DenseVectorIter<float, LabelT>(data.get(), dim_, element_size);
+        merge_index->StoreData(std::move(iter));
+        merge_index->CopyGraph(*chunks[1], offsets[1]);
+        merge_index->MergeGraph(*chunks[0], offsets[0]);
+        merge_index->MergeGraph(*chunks[2], offsets[2]);
+    }
+    merge_index->Check();
+
+    float merge_recall = Recall(*merge_index, data.get(), element_size, 100, 10);
+    EXPECT_GE(merge_recall, 0.9);
+}
@@ -33,6 +33,10 @@ import column_vector;
 import data_block;
 import index_hnsw;
 import index_secondary;
+import index_diskann;
+import diskann_index_in_chunk;
+import chunk_index_entry;
+import default_values;
 import statement_common;
 import embedding_info;
 import knn_expr;
@@ -289,4 +293,113 @@ TEST_P(OptimizeKnnTest, test_secondary_index_optimize) {
         ASSERT_EQ(memory_index_entry.get(), nullptr);
         txn_mgr->CommitTxn(txn);
     }
-}
\ No newline at end of file
+}
+TEST_P(OptimizeKnnTest, test_diskann_optimize) {
+    Storage *storage = InfinityContext::instance().storage();
+    TxnManager *txn_mgr = storage->txn_manager();
+
+    auto db_name = std::make_shared<std::string>("default_db");
+    auto column_def1 = std::make_shared<ColumnDef>(0, std::make_shared<DataType>(LogicalType::kInteger), "col1", std::set<ConstraintType>());
+    auto column_def2 =
+        std::make_shared<ColumnDef>(1,
+                                    std::make_shared<DataType>(LogicalType::kEmbedding, EmbeddingInfo::Make(EmbeddingDataType::kElemFloat, 4)),
+                                    "col2",
+                                    std::set<ConstraintType>());
+    auto table_name = std::make_shared<std::string>("tb1");
+    auto table_def = TableDef::Make(db_name, table_name, {column_def1, column_def2});
+    auto index_name = std::make_shared<std::string>("idx1");
+
+    {
+        auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("create table"));
+        txn->CreateTable(*db_name, table_def, ConflictType::kError);
+        txn_mgr->CommitTxn(txn);
+    }
+    {
+        Vector<String> column_names{"col2"};
+        const String &file_name = "idx_file.idx";
+        InitParameter metric_param{"metric", "l2"};
+        Vector<InitParameter *> index_param_list_ptr{&metric_param};
+        auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("create index"));
+        auto [table_entry, status] = txn->GetTableByName(*db_name, *table_name);
+        ASSERT_TRUE(status.ok());
+        auto index_diskann = IndexDiskAnn::Make(index_name, file_name, column_names, index_param_list_ptr);
+        auto [table_index_entry, status2] = txn->CreateIndexDef(table_entry, index_diskann, ConflictType::kError);
+        ASSERT_TRUE(status2.ok());
+        txn_mgr->CommitTxn(txn);
+    }
+
+    // more rows than the pq centers, appended after the index is created, so only optimize can build a graph of them
+    auto row_vector = [](int i) -> Vector<float> { return {i * 0.01f, (i % 7) * 0.05f, (i % 3) * 0.02f, (i % 11) * 0.001f}; };
+    constexpr int batch_row_cnt = 100;
+    constexpr int batch_cnt = 4;
+    auto DoAppend = [&](int batch) {
+        auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("insert table"));
+        Vector<SharedPtr<ColumnVector>> column_vectors;
+        for (SizeT i = 0; i < table_def->columns().size(); ++i) {
+            SharedPtr<DataType> data_type = table_def->columns()[i]->type();
+            column_vectors.push_back(MakeShared<ColumnVector>(data_type));
+            column_vectors.back()->Initialize();
+        }
+        for (int i = batch * batch_row_cnt; i < (batch + 1) * batch_row_cnt; ++i) {
+            Vector<float> vec = row_vector(i);
+            column_vectors[0]->AppendByPtr(reinterpret_cast<const char *>(&i));
+            column_vectors[1]->AppendByPtr(reinterpret_cast<const char *>(vec.data()));
+        }
+        auto data_block = DataBlock::Make();
+        data_block->Init(column_vectors);
+        auto [table_entry, status] = txn->GetTableByName(*db_name, *table_name);
+        ASSERT_TRUE(status.ok());
+        status = txn->Append(table_entry, data_block);
+        ASSERT_TRUE(status.ok());
+        txn_mgr->CommitTxn(txn);
+    };
+    auto CheckChunks = [&](SizeT expect_chunk_cnt) {
+        auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("check index"));
+        auto [table_index_entry, status] = txn->GetIndexByName(*db_name, *table_name, *index_name);
+        ASSERT_TRUE(status.ok());
+        auto &segment_index_entries = table_index_entry->index_by_segment();
+        ASSERT_EQ(segment_index_entries.size(), 1ul);
+        auto &segment_index_entry = segment_index_entries.begin()->second;
+        Vector<SharedPtr<ChunkIndexEntry>> chunk_index_entries;
+        for (auto &chunk_index_entry : segment_index_entry->GetDiskAnnIndexSnapshot()) {
+            if (chunk_index_entry->CheckVisible(txn)) {
+                chunk_index_entries.push_back(chunk_index_entry);
+            }
+        }
+        ASSERT_EQ(chunk_index_entries.size(), expect_chunk_cnt);
+        if (expect_chunk_cnt != 0) {
+            auto &chunk_index_entry = chunk_index_entries[0];
+            ASSERT_EQ(chunk_index_entry->row_count_, u32(batch_row_cnt * batch_cnt));
+            auto index_handle = chunk_index_entry->GetIndex();
+            const auto *diskann_chunk = static_cast<const DiskAnnIndexInChunk *>(index_handle.GetData());
+            ASSERT_TRUE(diskann_chunk->HasGraph());
+            // a row of the last batch is the nearest to itself
+            Vector<float> query = row_vector(batch_row_cnt * batch_cnt - 10);
+            auto candidates = diskann_chunk->Search(query.data(), DISKANN_SEARCH_L, DISKANN_BEAM_WIDTH);
+            ASSERT_FALSE(candidates.empty());
+            EXPECT_EQ(candidates[0].second, u32(batch_row_cnt * batch_cnt - 10));
+        }
+        txn_mgr->CommitTxn(txn);
+    };
+    auto DoOptimize = [&] {
+        Txn *txn = txn_mgr->BeginTxn(MakeUnique<String>("optimize index"));
+        auto [table_entry, status] = txn->GetTableByName(*db_name, *table_name);
+        ASSERT_TRUE(status.ok());
+        table_entry->OptimizeIndex(txn);
+        txn_mgr->CommitTxn(txn);
+    };
+
+    for (int batch = 0; batch < batch_cnt; ++batch) {
+        DoAppend(batch);
+    }
+    CheckChunks(0);
+
+    DoOptimize();
+    CheckChunks(1);
+
+    // nothing was appended since, the chunk is kept
+    DoOptimize();
+    WaitFlushFullCkp(storage);
+    WaitCleanup(storage);
+    CheckChunks(1);
+}
@@ -44,3 +44,65 @@ TEST_F(ObjectStatMapTest, test1) {
     stat2 = obj_map.GetNoCount("key2");
     EXPECT_EQ(stat2, nullptr);
 }
+
+TEST_F(ObjectStatMapTest, cached_ranges) {
+    SizeT disk_capacity_limit = 10;
+    ObjectStatAccessor_ObjectStorage obj_map(disk_capacity_limit);
+
+    // key1 is known from the catalog but not downloaded
+    obj_map.PutNoCount("key1", ObjStat(8, 2, 0, false));
+    ObjStat *stat1 = obj_map.Get("key1");
+    EXPECT_FALSE(stat1->RangeCached(Range{.start_ = 0, .end_ = 1}));
+    stat1->AddCachedRange(Range{.start_ = 0, .end_ = 3});
+    EXPECT_TRUE(stat1->RangeCached(Range{.start_ = 1, .end_ = 2}));
+    EXPECT_FALSE(stat1->RangeCached(Range{.start_ = 2, .end_ = 5}));
+    stat1->AddCachedRange(Range{.start_ = 3, .end_ = 5});
+    EXPECT_EQ(stat1->cached_ranges_.size(), 1);
+    EXPECT_TRUE(stat1->RangeCached(Range{.start_ = 2, .end_ = 5}));
+    EXPECT_FALSE(stat1->cached_);
+
+    Vector<String> drop_keys;
+    obj_map.Release("key1", drop_keys);
+    EXPECT_EQ(obj_map.disk_used(), 5);
+
+    // the downloaded ranges of key1 are envicted with it
+    obj_map.PutNew("key2", ObjStat(6, 1, 0), drop_keys);
+    EXPECT_EQ(drop_keys.size(), 1);
+    EXPECT_EQ(drop_keys[0], "key1");
+    EXPECT_EQ(obj_map.disk_used(), 6);
+    stat1 = obj_map.GetNoCount("key1");
+    EXPECT_TRUE(stat1->cached_ranges_.empty());
+
+    // ranges covering the object make it cached
+    stat1->AddCachedRange(Range{.start_ = 4, .end_ = 8});
+    stat1->AddCachedRange(Range{.start_ = 0, .end_ = 4});
+    EXPECT_TRUE(stat1->cached_);
+    EXPECT_EQ(stat1->CachedSize(), 8);
+}
+
+TEST_F(ObjectStatMapTest, invalidate_partly_cached) {
+    SizeT disk_capacity_limit = 10;
+    ObjectStatAccessor_ObjectStorage obj_map(disk_capacity_limit);
+
+    // key1 is partly downloaded, it is in the lru list though it isn't cached
+    obj_map.PutNoCount("key1", ObjStat(8, 2, 0, false));
+    ObjStat *stat1 = obj_map.Get("key1");
+    stat1->AddCachedRange(Range{.start_ = 0, .end_ = 3});
+    Vector<String> drop_keys;
+    obj_map.Release("key1", drop_keys);
+    EXPECT_EQ(obj_map.disk_used(), 3);
+
+    Optional<ObjStat> stat1_opt = obj_map.Invalidate("key1");
+    EXPECT_TRUE(stat1_opt.has_value());
+    EXPECT_EQ(obj_map.GetNoCount("key1"), nullptr);
+    EXPECT_EQ(obj_map.disk_used(), 0);
+
+    // the lists are still consistent
+    obj_map.PutNew("key2", ObjStat(6, 1, 0), drop_keys);
+    obj_map.PutNew("key3", ObjStat(4, 1, 0), drop_keys);
+    EXPECT_TRUE(drop_keys.empty());
+    obj_map.PutNew("key4", ObjStat(4, 1, 0), drop_keys);
+    EXPECT_EQ(drop_keys.size(), 1);
+    EXPECT_EQ(drop_keys[0], "key2");
+    EXPECT_TRUE(obj_map.Invalidate("key2").has_value());
+}
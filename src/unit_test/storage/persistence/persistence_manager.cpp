@@ -6,6 +6,7 @@ import virtual_store;
 import third_party;
 import persist_result_handler;
 import local_file_handle;
+import logger;
 
 using namespace infinity;
 namespace fs = std::filesystem;
@@ -191,4 +192,54 @@ TEST_F(PersistenceManagerTest, CleanupBasic) {
     for (const auto& obj_path : obj_paths) {
         ASSERT_FALSE(fs::exists(obj_path));
     }
-}
\ No newline at end of file
+}
+
+TEST_F(PersistenceManagerTest, ObjectStorageEvictAndDownload) {
+    VirtualStore::InitRemoteStore();
+    if (!VirtualStore::BucketExists()) {
+        LOG_INFO("bucket existence check failed, skip the test");
+        VirtualStore::UnInitRemoteStore();
+        return;
+    }
+    // the disk cache holds two objects
+    pm_ = MakeUnique<PersistenceManager>(workspace_, file_dir_, ObjSizeLimit, false, 2 * ObjSizeLimit);
+    handler_ = MakeUnique<PersistResultHandler>(pm_.get());
+
+    String file_path_base = file_dir_ + "/persist_file";
+    Vector<String> file_paths;
+    Vector<String> persist_strs;
+    Vector<String> obj_paths;
+    for (SizeT i = 0; i < 4; ++i) {
+        String file_path = file_path_base + std::to_string(i);
+        String persist_str(ObjSizeLimit, 'a' + i);
+        std::ofstream out_file(file_path);
+        out_file << persist_str;
+        out_file.close();
+        file_paths.push_back(file_path);
+        persist_strs.push_back(persist_str);
+
+        PersistWriteResult result = pm_->Persist(file_path, file_path);
+        // the server role isn't set in the test, upload as a standalone node does
+        for (const String &persist_key : result.persist_keys_) {
+            String persist_path = pm_->GetObjPath(persist_key);
+            ASSERT_TRUE(VirtualStore::UploadObject(persist_path, persist_path).ok());
+        }
+        handler_->HandleWriteResult(result);
+        obj_paths.push_back(pm_->GetObjPath(result.obj_addr_.obj_key_));
+    }
+    // the two oldest objects were evicted from the disk
+    ASSERT_FALSE(fs::exists(obj_paths[0]));
+    ASSERT_FALSE(fs::exists(obj_paths[1]));
+    ASSERT_TRUE(fs::exists(obj_paths[2]));
+    ASSERT_TRUE(fs::exists(obj_paths[3]));
+
+    // they are downloaded again when read
+    for (SizeT i = 0; i < file_paths.size(); ++i) {
+        CheckObjData(file_paths[i], persist_strs[i]);
+    }
+
+    for (const auto &obj_path : obj_paths) {
+        EXPECT_TRUE(VirtualStore::RemoveObject(obj_path).ok());
+    }
+    VirtualStore::UnInitRemoteStore();
+}
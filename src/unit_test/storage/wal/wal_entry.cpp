@@ -288,6 +288,17 @@ TEST_F(WalEntryTest, ReadWrite) {
     EXPECT_NE(entry2, nullptr);
     EXPECT_EQ(*entry == *entry2, true);
     EXPECT_EQ(ptr_r - buf_beg, exp_size);
+
+    // a torn entry whose header claims more bytes than are left is rejected
+    auto *header = reinterpret_cast<WalEntryHeader *>(buf_beg);
+    header->size_ = exp_size + 1024;
+    ptr_r = buf_beg;
+    EXPECT_EQ(WalEntry::ReadAdv(ptr_r, exp_size), nullptr);
+    header->size_ = -exp_size;
+    ptr_r = buf_beg;
+    EXPECT_EQ(WalEntry::ReadAdv(ptr_r, exp_size), nullptr);
+    ptr_r = buf_beg;
+    EXPECT_EQ(WalEntry::ReadAdv(ptr_r, i32(sizeof(WalEntryHeader) - 1)), nullptr);
     infinity::InfinityContext::instance().UnInit();
 }
 
@@ -470,3 +481,42 @@ TEST_F(WalEntryTest, WalListIterator) {
     EXPECT_EQ(catalog_path, ckp_file_path);
     EXPECT_EQ(replay_entries.size(), 1u);
 }
+
+TEST_F(WalEntryTest, WalListIteratorParallelDecode) {
+    using namespace infinity;
+    RemoveDbDirs();
+    std::filesystem::create_directories(GetFullWalDir());
+    String wal_file_path1 = String(GetFullWalDir()) + "/wal.log";
+    String wal_file_path2 = String(GetFullWalDir()) + "/wal2.log";
+    String ckp_file_path = "catalog";
+    String ckp_file_name = String("META_123.full.json");
+    MockWalFile(wal_file_path1, ckp_file_path, ckp_file_name);
+    MockWalFile(wal_file_path2, ckp_file_path, ckp_file_name);
+
+    Vector<SharedPtr<WalEntry>> sequential_entries;
+    {
+        WalListIterator iterator({wal_file_path1, wal_file_path2});
+        while (iterator.HasNext()) {
+            auto wal_entry = iterator.Next();
+            if (wal_entry.get() == nullptr) {
+                break;
+            }
+            sequential_entries.push_back(wal_entry);
+        }
+    }
+    Vector<SharedPtr<WalEntry>> parallel_entries;
+    {
+        WalListIterator iterator({wal_file_path1, wal_file_path2}, 4);
+        while (iterator.HasNext()) {
+            auto wal_entry = iterator.Next();
+            if (wal_entry.get() == nullptr) {
+                break;
+            }
+            parallel_entries.push_back(wal_entry);
+        }
+    }
+    ASSERT_EQ(parallel_entries.size(), sequential_entries.size());
+    for (SizeT i = 0; i < parallel_entries.size(); ++i) {
+        EXPECT_EQ(*parallel_entries[i], *sequential_entries[i]);
+    }
+}
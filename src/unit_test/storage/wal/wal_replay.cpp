@@ -59,6 +59,8 @@ import table_index_entry;
 import base_entry;
 import compilation_config;
 import compaction_process;
+import base_memindex;
+import memindex_tracer;
 
 using namespace infinity;
 
@@ -1006,3 +1008,186 @@ TEST_P(WalReplayTest, wal_replay_create_index_hnsw) {
 #endif
     }
 }
+
+TEST_P(WalReplayTest, wal_replay_interleaved_tables) {
+    // appends and deletes of several tables interleave in the wal, with ddl and a two-table append as barriers in between.
+    // replay groups them by table, so the restarted catalog must hold the same rows, deletes and index rows as before.
+    constexpr SizeT block_rows = 8;
+    constexpr SizeT round_count = 4;
+    const Vector<String> table_names{"tbl1", "tbl2", "tbl3", "tbl4"};
+    Map<String, SizeT> row_counts;
+    Map<String, SizeT> deleted_counts;
+
+    auto make_columns = [] {
+        Vector<SharedPtr<ColumnDef>> columns;
+        {
+            std::set<ConstraintType> constraints;
+            auto column_def_ptr = MakeShared<ColumnDef>(0, MakeShared<DataType>(LogicalType::kBigInt), "c1", constraints);
+            columns.emplace_back(column_def_ptr);
+        }
+        {
+            std::set<ConstraintType> constraints;
+            auto embedding_info = MakeShared<EmbeddingInfo>(EmbeddingDataType::kElemFloat, 4);
+            auto column_def_ptr = MakeShared<ColumnDef>(1, MakeShared<DataType>(LogicalType::kEmbedding, embedding_info), "c2", constraints);
+            columns.emplace_back(column_def_ptr);
+        }
+        return columns;
+    };
+    // c1 holds the segment offset of the row, so the check after restart also sees the append order within each table
+    auto make_block = [&](const String &table_name) {
+        SharedPtr<DataBlock> input_block = MakeShared<DataBlock>();
+        Vector<SharedPtr<DataType>> column_types;
+        column_types.emplace_back(MakeShared<DataType>(LogicalType::kBigInt));
+        column_types.emplace_back(MakeShared<DataType>(LogicalType::kEmbedding, MakeShared<EmbeddingInfo>(EmbeddingDataType::kElemFloat, 4)));
+        input_block->Init(column_types, block_rows);
+        SizeT &row_count = row_counts[table_name];
+        for (SizeT i = 0; i < block_rows; ++i, ++row_count) {
+            input_block->AppendValue(0, Value::MakeBigInt(static_cast<i64>(row_count)));
+            f32 f = row_count;
+            input_block->AppendValue(1, Value::MakeEmbedding(Vector<f32>{f, f + 1, f + 2, f + 3}));
+        }
+        input_block->Finalize();
+        return input_block;
+    };
+
+    {
+#ifdef INFINITY_DEBUG
+        infinity::GlobalResourceUsage::Init();
+#endif
+        std::shared_ptr<std::string> config_path = WalReplayTest::config_path();
+        infinity::InfinityContext::instance().Init(config_path);
+
+        Storage *storage = infinity::InfinityContext::instance().storage();
+        TxnManager *txn_mgr = storage->txn_manager();
+
+        auto create_table = [&](const String &table_name) {
+            auto table_def = MakeUnique<TableDef>(MakeShared<String>("default_db"), MakeShared<String>(table_name), make_columns());
+            auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("create table"));
+            Status status = txn->CreateTable("default_db", std::move(table_def), ConflictType::kError);
+            EXPECT_TRUE(status.ok());
+            txn_mgr->CommitTxn(txn);
+        };
+        auto append = [&](const Vector<String> &names) {
+            auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("insert table"));
+            for (const auto &table_name : names) {
+                auto [table_entry, status] = txn->GetTableByName("default_db", table_name);
+                EXPECT_TRUE(status.ok());
+                status = txn->Append(table_entry, make_block(table_name));
+                EXPECT_TRUE(status.ok());
+            }
+            txn_mgr->CommitTxn(txn);
+        };
+        auto delete_rows = [&](const String &table_name, const Vector<SegmentOffset> &offsets) {
+            auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("delete table"));
+            auto [table_entry, status] = txn->GetTableByName("default_db", table_name);
+            EXPECT_TRUE(status.ok());
+            Vector<RowID> row_ids;
+            for (SegmentOffset offset : offsets) {
+                row_ids.emplace_back(0, offset);
+            }
+            status = txn->Delete(table_entry, row_ids);
+            EXPECT_TRUE(status.ok());
+            txn_mgr->CommitTxn(txn);
+            deleted_counts[table_name] += offsets.size();
+        };
+
+        create_table("tbl1");
+        create_table("tbl2");
+        create_table("tbl3");
+        {
+            auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("create index"));
+            Vector<InitParameter *> parameters;
+            parameters.emplace_back(new InitParameter("metric", "l2"));
+            parameters.emplace_back(new InitParameter("encode", "plain"));
+            parameters.emplace_back(new InitParameter("m", "16"));
+            parameters.emplace_back(new InitParameter("ef_construction", "200"));
+            auto index_base = IndexHnsw::Make(MakeShared<String>("hnsw_index"), "hnsw_index_tbl1", Vector<String>{"c2"}, parameters);
+            for (auto *init_parameter : parameters) {
+                delete init_parameter;
+            }
+            auto [table_entry, table_status] = txn->GetTableByName("default_db", "tbl1");
+            EXPECT_TRUE(table_status.ok());
+            auto table_ref = BaseTableRef::FakeTableRef(table_entry, txn);
+            auto [table_index_entry, status] = txn->CreateIndexDef(table_entry, index_base, ConflictType::kError);
+            EXPECT_TRUE(status.ok());
+            txn->CreateIndexPrepare(table_index_entry, table_ref.get(), false);
+            txn->CreateIndexFinish(table_entry, table_index_entry);
+            txn_mgr->CommitTxn(txn);
+        }
+        for (SizeT round = 0; round < round_count; ++round) {
+            if (round == 2) {
+                create_table("tbl4");
+            }
+            SegmentOffset base = round * block_rows;
+            append({"tbl1"});
+            append({"tbl2"});
+            delete_rows("tbl2", {base, base + 1});
+            append({"tbl3"});
+            if (round >= 2) {
+                append({"tbl4"});
+            }
+            delete_rows("tbl3", {base + 2});
+            if (round == 1) {
+                // one entry appending to two tables
+                append({"tbl3", "tbl1"});
+            }
+        }
+        delete_rows("tbl4", {0});
+
+        infinity::InfinityContext::instance().UnInit();
+#ifdef INFINITY_DEBUG
+        EXPECT_EQ(infinity::GlobalResourceUsage::GetObjectCount(), 0);
+        EXPECT_EQ(infinity::GlobalResourceUsage::GetRawMemoryCount(), 0);
+        infinity::GlobalResourceUsage::UnInit();
+#endif
+    }
+    EXPECT_EQ(row_counts["tbl1"], 40u);
+    EXPECT_EQ(row_counts["tbl3"], 40u);
+    EXPECT_EQ(row_counts["tbl4"], 16u);
+    // Restart the db instance
+    {
+#ifdef INFINITY_DEBUG
+        infinity::GlobalResourceUsage::Init();
+#endif
+        std::shared_ptr<std::string> config_path = WalReplayTest::config_path();
+        infinity::InfinityContext::instance().Init(config_path);
+
+        Storage *storage = infinity::InfinityContext::instance().storage();
+        TxnManager *txn_mgr = storage->txn_manager();
+
+        {
+            auto *txn = txn_mgr->BeginTxn(MakeUnique<String>("check table"));
+            TxnTimeStamp begin_ts = txn->BeginTS();
+            for (const auto &table_name : table_names) {
+                auto [table_entry, status] = txn->GetTableByName("default_db", table_name);
+                ASSERT_TRUE(status.ok());
+                SizeT row_count = row_counts[table_name];
+                auto segment_entry = table_entry->GetSegmentByID(0, begin_ts);
+                ASSERT_NE(segment_entry, nullptr);
+                EXPECT_EQ(segment_entry->row_count(), row_count);
+                EXPECT_EQ(segment_entry->actual_row_count(), row_count - deleted_counts[table_name]);
+
+                auto *block_entry = segment_entry->GetBlockEntryByID(0).get();
+                EXPECT_EQ(block_entry->row_count(), row_count);
+                ColumnVector col0 = block_entry->GetColumnBlockEntry(0)->GetConstColumnVector(storage->buffer_manager());
+                for (SizeT i = 0; i < row_count; ++i) {
+                    EXPECT_EQ(col0.GetValue(i).GetValue<BigIntT>(), static_cast<i64>(i));
+                }
+            }
+
+            auto [table_index_entry, status] = txn->GetIndexByName("default_db", "tbl1", "hnsw_index");
+            ASSERT_TRUE(status.ok());
+            BaseMemIndex *mem_index = table_index_entry->GetMemIndex();
+            ASSERT_NE(mem_index, nullptr);
+            EXPECT_EQ(mem_index->GetInfo().row_count_, row_counts["tbl1"]);
+            txn_mgr->CommitTxn(txn);
+        }
+
+        infinity::InfinityContext::instance().UnInit();
+#ifdef INFINITY_DEBUG
+        EXPECT_EQ(infinity::GlobalResourceUsage::GetObjectCount(), 0);
+        EXPECT_EQ(infinity::GlobalResourceUsage::GetRawMemoryCount(), 0);
+        infinity::GlobalResourceUsage::UnInit();
+#endif
+    }
+}
@@ -31,6 +31,7 @@ struct RegisterRequest {
 3: string node_ip,
 4: i64 node_port,
 5: i64 txn_timestamp,
+6: i64 log_batch_version = 0, // highest batched log frame version the node decodes, 0 for plain entries only
 }
 
 struct RegisterResponse {